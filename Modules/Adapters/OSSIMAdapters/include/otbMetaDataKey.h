@@ -74,6 +74,12 @@ namespace MetaDataKey
   extern OTBOSSIMAdapters_EXPORT char const * NoDataValueAvailable;
   extern OTBOSSIMAdapters_EXPORT char const * NoDataValue;
 
+  /** Keys set in the dictionary of a process object to report the memory it
+   * uses on top of its output buffers (as double values, in bytes). They are
+   * used by the PipelineMemoryPrintCalculator. */
+  extern OTBOSSIMAdapters_EXPORT char const * MemoryPrintPerOutputPixel;
+  extern OTBOSSIMAdapters_EXPORT char const * MemoryPrintPerThread;
+
 
   enum  KeyType
     {
@@ -65,6 +65,9 @@ char const* TileHintY = "TileHintY";
 
 char const * NoDataValueAvailable = "NoDataValueAvailable";
 char const * NoDataValue = "NoDataValue";
+
+char const * MemoryPrintPerOutputPixel = "MemoryPrintPerOutputPixel";
+char const * MemoryPrintPerThread = "MemoryPrintPerThread";
 }
 
 const MetaDataKey::KeyTypeDef Types[] =
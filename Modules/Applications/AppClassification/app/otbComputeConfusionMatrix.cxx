@@ -28,6 +28,7 @@
 #include "otbRAMDrivenAdaptativeStreamingManager.h"
 
 #include "otbConfusionMatrixMeasurements.h"
+#include "otbStreamingConfusionMatrixImageFilter.h"
 #include "otbContingencyTableCalculator.h"
 #include "otbContingencyTable.h"
 
@@ -81,6 +82,8 @@ public:
   typedef ConfusionMatrixMeasurementsType::MapOfClassesType                     MapOfClassesType;
   typedef ConfusionMatrixMeasurementsType::MeasurementType                      MeasurementType;
 
+  typedef otb::StreamingConfusionMatrixImageFilter<Int32ImageType>              ConfusionMatrixFilterType;
+
   typedef ContingencyTable<ClassLabelType>  ContingencyTableType;
   typedef ContingencyTableType::Pointer     ContingencyTablePointerType;
 
@@ -410,57 +413,24 @@ private:
 
   void DoExecuteConfusionMatrix(const StreamingInitializationData& sid)
   {
+    // Threaded and streamed counting of the reference/produced label pairs
+    ConfusionMatrixFilterType::Pointer confusionMatrixFilter = ConfusionMatrixFilterType::New();
+    confusionMatrixFilter->SetInput(m_Input);
+    confusionMatrixFilter->SetReferenceImage(m_Reference);
+    confusionMatrixFilter->SetReferenceNoDataFlag(sid.refhasnodata);
+    confusionMatrixFilter->SetReferenceNoDataValue(sid.refnodata);
+    confusionMatrixFilter->SetProducedNoDataFlag(sid.prodhasnodata);
+    confusionMatrixFilter->SetProducedNoDataValue(sid.prodnodata);
+    float bias = 2.0; // empiric value;
+    confusionMatrixFilter->GetStreamer()->SetAutomaticAdaptativeStreaming(GetParameterInt("ram"), bias);
+    AddProcess(confusionMatrixFilter->GetStreamer(), "Computing the confusion matrix...");
+    confusionMatrixFilter->Update();
 
-    // Extraction of the Class Labels from the Reference image/rasterized vector data + filling of m_Matrix
-    MapOfClassesType  mapOfClassesRef, mapOfClassesProd;
+    const OutputConfusionMatrixType& matrix = confusionMatrixFilter->GetSparseConfusionMatrix();
+    MapOfClassesType  mapOfClassesRef = confusionMatrixFilter->GetReferenceMapOfClasses();
+    MapOfClassesType  mapOfClassesProd = confusionMatrixFilter->GetProducedMapOfClasses();
     MapOfClassesType::iterator  itMapOfClassesRef, itMapOfClassesProd;
     ClassLabelType labelRef = 0, labelProd = 0;
-    int itLabelRef = 0, itLabelProd = 0;
-
-    for (unsigned int index = 0; index < sid.numberOfStreamDivisions; index++)
-      {
-      RegionType streamRegion = m_StreamingManager->GetSplit(index);
-
-      m_Input->SetRequestedRegion(streamRegion);
-      m_Input->PropagateRequestedRegion();
-      m_Input->UpdateOutputData();
-
-      m_Reference->SetRequestedRegion(streamRegion);
-      m_Reference->PropagateRequestedRegion();
-      m_Reference->UpdateOutputData();
-
-      ImageIteratorType itInput(m_Input, streamRegion);
-      itInput.GoToBegin();
-
-      ImageIteratorType itRef(m_Reference, streamRegion);
-      itRef.GoToBegin();
-
-      while (!itRef.IsAtEnd())
-        {
-        labelRef = static_cast<ClassLabelType> (itRef.Get());
-        labelProd = static_cast<ClassLabelType> (itInput.Get());
-
-        // Extraction of the reference/produced class labels
-        if ((!sid.refhasnodata || labelRef != sid.refnodata) && (!sid.prodhasnodata || labelProd != sid.prodnodata))
-          {
-          // If the current labels have not been added to their respective mapOfClasses yet
-          if (mapOfClassesRef.insert(MapOfClassesType::value_type(labelRef, itLabelRef)).second)
-            {
-            ++itLabelRef;
-            }
-          if (mapOfClassesProd.insert(MapOfClassesType::value_type(labelProd, itLabelProd)).second)
-            {
-            ++itLabelProd;
-            }
-
-          // Filling of m_Matrix
-          m_Matrix[labelRef][labelProd]++;
-          } // END if ((labelRef != nodata) && (labelProd != nodata))
-        ++itRef;
-        ++itInput;
-        }
-      } // END of for (unsigned int index = 0; index < numberOfStreamDivisions; index++)
-
 
     /////////////////////////////////////////////
     // Filling the 2 headers for the output file
@@ -474,15 +444,11 @@ private:
 
     MapOfClassesType::iterator itMapOfClassesRefEnd = mapOfClassesRef.end();
     itMapOfClassesRef = mapOfClassesRef.begin();
-    int indexLabelRef = 0;
     while (itMapOfClassesRef != itMapOfClassesRefEnd)
       {
-      // labels labelRef of mapOfClassesRef are already sorted
+      // labels of mapOfClassesRef are sorted, and so are their indices
       labelRef = itMapOfClassesRef->first;
-
-      // SORTING the itMapOfClassesRef->second items of mapOfClassesRef
-      mapOfClassesRef[labelRef] = indexLabelRef;
-      otbAppLogINFO("mapOfClassesRef[" << labelRef << "] = " << mapOfClassesRef[labelRef]);
+      otbAppLogINFO("mapOfClassesRef[" << labelRef << "] = " << itMapOfClassesRef->second);
 
       ossHeaderRefLabels << labelRef;
       ++itMapOfClassesRef;
@@ -494,23 +460,17 @@ private:
         {
         ossHeaderRefLabels << std::endl;
         }
-
-      ++indexLabelRef;
       }
 
     // Filling ossHeaderProdLabels for the output file
     ossHeaderProdLabels << commentProdStr;
     MapOfClassesType::iterator itMapOfClassesProdEnd = mapOfClassesProd.end();
     itMapOfClassesProd = mapOfClassesProd.begin();
-    int indexLabelProd = 0;
     while (itMapOfClassesProd != itMapOfClassesProdEnd)
       {
-      // labels labelProd of mapOfClassesProd are already sorted
+      // labels of mapOfClassesProd are sorted, and so are their indices
       labelProd = itMapOfClassesProd->first;
-
-      // SORTING the itMapOfClassesProd->second items of mapOfClassesProd
-      mapOfClassesProd[labelProd] = indexLabelProd;
-      otbAppLogINFO("mapOfClassesProd[" << labelProd << "] = " << mapOfClassesProd[labelProd]);
+      otbAppLogINFO("mapOfClassesProd[" << labelProd << "] = " << itMapOfClassesProd->second);
 
       ossHeaderProdLabels << labelProd;
       ++itMapOfClassesProd;
@@ -522,8 +482,6 @@ private:
         {
         ossHeaderProdLabels << std::endl;
         }
-
-      ++indexLabelProd;
       }
 
 
@@ -538,41 +496,20 @@ private:
     outFile << ossHeaderProdLabels.str();
     /////////////////////////////////////
 
-
-    // Initialization of the Confusion Matrix for the application LOG and for measurements
-    int nbClassesRef = static_cast<int>(mapOfClassesRef.size());
     int nbClassesProd = static_cast<int>(mapOfClassesProd.size());
 
-    // Formatting m_MatrixLOG from m_Matrix in order to make m_MatrixLOG a square matrix
-    // from the reference labels in mapOfClassesRef
-    indexLabelRef = 0;
-    int indexLabelProdInRef = 0;
-
-    // Initialization of m_MatrixLOG
-    m_MatrixLOG.SetSize(nbClassesRef, nbClassesRef);
-    m_MatrixLOG.Fill(0);
-    for (itMapOfClassesRef = mapOfClassesRef.begin(); itMapOfClassesRef != itMapOfClassesRefEnd; ++itMapOfClassesRef)
+    ///////////////////////////////////////////////////////////
+    // Writing the ordered confusion matrix in the output file,
+    // pairs which were never observed are zeros
+    OutputConfusionMatrixType::const_iterator itMatrix = matrix.begin();
+    for (; itMatrix != matrix.end(); ++itMatrix)
       {
-      // labels labelRef of mapOfClassesRef are already sorted
-      labelRef = itMapOfClassesRef->first;
-
-      indexLabelProd = 0;
+      int indexLabelProd = 0;
       for (itMapOfClassesProd = mapOfClassesProd.begin(); itMapOfClassesProd != itMapOfClassesProdEnd; ++itMapOfClassesProd)
         {
-        // labels labelProd of mapOfClassesProd are already sorted
-        labelProd = itMapOfClassesProd->first;
-
-        // If labelProd is present in mapOfClassesRef
-        if (mapOfClassesRef.count(labelProd) != 0)
-          {
-          // Index of labelProd in mapOfClassesRef; itMapOfClassesRef->second elements are now SORTED
-          indexLabelProdInRef = mapOfClassesRef[labelProd];
-          m_MatrixLOG(indexLabelRef, indexLabelProdInRef) = m_Matrix[labelRef][labelProd];
-          }
-
-        ///////////////////////////////////////////////////////////
-        // Writing the ordered confusion matrix in the output file
-        outFile << m_Matrix[labelRef][labelProd];
+        std::map<ClassLabelType, ConfusionMatrixEltType>::const_iterator itCount =
+          itMatrix->second.find(itMapOfClassesProd->first);
+        outFile << (itCount != itMatrix->second.end() ? itCount->second : 0);
         if (indexLabelProd < (nbClassesProd - 1))
           {
           outFile << separatorChar;
@@ -581,18 +518,16 @@ private:
           {
           outFile << std::endl;
           }
-        ///////////////////////////////////////////////////////////
         ++indexLabelProd;
         }
-
-      m_Matrix[labelRef].clear();
-      ++indexLabelRef;
       }
+    ///////////////////////////////////////////////////////////
 
-    // m_Matrix is cleared in order to remove old results in case of successive runs of the GUI application
-    m_Matrix.clear();
     outFile.close();
 
+    // Square confusion matrix over the reference labels, for the application LOG and for measurements
+    m_MatrixLOG = confusionMatrixFilter->GetConfusionMatrix();
+
     otbAppLogINFO("Reference class labels ordered according to the rows of the output confusion matrix: " << ossHeaderRefLabels.str());
     otbAppLogINFO("Produced class labels ordered according to the columns of the output confusion matrix: " << ossHeaderProdLabels.str());
     //otbAppLogINFO("Output confusion matrix (rows = reference labels, columns = produced labels):\n" << m_MatrixLOG);
@@ -601,16 +536,12 @@ private:
 
 
     // Measurements of the Confusion Matrix parameters
-    ConfusionMatrixMeasurementsType::Pointer confMatMeasurements = ConfusionMatrixMeasurementsType::New();
-
-    confMatMeasurements->SetMapOfClasses(mapOfClassesRef);
-    confMatMeasurements->SetConfusionMatrix(m_MatrixLOG);
-    confMatMeasurements->Compute();
+    const ConfusionMatrixMeasurementsType * confMatMeasurements = confusionMatrixFilter->GetMeasurements();
 
     for (itMapOfClassesRef = mapOfClassesRef.begin(); itMapOfClassesRef != itMapOfClassesRefEnd; ++itMapOfClassesRef)
       {
       labelRef = itMapOfClassesRef->first;
-      indexLabelRef = itMapOfClassesRef->second;
+      int indexLabelRef = itMapOfClassesRef->second;
 
       otbAppLogINFO("Precision of class [" << labelRef << "] vs all: " << confMatMeasurements->GetPrecisions()[indexLabelRef]);
       otbAppLogINFO("Recall of class [" << labelRef << "] vs all: " << confMatMeasurements->GetRecalls()[indexLabelRef]);
@@ -627,7 +558,6 @@ private:
   }// END Execute()
 
   ConfusionMatrixType m_MatrixLOG;
-  OutputConfusionMatrixType m_Matrix;
   Int32ImageType* m_Input;
   Int32ImageType::Pointer m_Reference;
   RAMDrivenAdaptativeStreamingManagerType::Pointer m_StreamingManager;
@@ -30,6 +30,13 @@
 #include "otbImageToVectorImageCastFilter.h"
 #include "otbMachineLearningModelFactory.h"
 
+#ifdef OTB_USE_OPENCV
+#include "otbRandomForestsMachineLearningModel.h"
+#endif
+#ifdef OTB_USE_SHARK
+#include "otbSharkRandomForestsMachineLearningModel.h"
+#endif
+
 namespace otb
 {
 namespace Wrapper
@@ -111,6 +118,19 @@ private:
     SetDefaultParameterInt("nodatalabel", 0);
     MandatoryOff("nodatalabel");
 
+    AddParameter(ParameterType_Empty, "quantized", "Quantized inference");
+    SetParameterDescription("quantized", "Predict from int16 quantized features and weights, "
+      "for the models supporting it (LibSVM with a linear or RBF kernel, NeuralNetwork). "
+      "The agreement with the floating point inference can be checked with the valid.quantized "
+      "option of TrainVectorClassifier.");
+    MandatoryOff("quantized");
+
+    AddParameter(ParameterType_Empty, "flatforest", "Flat forest inference");
+    SetParameterDescription("flatforest", "Predict random forest models (OpenCV and Shark) from a flat "
+      "copy of the trees, evaluating blocks of pixels one tree at a time. The predicted labels "
+      "are the same as with the standard inference.");
+    MandatoryOff("flatforest");
+
     AddParameter(ParameterType_OutputImage, "out",  "Output Image");
     SetParameterDescription( "out", "Output image containing class labels");
     SetDefaultOutputPixelType( "out", ImagePixelType_uint8);
@@ -165,6 +185,42 @@ private:
     m_Model->Load(GetParameterString("model"));
     otbAppLogINFO("Model loaded");
 
+    if (IsParameterEnabled("quantized"))
+      {
+      if (!m_Model->HasQuantizedInference())
+        {
+        otbAppLogFATAL(<< "Quantized inference is not supported by this model");
+        }
+      m_Model->SetQuantizedInference(true);
+      otbAppLogINFO("Quantized inference activated.");
+      }
+
+    if (IsParameterEnabled("flatforest"))
+      {
+      bool isRandomForest = false;
+#ifdef OTB_USE_OPENCV
+      typedef otb::RandomForestsMachineLearningModel<ValueType, LabelType> RandomForestType;
+      if (RandomForestType* randomForest = dynamic_cast<RandomForestType*>(m_Model.GetPointer()))
+        {
+        randomForest->SetFlatForestInference(true);
+        isRandomForest = true;
+        }
+#endif
+#ifdef OTB_USE_SHARK
+      typedef otb::SharkRandomForestsMachineLearningModel<ValueType, LabelType> SharkRandomForestType;
+      if (SharkRandomForestType* sharkRandomForest = dynamic_cast<SharkRandomForestType*>(m_Model.GetPointer()))
+        {
+        sharkRandomForest->SetFlatForestInference(true);
+        isRandomForest = true;
+        }
+#endif
+      if (!isRandomForest)
+        {
+        otbAppLogFATAL(<< "Flat forest inference is only supported by random forest models");
+        }
+      otbAppLogINFO("Flat forest inference activated.");
+      }
+
     // Normalize input image (optional)
     StatisticsReader::Pointer  statisticsReader = StatisticsReader::New();
     MeasurementType  meanMeasurementVector;
@@ -220,6 +276,11 @@ private:
         {
         SetParameterOutputImage<ConfidenceImageType>("confmap",m_ClassificationFilter->GetOutputConfidence());
         }
+      else if (IsParameterEnabled("quantized"))
+        {
+        otbAppLogWARNING("Confidence map requested but the quantized inference of this classifier doesn't support it!");
+        this->DisableParameter("confmap");
+        }
       else
         {
         otbAppLogWARNING("Confidence map requested but the classifier doesn't support it!");
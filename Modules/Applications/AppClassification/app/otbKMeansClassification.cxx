@@ -22,6 +22,13 @@
 #include "otbWrapperApplicationFactory.h"
 
 #include "otbOGRDataToSamplePositionFilter.h"
+#include "otbStreamingMiniBatchKMeansImageFilter.h"
+#include "otbStatisticsXMLFileReader.h"
+#include "otbShiftScaleVectorImageFilter.h"
+
+#ifdef OTB_USE_SHARK
+#include "otbSharkKMeansMachineLearningModel.h"
+#endif
 
 namespace otb
 {
@@ -40,6 +47,11 @@ public:
   /** Standard macro */
   itkTypeMacro( KMeansApplicationBase, Superclass )
 
+  typedef itk::VariableLengthVector<FloatVectorImageType::InternalPixelType>      MeasurementType;
+  typedef otb::StatisticsXMLFileReader<MeasurementType>                           StatisticsReader;
+  typedef otb::ShiftScaleVectorImageFilter<FloatVectorImageType, FloatVectorImageType> RescalerType;
+  typedef otb::StreamingMiniBatchKMeansImageFilter<FloatVectorImageType, UInt8ImageType> MiniBatchKMeansType;
+
 protected:
   void InitKMParams()
   {
@@ -82,6 +94,14 @@ protected:
     SetDefaultParameterInt("maxit", 1000);
     MandatoryOff("maxit");
 
+    AddParameter(ParameterType_Int, "passes", "Number of passes over the whole image");
+    SetParameterDescription("passes", "After training on the sampled pixels, refine the centroids "
+      "with mini-batches of all the valid pixels of the image, streamed this number of times. "
+      "Memory use does not depend on the image size. 0 disables the refinement.");
+    SetDefaultParameterInt("passes", 0);
+    SetMinimumParameterIntValue("passes", 0);
+    MandatoryOff("passes");
+
     AddParameter(ParameterType_OutputFilename, "outmeans", "Centroid filename");
     SetParameterDescription("outmeans", "Output text file containing centroid positions");
     MandatoryOff("outmeans");
@@ -260,6 +280,71 @@ protected:
     otbAppLogINFO("output model : " << GetInternalApplication("training")->GetParameterString("io.out"));
   }
 
+  void RefineKMModel(FloatVectorImageType *image,
+                     const std::string &imagesStatsFileName,
+                     const std::string &modelFileName)
+  {
+#ifdef OTB_USE_SHARK
+    typedef otb::SharkKMeansMachineLearningModel<FloatVectorImageType::InternalPixelType, int> KMeansModelType;
+
+    KMeansModelType::Pointer model = KMeansModelType::New();
+    model->Load(modelFileName);
+    KMeansModelType::InputListSampleType::Pointer centroidList = KMeansModelType::InputListSampleType::New();
+    model->GetCentroids(centroidList);
+
+    MiniBatchKMeansType::CentroidsType initialCentroids;
+    for (unsigned int k = 0; k < centroidList->Size(); ++k)
+      {
+      const KMeansModelType::InputSampleType& centroid = centroidList->GetMeasurementVector(k);
+      MiniBatchKMeansType::RealPixelType c(centroid.Size());
+      for (unsigned int j = 0; j < centroid.Size(); ++j)
+        {
+        c[j] = centroid[j];
+        }
+      initialCentroids.push_back(c);
+      }
+
+    // The model was trained on centered and reduced samples
+    StatisticsReader::Pointer statisticsReader = StatisticsReader::New();
+    statisticsReader->SetFileName(imagesStatsFileName);
+    RescalerType::Pointer rescaler = RescalerType::New();
+    rescaler->SetShift(statisticsReader->GetStatisticVectorByName("mean"));
+    rescaler->SetScale(statisticsReader->GetStatisticVectorByName("stddev"));
+    rescaler->SetInput(image);
+
+    MiniBatchKMeansType::Pointer kmeansFilter = MiniBatchKMeansType::New();
+    kmeansFilter->SetInput(rescaler->GetOutput());
+    if (IsParameterEnabled("vm") && HasValue("vm"))
+      {
+      kmeansFilter->SetMask(GetParameterImage<UInt8ImageType>("vm"));
+      }
+    kmeansFilter->SetInitialCentroids(initialCentroids);
+    kmeansFilter->SetNumberOfPasses(GetParameterInt("passes"));
+    kmeansFilter->GetStreamer()->SetAutomaticAdaptativeStreaming(GetParameterInt("ram"));
+    AddProcess(kmeansFilter->GetStreamer(), "Refine the centroids over the whole image...");
+    kmeansFilter->Update();
+
+    const MiniBatchKMeansType::CentroidsType& centroids = kmeansFilter->GetCentroids();
+    for (unsigned int k = 0; k < centroids.size(); ++k)
+      {
+      KMeansModelType::InputSampleType centroid(centroids[k].Size());
+      for (unsigned int j = 0; j < centroids[k].Size(); ++j)
+        {
+        centroid[j] = static_cast<KMeansModelType::InputValueType>(centroids[k][j]);
+        }
+      centroidList->SetMeasurementVector(k, centroid);
+      }
+    model->SetCentroids(centroidList);
+    model->Save(modelFileName);
+    otbAppLogINFO("centroids refined over the whole image in " << GetParameterInt("passes") << " pass(es)");
+#else
+    (void)image;
+    (void)imagesStatsFileName;
+    (void)modelFileName;
+    otbAppLogFATAL("Module SharkLearning is not installed. You should consider turning OTB_USE_SHARK on during cmake configuration.");
+#endif
+  }
+
   void ComputeImageStatistics(const std::string &imageFileName,
                                                const std::string &imagesStatsFileName)
   {
@@ -412,7 +497,8 @@ private:
             "(1000000 samples max),\n"
         "4) SamplesExtraction : extract the samples descriptors (update of SampleSelection output file),\n"
         "5) ComputeImagesStatistics : compute images second order statistics,\n"
-        "6) TrainVectorClassifier : train the SharkKMeans model,\n"
+        "6) TrainVectorClassifier : train the SharkKMeans model, "
+            "optionally refined with mini-batches of all the image pixels (passes parameter),\n"
         "7) ImageClassifier : performs the classification of the input image "
             "according to a model file.\n\n"
         "It's possible to choice random/periodic modes of the SampleSelection application.\n"
@@ -488,6 +574,13 @@ private:
     Superclass::TrainKMModel(GetParameterImage("in"), fileNames.sampleOutput,
                              fileNames.modelFile);
 
+    // Refine the centroids with all the pixels of the image
+    if (GetParameterInt("passes") > 0)
+      {
+      Superclass::RefineKMModel(GetParameterImage("in"), fileNames.imgStatOutput,
+                                fileNames.modelFile);
+      }
+
     // Compute a classification of the input image according to a model file
     Superclass::KMeansClassif();
 
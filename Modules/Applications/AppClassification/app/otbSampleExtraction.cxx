@@ -80,6 +80,13 @@ private:
       "values (OGR format). If not given, the input vector data file is updated");
     MandatoryOff("out");
 
+    AddParameter(ParameterType_OutputFilename, "outbin", "Output binary sample file");
+    SetParameterDescription("outbin","Columnar binary file storing the numeric fields of the "
+      "samples (sample values and integer fields such as the class label), instead of an OGR "
+      "file. It is faster to write and can be given to TrainVectorClassifier in place of a "
+      "vector file. When it is set, out is ignored and the input vector data file is not updated.");
+    MandatoryOff("outbin");
+
     AddParameter(ParameterType_Choice, "outfield", "Output field names");
     SetParameterDescription("outfield", "Choice between naming method for output fields");
 
@@ -106,6 +113,18 @@ private:
     MandatoryOff("layer");
     SetDefaultParameterInt("layer",0);
 
+    AddParameter(ParameterType_Int, "ogrtransaction", "OGR transaction size");
+    SetParameterDescription("ogrtransaction", "Number of output features written within one OGR "
+      "transaction. Larger transactions write faster to file formats like SQLite or GPKG. "
+      "0 gives one transaction per processing thread.");
+    SetDefaultParameterInt("ogrtransaction", 100000);
+    SetMinimumParameterIntValue("ogrtransaction", 0);
+    MandatoryOff("ogrtransaction");
+
+    AddParameter(ParameterType_Empty, "sparse", "Sparse sampling");
+    SetParameterDescription("sparse", "Only read the blocks of the input image that contain sample positions, instead of streaming over the whole image. This is faster when the samples are sparse.");
+    MandatoryOff("sparse");
+
     AddRAMParameter();
 
     // Doc example parameter settings
@@ -153,7 +172,14 @@ private:
     {
     ogr::DataSource::Pointer vectors;
     ogr::DataSource::Pointer output;
-    if (IsParameterEnabled("out") && HasValue("out"))
+    const bool binaryOutput = IsParameterEnabled("outbin") && HasValue("outbin");
+    if (binaryOutput)
+      {
+      // The samples only go through an in-memory layer
+      vectors = ogr::DataSource::New(this->GetParameterString("vec"));
+      output = ogr::DataSource::New();
+      }
+    else if (IsParameterEnabled("out") && HasValue("out"))
       {
       vectors = ogr::DataSource::New(this->GetParameterString("vec"));
       output = ogr::DataSource::New(this->GetParameterString("out"),
@@ -200,14 +226,24 @@ private:
     filter->SetSamplePositions(vectors);
     filter->SetOutputSamples(output);
     filter->SetClassFieldName(fieldName);
+    filter->SetOGRTransactionSize(GetParameterInt("ogrtransaction"));
+    if (binaryOutput)
+      {
+      filter->SetSampleFileName(GetParameterString("outbin"));
+      }
     filter->SetOutputFieldPrefix(namePrefix);
     filter->SetOutputFieldNames(nameList);
     filter->GetStreamer()->SetAutomaticAdaptativeStreaming(GetParameterInt("ram"));
+    filter->SetSparseSampling(IsParameterEnabled("sparse"));
+    filter->SetAvailableRAMInMB(GetParameterInt("ram"));
 
     
     AddProcess(filter->GetStreamer(),"Extracting sample values...");
     filter->Update();
-    output->SyncToDisk();
+    if (!binaryOutput)
+      {
+      output->SyncToDisk();
+      }
     }
 
 };
@@ -211,6 +211,14 @@ private:
     MandatoryOff("layer");
     SetDefaultParameterInt("layer",0);
 
+    AddParameter(ParameterType_Int, "ogrtransaction", "OGR transaction size");
+    SetParameterDescription("ogrtransaction", "Number of output features written within one OGR "
+      "transaction. Larger transactions write faster to file formats like SQLite or GPKG. "
+      "0 gives one transaction per processing thread.");
+    SetDefaultParameterInt("ogrtransaction", 100000);
+    SetMinimumParameterIntValue("ogrtransaction", 0);
+    MandatoryOff("ogrtransaction");
+
     ElevationParametersHandler::AddElevationParameters(this, "elev");
 
     AddRAMParameter();
@@ -419,6 +427,7 @@ private:
         periodicFilt->SetOutputPositionContainerAndRates(outputSamples, rates);
         periodicFilt->SetFieldName(fieldName);
         periodicFilt->SetLayerIndex(this->GetParameterInt("layer"));
+        periodicFilt->SetOGRTransactionSize(this->GetParameterInt("ogrtransaction"));
         periodicFilt->SetSamplerParameters(param);
         if (IsParameterEnabled("mask") && HasValue("mask"))
           {
@@ -438,6 +447,7 @@ private:
         randomFilt->SetOutputPositionContainerAndRates(outputSamples, rates);
         randomFilt->SetFieldName(fieldName);
         randomFilt->SetLayerIndex(this->GetParameterInt("layer"));
+        randomFilt->SetOGRTransactionSize(this->GetParameterInt("ogrtransaction"));
         if (IsParameterEnabled("mask") && HasValue("mask"))
           {
           randomFilt->SetMask(this->GetParameterImage<UInt8ImageType>("mask"));
@@ -134,6 +134,12 @@ protected:
     typename ListSampleType::Pointer validationListSample,
     std::string modelPath);
 
+  /** Load a model file and log the agreement between its quantized and
+   *  floating point inference on a sample list */
+  void CheckQuantizedInference(
+    typename ListSampleType::Pointer validationListSample,
+    std::string modelPath);
+
   /** Init method that creates all the parameters for machine learning models */
   void DoInit() ITK_OVERRIDE;
 
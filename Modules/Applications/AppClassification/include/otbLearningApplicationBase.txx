@@ -162,6 +162,42 @@ LearningApplicationBase<TInputValue,TOutputValue>
   return predictedList;
 }
 
+template <class TInputValue, class TOutputValue>
+void
+LearningApplicationBase<TInputValue,TOutputValue>
+::CheckQuantizedInference(typename ListSampleType::Pointer validationListSample,
+                          std::string modelPath)
+{
+  ModelPointerType model = ModelFactoryType::CreateMachineLearningModel(modelPath,
+                                                                        ModelFactoryType::ReadMode);
+
+  if (model.IsNull())
+    {
+    otbAppLogFATAL(<< "Error when loading model " << modelPath);
+    }
+
+  if (!model->HasQuantizedInference())
+    {
+    otbAppLogWARNING("Quantized inference is not supported by this model.");
+    return;
+    }
+
+  model->Load(modelPath);
+  model->SetRegressionMode(this->m_RegressionFlag);
+
+  if (this->m_RegressionFlag)
+    {
+    const double error = model->ComputeQuantizationError(validationListSample);
+    otbAppLogINFO("RMS difference between the quantized and the floating point inference: "
+                  << error);
+    return;
+    }
+
+  const double agreement = model->ComputeQuantizationAgreement(validationListSample);
+  otbAppLogINFO("Agreement between the quantized and the floating point inference: "
+                << agreement * 100. << "%");
+}
+
 template <class TInputValue, class TOutputValue>
 void
 LearningApplicationBase<TInputValue,TOutputValue>
@@ -108,6 +108,12 @@ namespace Wrapper
     AddParameter(ParameterType_Empty, "classifier.libsvm.opt", "Parameters optimization");
     MandatoryOff("classifier.libsvm.opt");
     SetParameterDescription("classifier.libsvm.opt", "SVM parameters optimization flag.");
+    AddParameter(ParameterType_Empty, "classifier.libsvm.parallelcv", "Parallel cross validation");
+    MandatoryOff("classifier.libsvm.parallelcv");
+    SetParameterDescription("classifier.libsvm.parallelcv",
+        "Run the cross validation folds and the optimization grid points "
+        "concurrently. The folds are stratified and fixed, and grid points "
+        "that can no longer reach the best accuracy are dropped early.");
     AddParameter(ParameterType_Empty, "classifier.libsvm.prob", "Probability estimation");
     MandatoryOff("classifier.libsvm.prob");
     SetParameterDescription("classifier.libsvm.prob", "Probability estimation flag.");
@@ -141,6 +147,10 @@ namespace Wrapper
       {
       libSVMClassifier->SetParameterOptimization(true);
       }
+    if (IsParameterEnabled("classifier.libsvm.parallelcv"))
+      {
+      libSVMClassifier->SetParallelCrossValidation(true);
+      }
     if (IsParameterEnabled("classifier.libsvm.prob"))
       {
       libSVMClassifier->SetDoProbabilityEstimates(true);
@@ -32,7 +32,8 @@
 #include "otbStatisticsXMLFileReader.h"
 
 #include "itkListSample.h"
-#include "otbShiftScaleSampleListFilter.h"
+#include "otbContiguousListSample.h"
+#include "otbSampleFileReader.h"
 
 #include <algorithm>
 #include <locale>
@@ -69,7 +70,7 @@ public:
 
   typedef otb::StatisticsXMLFileReader<SampleType> StatisticsReader;
 
-  typedef otb::Statistics::ShiftScaleSampleListFilter<ListSampleType, ListSampleType> ShiftScaleFilterType;
+  typedef otb::ContiguousListSample<SampleType> ContiguousListSampleType;
 
 protected:
 
@@ -167,6 +168,14 @@ protected:
   SamplesWithLabel
   ExtractSamplesWithLabel(std::string parameterName, std::string parameterLayer, const ShiftScaleParameters &measurement);
 
+  /** Append the samples of a binary sample file (see SampleFileReader),
+   *  centered and reduced, to values and their labels to target */
+  void ReadSampleFile(const std::string &fileName,
+                      const std::vector<InputValueType> &shifts,
+                      const std::vector<InputValueType> &invertedScales,
+                      ContiguousListSampleType::BufferType &values,
+                      TargetListSampleType *target);
+
 
   /**
    * Retrieve statistics mean and standard deviation if input statistics are provided.
@@ -36,7 +36,8 @@ void TrainVectorBase::DoInit()
 
   AddParameter( ParameterType_InputVectorDataList, "io.vd", "Input Vector Data" );
   SetParameterDescription( "io.vd",
-    "Input geometries used for training (note : all geometries from the layer will be used)" );
+    "Input geometries used for training (note : all geometries from the layer will be used). "
+    "Binary sample files written by the outbin option of SampleExtraction are also accepted." );
 
   AddParameter( ParameterType_InputFilename, "io.stats", "Input XML image statistics file" );
   MandatoryOff( "io.stats" );
@@ -74,6 +75,15 @@ void TrainVectorBase::DoInit()
   MandatoryOff( "valid.layer" );
   SetDefaultParameterInt( "valid.layer", 0 );
 
+  AddParameter( ParameterType_Empty, "valid.quantized",
+    "Check the quantized inference" );
+  SetParameterDescription( "valid.quantized",
+    "Report the agreement between the quantized and the floating point "
+    "inference of the trained model on the validation samples, or their "
+    "RMS difference in regression mode "
+    "(only for the models supporting quantized inference)." );
+  MandatoryOff( "valid.quantized" );
+
   // Add class field if we used validation
   AddParameter( ParameterType_ListView, "cfield",
     "Field containing the class integer label for supervision" );
@@ -116,6 +126,24 @@ void TrainVectorBase::DoUpdateParameters()
   if( HasValue( "io.vd" ) )
     {
     std::vector<std::string> vectorFileList = GetParameterStringList( "io.vd" );
+    if( SampleFileReader::CanReadFile( vectorFileList[0] ) )
+      {
+      // All the fields of a sample file are numeric
+      SampleFileReader reader;
+      reader.Open( vectorFileList[0] );
+      ClearChoices( "feat" );
+      ClearChoices( "cfield" );
+      for( unsigned int iField = 0; iField < reader.GetFieldNames().size(); iField++ )
+        {
+        std::string key, item = reader.GetFieldNames()[iField];
+        key = item;
+        std::string::iterator end = std::remove_if( key.begin(), key.end(), IsNotAlphaNum );
+        std::transform( key.begin(), end, key.begin(), tolower );
+        AddChoice( "feat." + key.substr( 0, static_cast<unsigned long>( end - key.begin() ) ), item );
+        AddChoice( "cfield." + key.substr( 0, static_cast<unsigned long>( end - key.begin() ) ), item );
+        }
+      return;
+      }
     ogr::DataSource::Pointer ogrDS = ogr::DataSource::New( vectorFileList[0], ogr::DataSource::Modes::Read );
     ogr::Layer layer = ogrDS->GetLayer( static_cast<size_t>( this->GetParameterInt( "layer" ) ) );
     ogr::Feature feature = layer.ogr().GetNextFeature();
@@ -163,6 +191,11 @@ void TrainVectorBase::DoExecute()
 
   m_PredictedList =
     this->Classify( m_ClassificationSamplesWithLabel.listSample, GetParameterString( "io.out" ) );
+
+  if( IsParameterEnabled( "valid.quantized" ) )
+    {
+    this->CheckQuantizedInference( m_ClassificationSamplesWithLabel.listSample, GetParameterString( "io.out" ) );
+    }
 }
 
 
@@ -238,13 +271,38 @@ TrainVectorBase::ExtractSamplesWithLabel(std::string parameterName, std::string
   SamplesWithLabel samplesWithLabel;
   if( HasValue( parameterName ) && IsParameterEnabled( parameterName ) )
     {
-    ListSampleType::Pointer input = ListSampleType::New();
+    const unsigned int nbFeatures = m_FeaturesInfo.m_NbFeatures;
     TargetListSampleType::Pointer target = TargetListSampleType::New();
-    input->SetMeasurementVectorSize( m_FeaturesInfo.m_NbFeatures );
+
+    if( measurement.meanMeasurementVector.Size() != nbFeatures
+        || measurement.stddevMeasurementVector.Size() != nbFeatures )
+      {
+      otbAppLogFATAL( "Inconsistent measurement vector size : " << nbFeatures << " features, "
+                      << measurement.meanMeasurementVector.Size() << " means and "
+                      << measurement.stddevMeasurementVector.Size() << " standard deviations" );
+      }
+
+    // Samples are centered and reduced while they are read, as
+    // ShiftScaleSampleListFilter would do, and stored in a single buffer
+    std::vector<InputValueType> shifts( nbFeatures );
+    std::vector<InputValueType> invertedScales( nbFeatures );
+    for( unsigned int idx = 0; idx < nbFeatures; ++idx )
+      {
+      const InputValueType scale = measurement.stddevMeasurementVector[idx];
+      shifts[idx] = measurement.meanMeasurementVector[idx];
+      invertedScales[idx] = ( scale - 1e-10 < 0. ) ? 0 : 1 / scale;
+      }
+    ContiguousListSampleType::BufferType values;
 
     std::vector<std::string> fileList = this->GetParameterStringList( parameterName );
     for( unsigned int k = 0; k < fileList.size(); k++ )
       {
+      if( SampleFileReader::CanReadFile( fileList[k] ) )
+        {
+        otbAppLogINFO( "Reading sample file " << k + 1 << "/" << fileList.size() );
+        ReadSampleFile( fileList[k], shifts, invertedScales, values, target );
+        continue;
+        }
       otbAppLogINFO( "Reading vector file " << k + 1 << "/" << fileList.size() );
       ogr::DataSource::Pointer source = ogr::DataSource::New( fileList[k], ogr::DataSource::Modes::Read );
       ogr::Layer layer = source->GetLayer( static_cast<size_t>(this->GetParameterInt( parameterLayer )) );
@@ -268,8 +326,8 @@ TrainVectorBase::ExtractSamplesWithLabel(std::string parameterName, std::string
         }
 
       //   - check feature fields
-      std::vector<int> featureFieldIndex( m_FeaturesInfo.m_NbFeatures, -1 );
-      for( unsigned int i = 0; i < m_FeaturesInfo.m_NbFeatures; i++ )
+      std::vector<int> featureFieldIndex( nbFeatures, -1 );
+      for( unsigned int i = 0; i < nbFeatures; i++ )
         {
         featureFieldIndex[i] = feature.ogr().GetFieldIndex( m_FeaturesInfo.m_SelectedNames[i].c_str() );
         if( featureFieldIndex[i] < 0 )
@@ -278,16 +336,21 @@ TrainVectorBase::ExtractSamplesWithLabel(std::string parameterName, std::string
                                                         << fileList[k] );
         }
 
+      // Reserve the buffer when the driver knows the feature count
+      const int featureCount = layer.GetFeatureCount( false );
+      if( featureCount > 0 )
+        {
+        values.reserve( values.size() + static_cast<size_t>(featureCount) * nbFeatures );
+        }
 
       while( goesOn )
         {
         // Retrieve all the features for each field in the ogr layer.
-        MeasurementType mv;
-        mv.SetSize( m_FeaturesInfo.m_NbFeatures );
-        for( unsigned int idx = 0; idx < m_FeaturesInfo.m_NbFeatures; ++idx )
-          mv[idx] = feature.ogr().GetFieldAsDouble( featureFieldIndex[idx] );
-
-        input->PushBack( mv );
+        for( unsigned int idx = 0; idx < nbFeatures; ++idx )
+          {
+          const InputValueType value = static_cast<InputValueType>(feature.ogr().GetFieldAsDouble( featureFieldIndex[idx] ));
+          values.push_back( static_cast<InputValueType>(( value - shifts[idx] ) * invertedScales[idx]) );
+          }
 
         if(cFieldIndex>=0 && ogr::Field(feature,cFieldIndex).HasBeenSet())
           target->PushBack( feature.ogr().GetFieldAsInteger( cFieldIndex ) );
@@ -299,22 +362,79 @@ TrainVectorBase::ExtractSamplesWithLabel(std::string parameterName, std::string
         }
       }
 
+    if( values.empty() )
+      {
+      otbAppLogFATAL( "Input Sample List is empty" );
+      }
 
+    ContiguousListSampleType::Pointer input = ContiguousListSampleType::New();
+    input->SetMeasurementVectorSize( nbFeatures );
+    input->SwapBuffer( values );
 
-    ShiftScaleFilterType::Pointer shiftScaleFilter = ShiftScaleFilterType::New();
-    shiftScaleFilter->SetInput( input );
-    shiftScaleFilter->SetShifts( measurement.meanMeasurementVector );
-    shiftScaleFilter->SetScales( measurement.stddevMeasurementVector );
-    shiftScaleFilter->Update();
-
-    samplesWithLabel.listSample = shiftScaleFilter->GetOutput();
+    samplesWithLabel.listSample = input;
     samplesWithLabel.labeledListSample = target;
-    samplesWithLabel.listSample->DisconnectPipeline();
     }
 
   return samplesWithLabel;
 }
 
+void TrainVectorBase::ReadSampleFile(const std::string &fileName,
+                                     const std::vector<InputValueType> &shifts,
+                                     const std::vector<InputValueType> &invertedScales,
+                                     ContiguousListSampleType::BufferType &values,
+                                     TargetListSampleType *target)
+{
+  const unsigned int nbFeatures = m_FeaturesInfo.m_NbFeatures;
+  SampleFileReader reader;
+  reader.Open( fileName );
+
+  // Only the columns of the selected fields are read
+  std::vector<unsigned int> fields( nbFeatures );
+  for( unsigned int i = 0; i < nbFeatures; i++ )
+    {
+    const int fieldIndex = reader.GetFieldIndex( m_FeaturesInfo.m_SelectedNames[i] );
+    if( fieldIndex < 0 )
+      {
+      otbAppLogFATAL( "The field name for feature " << m_FeaturesInfo.m_SelectedNames[i]
+                                                    << " has not been found in the sample file " << fileName );
+      }
+    fields[i] = static_cast<unsigned int>( fieldIndex );
+    }
+  const bool hasClassField = !m_FeaturesInfo.m_SelectedCFieldName.empty();
+  if( hasClassField )
+    {
+    const int cFieldIndex = reader.GetFieldIndex( m_FeaturesInfo.m_SelectedCFieldName );
+    if( cFieldIndex < 0 )
+      {
+      otbAppLogFATAL( "The field name for class label (" << m_FeaturesInfo.m_SelectedCFieldName
+                                                         << ") has not been found in the sample file " << fileName );
+      }
+    fields.push_back( static_cast<unsigned int>( cFieldIndex ) );
+    }
+
+  values.reserve( values.size() + static_cast<size_t>( reader.GetNumberOfSamples() ) * nbFeatures );
+  std::vector<double> blockValues;
+  for( unsigned int block = 0; block < reader.GetNumberOfBlocks(); ++block )
+    {
+    const unsigned long nbSamples = reader.GetBlockSize( block );
+    blockValues.resize( static_cast<size_t>( nbSamples ) * fields.size() );
+    if( blockValues.empty() )
+      {
+      continue;
+      }
+    reader.ReadBlock( block, fields, &blockValues[0] );
+    for( unsigned long i = 0; i < nbSamples; ++i )
+      {
+      const double* sample = &blockValues[static_cast<size_t>( i ) * fields.size()];
+      for( unsigned int idx = 0; idx < nbFeatures; ++idx )
+        {
+        const InputValueType value = static_cast<InputValueType>( sample[idx] );
+        values.push_back( static_cast<InputValueType>( ( value - shifts[idx] ) * invertedScales[idx] ) );
+        }
+      target->PushBack( hasClassField ? static_cast<int>( sample[nbFeatures] ) : 0 );
+      }
+    }
+}
 
 }
 }
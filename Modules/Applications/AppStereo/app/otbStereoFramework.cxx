@@ -24,6 +24,7 @@
 #include "otbStreamingWarpImageFilter.h"
 #include "otbBandMathImageFilter.h"
 #include "otbSubPixelDisparityImageFilter.h"
+#include "otbSemiGlobalMatchingImageFilter.h"
 #include "otbDisparityMapMedianFilter.h"
 #include "otbDisparityMapToDEMFilter.h"
 #include "otbDisparityMapTo3DFilter.h"
@@ -454,12 +455,50 @@ private:
     SetDefaultParameterFloat("bm.metric.lp.p", 1.0);
     SetMinimumParameterFloatValue("bm.metric.lp.p", 0.0);
 
+    AddParameter(ParameterType_Choice, "bm.method", "Disparity estimation method");
+    SetParameterDescription("bm.method","Method used to select the disparity of each pixel from the block-matching metric");
+
+    AddChoice("bm.method.local","Local block-matching");
+    SetParameterDescription("bm.method.local","The disparity of best metric is selected independently for each pixel");
+
+    AddChoice("bm.method.sgm","Semi-Global Matching");
+    SetParameterDescription("bm.method.sgm","The metric is used as a matching cost, which is aggregated along several paths crossing the image before selecting the disparity (see SemiGlobalMatchingImageFilter). This favors smooth disparity maps, at the expense of memory and computation time.");
+
+    AddParameter(ParameterType_Float,"bm.method.sgm.p1","Small disparity change penalty");
+    SetParameterDescription("bm.method.sgm.p1","Penalty of disparity changes of one pixel between neighbors, relative to the mean range of the matching costs, estimated at the center of the left image");
+    SetDefaultParameterFloat("bm.method.sgm.p1",0.1);
+    SetMinimumParameterFloatValue("bm.method.sgm.p1",0.);
+
+    AddParameter(ParameterType_Float,"bm.method.sgm.p2","Large disparity change penalty");
+    SetParameterDescription("bm.method.sgm.p2","Penalty of disparity changes of more than one pixel between neighbors, relative to the mean range of the matching costs, estimated at the center of the left image (should be greater than p1)");
+    SetDefaultParameterFloat("bm.method.sgm.p2",0.5);
+    SetMinimumParameterFloatValue("bm.method.sgm.p2",0.);
+
+    AddParameter(ParameterType_Empty,"bm.method.sgm.rawpenalties","Penalties in metric units");
+    SetParameterDescription("bm.method.sgm.rawpenalties","Give p1 and p2 in the unit of the block-matching metric instead of relative to the range of the matching costs (disabled by default)");
+    MandatoryOff("bm.method.sgm.rawpenalties");
+    DisableParameter("bm.method.sgm.rawpenalties");
+
+    AddParameter(ParameterType_Int,"bm.method.sgm.paths","Number of aggregation paths");
+    SetParameterDescription("bm.method.sgm.paths","Number of directions along which the costs are aggregated (4 or 8)");
+    SetDefaultParameterInt("bm.method.sgm.paths",8);
+    SetMinimumParameterIntValue("bm.method.sgm.paths",4);
+    SetMaximumParameterIntValue("bm.method.sgm.paths",8);
+
     AddParameter(ParameterType_Int,"bm.radius","Radius of blocks for matching filter (in pixels)");
     SetParameterDescription("bm.radius","The radius of blocks in Block-Matching (in pixels)");
     SetDefaultParameterInt("bm.radius",2);
     SetMinimumParameterIntValue("bm.radius",1);
     MandatoryOff("bm.radius");
 
+    AddParameter(ParameterType_Empty,"bm.boxfilter","Compute the metric with box sums");
+    SetParameterDescription("bm.boxfilter","The block-matching metric is computed with running box sums, "
+      "whose cost does not depend on the radius (enabled by default). The metric values are the same up to "
+      "floating point rounding, so that nearly equal optima may give a different disparity than the direct "
+      "computation: disable this option to reproduce the results of previous versions.");
+    MandatoryOff("bm.boxfilter");
+    EnableParameter("bm.boxfilter");
+
     AddParameter(ParameterType_Float,"bm.minhoffset","Minimum altitude offset (in meters)");
     SetParameterDescription("bm.minhoffset","Minimum altitude below the selected elevation source (in meters)");
     //MandatoryOff("bm.minhoffset");
@@ -537,6 +576,31 @@ private:
   }
 
 
+  template<class TInputImage, class TMetricFunctor>
+    typename otb::PixelWiseBlockMatchingImageFilter<TInputImage,TInputImage,TInputImage,TInputImage,TMetricFunctor>::Pointer
+    CreateBlockMatchingFilter()
+    {
+    typedef otb::PixelWiseBlockMatchingImageFilter<TInputImage,TInputImage,TInputImage,TInputImage,
+                                                   TMetricFunctor> BlockMatchingFilterType;
+    typedef otb::SemiGlobalMatchingImageFilter<TInputImage,TInputImage,TInputImage,TInputImage,
+                                               TMetricFunctor> SemiGlobalMatchingFilterType;
+
+    if (GetParameterString("bm.method") == "sgm")
+      {
+      if (GetParameterInt("bm.method.sgm.paths") != 4 && GetParameterInt("bm.method.sgm.paths") != 8)
+        {
+        otbAppLogFATAL(<<"Number of aggregation paths must be 4 or 8.");
+        }
+      typename SemiGlobalMatchingFilterType::Pointer sgmFilter = SemiGlobalMatchingFilterType::New();
+      sgmFilter->SetP1(GetParameterFloat("bm.method.sgm.p1"));
+      sgmFilter->SetP2(GetParameterFloat("bm.method.sgm.p2"));
+      sgmFilter->SetNormalizePenalties(!IsParameterEnabled("bm.method.sgm.rawpenalties"));
+      sgmFilter->SetNumberOfPaths(GetParameterInt("bm.method.sgm.paths"));
+      return sgmFilter.GetPointer();
+      }
+    return BlockMatchingFilterType::New();
+    }
+
   template<class TInputImage, class TMetricFunctor>
     void
     SetBlockMatchingParameters(otb::PixelWiseBlockMatchingImageFilter<TInputImage,TInputImage,TInputImage,TInputImage,
@@ -557,6 +621,9 @@ private:
     blockMatcherFilter->SetMaximumHorizontalDisparity(maxDisp);
     blockMatcherFilter->SetMinimumVerticalDisparity(0);
     blockMatcherFilter->SetMaximumVerticalDisparity(0);
+    // The metric is computed with running box sums, whose cost does not
+    // depend on the radius
+    blockMatcherFilter->SetUseBoxFilter(IsParameterEnabled("bm.boxfilter"));
 
     if (minimize)
       {
@@ -575,6 +642,7 @@ private:
       invBlockMatcherFilter->SetMaximumHorizontalDisparity(-minDisp);
       invBlockMatcherFilter->SetMinimumVerticalDisparity(0);
       invBlockMatcherFilter->SetMaximumVerticalDisparity(0);
+      invBlockMatcherFilter->SetUseBoxFilter(IsParameterEnabled("bm.boxfilter"));
 
       if (minimize)
         {
@@ -928,14 +996,14 @@ private:
         case 0: //SSDDivMean
           otbAppLogINFO(<<"Using robust SSD Metric for BlockMatching.");
 
-          SSDDivMeanBlockMatcherFilter = SSDDivMeanBlockMatchingFilterType::New();
+          SSDDivMeanBlockMatcherFilter = this->CreateBlockMatchingFilter<FloatImageType, SSDDivMeanBlockMatchingFunctorType>();
           blockMatcherFilterPointer = SSDDivMeanBlockMatcherFilter.GetPointer();
           m_Filters.push_back(blockMatcherFilterPointer);
 
           if (IsParameterEnabled("postproc.bij"))
             {
             //Reverse correlation
-            invSSDDivMeanBlockMatcherFilter = SSDDivMeanBlockMatchingFilterType::New();
+            invSSDDivMeanBlockMatcherFilter = this->CreateBlockMatchingFilter<FloatImageType, SSDDivMeanBlockMatchingFunctorType>();
             invBlockMatcherFilterPointer = invSSDDivMeanBlockMatcherFilter.GetPointer();
             m_Filters.push_back(invBlockMatcherFilterPointer);
             }
@@ -961,14 +1029,14 @@ private:
           case 1: //SSD
           otbAppLogINFO(<<"Using SSD Metric for BlockMatching.");
 
-          SSDBlockMatcherFilter = SSDBlockMatchingFilterType::New();
+          SSDBlockMatcherFilter = this->CreateBlockMatchingFilter<FloatImageType, SSDBlockMatchingFunctorType>();
           blockMatcherFilterPointer = SSDBlockMatcherFilter.GetPointer();
           m_Filters.push_back(blockMatcherFilterPointer);
 
           if (IsParameterEnabled("postproc.bij"))
             {
             //Reverse correlation
-            invSSDBlockMatcherFilter = SSDBlockMatchingFilterType::New();
+            invSSDBlockMatcherFilter = this->CreateBlockMatchingFilter<FloatImageType, SSDBlockMatchingFunctorType>();
             invBlockMatcherFilterPointer = invSSDBlockMatcherFilter.GetPointer();
             m_Filters.push_back(invBlockMatcherFilterPointer);
             }
@@ -992,14 +1060,14 @@ private:
         case 2: //NCC
           otbAppLogINFO(<<"Using NCC Metric for BlockMatching.");
 
-          NCCBlockMatcherFilter = NCCBlockMatchingFilterType::New();
+          NCCBlockMatcherFilter = this->CreateBlockMatchingFilter<FloatImageType, NCCBlockMatchingFunctorType>();
           blockMatcherFilterPointer = NCCBlockMatcherFilter.GetPointer();
           m_Filters.push_back(blockMatcherFilterPointer);
 
           if (IsParameterEnabled("postproc.bij"))
             {
             //Reverse correlation
-            invNCCBlockMatcherFilter = NCCBlockMatchingFilterType::New();
+            invNCCBlockMatcherFilter = this->CreateBlockMatchingFilter<FloatImageType, NCCBlockMatchingFunctorType>();
             invBlockMatcherFilterPointer = invNCCBlockMatcherFilter.GetPointer();
             m_Filters.push_back(invBlockMatcherFilterPointer);
             }
@@ -1024,7 +1092,7 @@ private:
         case 3: //LP
           otbAppLogINFO(<<"Using Lp Metric for BlockMatching.");
 
-          LPBlockMatcherFilter = LPBlockMatchingFilterType::New();
+          LPBlockMatcherFilter = this->CreateBlockMatchingFilter<FloatImageType, LPBlockMatchingFunctorType>();
           LPBlockMatcherFilter->GetFunctor().SetP(static_cast<double> (GetParameterFloat("bm.metric.lp.p")));
 
           blockMatcherFilterPointer = LPBlockMatcherFilter.GetPointer();
@@ -1033,7 +1101,7 @@ private:
           if (IsParameterEnabled("postproc.bij"))
             {
             //Reverse correlation
-            invLPBlockMatcherFilter = LPBlockMatchingFilterType::New();
+            invLPBlockMatcherFilter = this->CreateBlockMatchingFilter<FloatImageType, LPBlockMatchingFunctorType>();
             invLPBlockMatcherFilter->GetFunctor().SetP(static_cast<double> (GetParameterFloat("bm.metric.lp.p")));
             invBlockMatcherFilterPointer = invLPBlockMatcherFilter.GetPointer();
             m_Filters.push_back(invBlockMatcherFilterPointer);
@@ -84,6 +84,28 @@ public:
    */
   static RAMValueType GetMaxRAMHint();
 
+  /**
+   * GDALDatasetCacheSize is the maximum number of read-only GDAL
+   * datasets kept open after their last use, so that opening the
+   * same file again is cheaper.
+   *
+   * If environment variable OTB_GDAL_DATASET_CACHE_SIZE is defined and
+   * could be converted to int, return its content.
+   * Else, returns default value, which is 0 (no cache)
+   */
+  static unsigned int GetGDALDatasetCacheSize();
+
+  /**
+   * MemoryPrintCheck enables the comparison of the memory print
+   * estimated for streaming with the peak resident memory actually
+   * measured while writing images.
+   *
+   * If environment variable OTB_MEMORY_PRINT_CHECK is set to 1, ON,
+   * TRUE or YES, returns true.
+   * Else, returns default value, which is false
+   */
+  static bool GetMemoryPrintCheck();
+
 private:
   ConfigurationManager(); //purposely not implemented
   ~ConfigurationManager(); //purposely not implemented
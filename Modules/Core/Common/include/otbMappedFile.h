@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbMappedFile_h
+#define otbMappedFile_h
+
+#include <string>
+
+#include "OTBCommonExport.h"
+
+namespace otb
+{
+
+/** \class MappedFile
+ * \brief Read-only memory mapping of a whole file.
+ *
+ * This helper maps a file in the address space of the process so that
+ * raw image readers can copy pixels directly from the page cache,
+ * without seek and read system calls nor intermediate buffers.
+ *
+ * Open() returns false when the file can not be mapped (empty file,
+ * file larger than the address space, unsupported platform...): the
+ * caller is then expected to fall back to regular stream reads.
+ *
+ * WillNeed() forwards an access hint to the system (madvise on POSIX
+ * systems), so that the pages of the next streaming region can be
+ * read ahead while the current one is processed.
+ *
+ * On POSIX systems, reading a page of the mapping beyond the end of a
+ * file truncated by another process raises SIGBUS instead of an error.
+ * Contains() checks the current size of the file before each access, so
+ * that readers throw an exception on a truncated file. The mapping is
+ * read-only, so writes by other processes show through it, and a file
+ * truncated between this check and the copy of the data can still kill
+ * the process: files written while being read should not be mapped.
+ *
+ * \ingroup OTBCommon
+ */
+class OTBCommon_EXPORT MappedFile
+{
+public:
+  typedef unsigned long long SizeType;
+
+  MappedFile();
+  ~MappedFile();
+
+  /** Map the whole file read-only. Returns false on failure. */
+  bool Open(const std::string& filename);
+
+  /** Unmap the file, if mapped. */
+  void Close();
+
+  /** Returns true if a file is currently mapped */
+  bool IsOpen() const
+  {
+    return m_Data != 0;
+  }
+
+  /** Get the first byte of the mapping */
+  const char * GetData() const
+  {
+    return m_Data;
+  }
+
+  /** Get the size of the mapping in bytes */
+  SizeType GetSize() const
+  {
+    return m_Size;
+  }
+
+  /** Returns true if [offset, offset + length) lies inside the mapping,
+   * and inside the file on disk (which may have been truncated since it
+   * was mapped) */
+  bool Contains(SizeType offset, SizeType length) const;
+
+  /** Hint the system that the given byte range will be read soon.
+   * The range is clamped to the mapping. */
+  void WillNeed(SizeType offset, SizeType length) const;
+
+private:
+  MappedFile(const MappedFile&); //purposely not implemented
+  void operator =(const MappedFile&); //purposely not implemented
+
+  char *   m_Data;
+  SizeType m_Size;
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  void *   m_FileHandle;
+  void *   m_MappingHandle;
+#else
+  int      m_FileDescriptor;
+#endif
+};
+
+} // namespace otb
+
+#endif
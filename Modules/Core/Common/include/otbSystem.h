@@ -61,6 +61,10 @@ public:
 
   /** Parse a filename with additional information */
   static bool ParseFileNameForAdditionalInfo(const std::string& id, std::string& file, unsigned int& addNum);
+
+  /** Get the current and peak resident set size of the process (in bytes).
+   * Returns false if they are not available on this platform. */
+  static bool GetResidentSetSize(unsigned long long& current, unsigned long long& peak);
 };
 
 } // namespace otb
@@ -61,4 +61,31 @@ ConfigurationManager::RAMValueType ConfigurationManager::GetMaxRAMHint()
   return value;
 
 }
+
+unsigned int ConfigurationManager::GetGDALDatasetCacheSize()
+{
+  std::string svalue;
+
+  unsigned int value = 0;
+
+  if(itksys::SystemTools::GetEnv("OTB_GDAL_DATASET_CACHE_SIZE",svalue))
+    {
+    value = static_cast<unsigned int>(strtoul(svalue.c_str(),ITK_NULLPTR,10));
+    }
+
+  return value;
+}
+
+bool ConfigurationManager::GetMemoryPrintCheck()
+{
+  std::string svalue;
+
+  if(itksys::SystemTools::GetEnv("OTB_MEMORY_PRINT_CHECK",svalue))
+    {
+    svalue = itksys::SystemTools::UpperCase(svalue);
+    return svalue == "1" || svalue == "ON" || svalue == "TRUE" || svalue == "YES";
+    }
+
+  return false;
+}
 }
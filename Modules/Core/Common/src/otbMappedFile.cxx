@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbMappedFile.h"
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+#include <windows.h>
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace otb
+{
+
+MappedFile::MappedFile()
+  : m_Data(0),
+    m_Size(0)
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  , m_FileHandle(0),
+    m_MappingHandle(0)
+#else
+  , m_FileDescriptor(-1)
+#endif
+{
+}
+
+MappedFile::~MappedFile()
+{
+  this->Close();
+}
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+
+bool
+MappedFile::Open(const std::string& filename)
+{
+  this->Close();
+
+  HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                            NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+    {
+    return false;
+    }
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0
+      || static_cast<unsigned long long>(size.QuadPart) > static_cast<unsigned long long>(static_cast<size_t>(-1)))
+    {
+    CloseHandle(file);
+    return false;
+    }
+
+  HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (mapping == NULL)
+    {
+    CloseHandle(file);
+    return false;
+    }
+
+  void * data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (data == NULL)
+    {
+    CloseHandle(mapping);
+    CloseHandle(file);
+    return false;
+    }
+
+  m_FileHandle = file;
+  m_MappingHandle = mapping;
+  m_Data = static_cast<char *>(data);
+  m_Size = static_cast<SizeType>(size.QuadPart);
+  return true;
+}
+
+void
+MappedFile::Close()
+{
+  if (m_Data != 0)
+    {
+    UnmapViewOfFile(m_Data);
+    }
+  if (m_MappingHandle != 0)
+    {
+    CloseHandle(static_cast<HANDLE>(m_MappingHandle));
+    }
+  if (m_FileHandle != 0)
+    {
+    CloseHandle(static_cast<HANDLE>(m_FileHandle));
+    }
+  m_Data = 0;
+  m_Size = 0;
+  m_FileHandle = 0;
+  m_MappingHandle = 0;
+}
+
+bool
+MappedFile::Contains(SizeType offset, SizeType length) const
+{
+  if (offset > m_Size || length > m_Size - offset)
+    {
+    return false;
+    }
+
+  // A mapped file can not be truncated on Windows, check it anyway
+  LARGE_INTEGER size;
+  return m_FileHandle != 0
+    && GetFileSizeEx(static_cast<HANDLE>(m_FileHandle), &size)
+    && static_cast<unsigned long long>(size.QuadPart) >= offset + length;
+}
+
+void
+MappedFile::WillNeed(SizeType, SizeType) const
+{
+  // No portable read-ahead hint before Windows 8: rely on the system
+  // heuristics.
+}
+
+#else
+
+bool
+MappedFile::Open(const std::string& filename)
+{
+  this->Close();
+
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    {
+    return false;
+    }
+
+  struct stat status;
+  if (fstat(fd, &status) != 0 || status.st_size <= 0
+      || static_cast<unsigned long long>(status.st_size) > static_cast<unsigned long long>(static_cast<size_t>(-1)))
+    {
+    close(fd);
+    return false;
+    }
+
+  void * data = mmap(0, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  if (data == MAP_FAILED)
+    {
+    close(fd);
+    return false;
+    }
+
+  // The descriptor is kept to check the size of the file before accesses
+  m_FileDescriptor = fd;
+  m_Data = static_cast<char *>(data);
+  m_Size = static_cast<SizeType>(status.st_size);
+  return true;
+}
+
+void
+MappedFile::Close()
+{
+  if (m_Data != 0)
+    {
+    munmap(m_Data, static_cast<size_t>(m_Size));
+    }
+  if (m_FileDescriptor >= 0)
+    {
+    close(m_FileDescriptor);
+    }
+  m_Data = 0;
+  m_Size = 0;
+  m_FileDescriptor = -1;
+}
+
+bool
+MappedFile::Contains(SizeType offset, SizeType length) const
+{
+  if (offset > m_Size || length > m_Size - offset)
+    {
+    return false;
+    }
+
+  // Pages beyond the end of a truncated file raise SIGBUS when read
+  struct stat status;
+  return m_FileDescriptor >= 0
+    && fstat(m_FileDescriptor, &status) == 0
+    && static_cast<unsigned long long>(status.st_size) >= offset + length;
+}
+
+void
+MappedFile::WillNeed(SizeType offset, SizeType length) const
+{
+  if (m_Data == 0 || offset >= m_Size || length == 0)
+    {
+    return;
+    }
+  if (length > m_Size - offset)
+    {
+    length = m_Size - offset;
+    }
+
+  // madvise requires a page aligned address
+  const SizeType pageSize = static_cast<SizeType>(sysconf(_SC_PAGESIZE));
+  const SizeType alignedOffset = offset - offset % pageSize;
+  length += offset - alignedOffset;
+
+  madvise(m_Data + alignedOffset, static_cast<size_t>(length), MADV_WILLNEED);
+}
+
+#endif
+
+} // namespace otb
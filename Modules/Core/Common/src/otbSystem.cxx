@@ -40,6 +40,9 @@
  *====================================================================*/
 #include <sys/types.h>
 #include <dirent.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <fstream>
 #endif
 
 namespace otb
@@ -203,4 +206,33 @@ bool System::ParseFileNameForAdditionalInfo(const std::string& id, std::string&
   return true;
 }
 
+bool
+System::GetResidentSetSize(unsigned long long& current, unsigned long long& peak)
+{
+  current = 0;
+  peak = 0;
+#if defined(__linux__)
+  // Resident pages are the second field of statm
+  std::ifstream statm("/proc/self/statm");
+  unsigned long long size = 0;
+  unsigned long long resident = 0;
+  if (!(statm >> size >> resident))
+    {
+    return false;
+    }
+  current = resident * static_cast<unsigned long long>(sysconf(_SC_PAGESIZE));
+
+  // ru_maxrss is expressed in kilobytes on Linux
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+    return false;
+    }
+  peak = static_cast<unsigned long long>(usage.ru_maxrss) * 1024;
+  return true;
+#else
+  return false;
+#endif
+}
+
 }
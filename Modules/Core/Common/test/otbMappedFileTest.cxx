@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <fstream>
+#include <iostream>
+#include <cstdlib>
+
+#include "itkMacro.h"
+#include "otbMappedFile.h"
+
+int otbMappedFileTest(int itkNotUsed(argc), char * argv[])
+{
+  const char * outputFileName = argv[1];
+  const unsigned int fileSize = 100000;
+
+  std::ofstream file(outputFileName, std::ios::out | std::ios::trunc | std::ios::binary);
+  for (unsigned int i = 0; i < fileSize; ++i)
+    {
+    file.put(static_cast<char>(i % 251));
+    }
+  file.close();
+
+  otb::MappedFile mappedFile;
+  if (!mappedFile.Open(outputFileName))
+    {
+    // Mapping is optional: readers fall back to stream reads
+    std::cout << "Mapping not available on this platform" << std::endl;
+    return EXIT_SUCCESS;
+    }
+
+  if (mappedFile.GetSize() != fileSize)
+    {
+    std::cerr << "Wrong mapping size: " << mappedFile.GetSize() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  for (unsigned int i = 0; i < fileSize; ++i)
+    {
+    if (static_cast<unsigned char>(mappedFile.GetData()[i]) != i % 251)
+      {
+      std::cerr << "Wrong mapped value at offset " << i << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  if (!mappedFile.Contains(fileSize - 10, 10) || mappedFile.Contains(fileSize - 10, 11))
+    {
+    std::cerr << "Wrong range check" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Hints outside of the mapping are silently clamped
+  mappedFile.WillNeed(5000, 10 * fileSize);
+  mappedFile.WillNeed(2 * fileSize, 10);
+
+  // Truncate the file while it is mapped (this fails on Windows): accesses
+  // beyond the new end of file must be rejected instead of raising SIGBUS
+  std::ofstream truncated(outputFileName, std::ios::out | std::ios::trunc | std::ios::binary);
+  for (unsigned int i = 0; i < fileSize / 2 && truncated.good(); ++i)
+    {
+    truncated.put(static_cast<char>(i % 251));
+    }
+  truncated.close();
+
+  std::ifstream check(outputFileName, std::ios::in | std::ios::binary | std::ios::ate);
+  const bool fileIsComplete = (static_cast<unsigned long long>(check.tellg()) == fileSize);
+  check.close();
+  if (mappedFile.Contains(fileSize - 10, 10) != fileIsComplete || !mappedFile.Contains(0, 10))
+    {
+    std::cerr << "Wrong range check after truncation of the file" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  mappedFile.Close();
+  if (mappedFile.IsOpen() || mappedFile.GetSize() != 0)
+    {
+    std::cerr << "Mapping not released" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  if (mappedFile.Open(std::string(outputFileName) + ".missing"))
+    {
+    std::cerr << "Mapping of a missing file should fail" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -323,6 +323,19 @@ public:
   /** Reads the data from disk into the memory buffer provided. */
   virtual void Read(void* buffer) = 0;
 
+  /** Reads the data from disk into a memory buffer of the given component
+   * type, keeping only the components listed in bandList (all components if
+   * empty). This lets the reader skip its intermediate buffer and conversion
+   * step when the ImageIO can convert the data itself. Returns false, without
+   * reading anything, if the conversion is not supported. Default
+   * implementation always returns false. */
+  virtual bool ReadAs(void* itkNotUsed(buffer),
+                      const std::type_info& itkNotUsed(componentType),
+                      const std::vector<unsigned int>& itkNotUsed(bandList))
+    {
+    return false;
+    }
+
 
   /*-------- This part of the interfaces deals with writing data ----- */
 
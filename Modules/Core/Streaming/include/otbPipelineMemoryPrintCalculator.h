@@ -55,6 +55,20 @@ namespace otb
  *  memory usage. The optimal number of stream divisions can be
  *  retrieved using the GetOptimalNumberOfStreamDivisions().
  *
+ *  Filters using memory on top of their output buffers can report it
+ *  by setting the MetaDataKey::MemoryPrintPerOutputPixel and
+ *  MetaDataKey::MemoryPrintPerThread keys (as double values, in
+ *  bytes) in their own MetaDataDictionary, for instance in
+ *  GenerateInputRequestedRegion(). The per pixel part is added to the
+ *  memory print, while the per thread part (multiplied by the number
+ *  of threads of the filter) does not depend on the size of the
+ *  requested region and is reported by GetFixedMemoryPrint(), along
+ *  with the share of the GDAL block cache found in the
+ *  MetaDataKey::CacheSizeInBytes key of the readers. Each reader
+ *  reports the share its blocks fill for a stream piece (one row of
+ *  blocks, at most the cache size), and the shares are summed since the
+ *  cache is shared (see GetCacheMemoryPrint()).
+ *
  *  Please note that for now this calculator suffers from the
  *  following limitations:
  *  - DataObject taken into account for memory usage estimation are
@@ -100,6 +114,14 @@ public:
   /** Get the total memory print (in bytes) */
   itkGetMacro(MemoryPrint, MemoryPrintType);
 
+  /** Get the memory print (in bytes) which does not depend on the size
+   * of the requested region: per thread scratch memory and block cache */
+  itkGetMacro(FixedMemoryPrint, MemoryPrintType);
+
+  /** Get the part of the fixed memory print (in bytes) due to the block
+   * cache of the readers */
+  itkGetMacro(CacheMemoryPrint, MemoryPrintType);
+
   /** Set/Get the bias correction factor which will weight the
    * estimated memory print (allows compensating bias between
    * estimated and real memory print, default is 1., i.e. no correction) */
@@ -136,6 +158,13 @@ protected:
   /** Recursive method to evaluate memory print in bytes */
   MemoryPrintType EvaluateProcessObjectPrintRecursive(ProcessObjectType * process);
 
+  /** Evaluate the memory reported by a process object on top of its output
+   * buffers. The per thread part is added to the fixed memory print. */
+  MemoryPrintType EvaluateProcessObjectExtraPrint(ProcessObjectType * process);
+
+  /** Keep track of the block cache size reported in a dictionary */
+  void UpdateCacheMemoryPrint(const itk::MetaDataDictionary & dict);
+
 private:
   PipelineMemoryPrintCalculator(const Self &); //purposely not implemented
   void operator =(const Self&);                //purposely not implemented
@@ -143,6 +172,12 @@ private:
   /** The total memory print of the pipeline */
   MemoryPrintType       m_MemoryPrint;
 
+  /** The memory print which does not depend on the requested region */
+  MemoryPrintType       m_FixedMemoryPrint;
+
+  /** The block cache size (shared by all the readers) */
+  MemoryPrintType       m_CacheMemoryPrint;
+
   /** Pointer to the last pipeline filter */
   DataObjectPointerType m_DataToWrite;
 
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbRAMDrivenBlockAlignedStreamingManager_h
+#define otbRAMDrivenBlockAlignedStreamingManager_h
+
+#include "otbStreamingManager.h"
+#include <vector>
+
+namespace otb
+{
+
+/** \class RAMDrivenBlockAlignedStreamingManager
+ *  \brief This class computes the divisions needed to stream an image
+ *  so that each division covers whole blocks of the output file, according
+ *  to a user-defined available RAM.
+ *
+ * The block layout of the output file is given with SetOutputBlockSize
+ * (ImageFileWriter fills it from the GDAL creation options). Blocks are
+ * anchored on the first index of the streamed region, since this is where
+ * the written file starts. A null block size in a dimension means that
+ * this dimension is not constrained by the output file.
+ *
+ * The TileHint from the MetaDataDictionary of the input image is also
+ * taken into account: when the input tile grid coincides with the output
+ * block grid, divisions are aligned on both layouts as long as the common
+ * block fits in a single division. Otherwise the output layout prevails,
+ * so that no output block is ever written by two different divisions.
+ *
+ * If neither layout is known, this manager behaves like
+ * RAMDrivenTiledStreamingManager.
+ *
+ * \sa RAMDrivenAdaptativeStreamingManager
+ * \sa ImageFileWriter
+ *
+ * \ingroup OTBStreaming
+ */
+template<class TImage>
+class ITK_EXPORT RAMDrivenBlockAlignedStreamingManager : public StreamingManager<TImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef RAMDrivenBlockAlignedStreamingManager Self;
+  typedef StreamingManager<TImage>              Superclass;
+  typedef itk::SmartPointer<Self>               Pointer;
+  typedef itk::SmartPointer<const Self>         ConstPointer;
+
+  typedef TImage                          ImageType;
+  typedef typename Superclass::RegionType RegionType;
+  typedef typename RegionType::IndexType    IndexType;
+  typedef typename RegionType::SizeType     SizeType;
+  typedef typename IndexType::IndexValueType IndexValueType;
+  typedef typename SizeType::SizeValueType   SizeValueType;
+
+  /** Creation through object factory macro */
+  itkNewMacro(Self);
+
+  /** Type macro */
+  itkTypeMacro(RAMDrivenBlockAlignedStreamingManager, itk::LightObject);
+
+  /** Dimension of input image. */
+  itkStaticConstMacro(ImageDimension, unsigned int, ImageType::ImageDimension);
+
+  /** The number of Megabytes available (if 0, the configuration option is
+    used)*/
+  itkSetMacro(AvailableRAMInMB, unsigned int);
+
+  /** The number of Megabytes available (if 0, the configuration option is
+    used)*/
+  itkGetConstMacro(AvailableRAMInMB, unsigned int);
+
+  /** The multiplier to apply to the memory print estimation */
+  itkSetMacro(Bias, double);
+
+  /** The multiplier to apply to the memory print estimation */
+  itkGetConstMacro(Bias, double);
+
+  /** The block size of the output file (0 if unknown in a dimension) */
+  itkSetMacro(OutputBlockSize, SizeType);
+
+  /** The block size of the output file (0 if unknown in a dimension) */
+  itkGetConstReferenceMacro(OutputBlockSize, SizeType);
+
+  /** Actually computes the stream divisions, according to the specified streaming mode,
+   * eventually using the input parameter to estimate memory consumption */
+  void PrepareStreaming(itk::DataObject * input, const RegionType &region) ITK_OVERRIDE;
+
+  /** Get a region definition that represents the ith piece a specified region.
+   * The "numberOfPieces" must be equal to what
+   * GetNumberOfSplits() returns. */
+  RegionType GetSplit(unsigned int i) ITK_OVERRIDE;
+
+protected:
+  RAMDrivenBlockAlignedStreamingManager();
+  ~RAMDrivenBlockAlignedStreamingManager() ITK_OVERRIDE;
+
+  /** Least common multiple of two block sizes */
+  static SizeValueType LeastCommonMultiple(SizeValueType a, SizeValueType b);
+
+  /** The number of MegaBytes of RAM available */
+  unsigned int m_AvailableRAMInMB;
+
+  /** The multiplier to apply to the memory print estimation */
+  double m_Bias;
+
+  /** The block size of the output file */
+  SizeType m_OutputBlockSize;
+
+  /** The block-aligned divisions (empty when the splitter is used) */
+  std::vector<RegionType> m_Splits;
+
+private:
+  RAMDrivenBlockAlignedStreamingManager(const RAMDrivenBlockAlignedStreamingManager &);
+  void operator =(const RAMDrivenBlockAlignedStreamingManager&);
+};
+
+} // End namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbRAMDrivenBlockAlignedStreamingManager.txx"
+#endif
+
+#endif
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbRAMDrivenBlockAlignedStreamingManager_txx
+#define otbRAMDrivenBlockAlignedStreamingManager_txx
+
+#include "otbRAMDrivenBlockAlignedStreamingManager.h"
+#include "otbMacro.h"
+#include "otbMath.h"
+#include "otbImageRegionSquareTileSplitter.h"
+#include "itkMetaDataObject.h"
+#include "otbMetaDataKey.h"
+
+#include <algorithm>
+
+namespace otb
+{
+
+template <class TImage>
+RAMDrivenBlockAlignedStreamingManager<TImage>::RAMDrivenBlockAlignedStreamingManager()
+  : m_AvailableRAMInMB(0),
+    m_Bias(1.0)
+{
+  m_OutputBlockSize.Fill(0);
+}
+
+template <class TImage>
+RAMDrivenBlockAlignedStreamingManager<TImage>::~RAMDrivenBlockAlignedStreamingManager()
+{
+}
+
+template <class TImage>
+typename RAMDrivenBlockAlignedStreamingManager<TImage>::SizeValueType
+RAMDrivenBlockAlignedStreamingManager<TImage>::LeastCommonMultiple(SizeValueType a, SizeValueType b)
+{
+  SizeValueType x = a;
+  SizeValueType y = b;
+  while (y != 0)
+    {
+    SizeValueType r = x % y;
+    x = y;
+    y = r;
+    }
+  return (a / x) * b;
+}
+
+template <class TImage>
+void
+RAMDrivenBlockAlignedStreamingManager<TImage>::PrepareStreaming( itk::DataObject * input, const RegionType &region )
+{
+  unsigned long nbDivisions =
+      this->EstimateOptimalNumberOfDivisions(input, region, m_AvailableRAMInMB, m_Bias);
+
+  this->m_Region = region;
+  m_Splits.clear();
+
+  unsigned int tileHint[2] = {0, 0};
+
+  itk::ExposeMetaData<unsigned int>(input->GetMetaDataDictionary(),
+                                    MetaDataKey::TileHintX,
+                                    tileHint[0]);
+
+  itk::ExposeMetaData<unsigned int>(input->GetMetaDataDictionary(),
+                                    MetaDataKey::TileHintY,
+                                    tileHint[1]);
+
+  const bool outputLayoutKnown = m_OutputBlockSize[0] > 0 || m_OutputBlockSize[1] > 0;
+  const bool inputLayoutKnown = tileHint[0] > 0 && tileHint[1] > 0;
+
+  if (ImageDimension != 2 || (!outputLayoutKnown && !inputLayoutKnown))
+    {
+    // No layout to follow: fall back to square tiles
+    this->m_Splitter = otb::ImageRegionSquareTileSplitter<itkGetStaticConstMacro(ImageDimension)>::New();
+    this->m_ComputedNumberOfSplits = this->m_Splitter->GetNumberOfSplits(region, nbDivisions);
+    otbMsgDevMacro(<< "Number of split : " << this->m_ComputedNumberOfSplits)
+    return;
+    }
+
+  const SizeType& regionSize = region.GetSize();
+  const IndexType& regionIndex = region.GetIndex();
+
+  if (nbDivisions < 1)
+    {
+    nbDivisions = 1;
+    }
+  const double pixelsPerSplit =
+    static_cast<double>(regionSize[0]) * static_cast<double>(regionSize[1]) / nbDivisions;
+
+  // Elementary block of the divisions: output blocks if known, input tiles otherwise
+  SizeValueType outputUnit[2];
+  SizeValueType commonUnit[2];
+  bool gridsCoincide = outputLayoutKnown && inputLayoutKnown;
+
+  for (unsigned int dim = 0; dim < 2; ++dim)
+    {
+    if (outputLayoutKnown)
+      {
+      outputUnit[dim] = m_OutputBlockSize[dim] > 0 ? m_OutputBlockSize[dim] : 1;
+      }
+    else
+      {
+      outputUnit[dim] = tileHint[dim];
+      }
+
+    if (gridsCoincide)
+      {
+      // Output blocks start at the region index, input tiles at 0
+      gridsCoincide = (regionIndex[dim] % static_cast<IndexValueType>(tileHint[dim])) == 0;
+      commonUnit[dim] = LeastCommonMultiple(outputUnit[dim], tileHint[dim]);
+      }
+    }
+
+  SizeValueType unit[2] = {outputUnit[0], outputUnit[1]};
+
+  if (gridsCoincide
+      && static_cast<double>(commonUnit[0]) * static_cast<double>(commonUnit[1]) <= pixelsPerSplit)
+    {
+    unit[0] = commonUnit[0];
+    unit[1] = commonUnit[1];
+    }
+
+  // Group blocks in nearly square divisions of about pixelsPerSplit pixels
+  SizeValueType nbUnits[2];
+  SizeValueType group[2];
+
+  for (unsigned int dim = 0; dim < 2; ++dim)
+    {
+    nbUnits[dim] = (regionSize[dim] + unit[dim] - 1) / unit[dim];
+    }
+
+  group[0] = static_cast<SizeValueType>(vcl_sqrt(pixelsPerSplit) / unit[0]);
+  group[0] = std::max<SizeValueType>(1, std::min(group[0], nbUnits[0]));
+
+  group[1] = static_cast<SizeValueType>(pixelsPerSplit / (static_cast<double>(group[0] * unit[0]) * unit[1]));
+  group[1] = std::max<SizeValueType>(1, std::min(group[1], nbUnits[1]));
+
+  const SizeValueType nbSplitsX = (nbUnits[0] + group[0] - 1) / group[0];
+  const SizeValueType nbSplitsY = (nbUnits[1] + group[1] - 1) / group[1];
+
+  m_Splits.reserve(nbSplitsX * nbSplitsY);
+
+  for (SizeValueType splitY = 0; splitY < nbSplitsY; ++splitY)
+    {
+    for (SizeValueType splitX = 0; splitX < nbSplitsX; ++splitX)
+      {
+      IndexType index;
+      SizeType  size;
+      index[0] = regionIndex[0] + splitX * group[0] * unit[0];
+      index[1] = regionIndex[1] + splitY * group[1] * unit[1];
+      size[0] = group[0] * unit[0];
+      size[1] = group[1] * unit[1];
+
+      RegionType split(index, size);
+      split.Crop(region);
+      m_Splits.push_back(split);
+      }
+    }
+
+  this->m_ComputedNumberOfSplits = m_Splits.size();
+  otbMsgDevMacro(<< "Block size : " << unit[0] << "x" << unit[1]
+                 << ", blocks per split : " << group[0] << "x" << group[1]
+                 << ", number of split : " << this->m_ComputedNumberOfSplits)
+}
+
+template <class TImage>
+typename RAMDrivenBlockAlignedStreamingManager<TImage>::RegionType
+RAMDrivenBlockAlignedStreamingManager<TImage>::GetSplit(unsigned int i)
+{
+  if (m_Splits.empty())
+    {
+    return Superclass::GetSplit(i);
+    }
+  if (i >= m_Splits.size())
+    {
+    itkExceptionMacro(<< "Split " << i << " requested, but only " << m_Splits.size() << " splits available.");
+    }
+  return m_Splits[i];
+}
+
+} // End namespace otb
+
+#endif
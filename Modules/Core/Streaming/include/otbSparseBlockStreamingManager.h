@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSparseBlockStreamingManager_h
+#define otbSparseBlockStreamingManager_h
+
+#include "otbStreamingManager.h"
+#include <vector>
+
+namespace otb
+{
+
+/** \class SparseBlockStreamingManager
+ *  \brief This class computes divisions that only cover the blocks of the
+ *  input image touched by a set of regions of interest.
+ *
+ * The regions of interest (for instance the pixels of sparse sample
+ * positions) are given with AddRegion before PrepareStreaming. The
+ * image is cut along a grid of blocks, given by SetBlockSize or, when
+ * it is not set, by the TileHint from the MetaDataDictionary of the
+ * input image (the GDAL block size of the file). Blocks touched by no
+ * region of interest are never requested, so that they are not read.
+ *
+ * When the TileHint describes strips (blocks as wide as the image), rows
+ * of blocks are at least 256 pixels high: the strips are grouped, so that
+ * each division does not cover a single row of pixels.
+ *
+ * Touched blocks which are contiguous on a row of blocks are grouped in
+ * a single division. Such runs of blocks are then merged with the runs
+ * covering the same columns on the next rows of blocks. Divisions
+ * always fit in the available RAM, and are given in raster order of
+ * their first block.
+ *
+ * \sa RAMDrivenBlockAlignedStreamingManager
+ * \sa ImageSampleExtractorFilter
+ *
+ * \ingroup OTBStreaming
+ */
+template<class TImage>
+class ITK_EXPORT SparseBlockStreamingManager : public StreamingManager<TImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef SparseBlockStreamingManager   Self;
+  typedef StreamingManager<TImage>      Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  typedef TImage                             ImageType;
+  typedef typename Superclass::RegionType    RegionType;
+  typedef typename RegionType::IndexType     IndexType;
+  typedef typename RegionType::SizeType      SizeType;
+  typedef typename IndexType::IndexValueType IndexValueType;
+  typedef typename SizeType::SizeValueType   SizeValueType;
+
+  /** Creation through object factory macro */
+  itkNewMacro(Self);
+
+  /** Type macro */
+  itkTypeMacro(SparseBlockStreamingManager, itk::LightObject);
+
+  /** Dimension of input image. */
+  itkStaticConstMacro(ImageDimension, unsigned int, ImageType::ImageDimension);
+
+  /** The number of Megabytes available (if 0, the configuration option is
+    used)*/
+  itkSetMacro(AvailableRAMInMB, unsigned int);
+
+  /** The number of Megabytes available (if 0, the configuration option is
+    used)*/
+  itkGetConstMacro(AvailableRAMInMB, unsigned int);
+
+  /** The multiplier to apply to the memory print estimation */
+  itkSetMacro(Bias, double);
+
+  /** The multiplier to apply to the memory print estimation */
+  itkGetConstMacro(Bias, double);
+
+  /** The block size (0 to use the TileHint of the input image) */
+  itkSetMacro(BlockSize, SizeType);
+
+  /** The block size (0 to use the TileHint of the input image) */
+  itkGetConstReferenceMacro(BlockSize, SizeType);
+
+  /** Add a region of interest */
+  void AddRegion(const RegionType &region);
+
+  /** Add a single pixel of interest */
+  void AddIndex(const IndexType &index);
+
+  /** Remove all the regions of interest */
+  void ClearRegions();
+
+  /** Actually computes the stream divisions, according to the specified streaming mode,
+   * eventually using the input parameter to estimate memory consumption */
+  void PrepareStreaming(itk::DataObject * input, const RegionType &region) ITK_OVERRIDE;
+
+  /** Get a region definition that represents the ith piece a specified region.
+   * The "numberOfPieces" must be equal to what
+   * GetNumberOfSplits() returns. */
+  RegionType GetSplit(unsigned int i) ITK_OVERRIDE;
+
+protected:
+  SparseBlockStreamingManager();
+  ~SparseBlockStreamingManager() ITK_OVERRIDE;
+
+  /** The number of MegaBytes of RAM available */
+  unsigned int m_AvailableRAMInMB;
+
+  /** The multiplier to apply to the memory print estimation */
+  double m_Bias;
+
+  /** The block size */
+  SizeType m_BlockSize;
+
+  /** The regions of interest */
+  std::vector<RegionType> m_RegionsOfInterest;
+
+  /** The divisions covering the touched blocks */
+  std::vector<RegionType> m_Splits;
+
+private:
+  SparseBlockStreamingManager(const SparseBlockStreamingManager &);
+  void operator =(const SparseBlockStreamingManager&);
+};
+
+} // End namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbSparseBlockStreamingManager.txx"
+#endif
+
+#endif
@@ -0,0 +1,246 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSparseBlockStreamingManager_txx
+#define otbSparseBlockStreamingManager_txx
+
+#include "otbSparseBlockStreamingManager.h"
+#include "otbMacro.h"
+#include "itkMetaDataObject.h"
+#include "otbMetaDataKey.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+namespace otb
+{
+
+template <class TImage>
+SparseBlockStreamingManager<TImage>::SparseBlockStreamingManager()
+  : m_AvailableRAMInMB(0),
+    m_Bias(1.0)
+{
+  m_BlockSize.Fill(0);
+}
+
+template <class TImage>
+SparseBlockStreamingManager<TImage>::~SparseBlockStreamingManager()
+{
+}
+
+template <class TImage>
+void
+SparseBlockStreamingManager<TImage>::AddRegion(const RegionType &region)
+{
+  m_RegionsOfInterest.push_back(region);
+}
+
+template <class TImage>
+void
+SparseBlockStreamingManager<TImage>::AddIndex(const IndexType &index)
+{
+  SizeType size;
+  size.Fill(1);
+  m_RegionsOfInterest.push_back(RegionType(index, size));
+}
+
+template <class TImage>
+void
+SparseBlockStreamingManager<TImage>::ClearRegions()
+{
+  m_RegionsOfInterest.clear();
+}
+
+template <class TImage>
+void
+SparseBlockStreamingManager<TImage>::PrepareStreaming( itk::DataObject * input, const RegionType &region )
+{
+  if (ImageDimension != 2)
+    {
+    itkExceptionMacro(<< "SparseBlockStreamingManager only handles 2D images.");
+    }
+
+  unsigned long nbDivisions =
+      this->EstimateOptimalNumberOfDivisions(input, region, m_AvailableRAMInMB, m_Bias);
+
+  this->m_Region = region;
+  m_Splits.clear();
+
+  unsigned int tileHint[2] = {0, 0};
+
+  itk::ExposeMetaData<unsigned int>(input->GetMetaDataDictionary(),
+                                    MetaDataKey::TileHintX,
+                                    tileHint[0]);
+
+  itk::ExposeMetaData<unsigned int>(input->GetMetaDataDictionary(),
+                                    MetaDataKey::TileHintY,
+                                    tileHint[1]);
+
+  // Block grid, anchored on index 0 like the tiles of the file. Without
+  // any layout, blocks of 256x256 pixels are used.
+  IndexValueType blockSize[2];
+  for (unsigned int dim = 0; dim < 2; ++dim)
+    {
+    SizeValueType size = m_BlockSize[dim] > 0 ? m_BlockSize[dim] : tileHint[dim];
+    blockSize[dim] = static_cast<IndexValueType>(size > 0 ? size : 256);
+    }
+
+  // Strips of a few rows would give one division per row of pixels:
+  // group them in blocks at least 256 rows high
+  const IndexValueType minimumBlockHeight = 256;
+  const ImageType* inputImage = dynamic_cast<const ImageType*>(input);
+  const bool stripped = inputImage != ITK_NULLPTR && tileHint[0] > 0
+    && tileHint[0] >= inputImage->GetLargestPossibleRegion().GetSize()[0];
+  if (m_BlockSize[1] == 0 && stripped && blockSize[1] < minimumBlockHeight)
+    {
+    blockSize[1] *= (minimumBlockHeight + blockSize[1] - 1) / blockSize[1];
+    }
+
+  if (nbDivisions < 1)
+    {
+    nbDivisions = 1;
+    }
+  const double pixelsPerSplit = static_cast<double>(region.GetNumberOfPixels()) / nbDivisions;
+  IndexValueType maxBlocksPerSplit = static_cast<IndexValueType>(
+    pixelsPerSplit / (static_cast<double>(blockSize[0]) * blockSize[1]));
+  if (maxBlocksPerSplit < 1)
+    {
+    maxBlocksPerSplit = 1;
+    }
+
+  // List the touched blocks as (row, column) pairs
+  typedef std::pair<IndexValueType, IndexValueType> BlockIdType;
+  std::vector<BlockIdType> blocks;
+  blocks.reserve(m_RegionsOfInterest.size());
+
+  for (typename std::vector<RegionType>::const_iterator it = m_RegionsOfInterest.begin();
+       it != m_RegionsOfInterest.end(); ++it)
+    {
+    RegionType roi = *it;
+    if (!roi.Crop(region))
+      {
+      continue;
+      }
+    IndexValueType first[2];
+    IndexValueType last[2];
+    for (unsigned int dim = 0; dim < 2; ++dim)
+      {
+      // the region is inside the image, indexes are positive
+      first[dim] = roi.GetIndex()[dim] / blockSize[dim];
+      last[dim] = (roi.GetIndex()[dim] + static_cast<IndexValueType>(roi.GetSize()[dim]) - 1) / blockSize[dim];
+      }
+    for (IndexValueType row = first[1]; row <= last[1]; ++row)
+      {
+      for (IndexValueType col = first[0]; col <= last[0]; ++col)
+        {
+        blocks.push_back(BlockIdType(row, col));
+        }
+      }
+    }
+
+  std::sort(blocks.begin(), blocks.end());
+  blocks.erase(std::unique(blocks.begin(), blocks.end()), blocks.end());
+
+  // Group the contiguous blocks of a row in runs, then extend each run
+  // with the runs covering the same columns on the next rows
+  struct BlockRun
+    {
+    IndexValueType FirstRow;
+    IndexValueType NbRows;
+    IndexValueType FirstCol;
+    IndexValueType NbCols;
+    };
+  std::vector<BlockRun> runs;
+  // Last run covering a span of columns (first column, number of columns)
+  std::map<BlockIdType, size_t> openRuns;
+
+  typename std::vector<BlockIdType>::const_iterator blockIt = blocks.begin();
+  while (blockIt != blocks.end())
+    {
+    const IndexValueType row = blockIt->first;
+    const IndexValueType firstCol = blockIt->second;
+    IndexValueType nbBlocks = 1;
+    ++blockIt;
+    while (blockIt != blocks.end()
+           && blockIt->first == row
+           && blockIt->second == firstCol + nbBlocks
+           && nbBlocks < maxBlocksPerSplit)
+      {
+      ++nbBlocks;
+      ++blockIt;
+      }
+
+    const BlockIdType columns(firstCol, nbBlocks);
+    typename std::map<BlockIdType, size_t>::iterator openIt = openRuns.find(columns);
+    if (openIt != openRuns.end())
+      {
+      BlockRun& previous = runs[openIt->second];
+      if (previous.FirstRow + previous.NbRows == row
+          && (previous.NbRows + 1) * nbBlocks <= maxBlocksPerSplit)
+        {
+        ++previous.NbRows;
+        continue;
+        }
+      }
+
+    BlockRun run;
+    run.FirstRow = row;
+    run.NbRows = 1;
+    run.FirstCol = firstCol;
+    run.NbCols = nbBlocks;
+    openRuns[columns] = runs.size();
+    runs.push_back(run);
+    }
+
+  for (typename std::vector<BlockRun>::const_iterator runIt = runs.begin(); runIt != runs.end(); ++runIt)
+    {
+    IndexType index;
+    SizeType  size;
+    index[0] = runIt->FirstCol * blockSize[0];
+    index[1] = runIt->FirstRow * blockSize[1];
+    size[0] = runIt->NbCols * blockSize[0];
+    size[1] = runIt->NbRows * blockSize[1];
+
+    RegionType split(index, size);
+    split.Crop(region);
+    m_Splits.push_back(split);
+    }
+
+  this->m_ComputedNumberOfSplits = m_Splits.size();
+  otbMsgDevMacro(<< "Block size : " << blockSize[0] << "x" << blockSize[1]
+                 << ", touched blocks : " << blocks.size()
+                 << ", number of split : " << this->m_ComputedNumberOfSplits)
+}
+
+template <class TImage>
+typename SparseBlockStreamingManager<TImage>::RegionType
+SparseBlockStreamingManager<TImage>::GetSplit(unsigned int i)
+{
+  if (i >= m_Splits.size())
+    {
+    itkExceptionMacro(<< "Split " << i << " requested, but only " << m_Splits.size() << " splits available.");
+    }
+  return m_Splits[i];
+}
+
+} // End namespace otb
+
+#endif
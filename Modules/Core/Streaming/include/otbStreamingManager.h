@@ -88,6 +88,11 @@ public:
    * GetNumberOfSplits() returns. */
   virtual RegionType GetSplit(unsigned int i);
 
+  /** Returns the memory print (in bytes) estimated for the processing of
+   * one split, including the fixed memory print of the pipeline. It is 0
+   * if the number of splits was not derived from a memory estimation. */
+  itkGetConstMacro(EstimatedMemoryPrintPerSplit, MemoryPrintType);
+
 protected:
   StreamingManager();
   ~StreamingManager() ITK_OVERRIDE;
@@ -102,6 +107,9 @@ protected:
   /** The region to stream */
   RegionType m_Region;
 
+  /** The memory print estimated for one split */
+  MemoryPrintType m_EstimatedMemoryPrintPerSplit;
+
   /** The splitter used to compute the different strips */
   typedef itk::ImageRegionSplitterBase           AbstractSplitterType;
   typedef typename AbstractSplitterType::Pointer AbstractSplitterPointerType;
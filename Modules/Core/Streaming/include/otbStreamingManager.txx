@@ -25,12 +25,15 @@
 #include "otbConfigurationManager.h"
 #include "itkExtractImageFilter.h"
 
+#include <algorithm>
+
 namespace otb
 {
 
 template <class TImage>
 StreamingManager<TImage>::StreamingManager()
-  : m_ComputedNumberOfSplits(0)
+  : m_ComputedNumberOfSplits(0),
+    m_EstimatedMemoryPrintPerSplit(0)
 {
 }
 
@@ -145,11 +148,36 @@ StreamingManager<TImage>::EstimateOptimalNumberOfDivisions(itk::DataObject * inp
     pipelineMemoryPrint = memoryPrintCalculator->GetMemoryPrint();
     }
 
+  // Per thread buffers and block cache do not shrink with the stream
+  // divisions: remove them from the RAM available for the pipeline buffers.
+  // At least half of the RAM is kept for the buffers, so that the number of
+  // divisions varies continuously with the fixed print.
+  MemoryPrintType fixedMemoryPrint = memoryPrintCalculator->GetFixedMemoryPrint();
+  const MemoryPrintType maxFixedMemoryPrint = availableRAMInBytes / 2;
+  // The GDAL block cache is sized independently of the RAM hint (5% of the
+  // physical memory by default) and easily exceeds half of it: it is capped
+  // silently, only the per thread buffers deserve a warning.
+  const MemoryPrintType threadMemoryPrint = fixedMemoryPrint - memoryPrintCalculator->GetCacheMemoryPrint();
+  if (threadMemoryPrint > maxFixedMemoryPrint)
+    {
+    itkWarningMacro(<< "The per thread buffers of the pipeline ("
+                    << static_cast<unsigned int>(threadMemoryPrint * otb::PipelineMemoryPrintCalculator::ByteToMegabyte)
+                    << " MB) exceed half of the available RAM ("
+                    << static_cast<unsigned int>(availableRAMInBytes * otb::PipelineMemoryPrintCalculator::ByteToMegabyte)
+                    << " MB). Only half of the available RAM is kept for the stream buffers:"
+                    << " the actual memory usage may exceed the available RAM.");
+    }
+  MemoryPrintType availableRAMForBuffers = availableRAMInBytes - std::min(fixedMemoryPrint, maxFixedMemoryPrint);
+
   unsigned int optimalNumberOfDivisions =
-      otb::PipelineMemoryPrintCalculator::EstimateOptimalNumberOfStreamDivisions(pipelineMemoryPrint, availableRAMInBytes);
+      otb::PipelineMemoryPrintCalculator::EstimateOptimalNumberOfStreamDivisions(pipelineMemoryPrint, availableRAMForBuffers);
+
+  m_EstimatedMemoryPrintPerSplit = pipelineMemoryPrint / std::max(optimalNumberOfDivisions, 1U) + fixedMemoryPrint;
 
   otbMsgDevMacro( "Estimated Memory print for the full image : "
                   << static_cast<unsigned int>(pipelineMemoryPrint * otb::PipelineMemoryPrintCalculator::ByteToMegabyte ) << std::endl)
+  otbMsgDevMacro( "Fixed memory print : "
+                  << static_cast<unsigned int>(fixedMemoryPrint * otb::PipelineMemoryPrintCalculator::ByteToMegabyte ) << std::endl)
   otbMsgDevMacro( "Optimal number of stream divisions: "
                   << optimalNumberOfDivisions << std::endl)
 
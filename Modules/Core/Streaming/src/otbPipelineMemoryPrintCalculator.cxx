@@ -27,6 +27,10 @@
 #include "otbVectorImage.h"
 #include "itkFixedArray.h"
 #include "otbImageList.h"
+#include "otbMetaDataKey.h"
+#include "itkMetaDataObject.h"
+
+#include <algorithm>
 
 namespace otb
 {
@@ -36,6 +40,8 @@ const double PipelineMemoryPrintCalculator::MegabyteToByte = vcl_pow(2.0, 20);
 PipelineMemoryPrintCalculator
 ::PipelineMemoryPrintCalculator()
   : m_MemoryPrint(0),
+    m_FixedMemoryPrint(0),
+    m_CacheMemoryPrint(0),
     m_DataToWrite(ITK_NULLPTR),
     m_BiasCorrectionFactor(1.),
     m_VisitedProcessObjects()
@@ -66,6 +72,7 @@ PipelineMemoryPrintCalculator
   // Display parameters
   os<<indent<<"Data to write:                      "<<m_DataToWrite<<std::endl;
   os<<indent<<"Memory print of whole pipeline:     "<<m_MemoryPrint * ByteToMegabyte <<" Mb"<<std::endl;
+  os<<indent<<"Fixed memory print:                 "<<m_FixedMemoryPrint * ByteToMegabyte <<" Mb"<<std::endl;
   os<<indent<<"Bias correction factor applied:     "<<m_BiasCorrectionFactor<<std::endl;
 }
 
@@ -75,6 +82,8 @@ PipelineMemoryPrintCalculator
 {
   // Clear the visited process objects set
   m_VisitedProcessObjects.clear();
+  m_FixedMemoryPrint = 0;
+  m_CacheMemoryPrint = 0;
 
   // Dry run of pipeline synchronisation
   m_DataToWrite->UpdateOutputInformation();
@@ -99,6 +108,9 @@ PipelineMemoryPrintCalculator
   // Apply bias correction factor
   m_MemoryPrint *= m_BiasCorrectionFactor;
 
+  // The block cache is shared by all the readers of the pipeline
+  m_FixedMemoryPrint += m_CacheMemoryPrint;
+
 }
 
 PipelineMemoryPrintCalculator::MemoryPrintType
@@ -156,10 +168,66 @@ PipelineMemoryPrintCalculator
       print += localPrint;
     }
 
+  // Add the memory used by the process object itself
+  print += this->EvaluateProcessObjectExtraPrint(process);
+  this->UpdateCacheMemoryPrint(process->GetMetaDataDictionary());
+
   // Finally, return the total print
   return print;
 }
 
+PipelineMemoryPrintCalculator::MemoryPrintType
+PipelineMemoryPrintCalculator
+::EvaluateProcessObjectExtraPrint(ProcessObjectType * process)
+{
+  const itk::MetaDataDictionary& dict = process->GetMetaDataDictionary();
+
+  double perOutputPixel = 0.;
+  double perThread = 0.;
+  itk::ExposeMetaData<double>(dict, MetaDataKey::MemoryPrintPerOutputPixel, perOutputPixel);
+  itk::ExposeMetaData<double>(dict, MetaDataKey::MemoryPrintPerThread, perThread);
+
+  MemoryPrintType print = 0;
+
+  if(perOutputPixel > 0.)
+    {
+    // Use the largest output requested region
+    itk::SizeValueType nbPixels = 0;
+    ProcessObjectType::DataObjectPointerArray outputs = process->GetOutputs();
+    for(unsigned int i = 0; i < outputs.size(); ++i)
+      {
+      const itk::ImageBase<2> * image = dynamic_cast<const itk::ImageBase<2> *>(outputs[i].GetPointer());
+      if(image != ITK_NULLPTR)
+        {
+        nbPixels = std::max(nbPixels, image->GetRequestedRegion().GetNumberOfPixels());
+        }
+      }
+    print = static_cast<MemoryPrintType>(perOutputPixel * nbPixels);
+    }
+
+  if(perThread > 0.)
+    {
+    m_FixedMemoryPrint += static_cast<MemoryPrintType>(perThread * process->GetNumberOfThreads());
+    }
+
+  otbMsgDevMacro(<< "Extra memory print of " << process->GetNameOfClass() << ": "
+                 << print << " bytes, " << perThread << " bytes per thread")
+
+  return print;
+}
+
+void
+PipelineMemoryPrintCalculator
+::UpdateCacheMemoryPrint(const itk::MetaDataDictionary & dict)
+{
+  unsigned int cacheSize = 0;
+  if(itk::ExposeMetaData<unsigned int>(dict, MetaDataKey::CacheSizeInBytes, cacheSize))
+    {
+    // Each reader reports the share of the shared cache its blocks fill
+    m_CacheMemoryPrint += static_cast<MemoryPrintType>(cacheSize);
+    }
+}
+
 PipelineMemoryPrintCalculator::MemoryPrintType
 PipelineMemoryPrintCalculator
 ::EvaluateDataObjectPrint(DataObjectType * data) const
@@ -24,6 +24,8 @@
 #include "otbImage.h"
 #include "otbImageFileReader.h"
 #include "otbVectorImageToIntensityImageFilter.h"
+#include "otbMetaDataKey.h"
+#include "itkMetaDataObject.h"
 
 int otbPipelineMemoryPrintCalculatorNew(int itkNotUsed(argc), char * itkNotUsed(argv) [])
 {
@@ -67,3 +69,50 @@ int otbPipelineMemoryPrintCalculatorTest(int itkNotUsed(argc), char * argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbPipelineMemoryPrintCalculatorExtraPrintTest(int itkNotUsed(argc), char * argv[])
+{
+  typedef otb::VectorImage<double, 2>            VectorImageType;
+  typedef otb::Image<double, 2>                  ImageType;
+  typedef otb::ImageFileReader<VectorImageType>  ReaderType;
+  typedef otb::VectorImageToIntensityImageFilter
+    <VectorImageType, ImageType>                 IntensityImageFilterType;
+  typedef otb::PipelineMemoryPrintCalculator::MemoryPrintType MemoryPrintType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(argv[1]);
+
+  IntensityImageFilterType::Pointer intensity = IntensityImageFilterType::New();
+  intensity->SetInput(reader->GetOutput());
+  intensity->SetNumberOfThreads(4);
+
+  otb::PipelineMemoryPrintCalculator::Pointer calculator = otb::PipelineMemoryPrintCalculator::New();
+  calculator->SetDataToWrite(intensity->GetOutput());
+  calculator->Compute();
+
+  const MemoryPrintType memoryPrint = calculator->GetMemoryPrint();
+  const MemoryPrintType fixedMemoryPrint = calculator->GetFixedMemoryPrint();
+
+  // Report 8 bytes per output pixel and 1000 bytes per thread
+  itk::EncapsulateMetaData<double>(intensity->GetMetaDataDictionary(), otb::MetaDataKey::MemoryPrintPerOutputPixel, 8.);
+  itk::EncapsulateMetaData<double>(intensity->GetMetaDataDictionary(), otb::MetaDataKey::MemoryPrintPerThread, 1000.);
+  calculator->Compute();
+
+  const MemoryPrintType expectedExtraPrint = 8 * intensity->GetOutput()->GetRequestedRegion().GetNumberOfPixels();
+
+  if (calculator->GetMemoryPrint() != memoryPrint + expectedExtraPrint)
+    {
+    std::cerr << "Memory print is " << calculator->GetMemoryPrint() << " bytes, expected "
+              << memoryPrint + expectedExtraPrint << " bytes" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  if (calculator->GetFixedMemoryPrint() != fixedMemoryPrint + 4000)
+    {
+    std::cerr << "Fixed memory print is " << calculator->GetFixedMemoryPrint() << " bytes, expected "
+              << fixedMemoryPrint + 4000 << " bytes" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
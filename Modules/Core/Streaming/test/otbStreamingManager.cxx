@@ -25,6 +25,8 @@
 #include "otbTileDimensionTiledStreamingManager.h"
 #include "otbRAMDrivenTiledStreamingManager.h"
 #include "otbRAMDrivenAdaptativeStreamingManager.h"
+#include "otbRAMDrivenBlockAlignedStreamingManager.h"
+#include "otbSparseBlockStreamingManager.h"
 
 #include <fstream>
 
@@ -35,6 +37,8 @@ typedef otb::RAMDrivenStrippedStreamingManager<ImageType>     RAMDrivenStrippedS
 typedef otb::TileDimensionTiledStreamingManager<ImageType>    TileDimensionTiledStreamingManagerType;
 typedef otb::RAMDrivenTiledStreamingManager<ImageType>        RAMDrivenTiledStreamingManagerType;
 typedef otb::RAMDrivenAdaptativeStreamingManager<ImageType>        RAMDrivenAdaptativeStreamingManagerType;
+typedef otb::RAMDrivenBlockAlignedStreamingManager<ImageType>      RAMDrivenBlockAlignedStreamingManagerType;
+typedef otb::SparseBlockStreamingManager<ImageType>                SparseBlockStreamingManagerType;
 
 
 ImageType::Pointer makeImage(ImageType::RegionType region)
@@ -69,6 +73,12 @@ int otbStreamingManagerNew(int itkNotUsed(argc), char * itkNotUsed(argv) [])
   RAMDrivenAdaptativeStreamingManagerType::Pointer streamingManager5 = RAMDrivenAdaptativeStreamingManagerType::New();
   std::cout<<streamingManager5<<std::endl;
 
+  RAMDrivenBlockAlignedStreamingManagerType::Pointer streamingManager6 = RAMDrivenBlockAlignedStreamingManagerType::New();
+  std::cout<<streamingManager6<<std::endl;
+
+  SparseBlockStreamingManagerType::Pointer streamingManager7 = SparseBlockStreamingManagerType::New();
+  std::cout<<streamingManager7<<std::endl;
+
   return EXIT_SUCCESS;
 }
 
@@ -230,3 +240,192 @@ int otbRAMDrivenAdaptativeStreamingManager(int itkNotUsed(argc), char * argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbRAMDrivenBlockAlignedStreamingManager(int itkNotUsed(argc), char * argv[])
+{
+  std::ofstream outfile(argv[1]);
+
+  RAMDrivenBlockAlignedStreamingManagerType::Pointer streamingManager = RAMDrivenBlockAlignedStreamingManagerType::New();
+
+  ImageType::RegionType region;
+  region.SetIndex(0, 100);
+  region.SetIndex(1, 50);
+  region.SetSize(0, 10013);
+  region.SetSize(1, 5727);
+
+  // Tiled output (256x256), then stripped output (16 lines per strip)
+  ImageType::SizeType blockSizes[2];
+  blockSizes[0].Fill(256);
+  blockSizes[1][0] = region.GetSize()[0];
+  blockSizes[1][1] = 16;
+
+  for (unsigned int layout = 0; layout < 2; ++layout)
+    {
+    streamingManager->SetAvailableRAMInMB(1);
+    streamingManager->SetOutputBlockSize(blockSizes[layout]);
+    streamingManager->PrepareStreaming( makeImage(region), region );
+
+    unsigned int nbSplits = streamingManager->GetNumberOfSplits();
+    unsigned long nbPixels = 0;
+
+    for (unsigned int i = 0; i < nbSplits; ++i)
+      {
+      ImageType::RegionType split = streamingManager->GetSplit(i);
+      nbPixels += split.GetNumberOfPixels();
+
+      for (unsigned int dim = 0; dim < 2; ++dim)
+        {
+        const long blockSize = static_cast<long>(blockSizes[layout][dim]);
+        const long offset = split.GetIndex()[dim] - region.GetIndex()[dim];
+        const long end = offset + static_cast<long>(split.GetSize()[dim]);
+
+        // Each split must start and end on an output block boundary
+        if (!region.IsInside(split)
+            || offset % blockSize != 0
+            || (end % blockSize != 0 && end != static_cast<long>(region.GetSize()[dim])))
+          {
+          std::cerr << "Split " << i << " is not aligned on output blocks: " << split << std::endl;
+          return EXIT_FAILURE;
+          }
+        }
+      }
+
+    // Splits are laid on a grid: they do not overlap if they cover the region exactly
+    if (nbPixels != region.GetNumberOfPixels())
+      {
+      std::cerr << "Splits cover " << nbPixels << " pixels instead of " << region.GetNumberOfPixels() << std::endl;
+      return EXIT_FAILURE;
+      }
+
+    outfile << nbSplits << std::endl;
+    outfile << streamingManager->GetSplit(0) << std::endl;
+    outfile << streamingManager->GetSplit(nbSplits - 1) << std::endl;
+    }
+
+  return EXIT_SUCCESS;
+}
+
+int otbSparseBlockStreamingManager(int itkNotUsed(argc), char * argv[])
+{
+  std::ofstream outfile(argv[1]);
+
+  SparseBlockStreamingManagerType::Pointer streamingManager = SparseBlockStreamingManagerType::New();
+
+  ImageType::RegionType region;
+  region.SetIndex(0, 0);
+  region.SetIndex(1, 0);
+  region.SetSize(0, 10013);
+  region.SetSize(1, 5727);
+
+  // Sparse pixels, two of them in the same 64x64 block, and a region
+  // spreading over two blocks
+  std::vector<ImageType::RegionType> rois;
+  ImageType::IndexType index;
+  ImageType::SizeType size;
+  size.Fill(1);
+  index[0] = 3;     index[1] = 5;     rois.push_back(ImageType::RegionType(index, size));
+  index[0] = 60;    index[1] = 10;    rois.push_back(ImageType::RegionType(index, size));
+  index[0] = 5000;  index[1] = 3000;  rois.push_back(ImageType::RegionType(index, size));
+  index[0] = 10012; index[1] = 5726;  rois.push_back(ImageType::RegionType(index, size));
+  index[0] = 120;   index[1] = 20;
+  size[0] = 20;     size[1] = 10;     rois.push_back(ImageType::RegionType(index, size));
+
+  for (unsigned int i = 0; i < rois.size(); ++i)
+    {
+    streamingManager->AddRegion(rois[i]);
+    }
+  // outside of the image: ignored
+  index[0] = -10; index[1] = 20000;
+  streamingManager->AddIndex(index);
+
+  streamingManager->SetAvailableRAMInMB(1);
+  streamingManager->PrepareStreaming( makeImage(region), region );
+
+  unsigned int nbSplits = streamingManager->GetNumberOfSplits();
+  unsigned long nbPixels = 0;
+
+  for (unsigned int i = 0; i < nbSplits; ++i)
+    {
+    ImageType::RegionType split = streamingManager->GetSplit(i);
+    nbPixels += split.GetNumberOfPixels();
+
+    bool touched = false;
+    for (unsigned int j = 0; j < rois.size(); ++j)
+      {
+      ImageType::RegionType roi = rois[j];
+      touched = touched || roi.Crop(split);
+      }
+    if (!region.IsInside(split) || !touched
+        || split.GetIndex()[0] % 64 != 0 || split.GetIndex()[1] % 64 != 0)
+      {
+      std::cerr << "Split " << i << " is not a touched block: " << split << std::endl;
+      return EXIT_FAILURE;
+      }
+    outfile << split << std::endl;
+    }
+
+  for (unsigned int j = 0; j < rois.size(); ++j)
+    {
+    ImageType::IndexType first = rois[j].GetIndex();
+    ImageType::IndexType last = rois[j].GetUpperIndex();
+    bool firstFound = false;
+    bool lastFound = false;
+    for (unsigned int i = 0; i < nbSplits; ++i)
+      {
+      firstFound = firstFound || streamingManager->GetSplit(i).IsInside(first);
+      lastFound = lastFound || streamingManager->GetSplit(i).IsInside(last);
+      }
+    if (!firstFound || !lastFound)
+      {
+      std::cerr << "Region of interest " << rois[j] << " is not covered by the splits" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // 5 blocks are touched: 3 contiguous ones on the first row, one in the
+  // middle and the last (cropped) block of the image
+  if (nbSplits != 3 || nbPixels != 4 * 64 * 64 + (10013 % 64) * (5727 % 64))
+    {
+    std::cerr << "Unexpected splits: " << nbSplits << " splits, " << nbPixels << " pixels" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Stripped file, 8 rows per strip: strips are grouped in blocks of 256
+  // rows, and the blocks touched on consecutive rows are merged
+  ImageType::Pointer strippedImage = makeImage(region);
+  itk::MetaDataDictionary& dict = strippedImage->GetMetaDataDictionary();
+  itk::EncapsulateMetaData<unsigned int>(dict, otb::MetaDataKey::TileHintX, 10013);
+  itk::EncapsulateMetaData<unsigned int>(dict, otb::MetaDataKey::TileHintY, 8);
+
+  SparseBlockStreamingManagerType::Pointer stripManager = SparseBlockStreamingManagerType::New();
+  index[0] = 10;   index[1] = 5;   stripManager->AddIndex(index);
+  index[0] = 9000; index[1] = 300; stripManager->AddIndex(index);
+  index[0] = 500;  index[1] = 800; stripManager->AddIndex(index);
+  stripManager->SetAvailableRAMInMB(1024);
+  stripManager->PrepareStreaming( strippedImage, region );
+
+  ImageType::RegionType expected[2];
+  expected[0].SetIndex(0, 0);
+  expected[0].SetIndex(1, 0);
+  expected[0].SetSize(0, 10013);
+  expected[0].SetSize(1, 512);
+  expected[1].SetIndex(0, 0);
+  expected[1].SetIndex(1, 768);
+  expected[1].SetSize(0, 10013);
+  expected[1].SetSize(1, 256);
+
+  if (stripManager->GetNumberOfSplits() != 2
+      || stripManager->GetSplit(0) != expected[0]
+      || stripManager->GetSplit(1) != expected[1])
+    {
+    std::cerr << "Unexpected splits for a stripped image: "
+              << stripManager->GetNumberOfSplits() << " splits" << std::endl;
+    return EXIT_FAILURE;
+    }
+  for (unsigned int i = 0; i < 2; ++i)
+    {
+    outfile << stripManager->GetSplit(i) << std::endl;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -111,6 +111,9 @@ public:
     * cooccurrence is stored is saved in the LookupArrayType.*/
   typedef std::vector<CooccurrencePairType> VectorType;
 
+  /** std::vector holding the frequency of each bin along one axis */
+  typedef std::vector<FrequencyType> MarginalVectorType;
+
   /** Get the total frequency of Co-occurrence pairs. */
   itkGetMacro(TotalFrequency, TotalFrequencyType);
 
@@ -120,15 +123,40 @@ public:
   /** Get std::vector containing non-zero co-occurrence pairs */
   VectorType GetVector();
 
+  /** Get the marginal frequencies of the co-occurrence pairs along the
+    * given axis: element i is the total frequency of the pairs whose
+    * index[dimension] is i. They are updated with each added or removed
+    * pair, so that they do not need a pass over m_Vector. */
+  const MarginalVectorType & GetMarginalFrequencies(const unsigned int dimension) const
+  {
+    return m_Marginals[dimension];
+  }
+
   /** Initialize the lowerbound and upper bound vecotor, Fill m_LookupArray with
     * -1 and set m_TotalFrequency to zero */
   void Initialize(const unsigned int nbins, const PixelValueType min,
                   const PixelValueType max, const bool symmetry = true);
 
+  /** Upper bound of the memory (in bytes) used by a list initialized with
+    * the given number of bins per axis */
+  static double GetMemoryPrint(const unsigned int nbins)
+  {
+    const double nbCells = static_cast<double>(nbins) * nbins;
+    return nbCells * (sizeof(int) + sizeof(CooccurrencePairType))
+      + 2 * PixelPairSize * nbins * sizeof(PixelValueType)
+      + PixelPairSize * nbins * sizeof(FrequencyType);
+  }
+
   //check if both pixel values fall between m_InputImageMinimum and
   //m_InputImageMaximum. If so add to m_Vector via AddPairToVector method */
   void AddPixelPair(const PixelValueType& pixelvalue1, const PixelValueType& pixelvalue2);
 
+  /** Remove a pixel pair previously added with AddPixelPair. This allows to
+    * update the list when a neighborhood slides over the image. A pair whose
+    * frequency drops to zero is removed from m_Vector, so that m_Vector only
+    * holds the pairs of the current neighborhood. */
+  void RemovePixelPair(const PixelValueType& pixelvalue1, const PixelValueType& pixelvalue2);
+
   /* Get the frequency value from Vector with index =[j,i] */
   RelativeFrequencyType GetFrequency(IndexValueType i, IndexValueType j);
 
@@ -146,6 +174,10 @@ protected:
     * co-occurrence pair is added again with index values swapped */
   void AddPairToVector(IndexType index);
 
+  /** decrement the frequency of the co-occurrence pair with given index.
+    * When it reaches zero, the last pair of m_Vector takes its place. */
+  void RemovePairFromVector(IndexType index);
+
   void SetBinMin(const unsigned int dimension, const InstanceIdentifier nbin,
                  PixelValueType min);
 
@@ -168,6 +200,9 @@ private:
   /* std::vector holding actual co-occurrence pairs */
   VectorType m_Vector;
 
+  /* Marginal frequencies of the co-occurrence pairs along each axis */
+  std::vector<MarginalVectorType> m_Marginals;
+
   /* Size instance */
   SizeType m_Size;
 
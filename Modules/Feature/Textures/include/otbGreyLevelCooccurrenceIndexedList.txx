@@ -57,7 +57,9 @@ Initialize(const unsigned int nbins, const PixelValueType min,
   m_Symmetry = symmetry;
   m_LookupArray = LookupArrayType(m_Size[0] * m_Size[1]);
   m_LookupArray.Fill(-1);
+  m_Vector.clear();
   m_TotalFrequency = 0;
+  m_Marginals.assign(PixelPairSize, MarginalVectorType(nbins, 0));
 
   // adjust the sizes of min max value containers
   unsigned int dim;
@@ -246,6 +248,41 @@ AddPixelPair(const PixelValueType& pixelvalue1, const PixelValueType& pixelvalue
     }
 }
 
+template <class TPixel >
+void
+GreyLevelCooccurrenceIndexedList<TPixel>::
+RemovePixelPair(const PixelValueType& pixelvalue1, const PixelValueType& pixelvalue2)
+{
+  // Same checks as AddPixelPair: out-of-bounds pairs were never added
+  if ( pixelvalue1 < m_InputImageMinimum
+       || pixelvalue1 > m_InputImageMaximum )
+    {
+    return;
+    }
+
+  if ( pixelvalue2 < m_InputImageMinimum
+       || pixelvalue2 > m_InputImageMaximum )
+    {
+    return;
+    }
+
+  IndexType index;
+  PixelPairType ppair( PixelPairSize);
+  ppair[0] = pixelvalue1;
+  ppair[1] = pixelvalue2;
+
+  this->GetIndex(ppair, index);
+  this->RemovePairFromVector(index);
+  if(m_Symmetry)
+    {
+    IndexValueType temp;
+    temp = index[0];
+    index[0] = index[1];
+    index[1] = temp;
+    this->RemovePairFromVector(index);
+    }
+}
+
 template <class TPixel>
 typename GreyLevelCooccurrenceIndexedList<TPixel>::RelativeFrequencyType
 GreyLevelCooccurrenceIndexedList<TPixel>::
@@ -306,9 +343,43 @@ GreyLevelCooccurrenceIndexedList<TPixel>
     {
     m_Vector[vindex].second++;
     }
+  m_Marginals[0][index[0]]++;
+  m_Marginals[1][index[1]]++;
   m_TotalFrequency = m_TotalFrequency + 1;
 }
 
+template <class TPixel>
+void
+GreyLevelCooccurrenceIndexedList<TPixel>
+::RemovePairFromVector(IndexType index)
+{
+  InstanceIdentifier instanceId = 0;
+  instanceId = index[1] * m_Size[0] + index[0];
+  int vindex = m_LookupArray[instanceId];
+  if( vindex < 0 || m_Vector[vindex].second == 0 )
+    {
+    itkExceptionMacro(<< "Co-occurrence pair " << index << " is not in the list.");
+    }
+  m_Vector[vindex].second--;
+  m_Marginals[0][index[0]]--;
+  m_Marginals[1][index[1]]--;
+  m_TotalFrequency = m_TotalFrequency - 1;
+
+  // Compact m_Vector: move its last pair in the slot of the removed one
+  if (m_Vector[vindex].second == 0)
+    {
+    const int lastIndex = static_cast<int>(m_Vector.size()) - 1;
+    if (vindex != lastIndex)
+      {
+      const IndexType lastPair = m_Vector[lastIndex].first;
+      m_Vector[vindex] = m_Vector[lastIndex];
+      m_LookupArray[lastPair[1] * m_Size[0] + lastPair[0]] = vindex;
+      }
+    m_Vector.pop_back();
+    m_LookupArray[instanceId] = -1;
+    }
+}
+
 template <class TPixel>
 void
 GreyLevelCooccurrenceIndexedList<TPixel>
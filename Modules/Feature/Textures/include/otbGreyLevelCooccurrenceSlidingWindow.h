@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbGreyLevelCooccurrenceSlidingWindow_h
+#define otbGreyLevelCooccurrenceSlidingWindow_h
+
+#include "otbGreyLevelCooccurrenceIndexedList.h"
+#include <algorithm>
+
+namespace otb
+{
+/** \class GreyLevelCooccurrenceSlidingWindow
+ * \brief Maintains the co-occurrence indexed list of a window moving over an image.
+ *
+ * Texture filters estimate a co-occurrence list on the neighborhood of each
+ * output pixel. Consecutive windows along an image row share all but their
+ * first and last columns, so rebuilding the list from scratch for every pixel
+ * wastes most of the work. This class keeps the list of the current window
+ * and, when the window is moved along the row, only removes the pairs of the
+ * columns leaving the window and adds the pairs of the columns entering it.
+ * Any other move (new row, cropped window of a different height, disjoint
+ * windows) triggers a full rebuild of the list.
+ *
+ * A pair is made of a pixel of the window and the pixel at the given offset,
+ * which is only counted if it lies in the buffered region of the input
+ * image. The resulting list is thus the same as the one built by iterating
+ * over the window with a neighborhood iterator, up to the order of its
+ * elements.
+ *
+ * This class only handles 2D images.
+ *
+ * \sa otb::GreyLevelCooccurrenceIndexedList
+ * \sa otb::ScalarImageToTexturesFilter
+ * \sa otb::ScalarImageToAdvancedTexturesFilter
+ *
+ * \ingroup OTBTextures
+ */
+template <class TInputImage>
+class ITK_EXPORT GreyLevelCooccurrenceSlidingWindow : public itk::LightObject
+{
+public:
+  /** Standard typedefs */
+  typedef GreyLevelCooccurrenceSlidingWindow Self;
+  typedef itk::LightObject                   Superclass;
+  typedef itk::SmartPointer<Self>            Pointer;
+  typedef itk::SmartPointer<const Self>      ConstPointer;
+
+  /** Creation through the object factory */
+  itkNewMacro(Self);
+
+  /** RTTI */
+  itkTypeMacro(GreyLevelCooccurrenceSlidingWindow, itk::LightObject);
+
+  typedef TInputImage                              InputImageType;
+  typedef typename InputImageType::ConstPointer    InputImageConstPointerType;
+  typedef typename InputImageType::PixelType       InputPixelType;
+  typedef typename InputImageType::RegionType      RegionType;
+  typedef typename InputImageType::IndexType       IndexType;
+  typedef typename InputImageType::OffsetType      OffsetType;
+  typedef typename IndexType::IndexValueType       IndexValueType;
+
+  typedef GreyLevelCooccurrenceIndexedList<InputPixelType>      CooccurrenceIndexedListType;
+  typedef typename CooccurrenceIndexedListType::Pointer         CooccurrenceIndexedListPointerType;
+  typedef typename CooccurrenceIndexedListType::PixelValueType  PixelValueType;
+
+  /** Set the input image, the co-occurrence offset and the binning of the
+   * list. The current window is invalidated. */
+  void Initialize(const InputImageType * image, const OffsetType & offset,
+                  const unsigned int nbins, const PixelValueType min,
+                  const PixelValueType max);
+
+  /** Move the window to the given region, which must be contained in the
+   * buffered region of the input image. The co-occurrence list is updated
+   * incrementally when possible. */
+  void SetWindow(const RegionType & window);
+
+  /** Get the current window */
+  const RegionType & GetWindow() const
+  {
+    return m_Window;
+  }
+
+  /** Get the co-occurrence list of the current window */
+  CooccurrenceIndexedListType * GetCooccurrenceIndexedList()
+  {
+    return m_CooccurrenceIndexedList;
+  }
+
+protected:
+  GreyLevelCooccurrenceSlidingWindow();
+  ~GreyLevelCooccurrenceSlidingWindow() ITK_OVERRIDE { }
+
+  /** Clear the list and add all the columns of the given window */
+  void Rebuild(const RegionType & window);
+
+  /** Add (or remove) the pairs whose first pixel lies in column x of the
+   * given window */
+  void UpdateColumn(const RegionType & window, IndexValueType x, bool add);
+
+  void PrintSelf(std::ostream & os, itk::Indent indent) const ITK_OVERRIDE;
+
+private:
+  GreyLevelCooccurrenceSlidingWindow(const Self&); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+
+  /** Input image */
+  InputImageConstPointerType m_Image;
+
+  /** Co-occurrence offset */
+  OffsetType m_Offset;
+
+  /** Binning of the co-occurrence list */
+  unsigned int m_NumberOfBinsPerAxis;
+  PixelValueType m_InputImageMinimum;
+  PixelValueType m_InputImageMaximum;
+
+  /** Co-occurrence list of the current window */
+  CooccurrenceIndexedListPointerType m_CooccurrenceIndexedList;
+
+  /** Current window, and whether the list matches it */
+  RegionType m_Window;
+  bool m_WindowIsValid;
+};
+
+} // End namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbGreyLevelCooccurrenceSlidingWindow.txx"
+#endif
+
+#endif
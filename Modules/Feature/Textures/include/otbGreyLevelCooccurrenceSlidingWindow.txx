@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbGreyLevelCooccurrenceSlidingWindow_txx
+#define otbGreyLevelCooccurrenceSlidingWindow_txx
+
+#include "otbGreyLevelCooccurrenceSlidingWindow.h"
+
+namespace otb
+{
+template <class TInputImage>
+GreyLevelCooccurrenceSlidingWindow<TInputImage>
+::GreyLevelCooccurrenceSlidingWindow() :
+  m_NumberOfBinsPerAxis(8),
+  m_InputImageMinimum(0),
+  m_InputImageMaximum(255),
+  m_WindowIsValid(false)
+{
+  m_Offset.Fill(0);
+  m_CooccurrenceIndexedList = CooccurrenceIndexedListType::New();
+}
+
+template <class TInputImage>
+void
+GreyLevelCooccurrenceSlidingWindow<TInputImage>
+::Initialize(const InputImageType * image, const OffsetType & offset,
+             const unsigned int nbins, const PixelValueType min,
+             const PixelValueType max)
+{
+  m_Image = image;
+  m_Offset = offset;
+  m_NumberOfBinsPerAxis = nbins;
+  m_InputImageMinimum = min;
+  m_InputImageMaximum = max;
+  m_WindowIsValid = false;
+}
+
+template <class TInputImage>
+void
+GreyLevelCooccurrenceSlidingWindow<TInputImage>
+::SetWindow(const RegionType & window)
+{
+  if (m_WindowIsValid
+      && window.GetIndex(1) == m_Window.GetIndex(1)
+      && window.GetSize(1) == m_Window.GetSize(1))
+    {
+    const IndexValueType oldBegin = m_Window.GetIndex(0);
+    const IndexValueType oldEnd = oldBegin + static_cast<IndexValueType>(m_Window.GetSize(0));
+    const IndexValueType newBegin = window.GetIndex(0);
+    const IndexValueType newEnd = newBegin + static_cast<IndexValueType>(window.GetSize(0));
+    const IndexValueType overlapBegin = std::max(oldBegin, newBegin);
+    const IndexValueType overlapEnd = std::min(oldEnd, newEnd);
+
+    // Windows sharing some columns: only update the differing ones
+    if (overlapBegin < overlapEnd)
+      {
+      for (IndexValueType x = oldBegin; x < overlapBegin; ++x)
+        {
+        this->UpdateColumn(m_Window, x, false);
+        }
+      for (IndexValueType x = overlapEnd; x < oldEnd; ++x)
+        {
+        this->UpdateColumn(m_Window, x, false);
+        }
+      for (IndexValueType x = newBegin; x < overlapBegin; ++x)
+        {
+        this->UpdateColumn(window, x, true);
+        }
+      for (IndexValueType x = overlapEnd; x < newEnd; ++x)
+        {
+        this->UpdateColumn(window, x, true);
+        }
+      m_Window = window;
+      return;
+      }
+    }
+
+  this->Rebuild(window);
+}
+
+template <class TInputImage>
+void
+GreyLevelCooccurrenceSlidingWindow<TInputImage>
+::Rebuild(const RegionType & window)
+{
+  m_CooccurrenceIndexedList->Initialize(m_NumberOfBinsPerAxis, m_InputImageMinimum, m_InputImageMaximum);
+
+  const IndexValueType begin = window.GetIndex(0);
+  const IndexValueType end = begin + static_cast<IndexValueType>(window.GetSize(0));
+  for (IndexValueType x = begin; x < end; ++x)
+    {
+    this->UpdateColumn(window, x, true);
+    }
+
+  m_Window = window;
+  m_WindowIsValid = true;
+}
+
+template <class TInputImage>
+void
+GreyLevelCooccurrenceSlidingWindow<TInputImage>
+::UpdateColumn(const RegionType & window, IndexValueType x, bool add)
+{
+  const RegionType & buffered = m_Image->GetBufferedRegion();
+
+  IndexType center;
+  center[0] = x;
+  center[1] = window.GetIndex(1);
+
+  IndexType neighbor = center + m_Offset;
+
+  // The whole column is skipped if the offset points outside the image
+  if (neighbor[0] < buffered.GetIndex(0)
+      || neighbor[0] >= buffered.GetIndex(0) + static_cast<IndexValueType>(buffered.GetSize(0)))
+    {
+    return;
+    }
+
+  const IndexValueType bufferedBegin = buffered.GetIndex(1);
+  const IndexValueType bufferedEnd = bufferedBegin + static_cast<IndexValueType>(buffered.GetSize(1));
+
+  for (unsigned long y = 0; y < window.GetSize(1); ++y, ++center[1], ++neighbor[1])
+    {
+    if (neighbor[1] < bufferedBegin || neighbor[1] >= bufferedEnd)
+      {
+      continue; // don't put a pixel in the co-occurrence list if the value is
+                // out of bounds
+      }
+
+    const InputPixelType centerPixelIntensity = m_Image->GetPixel(center);
+    const InputPixelType pixelIntensity = m_Image->GetPixel(neighbor);
+    if (add)
+      {
+      m_CooccurrenceIndexedList->AddPixelPair(centerPixelIntensity, pixelIntensity);
+      }
+    else
+      {
+      m_CooccurrenceIndexedList->RemovePixelPair(centerPixelIntensity, pixelIntensity);
+      }
+    }
+}
+
+template <class TInputImage>
+void
+GreyLevelCooccurrenceSlidingWindow<TInputImage>
+::PrintSelf(std::ostream & os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Offset: " << m_Offset << std::endl;
+  os << indent << "NumberOfBinsPerAxis: " << m_NumberOfBinsPerAxis << std::endl;
+  os << indent << "InputImageMinimum: " << m_InputImageMinimum << std::endl;
+  os << indent << "InputImageMaximum: " << m_InputImageMaximum << std::endl;
+  os << indent << "Window: " << m_Window << std::endl;
+}
+
+} // End namespace otb
+
+#endif
@@ -21,7 +21,7 @@
 #ifndef otbScalarImageToAdvancedTexturesFilter_h
 #define otbScalarImageToAdvancedTexturesFilter_h
 
-#include "otbGreyLevelCooccurrenceIndexedList.h"
+#include "otbGreyLevelCooccurrenceSlidingWindow.h"
 #include "itkImageToImageFilter.h"
 
 namespace otb
@@ -42,6 +42,10 @@ namespace otb
  * offset and the cell index (i, j) of the pixel in the neighborhood
  * window. :(where each element in GLCIL is a pair of pixel index and it's
  * frequency, $ g(i, j) $ is the frequency value of the pair having index is i, j).
+ * The GLCIL of a window is not rebuilt for each output pixel: it is updated
+ * from the one of the previous pixel of the row by removing the pairs of the
+ * column leaving the window and adding the pairs of the column entering it
+ * (see otb::GreyLevelCooccurrenceSlidingWindow).
  *
  * "Mean" \f$ = \sum_{i, j}i g(i, j) \f$
  *
@@ -134,10 +138,14 @@ public:
   typedef typename CooccurrenceIndexedListType::PixelValueType         PixelValueType;
   typedef typename CooccurrenceIndexedListType::RelativeFrequencyType  RelativeFrequencyType;
   typedef typename CooccurrenceIndexedListType::VectorType             VectorType;
+  typedef typename CooccurrenceIndexedListType::MarginalVectorType     MarginalVectorType;
 
   typedef typename VectorType::iterator                    VectorIteratorType;
   typedef typename VectorType::const_iterator              VectorConstIteratorType;
 
+  typedef GreyLevelCooccurrenceSlidingWindow< InputImageType > CooccurrenceSlidingWindowType;
+  typedef typename CooccurrenceSlidingWindowType::Pointer      CooccurrenceSlidingWindowPointerType;
+
   /** Set the radius of the window on which textures will be computed */
   itkSetMacro(Radius, SizeType);
   /** Get the radius of the window on which textures will be computed */
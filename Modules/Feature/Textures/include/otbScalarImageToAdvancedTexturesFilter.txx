@@ -27,6 +27,8 @@
 #include "itkImageRegionIterator.h"
 #include "itkProgressReporter.h"
 #include "itkNumericTraits.h"
+#include "itkMetaDataObject.h"
+#include "otbMetaDataKey.h"
 #include <algorithm>
 
 namespace otb
@@ -283,6 +285,13 @@ ScalarImageToAdvancedTexturesFilter<TInputImage, TOutputImage>
   if (inputRequestedRegion.Crop(inputPtr->GetLargestPossibleRegion()))
     {
     inputPtr->SetRequestedRegion(inputRequestedRegion);
+
+    // Each thread holds a co-occurrence list and its marginal sums:
+    // report them to the pipeline memory print estimation
+    itk::EncapsulateMetaData<double>(this->GetMetaDataDictionary(),
+                                     MetaDataKey::MemoryPrintPerThread,
+                                     CooccurrenceIndexedListType::GetMemoryPrint(m_NumberOfBinsPerAxis)
+                                     + m_NumberOfBinsPerAxis * sizeof(double));
     }
   else
     {
@@ -360,6 +369,11 @@ ScalarImageToAdvancedTexturesFilter<TInputImage, TOutputImage>
 
   InputRegionType inputLargest = inputPtr->GetLargestPossibleRegion();
 
+  // Co-occurrence list of the sliding window: consecutive windows along a
+  // row only differ by their first and last columns
+  CooccurrenceSlidingWindowPointerType slidingWindow = CooccurrenceSlidingWindowType::New();
+  slidingWindow->Initialize(inputPtr, m_Offset, m_NumberOfBinsPerAxis, m_InputImageMinimum, m_InputImageMaximum);
+
   // Set-up progress reporting
   itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
 
@@ -398,24 +412,9 @@ ScalarImageToAdvancedTexturesFilter<TInputImage, TOutputImage>
     inputRegion.SetSize(inputSize);
     inputRegion.Crop(inputPtr->GetRequestedRegion());
 
-    CooccurrenceIndexedListPointerType GLCIList = CooccurrenceIndexedListType::New();
-    GLCIList->Initialize(m_NumberOfBinsPerAxis, m_InputImageMinimum, m_InputImageMaximum);
-
-    typedef itk::ConstNeighborhoodIterator< InputImageType > NeighborhoodIteratorType;
-    NeighborhoodIteratorType neighborIt;
-    neighborIt = NeighborhoodIteratorType(m_NeighborhoodRadius, inputPtr, inputRegion);
-    for ( neighborIt.GoToBegin(); !neighborIt.IsAtEnd(); ++neighborIt )
-    {
-    const InputPixelType centerPixelIntensity = neighborIt.GetCenterPixel();
-    bool pixelInBounds;
-    const InputPixelType pixelIntensity =  neighborIt.GetPixel(m_Offset, pixelInBounds);
-    if ( !pixelInBounds )
-      {
-      continue; // don't put a pixel in the co-occurrence list if the value is
-               // out of bounds
-      }
-    GLCIList->AddPixelPair(centerPixelIntensity, pixelIntensity);
-    }
+    // Update the co-occurrence list from the one of the previous window
+    slidingWindow->SetWindow(inputRegion);
+    CooccurrenceIndexedListPointerType GLCIList = slidingWindow->GetCooccurrenceIndexedList();
 
     PixelValueType m_Mean                    = itk::NumericTraits< PixelValueType >::Zero;
     PixelValueType m_Variance                = itk::NumericTraits< PixelValueType >::Zero;
@@ -453,20 +452,27 @@ ScalarImageToAdvancedTexturesFilter<TInputImage, TOutputImage>
     VectorType glcVector = GLCIList->GetVector();
     double totalFrequency = static_cast<double> (GLCIList->GetTotalFrequency());
 
+    //Compute Mean, hx, hy from the marginal frequencies kept by the list
+    const MarginalVectorType & marginalFrequenciesX = GLCIList->GetMarginalFrequencies(0);
+    const MarginalVectorType & marginalFrequenciesY = GLCIList->GetMarginalFrequencies(1);
+    for(long unsigned int i = 0; i < histSize; i++)
+      {
+      hx[i] = marginalFrequenciesX[i] / totalFrequency;
+      hy[i] = marginalFrequenciesY[i] / totalFrequency;
+      m_Mean += static_cast<double>(i) * hx[i];
+      }
+
     VectorConstIteratorType constVectorIt;
     //Normalize the GreyLevelCooccurrenceListType
-    //Compute Mean, Entropy (f12), hx, hy, pdxy
+    //Compute Entropy (f12), pdxy
     constVectorIt = glcVector.begin();
     while( constVectorIt != glcVector.end())
       {
       CooccurrenceIndexType index = (*constVectorIt).first;
       double frequency = (*constVectorIt).second / totalFrequency;
-      m_Mean += static_cast<double>(index[0]) * frequency;
       Entropy -= (frequency > 0.0001) ? frequency * vcl_log(frequency) / log2 : 0.;
       unsigned int i = index[1];
       unsigned int j = index[0];
-      hx[j] += frequency;
-      hy[i] += frequency;
 
       if( i+j > histSize-1)
         {
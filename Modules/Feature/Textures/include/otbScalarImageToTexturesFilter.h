@@ -22,7 +22,7 @@
 #ifndef otbScalarImageToTexturesFilter_h
 #define otbScalarImageToTexturesFilter_h
 
-#include "otbGreyLevelCooccurrenceIndexedList.h"
+#include "otbGreyLevelCooccurrenceSlidingWindow.h"
 #include "itkImageToImageFilter.h"
 
 namespace otb
@@ -44,6 +44,10 @@ namespace otb
  * offset and the cell index (i, j) of the pixel in the neighborhood
  * window. :(where each element in GLCIL is a pair of pixel index and it's
  * frequency, $ g(i, j) $ is the frequency value of the pair having index is i, j).
+ * The GLCIL of a window is not rebuilt for each output pixel: it is updated
+ * from the one of the previous pixel of the row by removing the pairs of the
+ * column leaving the window and adding the pairs of the column entering it
+ * (see otb::GreyLevelCooccurrenceSlidingWindow).
  *
  * "Energy" \f$ = f_1 = \sum_{i, j}g(i, j)^2 \f$
  *
@@ -91,6 +95,7 @@ namespace otb
  * is set using the SetOffset() method.
  *
  * \sa otb::GreyLevelCooccurrenceIndexedList
+ * \sa otb::GreyLevelCooccurrenceSlidingWindow
  * \sa otb::ScalarImageToAdvancedTexturesFiler
  * \sa otb::ScalarImageToHigherOrderTexturesFilter
  *
@@ -136,10 +141,14 @@ public:
   typedef typename CooccurrenceIndexedListType::PixelValueType         PixelValueType;
   typedef typename CooccurrenceIndexedListType::RelativeFrequencyType  RelativeFrequencyType;
   typedef typename CooccurrenceIndexedListType::VectorType             VectorType;
+  typedef typename CooccurrenceIndexedListType::MarginalVectorType     MarginalVectorType;
 
   typedef typename VectorType::iterator                    VectorIteratorType;
   typedef typename VectorType::const_iterator              VectorConstIteratorType;
 
+  typedef GreyLevelCooccurrenceSlidingWindow< InputImageType > CooccurrenceSlidingWindowType;
+  typedef typename CooccurrenceSlidingWindowType::Pointer      CooccurrenceSlidingWindowPointerType;
+
   /** Set the radius of the window on which textures will be computed */
   itkSetMacro(Radius, SizeType);
   /** Get the radius of the window on which textures will be computed */
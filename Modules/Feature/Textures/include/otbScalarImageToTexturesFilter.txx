@@ -28,6 +28,8 @@
 #include "itkImageRegionIterator.h"
 #include "itkProgressReporter.h"
 #include "itkNumericTraits.h"
+#include "itkMetaDataObject.h"
+#include "otbMetaDataKey.h"
 #include <vector>
 #include <cmath>
 
@@ -258,6 +260,13 @@ ScalarImageToTexturesFilter<TInputImage, TOutputImage>
   if (inputRequestedRegion.Crop(inputPtr->GetLargestPossibleRegion()))
     {
     inputPtr->SetRequestedRegion(inputRequestedRegion);
+
+    // Each thread holds a co-occurrence list and its marginal sums:
+    // report them to the pipeline memory print estimation
+    itk::EncapsulateMetaData<double>(this->GetMetaDataDictionary(),
+                                     MetaDataKey::MemoryPrintPerThread,
+                                     CooccurrenceIndexedListType::GetMemoryPrint(m_NumberOfBinsPerAxis)
+                                     + m_NumberOfBinsPerAxis * sizeof(double));
     }
   else
     {
@@ -327,6 +336,11 @@ ScalarImageToTexturesFilter<TInputImage, TOutputImage>
 
   InputRegionType inputLargest = inputPtr->GetLargestPossibleRegion();
 
+  // Co-occurrence list of the sliding window: consecutive windows along a
+  // row only differ by their first and last columns
+  CooccurrenceSlidingWindowPointerType slidingWindow = CooccurrenceSlidingWindowType::New();
+  slidingWindow->Initialize(inputPtr, m_Offset, m_NumberOfBinsPerAxis, m_InputImageMinimum, m_InputImageMaximum);
+
   // Set-up progress reporting
   itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
 
@@ -362,24 +376,9 @@ ScalarImageToTexturesFilter<TInputImage, TOutputImage>
     inputRegion.SetSize(inputSize);
     inputRegion.Crop(inputPtr->GetRequestedRegion());
 
-    CooccurrenceIndexedListPointerType GLCIList = CooccurrenceIndexedListType::New();
-    GLCIList->Initialize(m_NumberOfBinsPerAxis, m_InputImageMinimum, m_InputImageMaximum);
-
-    typedef itk::ConstNeighborhoodIterator< InputImageType > NeighborhoodIteratorType;
-    NeighborhoodIteratorType neighborIt;
-    neighborIt = NeighborhoodIteratorType(m_NeighborhoodRadius, inputPtr, inputRegion);
-    for ( neighborIt.GoToBegin(); !neighborIt.IsAtEnd(); ++neighborIt )
-      {
-      const InputPixelType centerPixelIntensity = neighborIt.GetCenterPixel();
-      bool pixelInBounds;
-      const InputPixelType pixelIntensity =  neighborIt.GetPixel(m_Offset, pixelInBounds);
-      if ( !pixelInBounds )
-        {
-        continue; // don't put a pixel in the co-occurrence list if the value is
-                  // out of bounds
-        }
-      GLCIList->AddPixelPair(centerPixelIntensity, pixelIntensity);
-      }
+    // Update the co-occurrence list from the one of the previous window
+    slidingWindow->SetWindow(inputRegion);
+    CooccurrenceIndexedListPointerType GLCIList = slidingWindow->GetCooccurrenceIndexedList();
 
     double pixelMean = 0.;
     double marginalMean;
@@ -393,15 +392,12 @@ ScalarImageToTexturesFilter<TInputImage, TOutputImage>
     VectorType glcVector = GLCIList->GetVector();
     double totalFrequency = static_cast<double> (GLCIList->GetTotalFrequency());
 
-    //Normalize the co-occurrence indexed list and compute mean, marginalSum
-    typename VectorType::iterator it = glcVector.begin();
-    while( it != glcVector.end())
+    //Compute mean and marginalSum from the marginal frequencies kept by the list
+    const MarginalVectorType & marginalFrequencies = GLCIList->GetMarginalFrequencies(0);
+    for (unsigned int bin = 0; bin < m_NumberOfBinsPerAxis; ++bin)
       {
-      double frequency = (*it).second / totalFrequency;
-      CooccurrenceIndexType index = (*it).first;
-      pixelMean += index[0] * frequency;
-      marginalSums[index[0]] += frequency;
-      ++it;
+      marginalSums[bin] = marginalFrequencies[bin] / totalFrequency;
+      pixelMean += bin * marginalSums[bin];
       }
 
     /* Now get the mean and deviaton of the marginal sums.
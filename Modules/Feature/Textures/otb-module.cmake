@@ -25,6 +25,7 @@ otb_module(OTBTextures
   DEPENDS
     OTBCommon
     OTBITK
+    OTBOSSIMAdapters
 
   TEST_DEPENDS
     OTBTestKernel
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbGreyLevelCooccurrenceSlidingWindow.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkConstNeighborhoodIterator.h"
+#include "itkImage.h"
+
+int otbGreyLevelCooccurrenceSlidingWindow(int itkNotUsed(argc), char * itkNotUsed(argv) [])
+{
+  const unsigned int IMGWIDTH   = 12;
+  const unsigned int IMGHEIGHT  = 9;
+  const unsigned int NDIMENSION = 2;
+  const unsigned int NBBINS     = 8;
+
+  typedef unsigned char InputPixelType;
+  typedef itk::Image<InputPixelType, NDIMENSION> InputImageType;
+  typedef InputImageType::RegionType             InputRegionType;
+
+  typedef otb::GreyLevelCooccurrenceSlidingWindow<InputImageType>    SlidingWindowType;
+  typedef SlidingWindowType::CooccurrenceIndexedListType              CooccurrenceIndexedListType;
+
+  InputImageType::Pointer image = InputImageType::New();
+  InputImageType::SizeType size = {{ IMGWIDTH, IMGHEIGHT }};
+  InputImageType::IndexType start;
+  start.Fill(0);
+  InputRegionType region(start, size);
+  image->SetRegions(region);
+  image->Allocate();
+
+  // Fill the image with a pattern, and a few values above the maximum of the
+  // list which must be ignored
+  itk::ImageRegionIteratorWithIndex<InputImageType> imageIt(image, region);
+  for (imageIt.GoToBegin(); !imageIt.IsAtEnd(); ++imageIt)
+    {
+    const InputImageType::IndexType & idx = imageIt.GetIndex();
+    InputPixelType value = (idx[0] * 7 + idx[1] * 3 + idx[0] * idx[1]) % 10;
+    if ((idx[0] + 2 * idx[1]) % 11 == 0)
+      {
+      value = 20;
+      }
+    imageIt.Set(value);
+    }
+
+  InputImageType::SizeType radius = {{ 2, 1 }};
+  InputImageType::OffsetType offset = {{ 1, -1 }};
+  InputImageType::SizeType neighborhoodRadius;
+  neighborhoodRadius.Fill(1);
+
+  SlidingWindowType::Pointer slidingWindow = SlidingWindowType::New();
+  slidingWindow->Initialize(image, offset, NBBINS, 0, 9);
+
+  // Every second column is skipped to also exercise moves by several columns
+  unsigned int nbWindows = 0;
+  for (unsigned int y = 0; y < IMGHEIGHT; ++y)
+    {
+    for (unsigned int x = y % 2; x < IMGWIDTH; x += 1 + (y % 2))
+      {
+      InputImageType::IndexType windowIndex;
+      windowIndex[0] = static_cast<long>(x) - static_cast<long>(radius[0]);
+      windowIndex[1] = static_cast<long>(y) - static_cast<long>(radius[1]);
+      InputImageType::SizeType windowSize;
+      windowSize[0] = 2 * radius[0] + 1;
+      windowSize[1] = 2 * radius[1] + 1;
+      InputRegionType window(windowIndex, windowSize);
+      window.Crop(image->GetRequestedRegion());
+
+      slidingWindow->SetWindow(window);
+      CooccurrenceIndexedListType::Pointer slidingList = slidingWindow->GetCooccurrenceIndexedList();
+
+      // Reference list, built from scratch
+      CooccurrenceIndexedListType::Pointer refList = CooccurrenceIndexedListType::New();
+      refList->Initialize(NBBINS, 0, 9);
+
+      typedef itk::ConstNeighborhoodIterator< InputImageType > NeighborhoodIteratorType;
+      NeighborhoodIteratorType neighborIt(neighborhoodRadius, image, window);
+      for (neighborIt.GoToBegin(); !neighborIt.IsAtEnd(); ++neighborIt)
+        {
+        bool pixelInBounds;
+        const InputPixelType pixelIntensity = neighborIt.GetPixel(offset, pixelInBounds);
+        if (!pixelInBounds)
+          {
+          continue;
+          }
+        refList->AddPixelPair(neighborIt.GetCenterPixel(), pixelIntensity);
+        }
+
+      if (slidingList->GetTotalFrequency() != refList->GetTotalFrequency())
+        {
+        std::cerr << "Window " << window << ": expected total frequency "
+                  << refList->GetTotalFrequency() << ", got "
+                  << slidingList->GetTotalFrequency() << std::endl;
+        return EXIT_FAILURE;
+        }
+
+      // Compare the raw frequencies of every cell
+      const CooccurrenceIndexedListType::VectorType slidingVector = slidingList->GetVector();
+      const CooccurrenceIndexedListType::VectorType refVector = refList->GetVector();
+      if (slidingVector.size() != refVector.size())
+        {
+        std::cerr << "Window " << window << ": expected " << refVector.size()
+                  << " non-zero pairs, got " << slidingVector.size() << std::endl;
+        return EXIT_FAILURE;
+        }
+      for (unsigned int dim = 0; dim < 2; ++dim)
+        {
+        if (slidingList->GetMarginalFrequencies(dim) != refList->GetMarginalFrequencies(dim))
+          {
+          std::cerr << "Window " << window << ": wrong marginal frequencies along axis "
+                    << dim << std::endl;
+          return EXIT_FAILURE;
+          }
+        }
+      for (unsigned int i = 0; i < NBBINS; ++i)
+        {
+        for (unsigned int j = 0; j < NBBINS; ++j)
+          {
+          if (slidingList->GetFrequency(i, j, slidingVector) != refList->GetFrequency(i, j, refVector))
+            {
+            std::cerr << "Window " << window << ": expected frequency "
+                      << refList->GetFrequency(i, j, refVector) << " at (" << i << ", " << j
+                      << "), got " << slidingList->GetFrequency(i, j, slidingVector) << std::endl;
+            return EXIT_FAILURE;
+            }
+          }
+        }
+      ++nbWindows;
+      }
+    }
+
+  std::cout << "Checked " << nbWindows << " windows" << std::endl;
+  return EXIT_SUCCESS;
+}
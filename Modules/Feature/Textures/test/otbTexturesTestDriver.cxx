@@ -27,6 +27,7 @@ void RegisterTests()
   REGISTER_TEST(otbHaralickTexturesImageFunctionNew);
   REGISTER_TEST(otbHaralickTexturesImageFunction);
   REGISTER_TEST(otbGreyLevelCooccurrenceIndexedList);
+  REGISTER_TEST(otbGreyLevelCooccurrenceSlidingWindow);
   REGISTER_TEST(otbScalarImageToTexturesFilter);
   REGISTER_TEST(otbScalarImageToTexturesFilterNew);
   REGISTER_TEST(otbSFSTexturesImageFilterTest);
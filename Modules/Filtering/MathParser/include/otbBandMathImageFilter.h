@@ -69,6 +69,10 @@ namespace otb
  * This functionality assumes that all the band involved have the same
  * spacing and origin.
  *
+ * When muParser supports it (OTB_MUPARSER_HAS_BULK_MODE), the variables
+ * are stored as arrays covering a whole scanline, and the expression is
+ * evaluated on all of them with a single call to the parser.
+ *
  *
  * \sa Parser
  *
@@ -144,6 +148,7 @@ private :
   std::vector< std::vector<double> >    m_AImage;
   std::vector< std::string >            m_VVarName;
   unsigned int                          m_NbVar;
+  unsigned int                          m_BulkSize; // number of pixels evaluated at once by a parser
 
   SpacingType                           m_Spacing;
   OrigineType                           m_Origin;
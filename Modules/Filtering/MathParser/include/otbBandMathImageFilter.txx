@@ -29,6 +29,7 @@
 #include "otbMacro.h"
 
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 
@@ -49,6 +50,7 @@ BandMathImageFilter<TImage>
   m_OverflowCount = 0;
   m_ThreadUnderflow.SetSize(1);
   m_ThreadOverflow.SetSize(1);
+  m_BulkSize = 1;
 }
 
 /** Destructor */
@@ -194,6 +196,13 @@ void BandMathImageFilter<TImage>
   m_NbVar = nbInputImages+nbAccessIndex;
   m_VVarName.resize(m_NbVar);
 
+#ifdef OTB_MUPARSER_HAS_BULK_MODE
+  // Variables hold a whole scanline of values
+  m_BulkSize = std::max(1u, static_cast<unsigned int>(this->GetOutput()->GetRequestedRegion().GetSize(0)));
+#else
+  m_BulkSize = 1;
+#endif
+
   for(itParser = m_VParser.begin(); itParser < m_VParser.end(); itParser++)
     {
     *itParser = ParserType::New();
@@ -201,18 +210,18 @@ void BandMathImageFilter<TImage>
 
   for(i = 0; i < nbThreads; ++i)
     {
-    m_AImage[i].resize(m_NbVar);
+    m_AImage[i].resize(m_NbVar*m_BulkSize);
     m_VParser[i]->SetExpr(m_Expression);
 
     for(j=0; j < nbInputImages; ++j)
       {
-      m_VParser[i]->DefineVar(m_VVarName[j], &(m_AImage[i][j]));
+      m_VParser[i]->DefineVar(m_VVarName[j], &(m_AImage[i][j*m_BulkSize]));
       }
 
     for(j=nbInputImages; j < nbInputImages+nbAccessIndex; ++j)
       {
       m_VVarName[j] = tmpIdxVarNames[j-nbInputImages];
-      m_VParser[i]->DefineVar(m_VVarName[j], &(m_AImage[i][j]));
+      m_VParser[i]->DefineVar(m_VVarName[j], &(m_AImage[i][j*m_BulkSize]));
       }
     }
 }
@@ -249,7 +258,6 @@ void BandMathImageFilter<TImage>
 ::ThreadedGenerateData(const ImageRegionType& outputRegionForThread,
            itk::ThreadIdType threadId)
 {
-  double value;
   unsigned int j;
   unsigned int nbInputImages = this->GetNumberOfInputs();
 
@@ -273,62 +281,75 @@ void BandMathImageFilter<TImage>
   long                     & threadUnderflow = m_ThreadUnderflow[threadId];
   long                     & threadOverflow  = m_ThreadOverflow[threadId];
   ImageRegionConstIteratorType & firstImageRegion = Vit.front(); // alias for better perfs
+  const unsigned int         bulkSize        = m_BulkSize;
+  std::vector<double>        values(bulkSize);
+
   while(!firstImageRegion.IsAtEnd())
-     {
-     for(j=0; j < nbInputImages; ++j)
-       {
-       threadImage[j] = static_cast<double>(Vit[j].Get());
-       }
-
-    // Image Indexes
-    for(j=0; j < 2; ++j)
-      {
-      threadImage[nbInputImages+j]   = static_cast<double>(firstImageRegion.GetIndex()[j]);
-      }
-    for(j=0; j < 2; ++j)
+    {
+    // Variable j of the pixel n is stored at threadImage[j*bulkSize+n]
+    unsigned int n;
+    for(n=0; n < bulkSize && !firstImageRegion.IsAtEnd(); ++n)
       {
-      threadImage[nbInputImages+2+j] = static_cast<double>(m_Origin[j])
-        + static_cast<double>(firstImageRegion.GetIndex()[j]) * static_cast<double>(m_Spacing[j]);
+      const IndexType index = firstImageRegion.GetIndex();
+
+      for(j=0; j < nbInputImages; ++j)
+        {
+        threadImage[j*bulkSize+n] = static_cast<double>(Vit[j].Get());
+        }
+
+      // Image Indexes
+      for(j=0; j < 2; ++j)
+        {
+        threadImage[(nbInputImages+j)*bulkSize+n]   = static_cast<double>(index[j]);
+        }
+      for(j=0; j < 2; ++j)
+        {
+        threadImage[(nbInputImages+2+j)*bulkSize+n] = static_cast<double>(m_Origin[j])
+          + static_cast<double>(index[j]) * static_cast<double>(m_Spacing[j]);
+        }
+
+      for(j=0; j < nbInputImages; ++j)
+        {
+        ++Vit[j];
+        }
       }
 
     try
       {
-
-      value = threadParser->Eval();
+      threadParser->Eval(&(values[0]), n);
       }
     catch(itk::ExceptionObject& err)
       {
       itkExceptionMacro(<< err);
       }
 
-    // Case value is equal to -inf or inferior to the minimum value
-    // allowed by the pixelType cast
-    if (value < double(itk::NumericTraits<PixelType>::NonpositiveMin()))
-      {
-      ot.Set(itk::NumericTraits<PixelType>::NonpositiveMin());
-      threadUnderflow++;
-      }
-    // Case value is equal to inf or superior to the maximum value
-    // allowed by the pixelType cast
-    else if (value > double(itk::NumericTraits<PixelType>::max()))
-      {
-      ot.Set(itk::NumericTraits<PixelType>::max());
-      threadOverflow++;
-      }
-    else
-      {
-      ot.Set(static_cast<PixelType>(value));
-      }
-
-    for(j=0; j < nbInputImages; ++j)
+    for(unsigned int k=0; k < n; ++k)
       {
-      ++Vit[j];
+      const double value = values[k];
+
+      // Case value is equal to -inf or inferior to the minimum value
+      // allowed by the pixelType cast
+      if (value < double(itk::NumericTraits<PixelType>::NonpositiveMin()))
+        {
+        ot.Set(itk::NumericTraits<PixelType>::NonpositiveMin());
+        threadUnderflow++;
+        }
+      // Case value is equal to inf or superior to the maximum value
+      // allowed by the pixelType cast
+      else if (value > double(itk::NumericTraits<PixelType>::max()))
+        {
+        ot.Set(itk::NumericTraits<PixelType>::max());
+        threadOverflow++;
+        }
+      else
+        {
+        ot.Set(static_cast<PixelType>(value));
+        }
+
+      ++ot;
+
+      progress.CompletedPixel();
       }
-
-    ++ot;
-
-    progress.CompletedPixel();
-
     }
 }
 
@@ -69,6 +69,12 @@ public:
   /** Trigger the parsing */
   ValueType Eval();
 
+  /** Trigger the parsing on nBulkSize sets of variable values at once:
+   *  each variable points to an array of nBulkSize values, and results
+   *  receives the nBulkSize values of the expression. Only nBulkSize = 1
+   *  is available when OTB_MUPARSER_HAS_BULK_MODE is not defined. */
+  void Eval(ValueType * results, int nBulkSize);
+
   /** Define a variable */
   void DefineVar(const std::string &sName, ValueType *fVar);
 
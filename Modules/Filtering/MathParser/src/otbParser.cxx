@@ -96,6 +96,27 @@ public:
     return result;
   }
 
+  /** Trigger the parsing on arrays of variable values */
+  void Eval(ValueType * results, int nBulkSize)
+  {
+    try
+      {
+#ifdef OTB_MUPARSER_HAS_BULK_MODE
+      m_MuParser.Eval(results, nBulkSize);
+#else
+      if (nBulkSize != 1)
+        {
+        itkExceptionMacro(<< "Bulk evaluation requires muParser 2.2.4 or later.");
+        }
+      results[0] = m_MuParser.Eval();
+#endif
+      }
+    catch(ExceptionType &e)
+      {
+      ExceptionHandler(e);
+      }
+  }
+
 
   /** Define a variable */
   void DefineVar(const std::string &sName, ValueType *fVar)
@@ -254,6 +275,11 @@ Parser::ValueType Parser::Eval()
   return m_InternalParser->Eval();
 }
 
+void Parser::Eval(Parser::ValueType * results, int nBulkSize)
+{
+  m_InternalParser->Eval(results, nBulkSize);
+}
+
 void Parser::DefineVar(const std::string &sName, Parser::ValueType *fVar)
 {
   m_InternalParser->DefineVar(sName, fVar);
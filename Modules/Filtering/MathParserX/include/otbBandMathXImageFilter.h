@@ -29,6 +29,7 @@
 
 #include "otbStreamingStatisticsVectorImageFilter.h"
 #include "otbParserX.h"
+#include "otbCompiledExpressions.h"
 
 #include <vector>
 
@@ -52,6 +53,13 @@ namespace otb
  * If the jth input image is multidimensional, then the variable imj represents a vector whose components are related to its bands.
  * In order to access the kth band, the variable observes the following pattern : imjbk.
  *
+ * When all the expressions are scalar and only use pixel values, indices,
+ * constants and the operations supported by CompiledExpressions, they are
+ * compiled together and evaluated on whole scanlines, instead of calling
+ * muParserX for each pixel. The compiled expressions are checked against
+ * muParserX on a few probe values before being used; muParserX is used
+ * whenever this check fails. See SetUseCompiledExpressions().
+ *
  * \sa Parser
  *
  * \ingroup Streamed
@@ -129,6 +137,14 @@ public:
   /** Return the variable and constant names */
   std::vector<std::string> GetVarNames() const;
 
+  /** Allow the compiled evaluation of the expressions (default is true) */
+  void SetUseCompiledExpressions(bool flag);
+  bool GetUseCompiledExpressions() const;
+
+  /** Return true if the expressions are evaluated by the compiled
+   *  expressions (only meaningful after UpdateOutputInformation()) */
+  bool IsCompiledEvaluation() const;
+
 
 protected :
   BandMathXImageFilter();
@@ -165,6 +181,8 @@ private :
   void PrepareParsers();
   void PrepareParsersGlobStats();
   void OutputsDimensions();
+  void PrepareCompiledExpressions();
+  void CompiledThreadedGenerateData(const ImageRegionType& outputRegionForThread, itk::ThreadIdType threadId);
 
   std::vector<std::string>                  m_Expression;
   std::vector< std::vector<ParserType::Pointer> > m_VParser;
@@ -190,6 +208,11 @@ private :
 
   bool                                  m_ManyExpressions;
 
+  bool                                  m_UseCompiledExpressions;
+  bool                                  m_CompiledEvaluation;
+  CompiledExpressions::Pointer          m_CompiledExpressions;
+  std::vector< int >                    m_CompiledVarIndex; // index of each m_VVarName variable in m_CompiledExpressions (-1 for constants)
+
 };
 
 }//end namespace otb
@@ -32,7 +32,9 @@
 #include "itkNumericTraits.h"
 #include "itkProgressReporter.h"
 #include "otbMacro.h"
+#include "vnl/vnl_math.h"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <string>
@@ -70,6 +72,9 @@ BandMathXImageFilter<TImage>
   
   m_ManyExpressions = true;
 
+  m_UseCompiledExpressions = true;
+  m_CompiledEvaluation = false;
+
 }
 
 /** Destructor */
@@ -230,6 +235,31 @@ void BandMathXImageFilter<TImage>
     m_ManyExpressions = flag;
 }
 
+template< typename TImage >
+void BandMathXImageFilter<TImage>
+::SetUseCompiledExpressions(bool flag)
+{
+  if (m_UseCompiledExpressions != flag)
+    {
+    m_UseCompiledExpressions = flag;
+    this->Modified();
+    }
+}
+
+template< typename TImage >
+bool BandMathXImageFilter<TImage>
+::GetUseCompiledExpressions() const
+{
+  return m_UseCompiledExpressions;
+}
+
+template< typename TImage >
+bool BandMathXImageFilter<TImage>
+::IsCompiledEvaluation() const
+{
+  return m_CompiledEvaluation;
+}
+
 template< typename TImage >
 void BandMathXImageFilter<TImage>
 ::SetExpression(const std::string& expression)
@@ -880,6 +910,117 @@ void BandMathXImageFilter< TImage >
 
 }
 
+template< typename TImage >
+void BandMathXImageFilter< TImage >
+::PrepareCompiledExpressions()
+{
+  m_CompiledEvaluation = false;
+  m_CompiledVarIndex.clear();
+
+  if (!m_UseCompiledExpressions)
+    return;
+
+  // Only scalar outputs can be compiled
+  for(unsigned int i=0; i<m_outputsDimensions.size(); ++i)
+    if (m_outputsDimensions[i] != 1)
+      return;
+
+  m_CompiledExpressions = CompiledExpressions::New();
+
+  // Per-pixel scalars become variables, everything that stays constant
+  // during the update is folded into the compiled expressions
+  std::vector<adhocStruct> & vars = m_AImage[0];
+  m_CompiledVarIndex.resize(vars.size(),-1);
+  for(unsigned int j=0; j<vars.size(); ++j)
+    {
+    switch (vars[j].type)
+      {
+      case 0 : //idxX
+      case 1 : //idxY
+      case 5 : //pixel
+        m_CompiledVarIndex[j] = m_CompiledExpressions->DefineVar(vars[j].name);
+      break;
+
+      case 2 : //Spacing X (imiPhyX)
+      case 3 : //Spacing Y (imiPhyY)
+      case 8 : //global stats
+        m_CompiledExpressions->DefineConst(vars[j].name, vars[j].value.GetFloat());
+      break;
+
+      case 7 : //user defined constant or matrix
+        if ( (vars[j].value.GetType() != 'i') && (vars[j].value.GetType() != 'f') )
+          return;
+        m_CompiledExpressions->DefineConst(vars[j].name, vars[j].value.GetFloat());
+      break;
+
+      default : //vectors and neighborhoods
+        return;
+      }
+    }
+
+  if (!m_CompiledExpressions->Compile(m_Expression))
+    return;
+
+  // Check the compiled expressions against muParserX on probe values
+  const unsigned int nbProbes = 4;
+  const unsigned int nbExpr = m_Expression.size();
+  const unsigned int nbCompiledVar = m_CompiledExpressions->GetNumberOfVariables();
+
+  std::vector< std::vector<double> > probes(nbCompiledVar, std::vector<double>(nbProbes));
+  for(unsigned int v=0; v<nbCompiledVar; ++v)
+    {
+    probes[v][0] = 1.0 + 0.25 * v;
+    probes[v][1] = 17.5 - 0.5 * v;
+    probes[v][2] = -3.0 - v;
+    probes[v][3] = 0.0;
+    }
+  std::vector< std::vector<double> > results(nbExpr, std::vector<double>(nbProbes));
+
+  std::vector<const double *> varPtrs(nbCompiledVar+1);
+  for(unsigned int v=0; v<nbCompiledVar; ++v)
+    varPtrs[v] = &(probes[v][0]);
+  std::vector<double *> outPtrs(nbExpr);
+  for(unsigned int e=0; e<nbExpr; ++e)
+    outPtrs[e] = &(results[e][0]);
+
+  CompiledExpressions::WorkspaceType workspace;
+  m_CompiledExpressions->Evaluate(&(varPtrs[0]), &(outPtrs[0]), nbProbes, workspace);
+
+  try
+    {
+    for(unsigned int p=0; p<nbProbes; ++p)
+      {
+      for(unsigned int j=0; j<vars.size(); ++j)
+        if (m_CompiledVarIndex[j] >= 0)
+          vars[j].value = probes[m_CompiledVarIndex[j]][p];
+
+      for(unsigned int e=0; e<nbExpr; ++e)
+        {
+        const mup::IValue & value = m_VParser[0][e]->EvalRef();
+        if ( (value.GetType() != 'i') && (value.GetType() != 'f') )
+          return;
+
+        const double expected = value.GetFloat();
+        const double result = results[e][p];
+        const bool bothNaN = vnl_math_isnan(expected) && vnl_math_isnan(result);
+        if ( !bothNaN && (expected != result)
+             && !(vcl_abs(expected-result) <= 1E-12 * std::max(vcl_abs(expected),vcl_abs(result))) )
+          {
+          otbMsgDevMacro(<< "Compiled expression " << m_Expression[e] << " gives " << result
+                         << " instead of " << expected << ": using muParserX");
+          return;
+          }
+        }
+      }
+    }
+  catch(itk::ExceptionObject &)
+    {
+    return;
+    }
+
+  m_CompiledEvaluation = true;
+}
+
 template< typename TImage >
 void BandMathXImageFilter< TImage >
 ::CheckImageDimensions(void)
@@ -916,6 +1057,7 @@ void BandMathXImageFilter< TImage >
   if (globalStatsDetected())
     PrepareParsersGlobStats();
   OutputsDimensions();
+  PrepareCompiledExpressions();
 
 
   typedef itk::ImageBase< TImage::ImageDimension > ImageBaseType;
@@ -1045,6 +1187,12 @@ void BandMathXImageFilter<TImage>
            itk::ThreadIdType threadId)
 {
 
+  if (m_CompiledEvaluation)
+    {
+    CompiledThreadedGenerateData(outputRegionForThread, threadId);
+    return;
+    }
+
   ValueType value;
   unsigned int nbInputImages = this->GetNumberOfInputs();
 
@@ -1245,6 +1393,125 @@ void BandMathXImageFilter<TImage>
 
 }
 
+template< typename TImage >
+void BandMathXImageFilter<TImage>
+::CompiledThreadedGenerateData(const ImageRegionType& outputRegionForThread,
+           itk::ThreadIdType threadId)
+{
+  unsigned int nbInputImages = this->GetNumberOfInputs();
+  const unsigned int nbExpr = m_Expression.size();
+  const unsigned int nbCompiledVar = m_CompiledExpressions->GetNumberOfVariables();
+  const unsigned int lineLength = outputRegionForThread.GetSize(0);
+
+  typedef itk::ImageScanlineConstIterator<TImage> ImageScanlineConstIteratorType;
+  typedef itk::ImageScanlineIterator<TImage> ImageScanlineIteratorType;
+  std::vector< ImageScanlineConstIteratorType > Vit(nbInputImages);
+  for(unsigned int j=0; j < nbInputImages; ++j)
+    Vit[j] = ImageScanlineConstIteratorType (this->GetNthInput(j), outputRegionForThread);
+
+  std::vector< ImageScanlineIteratorType > VoutIt(nbExpr);
+  for(unsigned int j=0; j < nbExpr; ++j)
+    VoutIt[j] = ImageScanlineIteratorType (this->GetOutput(j), outputRegionForThread);
+
+  // Support progress methods/callbacks
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  // One scanline of values per variable and per expression (struct of arrays)
+  std::vector< std::vector<double> > varLines(nbCompiledVar, std::vector<double>(lineLength));
+  std::vector< std::vector<double> > outLines(nbExpr, std::vector<double>(lineLength));
+  std::vector<const double *> varPtrs(nbCompiledVar+1);
+  for(unsigned int v=0; v<nbCompiledVar; ++v)
+    varPtrs[v] = &(varLines[v][0]);
+  std::vector<double *> outPtrs(nbExpr);
+  for(unsigned int e=0; e<nbExpr; ++e)
+    outPtrs[e] = &(outLines[e][0]);
+
+  CompiledExpressions::WorkspaceType workspace;
+  PixelType outPixel(1);
+
+  const double minValue = double(itk::NumericTraits<PixelValueType>::NonpositiveMin());
+  const double maxValue = double(itk::NumericTraits<PixelValueType>::max());
+
+  for(unsigned int j=0; j < nbInputImages; ++j)  {  Vit[j].GoToBegin();     }
+  for(unsigned int j=0; j < nbExpr; ++j)         {  VoutIt[j].GoToBegin();  }
+
+  while(!Vit[0].IsAtEnd()) // For each line
+    {
+    const IndexType lineIndex = Vit[0].GetIndex();
+
+    //----------------- Variable affectations -----------------//
+    for(unsigned int j=0; j < m_VVarName.size(); ++j)
+      {
+      if (m_CompiledVarIndex[j] < 0)
+        continue;
+
+      double * line = &(varLines[m_CompiledVarIndex[j]][0]);
+      switch (m_VVarName[j].type)
+        {
+        case 0 : //idxX
+          for(unsigned int k=0; k<lineLength; ++k)
+            line[k] = static_cast<double>(lineIndex[0] + k);
+        break;
+
+        case 1 : //idxY
+          std::fill(line, line+lineLength, static_cast<double>(lineIndex[1]));
+        break;
+
+        case 5 : //pixel
+          {
+          // m_VVarName[j].info[0] : Input image #ID
+          // m_VVarName[j].info[1] : Band #ID
+          ImageScanlineConstIteratorType it = Vit[m_VVarName[j].info[0]];
+          const unsigned int band = m_VVarName[j].info[1];
+          for(unsigned int k=0; k<lineLength; ++k, ++it)
+            line[k] = static_cast<double>(it.Get()[band]);
+          }
+        break;
+
+        default :
+          itkExceptionMacro(<< "Type of the variable can not be compiled");
+        break;
+        }
+      }
+
+    //----------------- Evaluations -----------------//
+    m_CompiledExpressions->Evaluate(&(varPtrs[0]), &(outPtrs[0]), lineLength, workspace);
+
+    //----------------- Pixel affectations -----------------//
+    for(unsigned int e=0; e<nbExpr; ++e)
+      {
+      const double * line = outPtrs[e];
+      for(unsigned int k=0; k<lineLength; ++k)
+        {
+        // Case value is equal to -inf or inferior to the minimum value
+        // allowed by the PixelValueType cast
+        if (line[k] < minValue)
+          {
+          outPixel[0] = itk::NumericTraits<PixelValueType>::NonpositiveMin();
+          m_ThreadUnderflow[threadId]++;
+          }
+        // Case value is equal to inf or superior to the maximum value
+        // allowed by the PixelValueType cast
+        else if (line[k] > maxValue)
+          {
+          outPixel[0] = itk::NumericTraits<PixelValueType>::max();
+          m_ThreadOverflow[threadId]++;
+          }
+        else
+          {
+          outPixel[0] = static_cast<PixelValueType>(line[k]);
+          }
+        VoutIt[e].Set(outPixel);
+        ++VoutIt[e];
+        }
+      VoutIt[e].NextLine();
+      }
+
+    for(unsigned int j=0; j < nbInputImages; ++j)  {   Vit[j].NextLine();    }
+    for(unsigned int k=0; k<lineLength; ++k)       {   progress.CompletedPixel(); }
+    }
+}
+
 }// end namespace otb
 
 #endif
@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbCompiledExpressions_h
+#define otbCompiledExpressions_h
+
+#include "itkLightObject.h"
+#include "itkObjectFactory.h"
+#include "itkIntTypes.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace otb
+{
+
+/** \class CompiledExpressions
+ * \brief Vectorized evaluator for a set of scalar expressions.
+ *
+ * This class compiles a set of scalar expressions written with the
+ * muParserX syntax into a single linear program, and evaluates it on
+ * blocks of pixels stored in struct-of-arrays form (one contiguous
+ * array of values per variable and per expression).
+ *
+ * Compilation performs constant folding (constants declared with
+ * DefineConst are folded as well) and common subexpression
+ * elimination across all the expressions of the set: an identical
+ * subexpression is only computed once per pixel, whatever the
+ * expression it belongs to.
+ *
+ * Only a scalar subset of the muParserX grammar is supported: numbers,
+ * variables and constants, the operators + - * / ^, unary signs,
+ * comparisons, && and ||, the ternary ?: operator and the functions
+ * sin, cos, tan, asin, acos, atan, sinh, cosh, tanh, exp, log, ln,
+ * log10, sqrt, abs and ndvi. Compile() returns false for any other
+ * construct (vectors, matrices, other functions...), so that callers
+ * can fall back to ParserX.
+ *
+ * Operations are evaluated in the same order and with the same
+ * floating point functions as muParserX, so that results match the
+ * ones of ParserX.
+ *
+ * Once compiled, Evaluate() is const and can be called concurrently
+ * from several threads, each one using its own workspace.
+ *
+ * \sa ParserX
+ * \sa BandMathXImageFilter
+ *
+ * \ingroup OTBMathParserX
+ */
+class ITK_EXPORT CompiledExpressions : public itk::LightObject
+{
+public:
+  /** Standard class typedefs. */
+  typedef CompiledExpressions                      Self;
+  typedef itk::LightObject                         Superclass;
+  typedef itk::SmartPointer<Self>                  Pointer;
+  typedef itk::SmartPointer<const Self>            ConstPointer;
+
+  /** New macro for creation of through a Smart Pointer */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods) */
+  itkTypeMacro(CompiledExpressions, itk::LightObject);
+
+  /** Convenient type definitions */
+  typedef double                                   ValueType;
+  typedef std::vector<ValueType>                   WorkspaceType;
+
+  /** Number of pixels processed at once by the evaluator */
+  itkStaticConstMacro(BlockSize, unsigned int, 256);
+
+  /** Define a variable, and return its index in the arrays given to
+   *  Evaluate() */
+  unsigned int DefineVar(const std::string & name);
+
+  /** Define a constant (folded at compile time) */
+  void DefineConst(const std::string & name, ValueType value);
+
+  /** Remove all the variables, user constants and compiled expressions */
+  void Clear();
+
+  /** Compile a set of expressions. Return false if one of them uses a
+   *  construct which is not supported. */
+  bool Compile(const std::vector<std::string> & expressions);
+
+  /** Return true if a set of expressions has been successfully compiled */
+  bool IsCompiled() const
+  {
+    return m_Compiled;
+  }
+
+  /** Return the number of variables */
+  unsigned int GetNumberOfVariables() const
+  {
+    return static_cast<unsigned int>(m_VariableNames.size());
+  }
+
+  /** Return the number of expressions compiled */
+  unsigned int GetNumberOfExpressions() const
+  {
+    return static_cast<unsigned int>(m_Outputs.size());
+  }
+
+  /** Return the number of operations evaluated for each pixel (after
+   *  constant folding and common subexpression elimination) */
+  unsigned int GetNumberOfOperations() const
+  {
+    return static_cast<unsigned int>(m_Program.size());
+  }
+
+  /** Evaluate the compiled expressions on count pixels.
+   *  variables[v] points to the count values of the variable #v, and
+   *  outputs[e] to the count values to write for the expression #e.
+   *  The workspace holds the temporaries and must not be shared between
+   *  threads. */
+  void Evaluate(const ValueType * const * variables,
+                ValueType * const * outputs,
+                unsigned int count,
+                WorkspaceType & workspace) const;
+
+protected:
+  CompiledExpressions();
+  ~CompiledExpressions() ITK_OVERRIDE {}
+  void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
+
+private:
+  CompiledExpressions(const Self &);   //purposely not implemented
+  void operator =(const Self &);       //purposely not implemented
+
+  /** Define the constants known by ParserX */
+  void InitConst();
+
+  class ExpressionReader;
+  friend class ExpressionReader;
+
+  /** Node of the expression graph. Leaves are constants or variables,
+   *  other nodes are operations on up to three previous nodes. */
+  struct NodeType
+  {
+    int          op;
+    int          args[3];
+    ValueType    value;
+    unsigned int variable;
+  };
+
+  /** Return the node computing op(args), after constant folding and
+   *  lookup of an identical node */
+  int MakeNode(int op, int a0, int a1 = -1, int a2 = -1);
+  int MakeConstant(ValueType value);
+  int MakeVariable(unsigned int variable);
+
+  /** Apply an operation on count values */
+  static void Apply(int op, const ValueType * const * args,
+                    ValueType * out, unsigned int count);
+
+  std::vector<std::string>                 m_VariableNames;
+  std::map<std::string, ValueType>         m_Constants;
+
+  std::vector<NodeType>                    m_Nodes;
+  std::map<std::vector<itk::int64_t>, int> m_NodeLookup;
+  std::vector<int>                         m_Program;
+  std::vector<int>                         m_Outputs;
+  bool                                     m_Compiled;
+}; // end class
+
+}//end namespace otb
+
+#endif
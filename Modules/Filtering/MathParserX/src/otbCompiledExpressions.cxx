@@ -0,0 +1,760 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbCompiledExpressions.h"
+#include "otbMath.h"
+#include "otbMacro.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace otb
+{
+
+namespace
+{
+/** Operations of the expression graph */
+enum
+{
+  OpConstant, OpVariable,
+  OpAdd, OpSub, OpMul, OpDiv, OpPow, OpNeg,
+  OpLT, OpLE, OpGT, OpGE, OpEQ, OpNE, OpAnd, OpOr, OpIf,
+  OpSin, OpCos, OpTan, OpASin, OpACos, OpATan,
+  OpSinh, OpCosh, OpTanh, OpExp, OpLog, OpLog10, OpSqrt, OpAbs,
+  OpNdvi
+};
+
+/** Supported functions, with their number of arguments */
+struct FunctionDefinition
+{
+  const char * name;
+  int          op;
+  unsigned int nbArgs;
+};
+
+const FunctionDefinition Functions[] =
+{
+  {"sin",   OpSin,   1},
+  {"cos",   OpCos,   1},
+  {"tan",   OpTan,   1},
+  {"asin",  OpASin,  1},
+  {"acos",  OpACos,  1},
+  {"atan",  OpATan,  1},
+  {"sinh",  OpSinh,  1},
+  {"cosh",  OpCosh,  1},
+  {"tanh",  OpTanh,  1},
+  {"exp",   OpExp,   1},
+  {"log",   OpLog,   1},
+  {"ln",    OpLog,   1},
+  {"log10", OpLog10, 1},
+  {"sqrt",  OpSqrt,  1},
+  {"abs",   OpAbs,   1},
+  {"ndvi",  OpNdvi,  2}
+};
+
+/** Binary operators, from the lowest to the highest precedence (the
+ *  longest symbols of a level come first) */
+struct OperatorDefinition
+{
+  const char * symbol;
+  int          op;
+};
+
+const OperatorDefinition OperatorsOr[]  = { {"||", OpOr}, {NULL, 0} };
+const OperatorDefinition OperatorsAnd[] = { {"&&", OpAnd}, {NULL, 0} };
+const OperatorDefinition OperatorsEq[]  = { {"==", OpEQ}, {"!=", OpNE}, {NULL, 0} };
+const OperatorDefinition OperatorsRel[] = { {"<=", OpLE}, {">=", OpGE},
+                                            {"<", OpLT}, {">", OpGT}, {NULL, 0} };
+const OperatorDefinition OperatorsAdd[] = { {"+", OpAdd}, {"-", OpSub}, {NULL, 0} };
+const OperatorDefinition OperatorsMul[] = { {"*", OpMul}, {"/", OpDiv}, {NULL, 0} };
+
+const OperatorDefinition * const BinaryOperators[] =
+{
+  OperatorsOr, OperatorsAnd, OperatorsEq, OperatorsRel, OperatorsAdd, OperatorsMul
+};
+
+const unsigned int NumberOfBinaryLevels = sizeof(BinaryOperators) / sizeof(BinaryOperators[0]);
+
+} // end anonymous namespace
+
+
+/** \class CompiledExpressions::ExpressionReader
+ * Recursive descent reader building the expression graph of one
+ * expression. All the methods return the index of the node read, or
+ * -1 if the expression can not be compiled.
+ */
+class CompiledExpressions::ExpressionReader
+{
+public:
+  ExpressionReader(CompiledExpressions & owner, const std::string & expression)
+    : m_Owner(owner), m_Expression(expression), m_Position(0)
+  {
+  }
+
+  int Read()
+  {
+    int root = ReadTernary();
+    SkipSpaces();
+    if (m_Position != m_Expression.size())
+      {
+      return -1;
+      }
+    return root;
+  }
+
+private:
+  void SkipSpaces()
+  {
+    while (m_Position < m_Expression.size()
+           && std::isspace(static_cast<unsigned char>(m_Expression[m_Position])))
+      {
+      ++m_Position;
+      }
+  }
+
+  bool Accept(const char * symbol)
+  {
+    SkipSpaces();
+    const size_t length = std::strlen(symbol);
+    if (m_Expression.compare(m_Position, length, symbol) == 0)
+      {
+      m_Position += length;
+      return true;
+      }
+    return false;
+  }
+
+  int ReadTernary()
+  {
+    int condition = ReadBinary(0);
+    if (condition < 0 || !Accept("?"))
+      {
+      return condition;
+      }
+    int ifTrue = ReadTernary();
+    if (ifTrue < 0 || !Accept(":"))
+      {
+      return -1;
+      }
+    int ifFalse = ReadTernary();
+    if (ifFalse < 0)
+      {
+      return -1;
+      }
+    return m_Owner.MakeNode(OpIf, condition, ifTrue, ifFalse);
+  }
+
+  int ReadBinary(unsigned int level)
+  {
+    if (level == NumberOfBinaryLevels)
+      {
+      return ReadUnary();
+      }
+
+    int left = ReadBinary(level + 1);
+    while (left >= 0)
+      {
+      const OperatorDefinition * oprt = BinaryOperators[level];
+      while (oprt->symbol != NULL && !Accept(oprt->symbol))
+        {
+        ++oprt;
+        }
+      if (oprt->symbol == NULL)
+        {
+        break;
+        }
+      int right = ReadBinary(level + 1);
+      if (right < 0)
+        {
+        return -1;
+        }
+      left = m_Owner.MakeNode(oprt->op, left, right);
+      }
+    return left;
+  }
+
+  // Signs have a lower precedence than the power operator: -a^b = -(a^b)
+  int ReadUnary()
+  {
+    if (Accept("-"))
+      {
+      int arg = ReadUnary();
+      return (arg < 0) ? -1 : m_Owner.MakeNode(OpNeg, arg);
+      }
+    if (Accept("+"))
+      {
+      return ReadUnary();
+      }
+    return ReadPower();
+  }
+
+  // The power operator is right associative: a^b^c = a^(b^c)
+  int ReadPower()
+  {
+    int base = ReadPrimary();
+    if (base < 0 || !Accept("^"))
+      {
+      return base;
+      }
+    int exponent = ReadUnary();
+    return (exponent < 0) ? -1 : m_Owner.MakeNode(OpPow, base, exponent);
+  }
+
+  int ReadPrimary()
+  {
+    SkipSpaces();
+    if (m_Position == m_Expression.size())
+      {
+      return -1;
+      }
+
+    if (Accept("("))
+      {
+      int inner = ReadTernary();
+      return (inner < 0 || !Accept(")")) ? -1 : inner;
+      }
+
+    const char c = m_Expression[m_Position];
+    if (std::isdigit(static_cast<unsigned char>(c)) || c == '.')
+      {
+      return ReadNumber();
+      }
+    if (std::isalpha(static_cast<unsigned char>(c)) || c == '_')
+      {
+      return ReadName();
+      }
+    return -1;
+  }
+
+  int ReadNumber()
+  {
+    const size_t start = m_Position;
+    SkipDigits();
+    if (m_Position < m_Expression.size() && m_Expression[m_Position] == '.')
+      {
+      ++m_Position;
+      SkipDigits();
+      }
+    if (m_Position < m_Expression.size()
+        && (m_Expression[m_Position] == 'e' || m_Expression[m_Position] == 'E'))
+      {
+      size_t exponent = m_Position + 1;
+      if (exponent < m_Expression.size()
+          && (m_Expression[exponent] == '+' || m_Expression[exponent] == '-'))
+        {
+        ++exponent;
+        }
+      if (exponent < m_Expression.size()
+          && std::isdigit(static_cast<unsigned char>(m_Expression[exponent])))
+        {
+        m_Position = exponent;
+        SkipDigits();
+        }
+      }
+
+    const std::string literal = m_Expression.substr(start, m_Position - start);
+    char * end = NULL;
+    const ValueType value = std::strtod(literal.c_str(), &end);
+    if (literal == "." || end != literal.c_str() + literal.size())
+      {
+      return -1;
+      }
+    return m_Owner.MakeConstant(value);
+  }
+
+  void SkipDigits()
+  {
+    while (m_Position < m_Expression.size()
+           && std::isdigit(static_cast<unsigned char>(m_Expression[m_Position])))
+      {
+      ++m_Position;
+      }
+  }
+
+  int ReadName()
+  {
+    const size_t start = m_Position;
+    while (m_Position < m_Expression.size()
+           && (std::isalnum(static_cast<unsigned char>(m_Expression[m_Position]))
+               || m_Expression[m_Position] == '_'))
+      {
+      ++m_Position;
+      }
+    const std::string name = m_Expression.substr(start, m_Position - start);
+
+    if (Accept("("))
+      {
+      return ReadFunction(name);
+      }
+
+    std::vector<std::string>::const_iterator var =
+      std::find(m_Owner.m_VariableNames.begin(), m_Owner.m_VariableNames.end(), name);
+    if (var != m_Owner.m_VariableNames.end())
+      {
+      return m_Owner.MakeVariable(static_cast<unsigned int>(var - m_Owner.m_VariableNames.begin()));
+      }
+
+    std::map<std::string, ValueType>::const_iterator cst = m_Owner.m_Constants.find(name);
+    if (cst != m_Owner.m_Constants.end())
+      {
+      return m_Owner.MakeConstant(cst->second);
+      }
+    return -1;
+  }
+
+  int ReadFunction(const std::string & name)
+  {
+    const FunctionDefinition * fun = NULL;
+    for (unsigned int i = 0; i < sizeof(Functions) / sizeof(Functions[0]); ++i)
+      {
+      if (name == Functions[i].name)
+        {
+        fun = &Functions[i];
+        }
+      }
+    if (fun == NULL)
+      {
+      return -1;
+      }
+
+    int args[2] = {-1, -1};
+    for (unsigned int i = 0; i < fun->nbArgs; ++i)
+      {
+      if (i > 0 && !Accept(","))
+        {
+        return -1;
+        }
+      args[i] = ReadTernary();
+      if (args[i] < 0)
+        {
+        return -1;
+        }
+      }
+    if (!Accept(")"))
+      {
+      return -1;
+      }
+    return m_Owner.MakeNode(fun->op, args[0], args[1]);
+  }
+
+  CompiledExpressions & m_Owner;
+  const std::string &   m_Expression;
+  size_t                m_Position;
+};
+
+
+CompiledExpressions::CompiledExpressions()
+  : m_Compiled(false)
+{
+  InitConst();
+}
+
+void CompiledExpressions::InitConst()
+{
+  // Constants of the muParserX non complex package
+  m_Constants["pi"] = CONST_PI;
+  m_Constants["e"]  = CONST_E;
+
+  // Constants defined by ParserX
+  m_Constants["log2e"]  = CONST_LOG2E;
+  m_Constants["log10e"] = CONST_LOG10E;
+  m_Constants["ln2"]    = CONST_LN2;
+  m_Constants["ln10"]   = CONST_LN10;
+  m_Constants["euler"]  = CONST_EULER;
+}
+
+unsigned int CompiledExpressions::DefineVar(const std::string & name)
+{
+  std::vector<std::string>::const_iterator it =
+    std::find(m_VariableNames.begin(), m_VariableNames.end(), name);
+  if (it != m_VariableNames.end())
+    {
+    return static_cast<unsigned int>(it - m_VariableNames.begin());
+    }
+  m_VariableNames.push_back(name);
+  m_Compiled = false;
+  return static_cast<unsigned int>(m_VariableNames.size() - 1);
+}
+
+void CompiledExpressions::DefineConst(const std::string & name, ValueType value)
+{
+  m_Constants[name] = value;
+  m_Compiled = false;
+}
+
+void CompiledExpressions::Clear()
+{
+  m_VariableNames.clear();
+  m_Constants.clear();
+  InitConst();
+
+  m_Nodes.clear();
+  m_NodeLookup.clear();
+  m_Program.clear();
+  m_Outputs.clear();
+  m_Compiled = false;
+}
+
+int CompiledExpressions::MakeConstant(ValueType value)
+{
+  NodeType node;
+  node.op = OpConstant;
+  node.args[0] = node.args[1] = node.args[2] = -1;
+  node.value = value;
+  node.variable = 0;
+
+  itk::int64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  std::vector<itk::int64_t> key(2);
+  key[0] = OpConstant;
+  key[1] = bits;
+
+  std::map<std::vector<itk::int64_t>, int>::const_iterator it = m_NodeLookup.find(key);
+  if (it != m_NodeLookup.end())
+    {
+    return it->second;
+    }
+  m_Nodes.push_back(node);
+  m_NodeLookup[key] = static_cast<int>(m_Nodes.size() - 1);
+  return static_cast<int>(m_Nodes.size() - 1);
+}
+
+int CompiledExpressions::MakeVariable(unsigned int variable)
+{
+  NodeType node;
+  node.op = OpVariable;
+  node.args[0] = node.args[1] = node.args[2] = -1;
+  node.value = 0.;
+  node.variable = variable;
+
+  std::vector<itk::int64_t> key(2);
+  key[0] = OpVariable;
+  key[1] = variable;
+
+  std::map<std::vector<itk::int64_t>, int>::const_iterator it = m_NodeLookup.find(key);
+  if (it != m_NodeLookup.end())
+    {
+    return it->second;
+    }
+  m_Nodes.push_back(node);
+  m_NodeLookup[key] = static_cast<int>(m_Nodes.size() - 1);
+  return static_cast<int>(m_Nodes.size() - 1);
+}
+
+int CompiledExpressions::MakeNode(int op, int a0, int a1, int a2)
+{
+  // Addition and multiplication are exactly commutative: a+b and b+a
+  // share the same node
+  if ((op == OpAdd || op == OpMul) && a1 < a0)
+    {
+    std::swap(a0, a1);
+    }
+
+  // A condition known at compile time selects its branch
+  if (op == OpIf && m_Nodes[a0].op == OpConstant)
+    {
+    return (m_Nodes[a0].value != 0.) ? a1 : a2;
+    }
+
+  // Constant folding, with the same code as the evaluation
+  const int args[3] = {a0, a1, a2};
+  bool constant = true;
+  for (unsigned int i = 0; i < 3; ++i)
+    {
+    if (args[i] >= 0 && m_Nodes[args[i]].op != OpConstant)
+      {
+      constant = false;
+      }
+    }
+  if (constant)
+    {
+    const ValueType * values[3] = {NULL, NULL, NULL};
+    for (unsigned int i = 0; i < 3; ++i)
+      {
+      if (args[i] >= 0)
+        {
+        values[i] = &m_Nodes[args[i]].value;
+        }
+      }
+    ValueType result;
+    Apply(op, values, &result, 1);
+    return MakeConstant(result);
+    }
+
+  // Common subexpression elimination
+  std::vector<itk::int64_t> key(4);
+  key[0] = op;
+  key[1] = a0;
+  key[2] = a1;
+  key[3] = a2;
+
+  std::map<std::vector<itk::int64_t>, int>::const_iterator it = m_NodeLookup.find(key);
+  if (it != m_NodeLookup.end())
+    {
+    return it->second;
+    }
+
+  NodeType node;
+  node.op = op;
+  node.args[0] = a0;
+  node.args[1] = a1;
+  node.args[2] = a2;
+  node.value = 0.;
+  node.variable = 0;
+  m_Nodes.push_back(node);
+  m_NodeLookup[key] = static_cast<int>(m_Nodes.size() - 1);
+  return static_cast<int>(m_Nodes.size() - 1);
+}
+
+bool CompiledExpressions::Compile(const std::vector<std::string> & expressions)
+{
+  m_Nodes.clear();
+  m_NodeLookup.clear();
+  m_Program.clear();
+  m_Outputs.clear();
+  m_Compiled = false;
+
+  for (unsigned int i = 0; i < expressions.size(); ++i)
+    {
+    ExpressionReader reader(*this, expressions[i]);
+    int root = reader.Read();
+    if (root < 0)
+      {
+      otbMsgDevMacro(<< "Expression can not be compiled: " << expressions[i]);
+      m_Outputs.clear();
+      return false;
+      }
+    m_Outputs.push_back(root);
+    }
+
+  // Only keep the operations needed by the outputs (folding leaves
+  // unused nodes behind). Arguments of a node always come before it.
+  std::vector<bool> used(m_Nodes.size(), false);
+  for (unsigned int i = 0; i < m_Outputs.size(); ++i)
+    {
+    used[m_Outputs[i]] = true;
+    }
+  for (int n = static_cast<int>(m_Nodes.size()) - 1; n >= 0; --n)
+    {
+    if (used[n])
+      {
+      for (unsigned int i = 0; i < 3; ++i)
+        {
+        if (m_Nodes[n].args[i] >= 0)
+          {
+          used[m_Nodes[n].args[i]] = true;
+          }
+        }
+      }
+    }
+  for (unsigned int n = 0; n < m_Nodes.size(); ++n)
+    {
+    if (used[n] && m_Nodes[n].op != OpConstant && m_Nodes[n].op != OpVariable)
+      {
+      m_Program.push_back(n);
+      }
+    }
+
+  m_Compiled = true;
+  return true;
+}
+
+void CompiledExpressions::Evaluate(const ValueType * const * variables,
+                                   ValueType * const * outputs,
+                                   unsigned int count,
+                                   WorkspaceType & workspace) const
+{
+  if (!m_Compiled)
+    {
+    itkExceptionMacro(<< "No expression compiled.");
+    }
+
+  const unsigned int blockSize = BlockSize;
+  const unsigned int nbNodes = static_cast<unsigned int>(m_Nodes.size());
+  workspace.resize(nbNodes * blockSize);
+
+  // One block of values per node : constants are broadcast once,
+  // variables directly point to the input arrays
+  std::vector<const ValueType *> operands(nbNodes, NULL);
+  for (unsigned int n = 0; n < nbNodes; ++n)
+    {
+    operands[n] = &workspace[n * blockSize];
+    if (m_Nodes[n].op == OpConstant)
+      {
+      std::fill(workspace.begin() + n * blockSize,
+                workspace.begin() + (n + 1) * blockSize,
+                m_Nodes[n].value);
+      }
+    }
+
+  for (unsigned int start = 0; start < count; start += blockSize)
+    {
+    const unsigned int size = std::min(blockSize, count - start);
+
+    for (unsigned int n = 0; n < nbNodes; ++n)
+      {
+      if (m_Nodes[n].op == OpVariable)
+        {
+        operands[n] = variables[m_Nodes[n].variable] + start;
+        }
+      }
+
+    for (std::vector<int>::const_iterator it = m_Program.begin(); it != m_Program.end(); ++it)
+      {
+      const NodeType & node = m_Nodes[*it];
+      const ValueType * args[3] = {NULL, NULL, NULL};
+      for (unsigned int i = 0; i < 3; ++i)
+        {
+        if (node.args[i] >= 0)
+          {
+          args[i] = operands[node.args[i]];
+          }
+        }
+      Apply(node.op, args, &workspace[*it * blockSize], size);
+      }
+
+    for (unsigned int e = 0; e < m_Outputs.size(); ++e)
+      {
+      const ValueType * result = operands[m_Outputs[e]];
+      std::copy(result, result + size, outputs[e] + start);
+      }
+    }
+}
+
+void CompiledExpressions::Apply(int op, const ValueType * const * args,
+                                ValueType * out, unsigned int count)
+{
+  const ValueType * a = args[0];
+  const ValueType * b = args[1];
+  const ValueType * c = args[2];
+
+  switch (op)
+    {
+    case OpAdd:
+      for (unsigned int k = 0; k < count; ++k) out[k] = a[k] + b[k];
+      break;
+    case OpSub:
+      for (unsigned int k = 0; k < count; ++k) out[k] = a[k] - b[k];
+      break;
+    case OpMul:
+      for (unsigned int k = 0; k < count; ++k) out[k] = a[k] * b[k];
+      break;
+    case OpDiv:
+      for (unsigned int k = 0; k < count; ++k) out[k] = a[k] / b[k];
+      break;
+    case OpPow:
+      for (unsigned int k = 0; k < count; ++k) out[k] = std::pow(a[k], b[k]);
+      break;
+    case OpNeg:
+      for (unsigned int k = 0; k < count; ++k) out[k] = -a[k];
+      break;
+    case OpLT:
+      for (unsigned int k = 0; k < count; ++k) out[k] = (a[k] < b[k]) ? 1. : 0.;
+      break;
+    case OpLE:
+      for (unsigned int k = 0; k < count; ++k) out[k] = (a[k] <= b[k]) ? 1. : 0.;
+      break;
+    case OpGT:
+      for (unsigned int k = 0; k < count; ++k) out[k] = (a[k] > b[k]) ? 1. : 0.;
+      break;
+    case OpGE:
+      for (unsigned int k = 0; k < count; ++k) out[k] = (a[k] >= b[k]) ? 1. : 0.;
+      break;
+    case OpEQ:
+      for (unsigned int k = 0; k < count; ++k) out[k] = (a[k] == b[k]) ? 1. : 0.;
+      break;
+    case OpNE:
+      for (unsigned int k = 0; k < count; ++k) out[k] = (a[k] != b[k]) ? 1. : 0.;
+      break;
+    case OpAnd:
+      for (unsigned int k = 0; k < count; ++k) out[k] = (a[k] != 0. && b[k] != 0.) ? 1. : 0.;
+      break;
+    case OpOr:
+      for (unsigned int k = 0; k < count; ++k) out[k] = (a[k] != 0. || b[k] != 0.) ? 1. : 0.;
+      break;
+    case OpIf:
+      for (unsigned int k = 0; k < count; ++k) out[k] = (a[k] != 0.) ? b[k] : c[k];
+      break;
+    case OpSin:
+      for (unsigned int k = 0; k < count; ++k) out[k] = std::sin(a[k]);
+      break;
+    case OpCos:
+      for (unsigned int k = 0; k < count; ++k) out[k] = std::cos(a[k]);
+      break;
+    case OpTan:
+      for (unsigned int k = 0; k < count; ++k) out[k] = std::tan(a[k]);
+      break;
+    case OpASin:
+      for (unsigned int k = 0; k < count; ++k) out[k] = std::asin(a[k]);
+      break;
+    case OpACos:
+      for (unsigned int k = 0; k < count; ++k) out[k] = std::acos(a[k]);
+      break;
+    case OpATan:
+      for (unsigned int k = 0; k < count; ++k) out[k] = std::atan(a[k]);
+      break;
+    case OpSinh:
+      for (unsigned int k = 0; k < count; ++k) out[k] = std::sinh(a[k]);
+      break;
+    case OpCosh:
+      for (unsigned int k = 0; k < count; ++k) out[k] = std::cosh(a[k]);
+      break;
+    case OpTanh:
+      for (unsigned int k = 0; k < count; ++k) out[k] = std::tanh(a[k]);
+      break;
+    case OpExp:
+      for (unsigned int k = 0; k < count; ++k) out[k] = std::exp(a[k]);
+      break;
+    case OpLog:
+      for (unsigned int k = 0; k < count; ++k) out[k] = std::log(a[k]);
+      break;
+    case OpLog10:
+      for (unsigned int k = 0; k < count; ++k) out[k] = std::log10(a[k]);
+      break;
+    case OpSqrt:
+      for (unsigned int k = 0; k < count; ++k) out[k] = std::sqrt(a[k]);
+      break;
+    case OpAbs:
+      for (unsigned int k = 0; k < count; ++k) out[k] = std::abs(a[k]);
+      break;
+    case OpNdvi:
+      // Same as the ndvi function of ParserX : a = r, b = niri
+      for (unsigned int k = 0; k < count; ++k)
+        {
+        out[k] = (std::abs(a[k] + b[k]) < 1E-6) ? 0. : (b[k] - a[k]) / (b[k] + a[k]);
+        }
+      break;
+    default:
+      itkGenericExceptionMacro(<< "Unknown operation " << op);
+    }
+}
+
+void CompiledExpressions::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Number of variables: "   << m_VariableNames.size() << std::endl;
+  os << indent << "Number of expressions: " << m_Outputs.size()       << std::endl;
+  os << indent << "Number of operations: "  << m_Program.size()       << std::endl;
+}
+
+}//end namespace otb
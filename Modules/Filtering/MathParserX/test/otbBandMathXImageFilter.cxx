@@ -562,3 +562,101 @@ int otbBandMathXImageFilterWithIdx( int itkNotUsed(argc), char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+
+int otbBandMathXImageFilterCompiled( int itkNotUsed(argc), char* itkNotUsed(argv) [])
+{
+  typedef otb::VectorImage<double, 2>              ImageType;
+  typedef otb::BandMathXImageFilter<ImageType>      FilterType;
+
+  const unsigned int N = 100, D1=3, D2=1;
+
+  ImageType::SizeType size;
+  size.Fill(N);
+  ImageType::IndexType index;
+  index.Fill(0);
+  ImageType::RegionType region;
+  region.SetSize(size);
+  region.SetIndex(index);
+
+  ImageType::Pointer image1 = ImageType::New();
+  ImageType::Pointer image2 = ImageType::New();
+
+  image1->SetLargestPossibleRegion( region );
+  image1->SetBufferedRegion( region );
+  image1->SetRequestedRegion( region );
+  image1->SetNumberOfComponentsPerPixel(D1);
+  image1->Allocate();
+
+  image2->SetLargestPossibleRegion( region );
+  image2->SetBufferedRegion( region );
+  image2->SetRequestedRegion( region );
+  image2->SetNumberOfComponentsPerPixel(D2);
+  image2->Allocate();
+
+  typedef itk::ImageRegionIteratorWithIndex<ImageType> IteratorType;
+  IteratorType it1(image1, region);
+  IteratorType it2(image2, region);
+
+  ImageType::PixelType val1, val2;
+  val1.SetSize(D1);
+  val2.SetSize(D2);
+
+  for (it1.GoToBegin(), it2.GoToBegin(); !it1.IsAtEnd(); ++it1, ++it2)
+  {
+    ImageType::IndexType i1 = it1.GetIndex();
+
+    val1[0] = i1[0] + i1[1] -50;
+    val1[1] = i1[0] * i1[1] -50;
+    val1[2] = i1[0] / (i1[1]+1)+5;
+    val2[0] = i1[0] * 0.1 - i1[1];
+
+    it1.Set(val1);
+    it2.Set(val2);
+  }
+
+  // Same expressions, evaluated with and without compilation
+  FilterType::Pointer filters[2] = { FilterType::New(), FilterType::New() };
+  filters[1]->SetUseCompiledExpressions(false);
+
+  for (unsigned int f=0; f<2; ++f)
+  {
+    filters[f]->SetNthInput(0, image1);
+    filters[f]->SetNthInput(1, image2);
+    filters[f]->SetConstant("cst", 1.5);
+    filters[f]->SetExpression("ndvi(im1b1, im1b2) * 2 + im2b1");
+    filters[f]->SetExpression("im1b3 > 5 ? sqrt(abs(im1b1)) : (im1b1 + im1b2)^2 / (idxX + 1)");
+    filters[f]->SetExpression("(im1b2 + im1b1) * pi - idxY + cst * im1PhyX + im2b1Mean");
+    filters[f]->Update();
+  }
+
+  if (!filters[0]->IsCompiledEvaluation() || filters[1]->IsCompiledEvaluation())
+    itkGenericExceptionMacro(<< "Wrong evaluation mode.");
+
+  for (unsigned int e=0; e<3; ++e)
+  {
+    IteratorType itCompiled(filters[0]->GetOutput(e), region);
+    IteratorType itParser(filters[1]->GetOutput(e), region);
+
+    for (itCompiled.GoToBegin(), itParser.GoToBegin(); !itCompiled.IsAtEnd(); ++itCompiled, ++itParser)
+    {
+      double result = itCompiled.Get()[0], expected = itParser.Get()[0];
+      if ( (vcl_abs(result - expected) > 1E-12 * vcl_abs(expected))
+           && !(vnl_math_isnan(result) && vnl_math_isnan(expected)) )
+        itkGenericExceptionMacro(<< "Expression " << filters[0]->GetExpression(e)
+                                 << " at " << itCompiled.GetIndex() << " : compiled result = " << result
+                                 << ", muParserX result = " << expected);
+    }
+  }
+
+  // Neighborhoods are not compiled
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetNthInput(0, image1);
+  filter->SetExpression("vmax(im1b1N3x3)");
+  filter->UpdateOutputInformation();
+
+  if (filter->IsCompiledEvaluation())
+    itkGenericExceptionMacro(<< "Neighborhoods can not be compiled.");
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbMath.h"
+#include "otbParserX.h"
+#include "otbCompiledExpressions.h"
+
+typedef otb::CompiledExpressions CompiledExpressionsType;
+
+int otbCompiledExpressionsTestNew(int itkNotUsed(argc), char * itkNotUsed(argv) [])
+{
+  // Instantiating object
+  CompiledExpressionsType::Pointer compiled = CompiledExpressionsType::New();
+  std::cout << compiled << std::endl;
+  return EXIT_SUCCESS;
+}
+
+int otbCompiledExpressionsTest(int itkNotUsed(argc), char * itkNotUsed(argv) [])
+{
+  const unsigned int nbValues = 1000;
+
+  std::vector<std::string> expressions;
+  expressions.push_back("ndvi(b1, b2) * 2.5 + 2 * 3");
+  expressions.push_back("(b2 - b1) / (b2 + b1) > 0.2 ? sqrt(b1 + b2) : -b1^2");
+  expressions.push_back("(b1 + b2) + (b2 + b1) + x * pi - log10(100) + 2^3^2");
+  expressions.push_back("b1 >= 10 && b2 < 5 || x == 3 ? exp(-x / 100) : cos(b1) * ln10");
+
+  // Supported expressions : compiled results must be the ones of muParserX
+  CompiledExpressionsType::Pointer compiled = CompiledExpressionsType::New();
+  const unsigned int b1 = compiled->DefineVar("b1");
+  const unsigned int b2 = compiled->DefineVar("b2");
+  const unsigned int x  = compiled->DefineVar("x");
+
+  if (!compiled->Compile(expressions))
+    {
+    std::cout << "Compilation failed" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // The 4 expressions contain 34 operations before compilation. Folding
+  // 2*3, log10(100) and 2^3^2 removes 4 of them (30 left), and computing
+  // b1+b2 (or b2+b1) only once removes 3 more: 27 operations are left
+  std::cout << compiled << std::endl;
+  if (compiled->GetNumberOfOperations() != 27)
+    {
+    std::cout << "Wrong number of operations: " << compiled->GetNumberOfOperations() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  std::vector< std::vector<double> > variables(3, std::vector<double>(nbValues));
+  std::vector< std::vector<double> > outputs(expressions.size(), std::vector<double>(nbValues));
+  for (unsigned int i = 0; i < nbValues; ++i)
+    {
+    variables[b1][i] = 0.5 * i - 20.;
+    variables[b2][i] = (i % 7) * 3.;
+    variables[x][i] = i % 13;
+    }
+
+  const double * variablesPtr[3] = {&variables[0][0], &variables[1][0], &variables[2][0]};
+  std::vector<double *> outputsPtr;
+  for (unsigned int e = 0; e < expressions.size(); ++e)
+    {
+    outputsPtr.push_back(&outputs[e][0]);
+    }
+
+  CompiledExpressionsType::WorkspaceType workspace;
+  compiled->Evaluate(variablesPtr, &outputsPtr[0], nbValues, workspace);
+
+  otb::ParserX::ValueType values[3];
+  for (unsigned int e = 0; e < expressions.size(); ++e)
+    {
+    otb::ParserX::Pointer parser = otb::ParserX::New();
+    parser->DefineVar("b1", &values[b1]);
+    parser->DefineVar("b2", &values[b2]);
+    parser->DefineVar("x", &values[x]);
+    parser->SetExpr(expressions[e]);
+
+    for (unsigned int i = 0; i < nbValues; ++i)
+      {
+      for (unsigned int v = 0; v < 3; ++v)
+        {
+        values[v] = variables[v][i];
+        }
+      const double expected = parser->Eval().GetFloat();
+      const double result = outputs[e][i];
+      if (vcl_abs(result - expected) > 1E-12 * vcl_abs(expected)
+          && !(vnl_math_isnan(result) && vnl_math_isnan(expected)))
+        {
+        std::cout << expressions[e] << " : got " << result << " while waiting for " << expected << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  // Unsupported constructs are reported
+  std::vector<std::string> unsupported(1);
+  const char * unsupportedExpressions[] = {"vmax(b1)", "b1 div b2", "b1 < < b2", "y + 1", "{b1, b2}"};
+  for (unsigned int i = 0; i < 5; ++i)
+    {
+    unsupported[0] = unsupportedExpressions[i];
+    if (compiled->Compile(unsupported))
+      {
+      std::cout << unsupported[0] << " should not be compiled" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
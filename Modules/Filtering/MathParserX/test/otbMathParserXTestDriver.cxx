@@ -29,4 +29,7 @@ void RegisterTests()
   REGISTER_TEST(otbBandMathXImageFilterConv);
   REGISTER_TEST(otbBandMathXImageFilterTxt);
   REGISTER_TEST(otbBandMathXImageFilterWithIdx);
+  REGISTER_TEST(otbBandMathXImageFilterCompiled);
+  REGISTER_TEST(otbCompiledExpressionsTestNew);
+  REGISTER_TEST(otbCompiledExpressionsTest);
 }
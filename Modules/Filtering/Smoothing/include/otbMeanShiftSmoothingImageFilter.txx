@@ -26,6 +26,8 @@
 #include "itkImageRegionIterator.h"
 #include "otbUnaryFunctorWithIndexWithOutputSizeImageFilter.h"
 #include "otbMacro.h"
+#include "otbMetaDataKey.h"
+#include "itkMetaDataObject.h"
 
 #include "itkProgressReporter.h"
 
@@ -193,6 +195,17 @@ void MeanShiftSmoothingImageFilter<TInputImage, TOutputImage, TKernel, TOutputIt
   if (inputRequestedRegion.Crop(inPtr->GetLargestPossibleRegion()))
     {
     inPtr->SetRequestedRegion(inputRequestedRegion);
+
+    // The joint domain image and the mode table cover the input requested
+    // region: report them to the pipeline memory print estimation
+    const double bytesPerInputPixel =
+      (ImageDimension + inPtr->GetNumberOfComponentsPerPixel()) * sizeof(RealType)
+      + sizeof(typename ModeTableImageType::PixelType);
+    const double bytesPerOutputPixel = bytesPerInputPixel * inputRequestedRegion.GetNumberOfPixels()
+      / std::max<double>(outputRequestedRegion.GetNumberOfPixels(), 1.);
+    itk::EncapsulateMetaData<double>(this->GetMetaDataDictionary(),
+                                     MetaDataKey::MemoryPrintPerOutputPixel,
+                                     bytesPerOutputPixel);
     return;
     }
   else
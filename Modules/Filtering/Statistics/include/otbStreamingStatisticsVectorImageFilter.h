@@ -42,6 +42,13 @@ namespace otb
  *
  * To get the statistics once the regions have been processed via the pipeline, use the Synthetize() method.
  *
+ * Second order statistics are accumulated by blocks of pixels: each block is
+ * centered on its own mean, its co-moment matrix is computed with one dot
+ * product per pair of bands, and it is merged into the thread statistics with
+ * the pairwise update of Chan et al. The thread statistics are merged the same
+ * way in Synthetize(). This avoids the cancellation of the naive sum of squares
+ * and keeps the accumulation cache friendly for images with many bands.
+ *
  * \sa PersistentImageFilter
  * \ingroup Streamed
  * \ingroup Multithreaded
@@ -82,6 +89,9 @@ public:
   /** Image related typedefs. */
   itkStaticConstMacro(ImageDimension, unsigned int, TInputImage::ImageDimension);
 
+  /** Number of pixels accumulated at once for second order statistics */
+  itkStaticConstMacro(SecondOrderBlockSize, unsigned int, 64);
+
   /** Smart Pointer type to a DataObject. */
   typedef typename itk::DataObject::Pointer DataObjectPointer;
   typedef itk::ProcessObject::DataObjectPointerArraySizeType DataObjectPointerArraySizeType;
@@ -230,6 +240,17 @@ protected:
   /** Multi-thread version GenerateData. */
   void  ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId) ITK_OVERRIDE;
 
+  /** Merge a block of pixels (stored band after band, with a stride of
+   * SecondOrderBlockSize) into the second order statistics of a thread */
+  void AccumulateSecondOrderBlock(std::vector<PrecisionType>& block, unsigned int nbPixels,
+                                  itk::ThreadIdType threadId);
+
+  /** Merge the mean and centered co-moments (upper triangle) of a set of
+   * nbPixels pixels into those of nbAccumulated pixels */
+  static void MergeSecondOrderStatistics(unsigned long nbAccumulated, RealPixelType& mean, MatrixType& comoments,
+                                         unsigned long nbPixels, const RealPixelType& otherMean,
+                                         const MatrixType& otherComoments);
+
 private:
   PersistentStreamingStatisticsVectorImageFilter(const Self &); //purposely not implemented
   void operator =(const Self&); //purposely not implemented
@@ -248,6 +269,8 @@ private:
   std::vector<RealType>      m_ThreadSecondOrderComponentAccumulators;
   std::vector<RealPixelType> m_ThreadFirstOrderAccumulators;
   std::vector<MatrixType>    m_ThreadSecondOrderAccumulators;
+  std::vector<RealPixelType> m_ThreadSecondOrderMeans;
+  std::vector<unsigned long> m_ThreadSecondOrderCounts;
 
   /* Ignored values */
   bool m_IgnoreInfiniteValues;
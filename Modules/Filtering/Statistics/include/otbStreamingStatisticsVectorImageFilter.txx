@@ -351,6 +351,13 @@ PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>
     m_ThreadSecondOrderAccumulators.resize(numberOfThreads);
     std::fill(m_ThreadSecondOrderAccumulators.begin(), m_ThreadSecondOrderAccumulators.end(), zeroMatrix);
 
+    RealPixelType zeroRealPixel;
+    zeroRealPixel.SetSize(numberOfComponent);
+    zeroRealPixel.Fill(itk::NumericTraits<PrecisionType>::ZeroValue());
+    m_ThreadSecondOrderMeans.resize(numberOfThreads);
+    std::fill(m_ThreadSecondOrderMeans.begin(), m_ThreadSecondOrderMeans.end(), zeroRealPixel);
+    m_ThreadSecondOrderCounts = std::vector<unsigned long>(numberOfThreads, 0);
+
     RealType zeroReal = itk::NumericTraits<RealType>::ZeroValue();
     m_ThreadSecondOrderComponentAccumulators.resize(numberOfThreads);
     std::fill(m_ThreadSecondOrderComponentAccumulators.begin(), m_ThreadSecondOrderComponentAccumulators.end(), zeroReal);
@@ -387,6 +394,9 @@ PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>
   streamFirstOrderAccumulator.Fill(itk::NumericTraits<PrecisionType>::Zero);
   MatrixType    streamSecondOrderAccumulator(numberOfComponent, numberOfComponent);
   streamSecondOrderAccumulator.Fill(itk::NumericTraits<PrecisionType>::Zero);
+  RealPixelType streamSecondOrderMean(numberOfComponent);
+  streamSecondOrderMean.Fill(itk::NumericTraits<PrecisionType>::Zero);
+  unsigned long streamSecondOrderCount = 0;
 
   RealType streamFirstOrderComponentAccumulator = itk::NumericTraits<RealType>::Zero;
   RealType streamSecondOrderComponentAccumulator = itk::NumericTraits<RealType>::Zero;
@@ -424,7 +434,10 @@ PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>
 
     if (m_EnableSecondOrderStats)
       {
-      streamSecondOrderAccumulator += m_ThreadSecondOrderAccumulators[threadId];
+      MergeSecondOrderStatistics(streamSecondOrderCount, streamSecondOrderMean, streamSecondOrderAccumulator,
+                                 m_ThreadSecondOrderCounts[threadId], m_ThreadSecondOrderMeans[threadId],
+                                 m_ThreadSecondOrderAccumulators[threadId]);
+      streamSecondOrderCount += m_ThreadSecondOrderCounts[threadId];
       streamSecondOrderComponentAccumulator += m_ThreadSecondOrderComponentAccumulators[threadId];
       }
     // Ignored Infinite Pixels
@@ -474,11 +487,6 @@ PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>
 
   if (m_EnableSecondOrderStats)
     {
-    MatrixType cor = streamSecondOrderAccumulator / nbRelevantPixel;
-    this->GetCorrelationOutput()->Set(cor);
-
-    const RealPixelType& mean = this->GetMeanOutput()->Get();
-
     double regul = 1.0;
     double regulComponent = 1.0;
 
@@ -496,14 +504,21 @@ PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>
        ( static_cast< double >(nbRelevantPixel * numberOfComponent) - 1.0 );
       }
 
-    MatrixType cov  = cor;
+    // Only the upper triangle of the centered co-moments is accumulated
+    MatrixType cor(numberOfComponent, numberOfComponent);
+    MatrixType cov(numberOfComponent, numberOfComponent);
     for (unsigned int r = 0; r < numberOfComponent; ++r)
       {
-      for (unsigned int c = 0; c < numberOfComponent; ++c)
+      for (unsigned int c = r; c < numberOfComponent; ++c)
         {
-        cov(r, c) = regul * (cov(r, c) - mean[r] * mean[c]);
+        const double comoment = streamSecondOrderAccumulator(r, c) / streamSecondOrderCount;
+        cor(r, c) = comoment + streamSecondOrderMean[r] * streamSecondOrderMean[c];
+        cov(r, c) = regul * comoment;
+        cor(c, r) = cor(r, c);
+        cov(c, r) = cov(r, c);
         }
       }
+    this->GetCorrelationOutput()->Set(cor);
     this->GetCovarianceOutput()->Set(cov);
 
     this->GetComponentMeanOutput()->Set(streamFirstOrderComponentAccumulator / (nbRelevantPixel * numberOfComponent));
@@ -528,6 +543,14 @@ PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>
   PixelType& threadMax  = m_ThreadMax [threadId];
 
 
+  // Relevant pixels are gathered by blocks for the second order statistics
+  std::vector<PrecisionType> block;
+  unsigned int blockPixels = 0;
+  if (m_EnableSecondOrderStats)
+    {
+    block.resize(inputPtr->GetNumberOfComponentsPerPixel() * SecondOrderBlockSize);
+    }
+
   itk::ImageRegionConstIteratorWithIndex<TInputImage> it(inputPtr, outputRegionForThread);
 
   for (it.GoToBegin(); !it.IsAtEnd(); ++it, progress.CompletedPixel())
@@ -584,15 +607,16 @@ PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>
 
         if (m_EnableSecondOrderStats)
           {
-          MatrixType&    threadSecondOrder = m_ThreadSecondOrderAccumulators[threadId];
           RealType& threadSecondOrderComponent = m_ThreadSecondOrderComponentAccumulators[threadId];
 
-          for (unsigned int r = 0; r < threadSecondOrder.Rows(); ++r)
+          for (unsigned int j = 0; j < vectorValue.GetSize(); ++j)
             {
-            for (unsigned int c = 0; c < threadSecondOrder.Cols(); ++c)
-              {
-              threadSecondOrder(r, c) += vectorValue[r] * vectorValue[c];
-              }
+            block[j * SecondOrderBlockSize + blockPixels] = vectorValue[j];
+            }
+          if (++blockPixels == SecondOrderBlockSize)
+            {
+            this->AccumulateSecondOrderBlock(block, blockPixels, threadId);
+            blockPixels = 0;
             }
           threadSecondOrderComponent += vectorValue.GetSquaredNorm();
           }
@@ -600,8 +624,100 @@ PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>
       }
     }
 
+  if (blockPixels > 0)
+    {
+    this->AccumulateSecondOrderBlock(block, blockPixels, threadId);
+    }
  }
 
+template<class TInputImage, class TPrecision>
+void
+PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>
+::AccumulateSecondOrderBlock(std::vector<PrecisionType>& block, unsigned int nbPixels, itk::ThreadIdType threadId)
+{
+  MatrixType&    threadComoments = m_ThreadSecondOrderAccumulators[threadId];
+  RealPixelType& threadMean      = m_ThreadSecondOrderMeans[threadId];
+  unsigned long& threadCount     = m_ThreadSecondOrderCounts[threadId];
+
+  const unsigned int numberOfComponent = threadComoments.Rows();
+  const unsigned long count = threadCount + nbPixels;
+  const double weight = static_cast<double>(threadCount) * nbPixels / count;
+
+  // Center each band of the block on its mean
+  RealPixelType delta(numberOfComponent);
+  for (unsigned int j = 0; j < numberOfComponent; ++j)
+    {
+    PrecisionType * band = &block[j * SecondOrderBlockSize];
+    PrecisionType blockMean = itk::NumericTraits<PrecisionType>::ZeroValue();
+    for (unsigned int k = 0; k < nbPixels; ++k)
+      {
+      blockMean += band[k];
+      }
+    blockMean /= nbPixels;
+    for (unsigned int k = 0; k < nbPixels; ++k)
+      {
+      band[k] -= blockMean;
+      }
+    delta[j] = blockMean - threadMean[j];
+    }
+
+  // Rank-k update of the upper triangle, merged with the thread co-moments
+  for (unsigned int r = 0; r < numberOfComponent; ++r)
+    {
+    const PrecisionType * bandR = &block[r * SecondOrderBlockSize];
+    PrecisionType * comomentsRow = threadComoments.GetVnlMatrix()[r];
+    for (unsigned int c = r; c < numberOfComponent; ++c)
+      {
+      const PrecisionType * bandC = &block[c * SecondOrderBlockSize];
+      PrecisionType dot = itk::NumericTraits<PrecisionType>::ZeroValue();
+      for (unsigned int k = 0; k < nbPixels; ++k)
+        {
+        dot += bandR[k] * bandC[k];
+        }
+      comomentsRow[c] += dot + weight * delta[r] * delta[c];
+      }
+    }
+
+  for (unsigned int j = 0; j < numberOfComponent; ++j)
+    {
+    threadMean[j] += delta[j] * nbPixels / count;
+    }
+  threadCount = count;
+}
+
+template<class TInputImage, class TPrecision>
+void
+PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>
+::MergeSecondOrderStatistics(unsigned long nbAccumulated, RealPixelType& mean, MatrixType& comoments,
+                             unsigned long nbPixels, const RealPixelType& otherMean,
+                             const MatrixType& otherComoments)
+{
+  if (nbPixels == 0)
+    {
+    return;
+    }
+  if (nbAccumulated == 0)
+    {
+    mean = otherMean;
+    comoments = otherComoments;
+    return;
+    }
+
+  const unsigned int numberOfComponent = mean.GetSize();
+  const unsigned long count = nbAccumulated + nbPixels;
+  const double weight = static_cast<double>(nbAccumulated) * nbPixels / count;
+
+  RealPixelType delta = otherMean - mean;
+  for (unsigned int r = 0; r < numberOfComponent; ++r)
+    {
+    for (unsigned int c = r; c < numberOfComponent; ++c)
+      {
+      comoments(r, c) += otherComoments(r, c) + weight * delta[r] * delta[c];
+      }
+    mean[r] += delta[r] * nbPixels / count;
+    }
+}
+
 template <class TImage, class TPrecision>
 void
 PersistentStreamingStatisticsVectorImageFilter<TImage, TPrecision>
@@ -25,6 +25,7 @@
 #include "otbVectorImage.h"
 #include <fstream>
 #include "otbStreamingTraits.h"
+#include "itkImageRegionIteratorWithIndex.h"
 
 int otbStreamingStatisticsVectorImageFilter(int argc, char * argv[])
 {
@@ -75,3 +76,101 @@ int otbStreamingStatisticsVectorImageFilter(int argc, char * argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbStreamingStatisticsVectorImageFilterManyBands(int itkNotUsed(argc), char * itkNotUsed(argv) [])
+{
+  typedef otb::VectorImage<double, 2>                          ImageType;
+  typedef otb::StreamingStatisticsVectorImageFilter<ImageType> StreamingStatisticsVectorImageFilterType;
+
+  // Many bands with a large offset: the naive sum of squares would lose
+  // most of the significant digits of the covariance
+  const unsigned int nbBands = 37;
+  const double offset = 1e6;
+
+  ImageType::SizeType size = {{ 53, 41 }};
+  ImageType::IndexType index;
+  index.Fill(0);
+  ImageType::RegionType region(index, size);
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->SetNumberOfComponentsPerPixel(nbBands);
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, region);
+  ImageType::PixelType pixel(nbBands);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+    const ImageType::IndexType & idx = it.GetIndex();
+    for (unsigned int b = 0; b < nbBands; ++b)
+      {
+      pixel[b] = offset + (idx[0] * (b + 3) + idx[1] * (2 * b + 1) + idx[0] * idx[1]) % 17;
+      }
+    it.Set(pixel);
+    }
+
+  // Reference statistics, computed in two passes
+  const double nbPixels = region.GetNumberOfPixels();
+  std::vector<double> mean(nbBands, 0.);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+    for (unsigned int b = 0; b < nbBands; ++b)
+      {
+      mean[b] += it.Get()[b] - offset;
+      }
+    }
+  for (unsigned int b = 0; b < nbBands; ++b)
+    {
+    mean[b] /= nbPixels;
+    }
+  // Centered co-moments: the filter uses the unbiased estimator of the
+  // covariance by default, and the co-moments in the correlation
+  std::vector<double> comoment(nbBands * nbBands, 0.);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+    for (unsigned int r = 0; r < nbBands; ++r)
+      {
+      for (unsigned int c = 0; c < nbBands; ++c)
+        {
+        comoment[r * nbBands + c] += (it.Get()[r] - offset - mean[r]) * (it.Get()[c] - offset - mean[c]) / nbPixels;
+        }
+      }
+    }
+
+  StreamingStatisticsVectorImageFilterType::Pointer filter = StreamingStatisticsVectorImageFilterType::New();
+  filter->SetInput(image);
+  filter->GetStreamer()->SetNumberOfLinesStrippedStreaming(7);
+  filter->Update();
+
+  bool passed = true;
+  for (unsigned int r = 0; r < nbBands; ++r)
+    {
+    if (vcl_abs(filter->GetMean()[r] - offset - mean[r]) > 1e-6)
+      {
+      std::cerr << "Wrong mean for band " << r << ": expected " << offset + mean[r]
+                << ", got " << filter->GetMean()[r] << std::endl;
+      passed = false;
+      }
+    for (unsigned int c = 0; c < nbBands; ++c)
+      {
+      const double covariance = comoment[r * nbBands + c] * nbPixels / (nbPixels - 1.);
+      if (vcl_abs(filter->GetCovariance()(r, c) - covariance) > 1e-6)
+        {
+        std::cerr << "Wrong covariance for bands " << r << " and " << c << ": expected "
+                  << covariance << ", got " << filter->GetCovariance()(r, c) << std::endl;
+        passed = false;
+        }
+
+      // The correlation is dominated by the product of the offset means,
+      // the tolerance still detects errors on the co-moment
+      const double correlation = comoment[r * nbBands + c] + (mean[r] + offset) * (mean[c] + offset);
+      if (vcl_abs(filter->GetCorrelation()(r, c) - correlation) > 1e-12 * vcl_abs(correlation))
+        {
+        std::cerr << "Wrong correlation for bands " << r << " and " << c << ": expected "
+                  << correlation << ", got " << filter->GetCorrelation()(r, c) << std::endl;
+        passed = false;
+        }
+    }
+
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -34,6 +34,9 @@ namespace otb
  * - &writegeom=ON : to activate the creation of an external geom file
  * - &gdal:co:<KEY>=<VALUE> : the gdal creation option <KEY>
  * - streaming modes
+ * - &streaming:writequeue=<N> : asynchronous writing with N queued stream pieces
+ * - &streaming:prefetch=ON : read ahead of the next stream piece by the readers
+ * - &cog=ON : write a cloud optimized GeoTIFF (tiled, with overviews)
  * - box
  * See http://wiki.orfeo-toolbox.org/index.php/ExtendedFileName
  *
@@ -71,6 +74,9 @@ public:
     std::pair<bool,  std::string>                streamingType;
     std::pair<bool,  std::string>                streamingSizeMode;
     std::pair<bool,  double>                     streamingSizeValue;
+    std::pair<bool,  unsigned int>               streamingWriteQueue;
+    std::pair<bool,  bool>                       streamingPrefetch;
+    std::pair<bool,  bool>                       cloudOptimized;
     std::pair<bool,  std::string>                box;
     std::pair< bool, std::string>                bandRange;
     std::vector<std::string>                     optionList;
@@ -92,6 +98,12 @@ public:
   std::string GetStreamingSizeMode() const;
   bool StreamingSizeValueIsSet() const;
   double GetStreamingSizeValue() const;
+  bool StreamingWriteQueueIsSet() const;
+  unsigned int GetStreamingWriteQueue() const;
+  bool StreamingPrefetchIsSet() const;
+  bool GetStreamingPrefetch() const;
+  bool CloudOptimizedIsSet() const;
+  bool GetCloudOptimized() const;
   std::string GetBandRange () const;
 
   bool BoxIsSet() const;
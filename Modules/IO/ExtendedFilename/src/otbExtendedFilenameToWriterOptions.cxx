@@ -42,6 +42,12 @@ ExtendedFilenameToWriterOptions
   m_Options.streamingType.first       = false;
   m_Options.streamingSizeMode.first   = false;
   m_Options.streamingSizeValue.first  = false;
+  m_Options.streamingWriteQueue.first  = false;
+  m_Options.streamingWriteQueue.second = 0;
+  m_Options.streamingPrefetch.first  = false;
+  m_Options.streamingPrefetch.second = false;
+  m_Options.cloudOptimized.first  = false;
+  m_Options.cloudOptimized.second = false;
 
   m_Options.bandRange.first = false;
   m_Options.bandRange.second = "";
@@ -51,6 +57,9 @@ ExtendedFilenameToWriterOptions
   m_Options.optionList.push_back("streaming:type");
   m_Options.optionList.push_back("streaming:sizemode");
   m_Options.optionList.push_back("streaming:sizevalue");
+  m_Options.optionList.push_back("streaming:writequeue");
+  m_Options.optionList.push_back("streaming:prefetch");
+  m_Options.optionList.push_back("cog");
   m_Options.optionList.push_back("box");
   m_Options.optionList.push_back("bands");
 }
@@ -113,6 +122,7 @@ ExtendedFilenameToWriterOptions
     if(map["streaming:type"] == "auto"
        || map["streaming:type"] == "tiled"
        || map["streaming:type"] == "stripped"
+       || map["streaming:type"] == "aligned"
        || map["streaming:type"] == "none")
       {
       m_Options.streamingType.first=true;
@@ -120,7 +130,7 @@ ExtendedFilenameToWriterOptions
       }
     else
       {
-      itkWarningMacro("Unkwown value "<<map["streaming:type"]<<" for streaming:type option. Available values are auto,tiled,stripped.");
+      itkWarningMacro("Unkwown value "<<map["streaming:type"]<<" for streaming:type option. Available values are auto,tiled,stripped,aligned,none.");
       }
     }
 
@@ -145,6 +155,48 @@ ExtendedFilenameToWriterOptions
     m_Options.streamingSizeValue.second = atof(map["streaming:sizevalue"].c_str());
     }
 
+  if(!map["streaming:writequeue"].empty())
+    {
+    int queueDepth = atoi(map["streaming:writequeue"].c_str());
+    if(queueDepth >= 0)
+      {
+      m_Options.streamingWriteQueue.first = true;
+      m_Options.streamingWriteQueue.second = static_cast<unsigned int>(queueDepth);
+      }
+    else
+      {
+      itkWarningMacro("Unknown value "<<map["streaming:writequeue"]<<" for streaming:writequeue option. Expect a positive number of queued stream pieces (0 disables asynchronous writing).");
+      }
+    }
+
+  if (!map["streaming:prefetch"].empty())
+     {
+     m_Options.streamingPrefetch.first = true;
+     if (   map["streaming:prefetch"] == "On"
+         || map["streaming:prefetch"] == "on"
+         || map["streaming:prefetch"] == "ON"
+         || map["streaming:prefetch"] == "true"
+         || map["streaming:prefetch"] == "True"
+         || map["streaming:prefetch"] == "1"   )
+       {
+       m_Options.streamingPrefetch.second = true;
+       }
+     }
+
+  if (!map["cog"].empty())
+     {
+     m_Options.cloudOptimized.first = true;
+     if (   map["cog"] == "On"
+         || map["cog"] == "on"
+         || map["cog"] == "ON"
+         || map["cog"] == "true"
+         || map["cog"] == "True"
+         || map["cog"] == "1"   )
+       {
+       m_Options.cloudOptimized.second = true;
+       }
+     }
+
   //Manage region size to write in output image
   if(!map["box"].empty())
     {
@@ -295,6 +347,48 @@ ExtendedFilenameToWriterOptions
   return m_Options.streamingSizeValue.second;
 }
 
+bool
+ExtendedFilenameToWriterOptions
+::StreamingWriteQueueIsSet() const
+{
+  return m_Options.streamingWriteQueue.first;
+}
+
+unsigned int
+ExtendedFilenameToWriterOptions
+::GetStreamingWriteQueue() const
+{
+  return m_Options.streamingWriteQueue.second;
+}
+
+bool
+ExtendedFilenameToWriterOptions
+::StreamingPrefetchIsSet() const
+{
+  return m_Options.streamingPrefetch.first;
+}
+
+bool
+ExtendedFilenameToWriterOptions
+::GetStreamingPrefetch() const
+{
+  return m_Options.streamingPrefetch.second;
+}
+
+bool
+ExtendedFilenameToWriterOptions
+::CloudOptimizedIsSet() const
+{
+  return m_Options.cloudOptimized.first;
+}
+
+bool
+ExtendedFilenameToWriterOptions
+::GetCloudOptimized() const
+{
+  return m_Options.cloudOptimized.second;
+}
+
 bool
 ExtendedFilenameToWriterOptions
 ::BoxIsSet() const
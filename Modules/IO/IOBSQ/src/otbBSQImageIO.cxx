@@ -25,6 +25,7 @@
 
 #include "itkByteSwapper.h"
 #include "otbSystem.h"
+#include "otbMappedFile.h"
 #include "itksys/SystemTools.hxx"
 
 #include "otbMacro.h"
@@ -58,6 +59,7 @@ BSQImageIO::BSQImageIO()
   m_Origin[0] = 0.5;
   m_Origin[1] = 0.5;
   m_ChannelsFile = ITK_NULLPTR;
+  m_ChannelsMappedFile = ITK_NULLPTR;
   m_FlagWriteImageInformation = true;
 
   this->AddSupportedWriteExtension(".hd");
@@ -85,6 +87,7 @@ BSQImageIO::~BSQImageIO()
       }
     delete[] m_ChannelsFile;
     }
+  this->UnmapChannelsFiles();
 }
 
 bool BSQImageIO::CanReadFile(const char* filename)
@@ -154,56 +157,108 @@ void BSQImageIO::Read(void* buffer)
   // Update the step variable
   step = step * (unsigned long) (this->GetComponentSize());
 
-  char * value = new char[numberOfBytesToBeRead];
-  if (value == ITK_NULLPTR)
+  if (lNbLines > 0 && this->MapChannelsFiles())
     {
-    itkExceptionMacro(<< "BSQImageIO::Read(): Bad alloc");
-    return;
-    }
+    // Copy the region straight from the mapped channel files
+    const MappedFile::SizeType regionLength =
+      static_cast<MappedFile::SizeType>(numberOfBytesPerLines) * (lNbLines - 1) + numberOfBytesToBeRead;
+    for (unsigned int nbComponents = 0; nbComponents < this->GetNumberOfComponents(); ++nbComponents)
+      {
+      const MappedFile& mappedFile = m_ChannelsMappedFile[nbComponents];
+      offset  =  headerLength + numberOfBytesPerLines * static_cast<std::streamoff>(lFirstLine);
+      offset +=  static_cast<std::streamoff>(this->GetComponentSize() * lFirstColumn);
+      if (!mappedFile.Contains(offset, regionLength))
+        {
+        itkExceptionMacro(<< "BSQImageIO::Read() Can Read the specified Region"); // read failed
+        }
+      const char * src = mappedFile.GetData() + offset;
 
-  otbMsgDevMacro(<< " sizeof(streamsize)    : " << sizeof(std::streamsize));
-  otbMsgDevMacro(<< " sizeof(streampos)     : " << sizeof(std::streampos));
-  otbMsgDevMacro(<< " sizeof(streamoff)     : " << sizeof(std::streamoff));
-  otbMsgDevMacro(<< " sizeof(std::ios::beg) : " << sizeof(std::ios::beg));
-  otbMsgDevMacro(<< " sizeof(size_t)        : " << sizeof(size_t));
-  otbMsgDevMacro(<< " sizeof(unsigned long) : " << sizeof(unsigned long));
+      if (this->GetNumberOfComponents() == 1 && numberOfBytesToBeRead == numberOfBytesPerLines)
+        {
+        // Whole lines of a single band: the region is contiguous
+        memcpy(p, src, static_cast<size_t>(regionLength));
+        }
+      else if (this->GetNumberOfComponents() == 1)
+        {
+        for (int LineNo = 0; LineNo < lNbLines; ++LineNo, src += numberOfBytesPerLines)
+          {
+          memcpy(p + cpt, src, static_cast<size_t>(numberOfBytesToBeRead));
+          cpt += numberOfBytesToBeRead;
+          }
+        }
+      else
+        {
+        cpt = (unsigned long) (nbComponents) * (unsigned long) (this->GetComponentSize());
+        for (int LineNo = 0; LineNo < lNbLines; ++LineNo, src += numberOfBytesPerLines)
+          {
+          for (std::streamsize i = 0;
+               i < numberOfBytesToBeRead;
+               i = i + static_cast<std::streamsize>(this->GetComponentSize()))
+            {
+            memcpy((void*) (&(p[cpt])), (const void*) (&(src[i])), (size_t) (this->GetComponentSize()));
+            cpt += step;
+            }
+          }
+        }
 
-  for (unsigned int nbComponents = 0; nbComponents < this->GetNumberOfComponents(); ++nbComponents)
+      // Streaming goes down the image: prefetch the lines of the next region
+      mappedFile.WillNeed(
+        headerLength + numberOfBytesPerLines * static_cast<std::streamoff>(lFirstLine + lNbLines),
+        static_cast<MappedFile::SizeType>(numberOfBytesPerLines) * lNbLines);
+      }
+    }
+  else
     {
-    cpt = (unsigned long) (nbComponents) * (unsigned long) (this->GetComponentSize());
-    //Read region of the channel
-    for (int LineNo = lFirstLine; LineNo < lFirstLine + lNbLines; LineNo++)
+    char * value = new char[numberOfBytesToBeRead];
+    if (value == ITK_NULLPTR)
       {
-      offset  =  headerLength + numberOfBytesPerLines * static_cast<std::streamoff>(LineNo);
-      offset +=  static_cast<std::streamoff>(this->GetComponentSize() * lFirstColumn);
-      m_ChannelsFile[nbComponents].seekg(offset, std::ios::beg);
-      //Read a line
-      m_ChannelsFile[nbComponents].read(static_cast<char *>(value), numberOfBytesToBeRead);
-      numberOfBytesRead = m_ChannelsFile[nbComponents].gcount();
+      itkExceptionMacro(<< "BSQImageIO::Read(): Bad alloc");
+      return;
+      }
+
+    otbMsgDevMacro(<< " sizeof(streamsize)    : " << sizeof(std::streamsize));
+    otbMsgDevMacro(<< " sizeof(streampos)     : " << sizeof(std::streampos));
+    otbMsgDevMacro(<< " sizeof(streamoff)     : " << sizeof(std::streamoff));
+    otbMsgDevMacro(<< " sizeof(std::ios::beg) : " << sizeof(std::ios::beg));
+    otbMsgDevMacro(<< " sizeof(size_t)        : " << sizeof(size_t));
+    otbMsgDevMacro(<< " sizeof(unsigned long) : " << sizeof(unsigned long));
+
+    for (unsigned int nbComponents = 0; nbComponents < this->GetNumberOfComponents(); ++nbComponents)
+      {
+      cpt = (unsigned long) (nbComponents) * (unsigned long) (this->GetComponentSize());
+      //Read region of the channel
+      for (int LineNo = lFirstLine; LineNo < lFirstLine + lNbLines; LineNo++)
+        {
+        offset  =  headerLength + numberOfBytesPerLines * static_cast<std::streamoff>(LineNo);
+        offset +=  static_cast<std::streamoff>(this->GetComponentSize() * lFirstColumn);
+        m_ChannelsFile[nbComponents].seekg(offset, std::ios::beg);
+        //Read a line
+        m_ChannelsFile[nbComponents].read(static_cast<char *>(value), numberOfBytesToBeRead);
+        numberOfBytesRead = m_ChannelsFile[nbComponents].gcount();
 #ifdef __APPLE_CC__
-      // fail() is broken in the Mac. It returns true when reaches eof().
-      if (numberOfBytesRead != numberOfBytesToBeRead)
+        // fail() is broken in the Mac. It returns true when reaches eof().
+        if (numberOfBytesRead != numberOfBytesToBeRead)
 #else
-      if ((numberOfBytesRead != numberOfBytesToBeRead)  || m_ChannelsFile[nbComponents].fail())
+        if ((numberOfBytesRead != numberOfBytesToBeRead)  || m_ChannelsFile[nbComponents].fail())
 #endif
-        {
-        itkExceptionMacro(<< "BSQImageIO::Read() Can Read the specified Region"); // read failed
-        }
+          {
+          itkExceptionMacro(<< "BSQImageIO::Read() Can Read the specified Region"); // read failed
+          }
 //                        cpt = (unsigned long )(nbComponents)* (unsigned long)(this->GetComponentSize()) + numberOfBytesToBeRead * this->GetNumberOfComponents() * LineNo;
 //                        cpt = (unsigned long )(nbComponents)* (unsigned long)(this->GetComponentSize()) + numberOfBytesToBeRead * this->GetNumberOfComponents();
-      for (std::streamsize i = 0;
-           i < numberOfBytesToBeRead;
-           i = i + static_cast<std::streamsize>(this->GetComponentSize()))
-        {
-        memcpy((void*) (&(p[cpt])), (const void*) (&(value[i])), (size_t) (this->GetComponentSize()));
-        cpt += step;
+        for (std::streamsize i = 0;
+             i < numberOfBytesToBeRead;
+             i = i + static_cast<std::streamsize>(this->GetComponentSize()))
+          {
+          memcpy((void*) (&(p[cpt])), (const void*) (&(value[i])), (size_t) (this->GetComponentSize()));
+          cpt += step;
+          }
         }
       }
+    delete[] value;
     }
   unsigned long numberOfPixelsOfRegion = lNbLines * lNbColumns * this->GetNumberOfComponents();
 
-  delete[] value;
-
   // Swap bytes if necessary
   if (0) {}
   otbSwappFileToSystemMacro(unsigned short, USHORT, buffer, numberOfPixelsOfRegion)
@@ -222,6 +277,38 @@ void BSQImageIO::Read(void* buffer)
     }
 }
 
+bool BSQImageIO::MapChannelsFiles()
+{
+  if (m_ChannelsFileName.empty())
+    {
+    return false;
+    }
+  // Mapping is only attempted once per opened image
+  if (m_ChannelsMappedFile == ITK_NULLPTR)
+    {
+    m_ChannelsMappedFile = new MappedFile[m_ChannelsFileName.size()];
+    for (unsigned int channels = 0; channels < m_ChannelsFileName.size(); ++channels)
+      {
+      if (!m_ChannelsMappedFile[channels].Open(m_ChannelsFileName[channels]))
+        {
+        otbMsgDevMacro(<< "BSQImageIO: unable to map " << m_ChannelsFileName[channels] << ", using stream reads");
+        for (unsigned int i = 0; i < channels; ++i)
+          {
+          m_ChannelsMappedFile[i].Close();
+          }
+        break;
+        }
+      }
+    }
+  return m_ChannelsMappedFile[m_ChannelsFileName.size() - 1].IsOpen();
+}
+
+void BSQImageIO::UnmapChannelsFiles()
+{
+  delete[] m_ChannelsMappedFile;
+  m_ChannelsMappedFile = ITK_NULLPTR;
+}
+
 void BSQImageIO::ReadImageInformation()
 {
   if (m_HeaderFile.is_open())
@@ -444,6 +531,7 @@ bool BSQImageIO::InternalReadHeaderInformation(const std::string& file_name, std
     m_ChannelsFileName.push_back(lStream.str());
     }
 
+  this->UnmapChannelsFiles();
   m_ChannelsFile = new std::fstream[this->GetNumberOfComponents()];
 
   //Try to open channels file
@@ -649,6 +737,7 @@ void BSQImageIO::WriteImageInformation()
     }
 
   //Allocate  buffer of stream file
+  this->UnmapChannelsFiles();
   m_ChannelsFile = new std::fstream[this->GetNumberOfComponents()];
 
   //Try to open channels file
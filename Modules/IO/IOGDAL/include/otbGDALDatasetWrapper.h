@@ -26,6 +26,8 @@
 
 #include "otbConfigure.h"
 
+#include <string>
+
 
 class GDALDataset;
 
@@ -84,6 +86,14 @@ protected :
 
 private:
   GDALDataset * m_Dataset;
+
+  /** Name of the file the dataset was opened from, when the dataset can be
+   *  handed back to the dataset cache of GDALDriverManagerWrapper on
+   *  destruction (empty otherwise) */
+  std::string   m_CacheKey;
+
+  /** Modification time of the file when the dataset was opened */
+  long int      m_ModifiedTime;
 }; // end of GDALDatasetWrapper
 
 
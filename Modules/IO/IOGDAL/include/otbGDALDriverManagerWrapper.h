@@ -24,8 +24,11 @@
 
 #include "itkLightObject.h"
 #include "itkProcessObject.h"
+#include "itkSimpleFastMutexLock.h"
 #include "otbConfigure.h"
 
+#include <list>
+
 class GDALDataset;
 class GDALDriver;
 
@@ -51,6 +54,17 @@ namespace otb
  * available during all the program lifetime. This class automatically
  * allocate and destroy the available gdal drivers.
  *
+ * It also holds a cache of read-only datasets: when the last user of a
+ * dataset opened with Open() releases it, the dataset is kept open (up
+ * to a given number of handles, the least recently used being closed
+ * first) and handed back by the next Open() call on the same file,
+ * which saves reopening it and parsing its header and metadata again.
+ * A cached dataset is only given to one user at a time, and it is
+ * discarded if the file was modified, if it is created again with
+ * Create(), or by PurgeDatasetCache(). The cache size defaults to the
+ * OTB_GDAL_DATASET_CACHE_SIZE configuration value (see
+ * ConfigurationManager).
+ *
  * \ingroup IOFilters
  *
  *
@@ -84,11 +98,52 @@ public:
 
   GDALDriver* GetDriverByName( std::string driverShortName ) const;
 
+  /** Set/Get the maximum number of idle datasets kept open by the cache.
+   *  0 disables the cache. */
+  void SetDatasetCacheCapacity( unsigned int capacity );
+  unsigned int GetDatasetCacheCapacity() const;
+
+  /** Number of Open() calls served from / missed by the dataset cache */
+  unsigned long GetDatasetCacheHits() const;
+  unsigned long GetDatasetCacheMisses() const;
+
+  /** Close all the idle datasets of the cache */
+  void ClearDatasetCache();
+
+  /** Close the idle datasets opened from filename. To be called before
+   *  writing filename other than through Create(). */
+  void PurgeDatasetCache( const std::string& filename ) const;
+
 private :
+  friend class GDALDatasetWrapper;
+
 // private constructor so that this class is allocated only inside GetInstance
   GDALDriverManagerWrapper();
 
   ~GDALDriverManagerWrapper();
+
+  /** Hand a dataset back to the cache. Returns false if the cache does
+   *  not take it, in which case the caller has to close it. */
+  bool ReleaseDataset( const std::string& filename, long int modifiedTime,
+                       GDALDataset* dataset ) const;
+
+  /** Close the least recently used datasets beyond capacity (the cache
+   *  mutex must be held) */
+  void ShrinkDatasetCache( unsigned int capacity ) const;
+
+  struct DatasetCacheEntry
+  {
+    std::string  FileName;
+    long int     ModifiedTime;
+    GDALDataset* Dataset;
+  };
+
+  // Most recently released datasets first
+  mutable std::list<DatasetCacheEntry> m_DatasetCache;
+  mutable itk::SimpleFastMutexLock     m_DatasetCacheMutex;
+  unsigned int                         m_DatasetCacheCapacity;
+  mutable unsigned long                m_DatasetCacheHits;
+  mutable unsigned long                m_DatasetCacheMisses;
 }; // end of GDALDriverManagerWrapper
 
 
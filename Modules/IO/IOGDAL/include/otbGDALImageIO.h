@@ -104,6 +104,16 @@ public:
   itkSetMacro(WriteRPCTags,bool);
   itkGetMacro(WriteRPCTags,bool);
 
+  /** Set/Get whether a GeoTIFF output is written as a cloud optimized
+   * GeoTIFF : tiled, with internal overviews stored ahead of the full
+   * resolution data. The overviews are averaged from the written pieces
+   * while streaming, so pieces should be aligned on the output tiles
+   * (see GetOutputBlockSize()). Nodata values are not excluded from
+   * the average. */
+  itkSetMacro(CloudOptimized,bool);
+  itkGetMacro(CloudOptimized,bool);
+  itkBooleanMacro(CloudOptimized);
+
   
   /** Set/Get the options */
   void SetOptions(const GDALCreationOptionsType& opts)
@@ -143,6 +153,12 @@ public:
   /** Reads the data from disk into the memory buffer provided. */
   void Read(void* buffer) ITK_OVERRIDE;
 
+  /** Reads the data from disk into a buffer of the given component type,
+   * letting GDAL select the bands and convert the values while reading.
+   * Only lossless conversions between real scalar types are supported. */
+  bool ReadAs(void* buffer, const std::type_info& componentType,
+              const std::vector<unsigned int>& bandList) ITK_OVERRIDE;
+
   /** Reads 3D data from multiple files assuming one slice per file. */
   virtual void ReadVolume(void* buffer);
 
@@ -152,6 +168,19 @@ public:
   /** Get if the pixel type in the file is complex or not (GDAL side)*/
   bool GDALPixelTypeIsComplex();
 
+  /** Get the block layout of the file that will be written, as deduced
+   * from the filename, the creation options and the written image (width,
+   * number of bands and size of a component in bytes, used to find the
+   * default strip height). A null sizeX means that blocks span whole lines
+   * (stripped layout). Returns false if the layout is unknown for the
+   * target driver. */
+  bool GetOutputBlockSize(unsigned int width, unsigned int nbBands, unsigned int bytesPerComponent,
+                          unsigned int& sizeX, unsigned int& sizeY) const;
+
+  /** Get the maximum size of the GDAL block cache, shared by all the
+   * datasets, in bytes */
+  static unsigned int GetCacheSizeInBytes();
+
   /*-------- This part of the interfaces deals with writing data. ----- */
 
   /** Determine the file type. Returns true if this ImageIO can read the
@@ -226,6 +255,11 @@ private:
 
   std::string FilenameToGdalDriverShortName(const std::string& name) const;
 
+  /** Compute the window of the file to read for the current IORegion,
+   * taking the resolution factor into account */
+  void ComputeReadWindow(int& firstColumn, int& firstLine,
+                         int& nbColumns, int& nbLines) const;
+
   /** Parse a GML box from a Jpeg2000 file and get the origin */
   bool GetOriginFromGMLBox(std::vector<double> &origin);
   
@@ -234,6 +268,39 @@ private:
    */
   bool CreationOptionContains(std::string partialOption) const;
 
+  /** Get the value of a creation option (for example "BLOCKXSIZE"),
+   *  or an empty string if the option is not set */
+  std::string GetCreationOptionValue(const std::string& key) const;
+
+  /** Compress the blocks of a compressed GTiff output on a pool of
+   *  threads, by adding the NUM_THREADS creation option (GDAL >= 2.1)
+   *  unless it is given by the user or by the GDAL_NUM_THREADS
+   *  configuration option. The pool has as many threads as the ITK
+   *  global default number of threads. */
+  void AddCompressionThreadsOption(GDALCreationOptionsType& creationOptions,
+                                   const std::string& driverShortName);
+
+  /** Tile size of a cloud optimized GeoTIFF output */
+  unsigned int GetCloudOptimizedTileSize() const;
+
+  /** Average the overview levels covered by a written piece and write
+   *  them to the temporary file of a cloud optimized GeoTIFF */
+  void WriteCloudOptimizedOverviews(const void* buffer, int firstColumn, int firstLine,
+                                    unsigned int nbColumns, unsigned int nbLines);
+
+  /** Complete the overview levels that could not be computed from the
+   *  written pieces, then copy the temporary file to the cloud optimized
+   *  output and remove it */
+  void FinalizeCloudOptimizedWrite();
+
+  /** Close and remove the temporary file of a cloud optimized GeoTIFF,
+   *  if any. Called when the writing completes, fails or is aborted. */
+  void RemoveCloudOptimizedTemporaryFile();
+
+  /** Removes the temporary file of a cloud optimized GeoTIFF when a
+   *  written piece leaves the write method with an exception */
+  class CloudOptimizedTemporaryFileGuard;
+
   /** GDAL parameters. */
   typedef itk::SmartPointer<GDALDatasetWrapper> GDALDatasetWrapperPointer;
   GDALDatasetWrapperPointer m_Dataset;
@@ -281,6 +348,38 @@ private:
    * True if RPC tags should be exported
    */
   bool m_WriteRPCTags;
+
+  /**
+   * Number of threads compressing the written blocks (empty when the
+   * compression runs on the writing thread)
+   */
+  std::string m_CompressionThreads;
+
+  /**
+   * Time spent writing the current file, in seconds
+   */
+  double m_WriteTime;
+
+  /**
+   * True if a GeoTIFF output is written as a cloud optimized GeoTIFF
+   */
+  bool m_CloudOptimized;
+
+  /**
+   * Temporary tiled file receiving the full resolution data and the
+   * overviews of a cloud optimized GeoTIFF (empty in other modes). It
+   * lives in GDAL's /vsimem/ in-memory file system when it fits in an
+   * eighth of the RAM hint, next to the output otherwise.
+   */
+  std::string m_CloudOptimizedTemporaryFileName;
+
+  /** Number of overview levels of a cloud optimized GeoTIFF */
+  unsigned int m_CloudOptimizedOverviewsCount;
+
+  /** First overview level (starting at 1) that could not be computed
+   * from the written pieces and has to be regenerated from the
+   * previous level at the end of the writing */
+  unsigned int m_CloudOptimizedFirstRegeneratedLevel;
   
 };
 
@@ -29,7 +29,7 @@ namespace otb
 {
 
 GDALDatasetWrapper
-::GDALDatasetWrapper(): m_Dataset(ITK_NULLPTR)
+::GDALDatasetWrapper(): m_Dataset(ITK_NULLPTR), m_ModifiedTime(0)
 {
 }
 
@@ -38,7 +38,12 @@ GDALDatasetWrapper
 {
   if( m_Dataset )
     {
-    GDALClose(m_Dataset);
+    // Read-only datasets may be kept open by the dataset cache
+    if( m_CacheKey.empty()
+        || !GDALDriverManagerWrapper::GetInstance().ReleaseDataset(m_CacheKey, m_ModifiedTime, m_Dataset) )
+      {
+      GDALClose(m_Dataset);
+      }
 
     // GDALDataset * is statically cast from GDALDatasetH in
     // GDALDriverManagerWrapper::Open(). So, it should be destroyed by
@@ -22,6 +22,8 @@
 #include <vector>
 #include "otb_boost_string_header.h"
 #include "otbSystem.h"
+#include "otbConfigurationManager.h"
+#include "itksys/SystemTools.hxx"
 
 namespace otb
 {
@@ -29,6 +31,9 @@ namespace otb
 // GDALDriverManagerWrapper method implementation
 
 GDALDriverManagerWrapper::GDALDriverManagerWrapper()
+  : m_DatasetCacheCapacity(ConfigurationManager::GetGDALDatasetCacheSize()),
+    m_DatasetCacheHits(0),
+    m_DatasetCacheMisses(0)
 {
     GDALAllRegister();
 
@@ -49,6 +54,7 @@ GDALDriverManagerWrapper::GDALDriverManagerWrapper()
 
 GDALDriverManagerWrapper::~GDALDriverManagerWrapper()
 {
+  ClearDatasetCache();
   GDALDestroyDriverManager();
 }
 
@@ -84,12 +90,70 @@ GDALDriverManagerWrapper::Open( std::string filename ) const
       " in order to avoid this driver.");
     }
 
-  GDALDatasetH dataset = GDALOpen(filename.c_str(), GA_ReadOnly);
+  const long int modifiedTime = itksys::SystemTools::ModifiedTime(filename.c_str());
+
+  GDALDataset* dataset = ITK_NULLPTR;
+  bool         cacheEnabled = false;
+  std::vector<GDALDataset*> staleDatasets;
+
+  m_DatasetCacheMutex.Lock();
+  cacheEnabled = (m_DatasetCacheCapacity > 0);
+  std::list<DatasetCacheEntry>::iterator it = m_DatasetCache.begin();
+  while (it != m_DatasetCache.end())
+    {
+    if (it->FileName != filename)
+      {
+      ++it;
+      }
+    else if (it->ModifiedTime != modifiedTime)
+      {
+      // The file changed since it was opened
+      staleDatasets.push_back(it->Dataset);
+      it = m_DatasetCache.erase(it);
+      }
+    else if (dataset == ITK_NULLPTR)
+      {
+      dataset = it->Dataset;
+      it = m_DatasetCache.erase(it);
+      }
+    else
+      {
+      ++it;
+      }
+    }
+  if (cacheEnabled)
+    {
+    if (dataset != ITK_NULLPTR)
+      {
+      ++m_DatasetCacheHits;
+      }
+    else
+      {
+      ++m_DatasetCacheMisses;
+      }
+    }
+  m_DatasetCacheMutex.Unlock();
+
+  for (std::vector<GDALDataset*>::iterator staleIt = staleDatasets.begin();
+       staleIt != staleDatasets.end(); ++staleIt)
+    {
+    GDALClose(*staleIt);
+    }
+
+  if (dataset == ITK_NULLPTR)
+    {
+    dataset = static_cast<GDALDataset*>(GDALOpen(filename.c_str(), GA_ReadOnly));
+    }
 
   if (dataset != ITK_NULLPTR)
     {
     datasetWrapper = GDALDatasetWrapper::New();
-    datasetWrapper->m_Dataset = static_cast<GDALDataset*>(dataset);
+    datasetWrapper->m_Dataset = dataset;
+    if (cacheEnabled)
+      {
+      datasetWrapper->m_CacheKey = filename;
+      datasetWrapper->m_ModifiedTime = modifiedTime;
+      }
     }
   return datasetWrapper;
 }
@@ -102,6 +166,9 @@ GDALDriverManagerWrapper::Create( std::string driverShortName, std::string filen
 {
   GDALDatasetWrapper::Pointer datasetWrapper;
 
+  // Idle datasets of a file being overwritten are not valid anymore
+  PurgeDatasetCache( filename );
+
   GDALDriver*  driver = GetDriverByName( driverShortName );
   if(driver != ITK_NULLPTR)
     {
@@ -125,4 +192,100 @@ GDALDriverManagerWrapper::GetDriverByName( std::string driverShortName ) const
   return GetGDALDriverManager()->GetDriverByName(driverShortName.c_str());
 }
 
+void
+GDALDriverManagerWrapper::SetDatasetCacheCapacity( unsigned int capacity )
+{
+  m_DatasetCacheMutex.Lock();
+  m_DatasetCacheCapacity = capacity;
+  ShrinkDatasetCache( capacity );
+  m_DatasetCacheMutex.Unlock();
+}
+
+unsigned int
+GDALDriverManagerWrapper::GetDatasetCacheCapacity() const
+{
+  m_DatasetCacheMutex.Lock();
+  unsigned int capacity = m_DatasetCacheCapacity;
+  m_DatasetCacheMutex.Unlock();
+  return capacity;
+}
+
+unsigned long
+GDALDriverManagerWrapper::GetDatasetCacheHits() const
+{
+  m_DatasetCacheMutex.Lock();
+  unsigned long hits = m_DatasetCacheHits;
+  m_DatasetCacheMutex.Unlock();
+  return hits;
+}
+
+unsigned long
+GDALDriverManagerWrapper::GetDatasetCacheMisses() const
+{
+  m_DatasetCacheMutex.Lock();
+  unsigned long misses = m_DatasetCacheMisses;
+  m_DatasetCacheMutex.Unlock();
+  return misses;
+}
+
+void
+GDALDriverManagerWrapper::ClearDatasetCache()
+{
+  m_DatasetCacheMutex.Lock();
+  ShrinkDatasetCache( 0 );
+  m_DatasetCacheMutex.Unlock();
+}
+
+bool
+GDALDriverManagerWrapper::ReleaseDataset( const std::string& filename, long int modifiedTime,
+                                          GDALDataset* dataset ) const
+{
+  m_DatasetCacheMutex.Lock();
+  if (m_DatasetCacheCapacity == 0)
+    {
+    m_DatasetCacheMutex.Unlock();
+    return false;
+    }
+
+  DatasetCacheEntry entry;
+  entry.FileName = filename;
+  entry.ModifiedTime = modifiedTime;
+  entry.Dataset = dataset;
+  m_DatasetCache.push_front(entry);
+
+  ShrinkDatasetCache( m_DatasetCacheCapacity );
+  m_DatasetCacheMutex.Unlock();
+  return true;
+}
+
+void
+GDALDriverManagerWrapper::PurgeDatasetCache( const std::string& filename ) const
+{
+  m_DatasetCacheMutex.Lock();
+  std::list<DatasetCacheEntry>::iterator it = m_DatasetCache.begin();
+  while (it != m_DatasetCache.end())
+    {
+    if (it->FileName == filename)
+      {
+      GDALClose(it->Dataset);
+      it = m_DatasetCache.erase(it);
+      }
+    else
+      {
+      ++it;
+      }
+    }
+  m_DatasetCacheMutex.Unlock();
+}
+
+void
+GDALDriverManagerWrapper::ShrinkDatasetCache( unsigned int capacity ) const
+{
+  while (m_DatasetCache.size() > capacity)
+    {
+    GDALClose(m_DatasetCache.back().Dataset);
+    m_DatasetCache.pop_back();
+    }
+}
+
 } // end namespace otb
@@ -21,6 +21,9 @@
 #include <iostream>
 #include <fstream>
 #include <vector>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 #include "otbGDALImageIO.h"
 #include "otbMacro.h"
@@ -36,12 +39,15 @@
 #include "itkRGBPixel.h"
 #include "itkRGBAPixel.h"
 #include "itkTimeProbe.h"
+#include "itkMultiThreader.h"
 
 #include "cpl_conv.h"
+#include "cpl_vsi.h"
 #include "ogr_spatialref.h"
 #include "ogr_srs_api.h"
 
 #include "otbGDALDriverManagerWrapper.h"
+#include "otbConfigurationManager.h"
 
 #include "otb_boost_string_header.h"
 
@@ -53,6 +59,131 @@ inline unsigned int uint_ceildivpow2(unsigned int a, unsigned int b) {
   return (a + (1 << b) - 1) >> b;
 }
 
+namespace
+{
+
+/** Arguments of the threaded 2x2 averaging of a pixel interleaved buffer */
+struct DownsampleByTwoArguments
+{
+  const char*   Input;
+  char*         Output;
+  unsigned int  InputColumns;
+  unsigned int  InputLines;
+  unsigned int  OutputColumns;
+  unsigned int  OutputLines;
+  // Number of scalar components per pixel (twice the bands for complex pixels)
+  unsigned int  NbComponents;
+  // Scalar GDAL type of a component
+  GDALDataType  ComponentType;
+};
+
+template <class T>
+T RoundAverage(double value)
+{
+  return std::numeric_limits<T>::is_integer ? static_cast<T>(std::floor(value + 0.5)) : static_cast<T>(value);
+}
+
+template <class T>
+void DownsampleByTwo(const DownsampleByTwoArguments& args, unsigned int beginLine, unsigned int endLine)
+{
+  const T* input = reinterpret_cast<const T*>(args.Input);
+  T* output = reinterpret_cast<T*>(args.Output);
+  const unsigned int nbComponents = args.NbComponents;
+  std::vector<double> sum(nbComponents);
+
+  for (unsigned int y = beginLine; y < endLine; ++y)
+    {
+    // Last line and column of an odd sized buffer are averaged alone
+    const unsigned int inBeginY = 2 * y;
+    const unsigned int inEndY = std::min(inBeginY + 2, args.InputLines);
+    for (unsigned int x = 0; x < args.OutputColumns; ++x)
+      {
+      const unsigned int inBeginX = 2 * x;
+      const unsigned int inEndX = std::min(inBeginX + 2, args.InputColumns);
+      std::fill(sum.begin(), sum.end(), 0.);
+      for (unsigned int inY = inBeginY; inY < inEndY; ++inY)
+        {
+        for (unsigned int inX = inBeginX; inX < inEndX; ++inX)
+          {
+          const T* pixel = input + (static_cast<size_t>(inY) * args.InputColumns + inX) * nbComponents;
+          for (unsigned int c = 0; c < nbComponents; ++c)
+            {
+            sum[c] += static_cast<double>(pixel[c]);
+            }
+          }
+        }
+      const double count = static_cast<double>((inEndY - inBeginY) * (inEndX - inBeginX));
+      T* pixel = output + (static_cast<size_t>(y) * args.OutputColumns + x) * nbComponents;
+      for (unsigned int c = 0; c < nbComponents; ++c)
+        {
+        pixel[c] = RoundAverage<T>(sum[c] / count);
+        }
+      }
+    }
+}
+
+ITK_THREAD_RETURN_TYPE DownsampleByTwoThreadCallback(void* arg)
+{
+  itk::MultiThreader::ThreadInfoStruct* threadInfo = static_cast<itk::MultiThreader::ThreadInfoStruct*>(arg);
+  const DownsampleByTwoArguments& args = *static_cast<const DownsampleByTwoArguments*>(threadInfo->UserData);
+
+  // Each thread averages a band of output lines
+  const unsigned int nbThreads = threadInfo->NumberOfThreads;
+  const unsigned int threadId = threadInfo->ThreadID;
+  const unsigned int beginLine = static_cast<unsigned int>(
+    static_cast<unsigned long long>(args.OutputLines) * threadId / nbThreads);
+  const unsigned int endLine = static_cast<unsigned int>(
+    static_cast<unsigned long long>(args.OutputLines) * (threadId + 1) / nbThreads);
+
+  switch (args.ComponentType)
+    {
+    case GDT_Byte:
+      DownsampleByTwo<GByte>(args, beginLine, endLine);
+      break;
+    case GDT_UInt16:
+      DownsampleByTwo<GUInt16>(args, beginLine, endLine);
+      break;
+    case GDT_Int16:
+      DownsampleByTwo<GInt16>(args, beginLine, endLine);
+      break;
+    case GDT_UInt32:
+      DownsampleByTwo<GUInt32>(args, beginLine, endLine);
+      break;
+    case GDT_Int32:
+      DownsampleByTwo<GInt32>(args, beginLine, endLine);
+      break;
+    case GDT_Float32:
+      DownsampleByTwo<float>(args, beginLine, endLine);
+      break;
+    case GDT_Float64:
+      DownsampleByTwo<double>(args, beginLine, endLine);
+      break;
+    default:
+      break;
+    }
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+/** Scalar type of the components of a (possibly complex) GDAL type */
+GDALDataType GetComponentDataType(GDALDataType type)
+{
+  switch (type)
+    {
+    case GDT_CInt16:
+      return GDT_Int16;
+    case GDT_CInt32:
+      return GDT_Int32;
+    case GDT_CFloat32:
+      return GDT_Float32;
+    case GDT_CFloat64:
+      return GDT_Float64;
+    default:
+      return type;
+    }
+}
+
+} // end anonymous namespace
+
 namespace otb
 {
 
@@ -164,10 +295,18 @@ GDALImageIO::GDALImageIO()
   m_ResolutionFactor = 0;
   m_BytePerPixel = 0;
   m_WriteRPCTags = false;
+
+  m_WriteTime = 0.;
+
+  m_CloudOptimized = false;
+  m_CloudOptimizedOverviewsCount = 0;
+  m_CloudOptimizedFirstRegeneratedLevel = 1;
 }
 
 GDALImageIO::~GDALImageIO()
 {
+  // An aborted cloud optimized writing leaves its temporary file behind
+  this->RemoveCloudOptimizedTemporaryFile();
   delete m_PxType;
 }
 
@@ -191,6 +330,7 @@ void GDALImageIO::PrintSelf(std::ostream& os, itk::Indent indent) const
   os << indent << "Compression Level : " << m_CompressionLevel << "\n";
   os << indent << "IsComplex (otb side) : " << m_IsComplex << "\n";
   os << indent << "Byte per pixel : " << m_BytePerPixel << "\n";
+  os << indent << "Cloud optimized : " << m_CloudOptimized << "\n";
 }
 
 // Read a 3D image (or event more bands)... not implemented yet
@@ -211,10 +351,6 @@ void GDALImageIO::Read(void* buffer)
     return;
     }
 
-  // Get the origin of the region to read
-  int lFirstLineRegion   = this->GetIORegion().GetIndex()[1];
-  int lFirstColumnRegion = this->GetIORegion().GetIndex()[0];
-
   // Get nb. of lines and columns of the region to read
   int lNbLinesRegion   = this->GetIORegion().GetSize()[1];
   int lNbColumnsRegion = this->GetIORegion().GetSize()[0];
@@ -222,21 +358,9 @@ void GDALImageIO::Read(void* buffer)
   //std::cout << "OriginBuffer= " <<  lFirstLineRegion << " x " << lFirstColumnRegion << std::endl;
   //std::cout << "SizeBuffer= " <<  lNbLinesRegion << " x " << lNbColumnsRegion << std::endl;
 
-  // Compute the origin of the image region to read at the initial resolution
-  int lFirstLine   = lFirstLineRegion * (1 << m_ResolutionFactor);
-  int lFirstColumn = lFirstColumnRegion * (1 << m_ResolutionFactor);
-
-  //std::cout << "OriginImage= " <<  lFirstLine << " x " << lFirstColumn << std::endl;
-
-  // Compute the size of the image region to read at the initial resolution
-  int lNbLines     = lNbLinesRegion * (1 << m_ResolutionFactor);
-  int lNbColumns   = lNbColumnsRegion * (1 << m_ResolutionFactor);
-
-  // Check if the image region is correct
-  if (lFirstLine + lNbLines > static_cast<int>(m_OriginalDimensions[1]))
-    lNbLines = static_cast<int>(m_OriginalDimensions[1]-lFirstLine);
-  if (lFirstColumn + lNbColumns > static_cast<int>(m_OriginalDimensions[0]))
-    lNbColumns = static_cast<int>(m_OriginalDimensions[0]-lFirstColumn);
+  // Compute the image region to read at the initial resolution
+  int lFirstLine, lFirstColumn, lNbLines, lNbColumns;
+  this->ComputeReadWindow(lFirstColumn, lFirstLine, lNbColumns, lNbLines);
 
   //std::cout << "SizeImage= " <<  lNbLines << " x " << lNbColumns << std::endl;
 
@@ -439,6 +563,121 @@ void GDALImageIO::Read(void* buffer)
     }
 }
 
+void GDALImageIO::ComputeReadWindow(int& firstColumn, int& firstLine,
+                                    int& nbColumns, int& nbLines) const
+{
+  // Compute the origin of the image region to read at the initial resolution
+  firstLine   = this->GetIORegion().GetIndex()[1] * (1 << m_ResolutionFactor);
+  firstColumn = this->GetIORegion().GetIndex()[0] * (1 << m_ResolutionFactor);
+
+  // Compute the size of the image region to read at the initial resolution
+  nbLines     = this->GetIORegion().GetSize()[1] * (1 << m_ResolutionFactor);
+  nbColumns   = this->GetIORegion().GetSize()[0] * (1 << m_ResolutionFactor);
+
+  // Check if the image region is correct
+  if (firstLine + nbLines > static_cast<int>(m_OriginalDimensions[1]))
+    nbLines = static_cast<int>(m_OriginalDimensions[1]-firstLine);
+  if (firstColumn + nbColumns > static_cast<int>(m_OriginalDimensions[0]))
+    nbColumns = static_cast<int>(m_OriginalDimensions[0]-firstColumn);
+}
+
+bool GDALImageIO::ReadAs(void* buffer, const std::type_info& componentType,
+                         const std::vector<unsigned int>& bandList)
+{
+  // Indexed and complex data keep their dedicated code path in Read()
+  if (buffer == ITK_NULLPTR || m_IsIndexed || m_IsComplex
+      || GDALDataTypeIsComplex(m_PxType->pixType))
+    {
+    return false;
+    }
+
+  GDALDataType bufferType = GDT_Unknown;
+  if (componentType == typeid(unsigned char))
+    bufferType = GDT_Byte;
+  else if (componentType == typeid(unsigned short))
+    bufferType = GDT_UInt16;
+  else if (componentType == typeid(short))
+    bufferType = GDT_Int16;
+  else if (componentType == typeid(unsigned int))
+    bufferType = GDT_UInt32;
+  else if (componentType == typeid(int))
+    bufferType = GDT_Int32;
+  else if (componentType == typeid(float))
+    bufferType = GDT_Float32;
+  else if (componentType == typeid(double))
+    bufferType = GDT_Float64;
+
+  // Only let GDAL convert when no value can change, so that the result is
+  // the same as the static_cast done by the reader conversion step
+  if (bufferType == GDT_Unknown
+      || GDALDataTypeUnion(m_PxType->pixType, bufferType) != bufferType)
+    {
+    return false;
+    }
+
+  // GDAL band indexes start at 1
+  std::vector<int> bandMap;
+  if (bandList.empty())
+    {
+    for (int i = 1; i <= m_NbBands; ++i)
+      {
+      bandMap.push_back(i);
+      }
+    }
+  else
+    {
+    for (std::vector<unsigned int>::const_iterator it = bandList.begin(); it != bandList.end(); ++it)
+      {
+      if (static_cast<int>(*it) >= m_NbBands)
+        {
+        return false;
+        }
+      bandMap.push_back(static_cast<int>(*it) + 1);
+      }
+    }
+
+  int lNbLinesRegion   = this->GetIORegion().GetSize()[1];
+  int lNbColumnsRegion = this->GetIORegion().GetSize()[0];
+
+  int lFirstLine, lFirstColumn, lNbLines, lNbColumns;
+  this->ComputeReadWindow(lFirstColumn, lFirstLine, lNbColumns, lNbLines);
+
+  int nbBands     = static_cast<int>(bandMap.size());
+  int bandOffset  = GDALGetDataTypeSize(bufferType) / 8;
+  int pixelOffset = bandOffset * nbBands;
+  int lineOffset  = pixelOffset * lNbColumnsRegion;
+
+  otbMsgDevMacro(<< "Parameters RasterIO (direct read): \n"
+                 << " indX = " << lFirstColumn << "\n"
+                 << " indY = " << lFirstLine << "\n"
+                 << " sizeX = " << lNbColumns << "\n"
+                 << " sizeY = " << lNbLines << "\n"
+                 << " GDAL Data Type = " << GDALGetDataTypeName(m_PxType->pixType) << "\n"
+                 << " Buffer Data Type = " << GDALGetDataTypeName(bufferType) << "\n"
+                 << " nbBands = " << nbBands);
+
+  CPLErr lCrGdal = m_Dataset->GetDataSet()->RasterIO(GF_Read,
+                                                     lFirstColumn,
+                                                     lFirstLine,
+                                                     lNbColumns,
+                                                     lNbLines,
+                                                     buffer,
+                                                     lNbColumnsRegion,
+                                                     lNbLinesRegion,
+                                                     bufferType,
+                                                     nbBands,
+                                                     &bandMap[0],
+                                                     pixelOffset,
+                                                     lineOffset,
+                                                     bandOffset);
+  if (lCrGdal == CE_Failure)
+    {
+    itkExceptionMacro(<< "Error while reading image (GDAL format) '"
+      << m_FileName.c_str() << "' : " << CPLGetLastErrorMsg());
+    }
+  return true;
+}
+
 bool GDALImageIO::GetSubDatasetInfo(std::vector<std::string> &names, std::vector<std::string> &desc)
 {
   // Note: we assume that the subdatasets are in order : SUBDATASET_ID_NAME, SUBDATASET_ID_DESC, SUBDATASET_ID+1_NAME, SUBDATASET_ID+1_DESC
@@ -1336,11 +1575,43 @@ bool GDALImageIO::CanStreamWrite()
   return m_CanStreamWrite;
 }
 
+class GDALImageIO::CloudOptimizedTemporaryFileGuard
+{
+public:
+  explicit CloudOptimizedTemporaryFileGuard(GDALImageIO* imageIO)
+    : m_ImageIO(imageIO), m_Released(false)
+  {
+  }
+
+  ~CloudOptimizedTemporaryFileGuard()
+  {
+    if (!m_Released)
+      {
+      m_ImageIO->RemoveCloudOptimizedTemporaryFile();
+      }
+  }
+
+  void Release()
+  {
+    m_Released = true;
+  }
+
+private:
+  GDALImageIO* m_ImageIO;
+  bool         m_Released;
+};
+
 void GDALImageIO::Write(const void* buffer)
 {
+  // Any exception thrown before the end of this method removes the
+  // temporary file of a cloud optimized output
+  CloudOptimizedTemporaryFileGuard temporaryFileGuard(this);
+
   // Check if we have to write the image information
   if (m_FlagWriteImageInformation == true)
     {
+    m_WriteTime = 0.;
+    m_CompressionThreads.clear();
     this->InternalWriteImageInformation(buffer);
     m_FlagWriteImageInformation = false;
     }
@@ -1410,7 +1681,9 @@ void GDALImageIO::Write(const void* buffer)
                                                        // Band offset is BytePerPixel
                                                        m_BytePerPixel);
     chrono.Stop();
-    otbMsgDevMacro(<< "RasterIO Write took " << chrono.GetTotal() << " sec")
+    m_WriteTime += chrono.GetTotal();
+    otbMsgDevMacro(<< "RasterIO Write took " << chrono.GetTotal() << " sec"
+                   << (m_CompressionThreads.empty() ? "" : " (compression threads : " + m_CompressionThreads + ")"))
 
     // Check if writing succeed
     if (lCrGdal == CE_Failure)
@@ -1418,6 +1691,12 @@ void GDALImageIO::Write(const void* buffer)
       itkExceptionMacro(<< "Error while writing image (GDAL format) '"
         << m_FileName.c_str() << "' : " << CPLGetLastErrorMsg());
       }
+
+    if (!m_CloudOptimizedTemporaryFileName.empty())
+      {
+      this->WriteCloudOptimizedOverviews(buffer, lFirstColumn, lFirstLine, lNbColumns, lNbLines);
+      }
+
     // Flush dataset cache
     m_Dataset->GetDataSet()->FlushCache();
     }
@@ -1435,9 +1714,18 @@ void GDALImageIO::Write(const void* buffer)
       }
 
     GDALCreationOptionsType creationOptions = m_CreationOptions;
+    this->AddCompressionThreadsOption(creationOptions, gdalDriverShortName);
+
+    // Idle datasets of a file being overwritten are not valid anymore
+    GDALDriverManagerWrapper::GetInstance().PurgeDatasetCache(realFileName);
+
+    itk::TimeProbe chrono;
+    chrono.Start();
     GDALDataset* hOutputDS = driver->CreateCopy( realFileName.c_str(), m_Dataset->GetDataSet(), FALSE,
                                                  otb::ogr::StringListConverter(creationOptions).to_ogr(),
                                                  ITK_NULLPTR, ITK_NULLPTR );
+    chrono.Stop();
+    m_WriteTime += chrono.GetTotal();
     if(!hOutputDS)
     {
       itkExceptionMacro(<< "Error while writing image (GDAL format) '"
@@ -1454,9 +1742,20 @@ void GDALImageIO::Write(const void* buffer)
       && lFirstColumn + lNbColumns == m_Dimensions[0])
     {
     // Last pixel written
+    if (!m_CloudOptimizedTemporaryFileName.empty())
+      {
+      itk::TimeProbe chrono;
+      chrono.Start();
+      this->FinalizeCloudOptimizedWrite();
+      chrono.Stop();
+      m_WriteTime += chrono.GetTotal();
+      }
+    otbMsgDevMacro(<< "Writing " << m_FileName << " took " << m_WriteTime << " sec"
+                   << (m_CompressionThreads.empty() ? "" : " (compression threads : " + m_CompressionThreads + ")"))
     // Reinitialize to close the file
     m_Dataset = GDALDatasetWrapperPointer();
     }
+  temporaryFileGuard.Release();
 }
 
 /** TODO : Methode WriteImageInformation non implementee */
@@ -1633,12 +1932,80 @@ void GDALImageIO::InternalWriteImageInformation(const void* buffer)
         }
       }
 */
+    std::string fileName = GetGdalWriteImageFileName(driverShortName, m_FileName);
+    this->RemoveCloudOptimizedTemporaryFile();
+    if (m_CloudOptimized && driverShortName != "GTiff")
+      {
+      itkWarningMacro(<< "Cloud optimized writing is only available for GeoTIFF files, "
+                      << m_FileName << " will be written as a regular file.");
+      }
+    else if (m_CloudOptimized)
+      {
+      // The full resolution data and the overviews are written to an
+      // uncompressed tiled file, which is copied to the output in the
+      // cloud optimized layout once the last piece is written. The
+      // GTiff driver can not write the overviews ahead of the data in
+      // a single pass. The file is kept in memory only when the data and
+      // its overviews (a third of the data) take a small part of the RAM
+      // hint, since this memory is not accounted for by the streaming.
+      const double temporaryFileSize = 4. / 3. * m_Dimensions[0] * m_Dimensions[1] * m_NbBands * m_BytePerPixel;
+      const double maxRAMHint = static_cast<double>(ConfigurationManager::GetMaxRAMHint()) * 1024. * 1024.;
+      std::ostringstream temporaryFileName;
+      if (temporaryFileSize <= maxRAMHint / 8.)
+        {
+        temporaryFileName << "/vsimem/otb_cog_" << static_cast<const void*>(this) << ".tif";
+        }
+      else
+        {
+        otbMsgDevMacro(<< "Cloud optimized temporary file of " << temporaryFileSize / (1024. * 1024.)
+                       << " MB exceeds an eighth of the RAM hint, it is written next to " << m_FileName)
+        temporaryFileName << fileName << ".cog.tmp.tif";
+        }
+      std::ostringstream tileSize;
+      tileSize << GetCloudOptimizedTileSize();
+      creationOptions.clear();
+      creationOptions.push_back("TILED=YES");
+      creationOptions.push_back("BLOCKXSIZE=" + tileSize.str());
+      creationOptions.push_back("BLOCKYSIZE=" + tileSize.str());
+      creationOptions.push_back("BIGTIFF=IF_SAFER");
+      m_CloudOptimizedTemporaryFileName = temporaryFileName.str();
+      fileName = m_CloudOptimizedTemporaryFileName;
+      }
+    else
+      {
+      this->AddCompressionThreadsOption(creationOptions, driverShortName);
+      }
+
     m_Dataset = GDALDriverManagerWrapper::GetInstance().Create(
                      driverShortName,
-                     GetGdalWriteImageFileName(driverShortName, m_FileName),
+                     fileName,
                      m_Dimensions[0], m_Dimensions[1],
                      m_NbBands, m_PxType->pixType,
                      otb::ogr::StringListConverter(creationOptions).to_ogr());
+
+    if (!m_CloudOptimizedTemporaryFileName.empty() && m_Dataset.IsNotNull())
+      {
+      // Overviews are added until the smallest one fits in a tile
+      const unsigned int tileSize = GetCloudOptimizedTileSize();
+      const unsigned int largestDimension = std::max(m_Dimensions[0], m_Dimensions[1]);
+      std::vector<int> overviewFactors;
+      while (uint_ceildivpow2(largestDimension, overviewFactors.size()) > tileSize)
+        {
+        overviewFactors.push_back(1 << (overviewFactors.size() + 1));
+        }
+      m_CloudOptimizedOverviewsCount = overviewFactors.size();
+      m_CloudOptimizedFirstRegeneratedLevel = m_CloudOptimizedOverviewsCount + 1;
+
+      // Create the overview levels without computing them, they are
+      // filled from the written pieces
+      if (!overviewFactors.empty()
+          && m_Dataset->GetDataSet()->BuildOverviews("NONE", overviewFactors.size(), &overviewFactors[0],
+                                                     0, ITK_NULLPTR, ITK_NULLPTR, ITK_NULLPTR) == CE_Failure)
+        {
+        itkExceptionMacro(<< "Unable to create the overviews of " << m_CloudOptimizedTemporaryFileName
+                          << " : " << CPLGetLastErrorMsg());
+        }
+      }
     }
   else
     {
@@ -2021,6 +2388,291 @@ bool GDALImageIO::CreationOptionContains(std::string partialOption) const
   return (i != m_CreationOptions.size());
 }
 
+std::string GDALImageIO::GetCreationOptionValue(const std::string& key) const
+{
+  const std::string prefix = key + "=";
+  for (size_t i = 0; i < m_CreationOptions.size(); ++i)
+    {
+    if (boost::algorithm::istarts_with(m_CreationOptions[i], prefix))
+      {
+      return m_CreationOptions[i].substr(prefix.size());
+      }
+    }
+  return std::string();
+}
+
+unsigned int GDALImageIO::GetCacheSizeInBytes()
+{
+  // Same convention as the CacheSizeInBytes metadata of Jpeg2000 files
+  return static_cast<unsigned int>(std::min<GIntBig>(GDALGetCacheMax64(), itk::NumericTraits<unsigned int>::max()));
+}
+
+bool GDALImageIO::GetOutputBlockSize(unsigned int width, unsigned int nbBands, unsigned int bytesPerComponent,
+                                     unsigned int& sizeX, unsigned int& sizeY) const
+{
+  sizeX = 0;
+  sizeY = 0;
+
+  // Only the GTiff block layout can be deduced from the creation options
+  if (FilenameToGdalDriverShortName(m_FileName) != "GTiff")
+    {
+    return false;
+    }
+
+  if (m_CloudOptimized)
+    {
+    sizeX = GetCloudOptimizedTileSize();
+    sizeY = sizeX;
+    return true;
+    }
+
+  const std::string tiled = GetCreationOptionValue("TILED");
+  const std::string blockXSize = GetCreationOptionValue("BLOCKXSIZE");
+  const std::string blockYSize = GetCreationOptionValue("BLOCKYSIZE");
+
+  if (boost::algorithm::iequals(tiled, "YES")
+      || boost::algorithm::iequals(tiled, "ON")
+      || boost::algorithm::iequals(tiled, "TRUE"))
+    {
+    // GTiff driver defaults to 256x256 tiles
+    sizeX = blockXSize.empty() ? 256 : atoi(blockXSize.c_str());
+    sizeY = blockYSize.empty() ? 256 : atoi(blockYSize.c_str());
+    }
+  else if (!blockYSize.empty())
+    {
+    sizeY = atoi(blockYSize.c_str());
+    }
+  else
+    {
+    // Without BLOCKYSIZE, the driver uses the libtiff default strips of
+    // about 8 kB (see TIFFDefaultStripSize())
+    const std::string interleave = GetCreationOptionValue("INTERLEAVE");
+    const unsigned long samplesPerLine = boost::algorithm::iequals(interleave, "BAND") ?
+      width : static_cast<unsigned long>(width) * nbBands;
+    const unsigned long scanlineSize = samplesPerLine * bytesPerComponent;
+    if (scanlineSize == 0)
+      {
+      return false;
+      }
+    sizeY = std::max(8192UL / scanlineSize, 1UL);
+
+    // The JPEG codec rounds strips up to whole MCU rows
+    if (boost::algorithm::iequals(GetCreationOptionValue("COMPRESS"), "JPEG"))
+      {
+      sizeY = ((sizeY + 7) / 8) * 8;
+      }
+    }
+
+  return true;
+}
+
+
+void GDALImageIO::AddCompressionThreadsOption(GDALCreationOptionsType& creationOptions,
+                                              const std::string& driverShortName)
+{
+  m_CompressionThreads = GetCreationOptionValue("NUM_THREADS");
+#if GDAL_VERSION_NUM >= 2010000
+  const std::string compress = GetCreationOptionValue("COMPRESS");
+  if (driverShortName != "GTiff" || compress.empty() || boost::algorithm::iequals(compress, "NONE"))
+    {
+    return;
+    }
+  if (m_CompressionThreads.empty())
+    {
+    const char* configThreads = CPLGetConfigOption("GDAL_NUM_THREADS", ITK_NULLPTR);
+    if (configThreads != ITK_NULLPTR)
+      {
+      m_CompressionThreads = configThreads;
+      }
+    else if (itk::MultiThreader::GetGlobalDefaultNumberOfThreads() > 1)
+      {
+      std::ostringstream nbThreads;
+      nbThreads << itk::MultiThreader::GetGlobalDefaultNumberOfThreads();
+      m_CompressionThreads = nbThreads.str();
+      creationOptions.push_back("NUM_THREADS=" + m_CompressionThreads);
+      }
+    }
+#else
+  (void)creationOptions;
+  (void)driverShortName;
+#endif
+}
+
+unsigned int GDALImageIO::GetCloudOptimizedTileSize() const
+{
+  // Square tiles, 512 pixels wide unless BLOCKXSIZE is given
+  const std::string blockXSize = GetCreationOptionValue("BLOCKXSIZE");
+  const int tileSize = blockXSize.empty() ? 0 : atoi(blockXSize.c_str());
+  return tileSize > 0 ? static_cast<unsigned int>(tileSize) : 512;
+}
+
+void GDALImageIO::WriteCloudOptimizedOverviews(const void* buffer, int firstColumn, int firstLine,
+                                               unsigned int nbColumns, unsigned int nbLines)
+{
+  const GDALDataType componentType = GetComponentDataType(m_PxType->pixType);
+  const unsigned int componentSize = GDALGetDataTypeSize(componentType) / 8;
+  const unsigned int nbComponents = m_NbBands * (GDALDataTypeIsComplex(m_PxType->pixType) ? 2 : 1);
+
+  if (nbComponents * componentSize != static_cast<unsigned int>(m_NbBands * m_BytePerPixel))
+    {
+    // The buffer components do not have the file type (64 bits long
+    // pixels), let GDAL compute all the levels at the end
+    m_CloudOptimizedFirstRegeneratedLevel = 1;
+    return;
+    }
+
+  GDALDataset* dataset = m_Dataset->GetDataSet();
+  itk::MultiThreader::Pointer threader = itk::MultiThreader::New();
+
+  const char*       input = static_cast<const char*>(buffer);
+  unsigned int      inputColumns = nbColumns;
+  unsigned int      inputLines = nbLines;
+  std::vector<char> previousLevel;
+  std::vector<char> currentLevel;
+
+  // Each level is averaged from the previous one
+  for (unsigned int level = 1; level < m_CloudOptimizedFirstRegeneratedLevel; ++level)
+    {
+    // The overview pixels of the piece must not straddle another piece
+    const unsigned int factor = 1u << level;
+    if (firstColumn % factor != 0 || firstLine % factor != 0
+        || (nbColumns % factor != 0 && firstColumn + nbColumns != m_Dimensions[0])
+        || (nbLines % factor != 0 && firstLine + nbLines != m_Dimensions[1]))
+      {
+      otbMsgDevMacro(<< "Written piece not aligned on overview level " << level
+                     << ", this level will be regenerated at the end of the writing");
+      m_CloudOptimizedFirstRegeneratedLevel = level;
+      break;
+      }
+
+    DownsampleByTwoArguments args;
+    args.InputColumns = inputColumns;
+    args.InputLines = inputLines;
+    args.OutputColumns = (inputColumns + 1) / 2;
+    args.OutputLines = (inputLines + 1) / 2;
+    args.NbComponents = nbComponents;
+    args.ComponentType = componentType;
+    currentLevel.resize(static_cast<size_t>(args.OutputColumns) * args.OutputLines * nbComponents * componentSize);
+    args.Input = input;
+    args.Output = &currentLevel[0];
+
+    threader->SetNumberOfThreads(std::max(1u, std::min(
+      static_cast<unsigned int>(itk::MultiThreader::GetGlobalDefaultNumberOfThreads()), args.OutputLines)));
+    threader->SetSingleMethod(DownsampleByTwoThreadCallback, &args);
+    threader->SingleMethodExecute();
+
+    for (int band = 0; band < m_NbBands; ++band)
+      {
+      GDALRasterBand* overview = dataset->GetRasterBand(band + 1)->GetOverview(level - 1);
+      if (overview == ITK_NULLPTR
+          || overview->RasterIO(GF_Write,
+                                firstColumn / factor,
+                                firstLine / factor,
+                                args.OutputColumns,
+                                args.OutputLines,
+                                &currentLevel[band * m_BytePerPixel],
+                                args.OutputColumns,
+                                args.OutputLines,
+                                m_PxType->pixType,
+                                m_BytePerPixel * m_NbBands,
+                                m_BytePerPixel * m_NbBands * args.OutputColumns) == CE_Failure)
+        {
+        itkExceptionMacro(<< "Error while writing overview level " << level << " of image (GDAL format) '"
+                          << m_FileName.c_str() << "' : " << CPLGetLastErrorMsg());
+        }
+      }
+
+    previousLevel.swap(currentLevel);
+    input = &previousLevel[0];
+    inputColumns = args.OutputColumns;
+    inputLines = args.OutputLines;
+    }
+}
+
+void GDALImageIO::FinalizeCloudOptimizedWrite()
+{
+  GDALDataset* dataset = m_Dataset->GetDataSet();
+
+  const unsigned int firstLevel = m_CloudOptimizedFirstRegeneratedLevel;
+  if (firstLevel <= m_CloudOptimizedOverviewsCount)
+    {
+    otbMsgDevMacro(<< "Regenerating overview levels " << firstLevel << " to "
+                   << m_CloudOptimizedOverviewsCount << " of " << m_FileName)
+    for (int band = 0; band < m_NbBands; ++band)
+      {
+      GDALRasterBand* fullResolution = dataset->GetRasterBand(band + 1);
+      GDALRasterBand* source = (firstLevel == 1 ? fullResolution : fullResolution->GetOverview(firstLevel - 2));
+      std::vector<GDALRasterBandH> overviews;
+      for (unsigned int level = firstLevel; level <= m_CloudOptimizedOverviewsCount; ++level)
+        {
+        overviews.push_back(fullResolution->GetOverview(level - 1));
+        }
+      if (GDALRegenerateOverviews(source, overviews.size(), &overviews[0], "AVERAGE",
+                                  ITK_NULLPTR, ITK_NULLPTR) == CE_Failure)
+        {
+        itkExceptionMacro(<< "Error while computing the overviews of image (GDAL format) '"
+                          << m_FileName.c_str() << "' : " << CPLGetLastErrorMsg());
+        }
+      }
+    }
+  dataset->FlushCache();
+
+  // The GTiff driver writes the copied overviews ahead of the full
+  // resolution data, with their IFDs at the beginning of the file
+  std::ostringstream tileSize;
+  tileSize << GetCloudOptimizedTileSize();
+  GDALCreationOptionsType creationOptions;
+  for (size_t i = 0; i < m_CreationOptions.size(); ++i)
+    {
+    if (!boost::algorithm::istarts_with(m_CreationOptions[i], "TILED=")
+        && !boost::algorithm::istarts_with(m_CreationOptions[i], "BLOCKXSIZE=")
+        && !boost::algorithm::istarts_with(m_CreationOptions[i], "BLOCKYSIZE="))
+      {
+      creationOptions.push_back(m_CreationOptions[i]);
+      }
+    }
+  creationOptions.push_back("TILED=YES");
+  creationOptions.push_back("BLOCKXSIZE=" + tileSize.str());
+  creationOptions.push_back("BLOCKYSIZE=" + tileSize.str());
+  creationOptions.push_back("COPY_SRC_OVERVIEWS=YES");
+  this->AddCompressionThreadsOption(creationOptions, "GTiff");
+
+  // Idle datasets of a file being overwritten are not valid anymore
+  const std::string realFileName = GetGdalWriteImageFileName("GTiff", m_FileName);
+  GDALDriverManagerWrapper::GetInstance().PurgeDatasetCache(realFileName);
+
+  GDALDriver* driver = GDALDriverManagerWrapper::GetInstance().GetDriverByName("GTiff");
+  GDALDataset* hOutputDS = driver->CreateCopy(realFileName.c_str(),
+                                              dataset, FALSE,
+                                              otb::ogr::StringListConverter(creationOptions).to_ogr(),
+                                              ITK_NULLPTR, ITK_NULLPTR);
+  const std::string errorMessage = CPLGetLastErrorMsg();
+
+  this->RemoveCloudOptimizedTemporaryFile();
+
+  if (!hOutputDS)
+    {
+    itkExceptionMacro(<< "Error while writing image (GDAL format) '"
+                      << m_FileName.c_str() << "' : " << errorMessage);
+    }
+  GDALClose(hOutputDS);
+}
+
+void GDALImageIO::RemoveCloudOptimizedTemporaryFile()
+{
+  if (m_CloudOptimizedTemporaryFileName.empty())
+    {
+    return;
+    }
+  // The dataset has to be closed before its file is removed
+  m_Dataset = GDALDatasetWrapperPointer();
+  GDALDriver* driver = GDALDriverManagerWrapper::GetInstance().GetDriverByName("GTiff");
+  if (driver == ITK_NULLPTR || GDALDeleteDataset(driver, m_CloudOptimizedTemporaryFileName.c_str()) != CE_None)
+    {
+    VSIUnlink(m_CloudOptimizedTemporaryFileName.c_str());
+    }
+  m_CloudOptimizedTemporaryFileName.clear();
+}
 
 std::string GDALImageIO::GetGdalPixelTypeAsString() const
 {
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "otbGDALImageIO.h"
+#include "otbGDALDriverManagerWrapper.h"
+#include "itkMacro.h"
+#include <iostream>
+
+int otbGDALDatasetCacheTest(int itkNotUsed(argc), char* argv[])
+{
+  otb::GDALDriverManagerWrapper& manager = otb::GDALDriverManagerWrapper::GetInstance();
+  manager.SetDatasetCacheCapacity(2);
+
+  const unsigned long initialHits = manager.GetDatasetCacheHits();
+
+  // First opening: the dataset goes to the cache when the ImageIO is released
+  otb::GDALImageIO::Pointer firstIO = otb::GDALImageIO::New();
+  if (!firstIO->CanReadFile(argv[1]))
+    {
+    std::cerr << "Unable to open " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+    }
+  firstIO = ITK_NULLPTR;
+
+  // Second opening: the cached dataset is handed back
+  otb::GDALImageIO::Pointer secondIO = otb::GDALImageIO::New();
+  if (!secondIO->CanReadFile(argv[1]))
+    {
+    std::cerr << "Unable to open " << argv[1] << " from the cache" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Third opening while the dataset is in use: a new handle is opened
+  otb::GDALImageIO::Pointer thirdIO = otb::GDALImageIO::New();
+  if (!thirdIO->CanReadFile(argv[1]))
+    {
+    std::cerr << "Unable to open " << argv[1] << " twice" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  const unsigned long hits = manager.GetDatasetCacheHits() - initialHits;
+  std::cout << "Cache hits: " << hits << ", misses: " << manager.GetDatasetCacheMisses() << std::endl;
+
+  secondIO = ITK_NULLPTR;
+  thirdIO = ITK_NULLPTR;
+  manager.ClearDatasetCache();
+  manager.SetDatasetCacheCapacity(0);
+
+  if (hits != 1)
+    {
+    std::cerr << "Expected 1 cache hit, got " << hits << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
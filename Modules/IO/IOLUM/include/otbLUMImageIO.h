@@ -22,6 +22,7 @@
 #define otbLUMImageIO_h
 
 #include "otbImageIOBase.h"
+#include "otbMappedFile.h"
 #include <fstream>
 #include <string>
 #include <vector>
@@ -33,7 +34,8 @@ namespace otb
  *
  * \brief ImageIO object for reading (not writing) LUM format images
  *
- * The streaming read is implemented.
+ * The streaming read is implemented. When possible, the file is memory
+ * mapped and regions are copied directly from the mapping.
  *
  * \ingroup IOFilters
  *
@@ -144,6 +146,11 @@ private:
 
   /** Internal method to read header information */
   bool InternalReadHeaderInformation(std::fstream& file, const bool reportError);
+
+  /** Map the file for reading. Returns false if it can not be mapped,
+   * in which case stream reads are used. */
+  bool MapFile();
+
   /** This method get the LUM type */
   int CaiGetTypeLum(const char *          type_code,
                     std::string&   str_sens_code,
@@ -190,6 +197,8 @@ private:
   std::string                 m_TypeLum; //used for write
   otb::ImageIOBase::ByteOrder m_FileByteOrder;
   std::fstream                m_File;
+  MappedFile                  m_MappedFile;
+  bool                        m_MappingAttempted;
 
 };
 
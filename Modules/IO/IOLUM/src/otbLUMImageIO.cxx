@@ -20,6 +20,8 @@
 
 #include "otbLUMImageIO.h"
 
+#include <cstring>
+
 #include "itkByteSwapper.h"
 #include "otbSystem.h"
 #include "itksys/SystemTools.hxx"
@@ -55,6 +57,7 @@ LUMImageIO::LUMImageIO()
   m_Origin[1] = 0.5;
 
   m_FlagWriteImageInformation = true;
+  m_MappingAttempted = false;
 
   //Definition of CAI image type
   m_CaiLumTyp.clear();
@@ -83,6 +86,20 @@ LUMImageIO::~LUMImageIO()
     }
 }
 
+bool LUMImageIO::MapFile()
+{
+  // Mapping is only attempted once per opened image
+  if (!m_MappingAttempted)
+    {
+    m_MappingAttempted = true;
+    if (!m_MappedFile.Open(m_FileName))
+      {
+      otbMsgDevMacro(<< "LUMImageIO: unable to map " << m_FileName << ", using stream reads");
+      }
+    }
+  return m_MappedFile.IsOpen();
+}
+
 bool LUMImageIO::CanReadFile(const char* filename)
 {
   std::string lFileName(filename);
@@ -147,23 +164,58 @@ void LUMImageIO::Read(void* buffer)
   std::streamsize numberOfBytesToBeRead = static_cast<std::streamsize>(this->GetComponentSize() * lNbColumns);
   std::streamsize numberOfBytesRead;
   std::streamsize cpt = 0;
-  for (int LineNo = lFirstLine; LineNo < lFirstLine + lNbLines; LineNo++)
+  if (lNbLines > 0 && this->MapFile())
     {
-    offset  =  headerLength + numberOfBytesPerLines * static_cast<std::streamoff>(LineNo);
+    // Copy the region straight from the mapped file
+    const MappedFile::SizeType regionLength =
+      static_cast<MappedFile::SizeType>(numberOfBytesPerLines) * (lNbLines - 1) + numberOfBytesToBeRead;
+    offset  =  headerLength + numberOfBytesPerLines * static_cast<std::streamoff>(lFirstLine);
     offset +=  static_cast<std::streamoff>(this->GetComponentSize() * lFirstColumn);
-    m_File.seekg(offset, std::ios::beg);
-    m_File.read(static_cast<char *>(p + cpt), numberOfBytesToBeRead);
-    numberOfBytesRead = m_File.gcount();
+    if (!m_MappedFile.Contains(offset, regionLength))
+      {
+      itkExceptionMacro(<< "LUMImageIO::Read() Can Read the specified Region"); // read failed
+      }
+    const char * src = m_MappedFile.GetData() + offset;
+
+    if (numberOfBytesToBeRead == numberOfBytesPerLines)
+      {
+      // Whole lines: the region is contiguous
+      memcpy(p, src, static_cast<size_t>(regionLength));
+      }
+    else
+      {
+      for (int LineNo = 0; LineNo < lNbLines; ++LineNo, src += numberOfBytesPerLines)
+        {
+        memcpy(p + cpt, src, static_cast<size_t>(numberOfBytesToBeRead));
+        cpt += numberOfBytesToBeRead;
+        }
+      }
+
+    // Streaming goes down the image: prefetch the lines of the next region
+    m_MappedFile.WillNeed(
+      headerLength + numberOfBytesPerLines * static_cast<std::streamoff>(lFirstLine + lNbLines),
+      static_cast<MappedFile::SizeType>(numberOfBytesPerLines) * lNbLines);
+    }
+  else
+    {
+    for (int LineNo = lFirstLine; LineNo < lFirstLine + lNbLines; LineNo++)
+      {
+      offset  =  headerLength + numberOfBytesPerLines * static_cast<std::streamoff>(LineNo);
+      offset +=  static_cast<std::streamoff>(this->GetComponentSize() * lFirstColumn);
+      m_File.seekg(offset, std::ios::beg);
+      m_File.read(static_cast<char *>(p + cpt), numberOfBytesToBeRead);
+      numberOfBytesRead = m_File.gcount();
 #ifdef __APPLE_CC__
-    // fail() is broken in the Mac. It returns true when reaches eof().
-    if (numberOfBytesRead != numberOfBytesToBeRead)
+      // fail() is broken in the Mac. It returns true when reaches eof().
+      if (numberOfBytesRead != numberOfBytesToBeRead)
 #else
-    if ((numberOfBytesRead != numberOfBytesToBeRead)  || m_File.fail())
+      if ((numberOfBytesRead != numberOfBytesToBeRead)  || m_File.fail())
 #endif
-      {
-      itkExceptionMacro(<< "LUMImageIO::Read() Can Read the specified Region"); // read failed
+        {
+        itkExceptionMacro(<< "LUMImageIO::Read() Can Read the specified Region"); // read failed
+        }
+      cpt += numberOfBytesToBeRead;
       }
-    cpt += numberOfBytesToBeRead;
     }
 
   unsigned long numberOfPixelsPerLines = lNbLines * lNbColumns;
@@ -191,6 +243,8 @@ void LUMImageIO::ReadImageInformation()
     {
     m_File.close();
     }
+  m_MappedFile.Close();
+  m_MappingAttempted = false;
 
   m_File.open(m_FileName.c_str(),  std::ios::in | std::ios::binary);
   if (m_File.fail())
@@ -395,6 +449,8 @@ void LUMImageIO::WriteImageInformation()
     {
     m_File.close();
     }
+  m_MappedFile.Close();
+  m_MappingAttempted = false;
 
   // Open the new file for writing
   // Actually open the file
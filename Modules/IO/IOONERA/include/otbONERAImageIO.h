@@ -23,6 +23,7 @@
 
 #include "itkByteSwapper.h"
 #include "otbImageIOBase.h"
+#include "otbMappedFile.h"
 #include <fstream>
 
 namespace otb
@@ -32,7 +33,8 @@ namespace otb
  *
  * \brief ImageIO object for reading (not writing) ONERA format images
  *
- * The streaming read is implemented.
+ * The streaming read is implemented. When possible, the data file is
+ * memory mapped and regions are copied directly from the mapping.
  *
  * \ingroup IOFilters
  *
@@ -131,6 +133,10 @@ protected:
   bool OpenOneraHeaderFileForReading(const char* filename);
   void InternalReadImageInformation();
 
+  /** Map the data file for reading. Returns false if it can not be
+   * mapped, in which case stream reads are used. */
+  bool MapFile();
+
   void InternalWriteImageInformation();
 
   bool OpenOneraDataFileForWriting(const char* filename);
@@ -148,6 +154,8 @@ protected:
   //float **pafimas;
   std::fstream m_Datafile;
   std::fstream m_Headerfile;
+  MappedFile   m_MappedFile;
+  bool         m_MappingAttempted;
 
 private:
   ONERAImageIO(const Self &); //purposely not implemented
@@ -49,6 +49,7 @@ ONERAImageIO::ONERAImageIO()
   m_Origin[1] = 0.5;
 
   m_FlagWriteImageInformation = true;
+  m_MappingAttempted = false;
 
   if (itk::ByteSwapper<char>::SystemIsLittleEndian() == true)
     {
@@ -185,40 +186,78 @@ void ONERAImageIO::Read(void* buffer)
   otbMsgDevMacro(<< " Region read (IORegion)  : " << this->GetIORegion());
   otbMsgDevMacro(<< " Nb Of Components  : " << this->GetNumberOfComponents());
 
-  //read header information file:
-  if (!this->OpenOneraDataFileForReading(m_FileName.c_str()))
-    {
-    itkExceptionMacro(<< "Cannot read requested file");
-    }
-
   std::streamoff  numberOfBytesPerLines = static_cast<std::streamoff>(2 * m_width * m_BytePerPixel);
   std::streamoff  headerLength = ONERA_HEADER_LENGTH + numberOfBytesPerLines;
   std::streamoff  offset;
   std::streamsize numberOfBytesToBeRead = 2 * m_BytePerPixel * lNbColumns;
   std::streamsize numberOfBytesRead;
-
-  char*           value = new char[numberOfBytesToBeRead];
   std::streamsize cpt = 0;
 
-  for (int LineNo = lFirstLine; LineNo < lFirstLine + lNbLines; LineNo++)
+  if (lNbLines > 0 && this->MapFile())
     {
-    offset  =  headerLength + numberOfBytesPerLines * static_cast<std::streamoff>(LineNo);
+    // Copy the region straight from the mapped data file
+    const MappedFile::SizeType regionLength =
+      static_cast<MappedFile::SizeType>(numberOfBytesPerLines) * (lNbLines - 1) + numberOfBytesToBeRead;
+    offset  =  headerLength + numberOfBytesPerLines * static_cast<std::streamoff>(lFirstLine);
     offset +=  static_cast<std::streamoff>(m_BytePerPixel * lFirstColumn);
-    m_Datafile.seekg(offset, std::ios::beg);
-    m_Datafile.read(static_cast<char *>(value), numberOfBytesToBeRead);
-    numberOfBytesRead = m_Datafile.gcount();
+    if (!m_MappedFile.Contains(offset, regionLength))
+      {
+      itkExceptionMacro(<< "ONERAImageIO::Read() Can Read the specified Region"); // read failed
+      }
+    const char * src = m_MappedFile.GetData() + offset;
+
+    if (numberOfBytesToBeRead == numberOfBytesPerLines)
+      {
+      // Whole lines: the region is contiguous
+      memcpy(p, src, static_cast<size_t>(regionLength));
+      }
+    else
+      {
+      for (int LineNo = 0; LineNo < lNbLines; ++LineNo, src += numberOfBytesPerLines)
+        {
+        memcpy(p + cpt, src, static_cast<size_t>(numberOfBytesToBeRead));
+        cpt += numberOfBytesToBeRead;
+        }
+      }
+
+    // Streaming goes down the image: prefetch the lines of the next region
+    m_MappedFile.WillNeed(
+      headerLength + numberOfBytesPerLines * static_cast<std::streamoff>(lFirstLine + lNbLines),
+      static_cast<MappedFile::SizeType>(numberOfBytesPerLines) * lNbLines);
+    }
+  else
+    {
+    //read header information file:
+    if (!this->OpenOneraDataFileForReading(m_FileName.c_str()))
+      {
+      itkExceptionMacro(<< "Cannot read requested file");
+      }
+
+    char*           value = new char[numberOfBytesToBeRead];
+
+    for (int LineNo = lFirstLine; LineNo < lFirstLine + lNbLines; LineNo++)
+      {
+      offset  =  headerLength + numberOfBytesPerLines * static_cast<std::streamoff>(LineNo);
+      offset +=  static_cast<std::streamoff>(m_BytePerPixel * lFirstColumn);
+      m_Datafile.seekg(offset, std::ios::beg);
+      m_Datafile.read(static_cast<char *>(value), numberOfBytesToBeRead);
+      numberOfBytesRead = m_Datafile.gcount();
 #ifdef __APPLE_CC__
-    // fail() is broken in the Mac. It returns true when reaches eof().
-    if (numberOfBytesRead != numberOfBytesToBeRead)
+      // fail() is broken in the Mac. It returns true when reaches eof().
+      if (numberOfBytesRead != numberOfBytesToBeRead)
 #else
-    if ((numberOfBytesRead != numberOfBytesToBeRead)  || m_Datafile.fail())
+      if ((numberOfBytesRead != numberOfBytesToBeRead)  || m_Datafile.fail())
 #endif
-      {
-      itkExceptionMacro(<< "ONERAImageIO::Read() Can Read the specified Region"); // read failed
+        {
+        itkExceptionMacro(<< "ONERAImageIO::Read() Can Read the specified Region"); // read failed
+        }
+
+      memcpy((void*) (&(p[cpt])), (const void*) (value), (size_t) (numberOfBytesToBeRead));
+      cpt += numberOfBytesToBeRead;
       }
 
-    memcpy((void*) (&(p[cpt])), (const void*) (value), (size_t) (numberOfBytesToBeRead));
-    cpt += numberOfBytesToBeRead;
+    delete[] value;
+    value = ITK_NULLPTR;
     }
 
   //byte swapping depending on pixel type:
@@ -231,10 +270,21 @@ void ONERAImageIO::Read(void* buffer)
     {
     itkExceptionMacro(<< "ONERAImageIO::Read() undefined component type! ");
     }
+}
 
-  delete[] value;
-  value = ITK_NULLPTR;
-
+bool ONERAImageIO::MapFile()
+{
+  // Mapping is only attempted once per opened image
+  if (!m_MappingAttempted)
+    {
+    m_MappingAttempted = true;
+    const std::string DataFileName = System::GetRootName(m_FileName) + ".dat";
+    if (!m_MappedFile.Open(DataFileName))
+      {
+      otbMsgDevMacro(<< "ONERAImageIO: unable to map " << DataFileName << ", using stream reads");
+      }
+    }
+  return m_MappedFile.IsOpen();
 }
 
 bool ONERAImageIO::OpenOneraDataFileForReading(const char* filename)
@@ -294,6 +344,8 @@ bool ONERAImageIO::OpenOneraHeaderFileForReading(const char* filename)
 
 void ONERAImageIO::ReadImageInformation()
 {
+  m_MappedFile.Close();
+  m_MappingAttempted = false;
   this->InternalReadImageInformation();
 }
 
@@ -410,6 +462,8 @@ bool ONERAImageIO::OpenOneraDataFileForWriting(const char* filename)
     {
     m_Datafile.close();
     }
+  m_MappedFile.Close();
+  m_MappingAttempted = false;
   const std::string DataFileName = System::GetRootName(filename) + ".dat";
 
   // Open the new file for reading
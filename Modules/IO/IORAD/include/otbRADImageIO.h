@@ -29,11 +29,14 @@
 namespace otb
 {
 
+class MappedFile;
+
 /** \class RADImageIO
  *
  * \brief ImageIO object for reading (not writing) RAD format images
  *
- * The streaming read is implemented.
+ * The streaming read is implemented. When possible, the channel files
+ * are memory mapped and regions are copied directly from the mapping.
  *
  * \ingroup IOFilters
  *
@@ -147,6 +150,13 @@ private:
   /** Internal method to read header information */
   bool InternalReadHeaderInformation(const std::string& file_name, std::fstream& file, const bool reportError);
 
+  /** Map the channel files for reading. Returns false if they can not
+   * all be mapped, in which case stream reads are used. */
+  bool MapChannelsFiles();
+
+  /** Release the channel files mappings */
+  void UnmapChannelsFiles();
+
 #define otbSwappFileOrderToSystemOrderMacro(StrongType, buffer, buffer_size) \
     { \
     typedef itk::ByteSwapper<StrongType> InternalByteSwapperType; \
@@ -181,6 +191,7 @@ private:
   std::string                 m_TypeRAD;
   std::vector<std::string>    m_ChannelsFileName;
   std::fstream *              m_ChannelsFile;
+  MappedFile *                m_ChannelsMappedFile;
   unsigned int                m_NbOfChannels;
   int                         m_BytePerPixel;
 
@@ -25,6 +25,7 @@
 
 #include "itkByteSwapper.h"
 #include "otbSystem.h"
+#include "otbMappedFile.h"
 #include "itksys/SystemTools.hxx"
 
 #include "otbMacro.h"
@@ -65,6 +66,7 @@ RADImageIO::RADImageIO()
   m_Origin[0] = 0.5;
   m_Origin[1] = 0.5;
   m_ChannelsFile = ITK_NULLPTR;
+  m_ChannelsMappedFile = ITK_NULLPTR;
   m_FlagWriteImageInformation = true;
 
   this->AddSupportedWriteExtension(".rad");
@@ -93,6 +95,7 @@ RADImageIO::~RADImageIO()
       }
     delete[] m_ChannelsFile;
     }
+  this->UnmapChannelsFiles();
 }
 
 bool RADImageIO::CanReadFile(const char* filename)
@@ -160,48 +163,101 @@ void RADImageIO::Read(void* buffer)
   // Update the step variable
   step = step * (unsigned long) (this->GetComponentSize());
 
-  char * value = new char[numberOfBytesToBeRead];
-  if (value == ITK_NULLPTR)
+  if (lNbLines > 0 && this->MapChannelsFiles())
     {
-    itkExceptionMacro(<< "RADImageIO::Read(): Bad alloc");
-    return;
-    }
+    // Copy the region straight from the mapped channel files
+    const MappedFile::SizeType regionLength =
+      static_cast<MappedFile::SizeType>(numberOfBytesPerLines) * (lNbLines - 1) + numberOfBytesToBeRead;
+    for (unsigned int numChannel = 0; numChannel < m_NbOfChannels; ++numChannel)
+      {
+      const MappedFile& mappedFile = m_ChannelsMappedFile[numChannel];
+      offset  =  headerLength + numberOfBytesPerLines * static_cast<std::streamoff>(lFirstLine);
+      offset +=  static_cast<std::streamoff>(m_BytePerPixel * lFirstColumn);
+      if (!mappedFile.Contains(offset, regionLength))
+        {
+        itkExceptionMacro(<< "RADImageIO::Read() Can Read the specified Region"); // read failed
+        }
+      const char * src = mappedFile.GetData() + offset;
 
-  otbMsgDevMacro(<< " sizeof(streamsize)    : " << sizeof(std::streamsize));
-  otbMsgDevMacro(<< " sizeof(streampos)     : " << sizeof(std::streampos));
-  otbMsgDevMacro(<< " sizeof(streamoff)     : " << sizeof(std::streamoff));
-  otbMsgDevMacro(<< " sizeof(std::ios::beg) : " << sizeof(std::ios::beg));
-  otbMsgDevMacro(<< " sizeof(size_t)        : " << sizeof(size_t));
-  otbMsgDevMacro(<< " sizeof(unsigned long) : " << sizeof(unsigned long));
+      if (m_NbOfChannels == 1 && numberOfBytesToBeRead == numberOfBytesPerLines)
+        {
+        // Whole lines of a single channel: the region is contiguous
+        memcpy(p, src, static_cast<size_t>(regionLength));
+        }
+      else if (m_NbOfChannels == 1)
+        {
+        for (int LineNo = 0; LineNo < lNbLines; ++LineNo, src += numberOfBytesPerLines)
+          {
+          memcpy(p + cpt, src, static_cast<size_t>(numberOfBytesToBeRead));
+          cpt += numberOfBytesToBeRead;
+          }
+        }
+      else
+        {
+        cpt = (unsigned long) (numChannel) * (unsigned long) (m_BytePerPixel);
+        for (int LineNo = 0; LineNo < lNbLines; ++LineNo, src += numberOfBytesPerLines)
+          {
+          for (std::streamsize i = 0; i < numberOfBytesToBeRead; i = i + static_cast<std::streamsize>(m_BytePerPixel))
+            {
+            memcpy((void*) (&(p[cpt])), (const void*) (&(src[i])), (size_t) (m_BytePerPixel));
+            cpt += step;
+            }
+          }
+        }
 
-  for (unsigned int numChannel = 0; numChannel < m_NbOfChannels; ++numChannel)
+      // Streaming goes down the image: prefetch the lines of the next region
+      mappedFile.WillNeed(
+        headerLength + numberOfBytesPerLines * static_cast<std::streamoff>(lFirstLine + lNbLines),
+        static_cast<MappedFile::SizeType>(numberOfBytesPerLines) * lNbLines);
+      }
+    }
+  else
     {
-    cpt = (unsigned long) (numChannel) * (unsigned long) (m_BytePerPixel);
-    //Read region of the channel
-    for (int LineNo = lFirstLine; LineNo < lFirstLine + lNbLines; LineNo++)
+    char * value = new char[numberOfBytesToBeRead];
+    if (value == ITK_NULLPTR)
       {
-      offset  =  headerLength + numberOfBytesPerLines * static_cast<std::streamoff>(LineNo);
-      offset +=  static_cast<std::streamoff>(m_BytePerPixel * lFirstColumn);
-      m_ChannelsFile[numChannel].seekg(offset, std::ios::beg);
-      //Read a line
-      m_ChannelsFile[numChannel].read(static_cast<char *>(value), numberOfBytesToBeRead);
+      itkExceptionMacro(<< "RADImageIO::Read(): Bad alloc");
+      return;
+      }
+
+    otbMsgDevMacro(<< " sizeof(streamsize)    : " << sizeof(std::streamsize));
+    otbMsgDevMacro(<< " sizeof(streampos)     : " << sizeof(std::streampos));
+    otbMsgDevMacro(<< " sizeof(streamoff)     : " << sizeof(std::streamoff));
+    otbMsgDevMacro(<< " sizeof(std::ios::beg) : " << sizeof(std::ios::beg));
+    otbMsgDevMacro(<< " sizeof(size_t)        : " << sizeof(size_t));
+    otbMsgDevMacro(<< " sizeof(unsigned long) : " << sizeof(unsigned long));
 
-      numberOfBytesRead = m_ChannelsFile[numChannel].gcount();
+    for (unsigned int numChannel = 0; numChannel < m_NbOfChannels; ++numChannel)
+      {
+      cpt = (unsigned long) (numChannel) * (unsigned long) (m_BytePerPixel);
+      //Read region of the channel
+      for (int LineNo = lFirstLine; LineNo < lFirstLine + lNbLines; LineNo++)
+        {
+        offset  =  headerLength + numberOfBytesPerLines * static_cast<std::streamoff>(LineNo);
+        offset +=  static_cast<std::streamoff>(m_BytePerPixel * lFirstColumn);
+        m_ChannelsFile[numChannel].seekg(offset, std::ios::beg);
+        //Read a line
+        m_ChannelsFile[numChannel].read(static_cast<char *>(value), numberOfBytesToBeRead);
+
+        numberOfBytesRead = m_ChannelsFile[numChannel].gcount();
 #ifdef __APPLE_CC__
-      // fail() is broken in the Mac. It returns true when reaches eof().
-      if (numberOfBytesRead != numberOfBytesToBeRead)
+        // fail() is broken in the Mac. It returns true when reaches eof().
+        if (numberOfBytesRead != numberOfBytesToBeRead)
 #else
-      if ((numberOfBytesRead != numberOfBytesToBeRead)  || m_ChannelsFile[numChannel].fail())
+        if ((numberOfBytesRead != numberOfBytesToBeRead)  || m_ChannelsFile[numChannel].fail())
 #endif
-        {
-        itkExceptionMacro(<< "RADImageIO::Read() Can Read the specified Region"); // read failed
-        }
-      for (std::streamsize i = 0; i < numberOfBytesToBeRead; i = i + static_cast<std::streamsize>(m_BytePerPixel))
-        {
-        memcpy((void*) (&(p[cpt])), (const void*) (&(value[i])), (size_t) (m_BytePerPixel));
-        cpt += step;
+          {
+          itkExceptionMacro(<< "RADImageIO::Read() Can Read the specified Region"); // read failed
+          }
+        for (std::streamsize i = 0; i < numberOfBytesToBeRead; i = i + static_cast<std::streamsize>(m_BytePerPixel))
+          {
+          memcpy((void*) (&(p[cpt])), (const void*) (&(value[i])), (size_t) (m_BytePerPixel));
+          cpt += step;
+          }
         }
       }
+    delete[] value;
+    value = ITK_NULLPTR;
     }
   unsigned long numberOfPixelsOfRegion = lNbLines * lNbColumns * this->GetNumberOfComponents();
 
@@ -221,10 +277,38 @@ void RADImageIO::Read(void* buffer)
     {
     itkExceptionMacro(<< "RADImageIO::Read() undefined component type! ");
     }
+}
 
-  delete[] value;
-  value = ITK_NULLPTR;
+bool RADImageIO::MapChannelsFiles()
+{
+  if (m_ChannelsFileName.empty())
+    {
+    return false;
+    }
+  // Mapping is only attempted once per opened image
+  if (m_ChannelsMappedFile == ITK_NULLPTR)
+    {
+    m_ChannelsMappedFile = new MappedFile[m_ChannelsFileName.size()];
+    for (unsigned int channels = 0; channels < m_ChannelsFileName.size(); ++channels)
+      {
+      if (!m_ChannelsMappedFile[channels].Open(m_ChannelsFileName[channels]))
+        {
+        otbMsgDevMacro(<< "RADImageIO: unable to map " << m_ChannelsFileName[channels] << ", using stream reads");
+        for (unsigned int i = 0; i < channels; ++i)
+          {
+          m_ChannelsMappedFile[i].Close();
+          }
+        break;
+        }
+      }
+    }
+  return m_ChannelsMappedFile[m_ChannelsFileName.size() - 1].IsOpen();
+}
 
+void RADImageIO::UnmapChannelsFiles()
+{
+  delete[] m_ChannelsMappedFile;
+  m_ChannelsMappedFile = ITK_NULLPTR;
 }
 
 void RADImageIO::ReadImageInformation()
@@ -465,6 +549,7 @@ bool RADImageIO::InternalReadHeaderInformation(const std::string& file_name, std
     }
   file.close();
 
+  this->UnmapChannelsFiles();
   m_ChannelsFile = new std::fstream[m_NbOfChannels];
 
   // Try to open channels file
@@ -735,6 +820,7 @@ void RADImageIO::WriteImageInformation()
   m_HeaderFile.close();
 
   //Allocate  buffer of stream file
+  this->UnmapChannelsFiles();
   m_ChannelsFile = new std::fstream[m_NbOfChannels];
 
   //Try to open channels file
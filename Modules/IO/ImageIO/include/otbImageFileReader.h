@@ -32,10 +32,12 @@
 #include "otbImageIOBase.h"
 #include "itkExceptionObject.h"
 #include "itkImageRegion.h"
+#include "itkMultiThreader.h"
 
 #include "otbDefaultConvertPixelTraits.h"
 #include "otbImageKeywordlist.h"
 #include "otbExtendedFilenameToReaderOptions.h"
+#include "otbRegionPrefetcher.h"
 
 namespace otb
 {
@@ -76,6 +78,13 @@ public:
  * http://wiki.orfeo-toolbox.org/index.php/ExtendedFileName for more
  * information.
  *
+ * ImageFileReader can read ahead (see RegionPrefetcher): when the region
+ * of the next update has been recorded, it is read by a background thread
+ * as soon as the current update is done, and its buffer is handed over to
+ * the output if the next update requests it. This overlaps the reading
+ * latency with the downstream processing, at the cost of a second output
+ * buffer.
+ *
  * \sa ExtendedFilenameToReaderOptions
  * \sa ImageSeriesReader
  * \sa ImageIOBase
@@ -88,7 +97,7 @@ public:
 template <class TOutputImage,
           class ConvertPixelTraits=DefaultConvertPixelTraits<
                    typename TOutputImage::IOPixelType > >
-class ITK_EXPORT ImageFileReader : public itk::ImageSource<TOutputImage>
+class ITK_EXPORT ImageFileReader : public itk::ImageSource<TOutputImage>, public RegionPrefetcher
 {
 public:
   /** Standard class typedefs. */
@@ -130,6 +139,11 @@ public:
    * enlarge the RequestedRegion to the size of the image on disk. */
   void EnlargeOutputRequestedRegion(itk::DataObject *output) ITK_OVERRIDE;
 
+  /** Record the current output requested region as the region of the
+   * next update: it will be read in background at the end of the current
+   * GenerateData(). */
+  void RecordNextRequestedRegion() ITK_OVERRIDE;
+
   /** Set/Get the ImageIO helper class. Often this is created via the object
    * factory mechanism that determines whether a particular ImageIO can
    * read a certain file. This method provides a way to get the ImageIO
@@ -164,6 +178,9 @@ protected:
   /** Convert a block of pixels from one type to another. */
   void DoConvertBuffer(void* buffer, size_t numberOfPixels);
 
+  /** Convert a block of pixels into the buffer of the given image. */
+  void DoConvertBuffer(void* buffer, size_t numberOfPixels, TOutputImage* image);
+
 private:
   /** Test whether m_ImageIO is valid (not NULL). This is intended to be called
    * after trying to create it via an ImageIOFactory. Throws an exception with
@@ -177,6 +194,18 @@ private:
 
   // Retrieve the real source file name if derived dataset */
   std::string GetDerivedDatasetSourceFileName(const std::string& filename) const;
+
+  /** Read the buffered region of the given image into its buffer */
+  void ReadRegion(TOutputImage* image);
+
+  /** Start reading the recorded next requested region in background */
+  void StartPrefetch();
+
+  /** Wait for the background reading to be done */
+  void WaitForPrefetch();
+
+  /** Entry point of the prefetch thread */
+  static ITK_THREAD_RETURN_TYPE PrefetchThreadCallback(void * arg);
   
   ImageFileReader(const Self &); //purposely not implemented
   void operator =(const Self&); //purposely not implemented
@@ -207,6 +236,15 @@ private:
    *  This variable can be the number of components in m_ImageIO or the
    *  number of components in the m_BandList (if used) */
   unsigned int m_IOComponents;
+
+  /** Read ahead of the next requested region */
+  ImageRegionType                m_NextRequestedRegion;
+  bool                           m_NextRequestedRegionIsSet;
+  typename TOutputImage::Pointer m_PrefetchImage;
+  bool                           m_PrefetchFailed;
+  itk::MultiThreader::Pointer    m_PrefetchThreader;
+  itk::ThreadIdType              m_PrefetchThreadId;
+  bool                           m_PrefetchThreadRunning;
 };
 
 } //namespace otb
@@ -26,6 +26,7 @@
 
 #include "otbSystem.h"
 #include <itksys/SystemTools.hxx>
+#include <algorithm>
 #include <fstream>
 #include <string>
 
@@ -36,6 +37,7 @@
 
 #include "otbConvertPixelBuffer.h"
 #include "otbImageIOFactory.h"
+#include "otbGDALImageIO.h"
 #include "otbMetaDataKey.h"
 
 #include "otbMacro.h"
@@ -69,7 +71,13 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>
    m_FilenameHelper(FNameHelperType::New()),
    m_AdditionalNumber(0),
    m_KeywordListUpToDate(false),
-   m_IOComponents(0)
+   m_IOComponents(0),
+   m_NextRequestedRegionIsSet(false),
+   m_PrefetchImage(),
+   m_PrefetchFailed(false),
+   m_PrefetchThreader(),
+   m_PrefetchThreadId(0),
+   m_PrefetchThreadRunning(false)
 {
 }
 
@@ -77,6 +85,7 @@ template <class TOutputImage, class ConvertPixelTraits>
 ImageFileReader<TOutputImage, ConvertPixelTraits>
 ::~ImageFileReader()
 {
+  this->WaitForPrefetch();
 }
 
 template <class TOutputImage, class ConvertPixelTraits>
@@ -108,6 +117,7 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>
 ::SetImageIO( otb::ImageIOBase * imageIO)
 {
   itkDebugMacro("setting ImageIO to " << imageIO );
+  this->WaitForPrefetch();
   if (this->m_ImageIO != imageIO )
     {
     this->m_ImageIO = imageIO;
@@ -124,10 +134,34 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>
 
   typename TOutputImage::Pointer output = this->GetOutput();
 
-  // allocate the output buffer
-  output->SetBufferedRegion(output->GetRequestedRegion());
-  output->Allocate();
+  // Hand over the region read in background if it is the requested one
+  this->WaitForPrefetch();
+  if (m_PrefetchImage.IsNotNull() && !m_PrefetchFailed
+      && m_PrefetchImage->GetBufferedRegion() == output->GetRequestedRegion())
+    {
+    otbMsgDevMacro(<< "Using prefetched region " << output->GetRequestedRegion());
+    output->SetBufferedRegion(output->GetRequestedRegion());
+    output->SetPixelContainer(m_PrefetchImage->GetPixelContainer());
+    }
+  else
+    {
+    // allocate the output buffer
+    output->SetBufferedRegion(output->GetRequestedRegion());
+    output->Allocate();
+
+    this->ReadRegion(output);
+    }
+  m_PrefetchImage = ITK_NULLPTR;
+
+  // Read the region of the next update while the current one is processed
+  this->StartPrefetch();
+}
 
+template <class TOutputImage, class ConvertPixelTraits>
+void
+ImageFileReader<TOutputImage, ConvertPixelTraits>
+::ReadRegion(TOutputImage* output)
+{
   // Raise an exception if the file could not be opened
   // i.e. if this->m_ImageIO is Null
   this->TestValidImageIO();
@@ -194,6 +228,17 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>
     }
   else // a type conversion is necessary
     {
+    // When the conversion only casts the components, let the ImageIO
+    // convert and select the bands while reading into the output buffer
+    const bool isVectorImage = (strcmp(output->GetNameOfClass(), "VectorImage") == 0);
+    if ((isVectorImage || ConvertOutputPixelTraits::GetNumberOfComponents() == m_IOComponents)
+        && this->m_ImageIO->ReadAs(buffer,
+                                   typeid(typename ConvertOutputPixelTraits::ComponentType),
+                                   m_BandList))
+      {
+      return;
+      }
+
     // note: char is used here because the buffer is read in bytes
     // regardless of the actual type of the pixels.
     ImageRegionType region = output->GetBufferedRegion();
@@ -218,12 +263,96 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>
     if (m_FilenameHelper->BandRangeIsSet())
       this->m_ImageIO->DoMapBuffer(loadBuffer, region.GetNumberOfPixels(), this->m_BandList);
 
-    this->DoConvertBuffer(loadBuffer, region.GetNumberOfPixels());
+    this->DoConvertBuffer(loadBuffer, region.GetNumberOfPixels(), output);
 
     delete[] loadBuffer;
     }
 }
 
+template <class TOutputImage, class ConvertPixelTraits>
+void
+ImageFileReader<TOutputImage, ConvertPixelTraits>
+::RecordNextRequestedRegion()
+{
+  m_NextRequestedRegion = this->GetOutput()->GetRequestedRegion();
+  m_NextRequestedRegionIsSet = true;
+}
+
+template <class TOutputImage, class ConvertPixelTraits>
+void
+ImageFileReader<TOutputImage, ConvertPixelTraits>
+::StartPrefetch()
+{
+  if (!m_NextRequestedRegionIsSet)
+    {
+    return;
+    }
+  m_NextRequestedRegionIsSet = false;
+
+  TOutputImage * output = this->GetOutput();
+
+  // Nothing to read ahead if the whole image is read at once, or if the
+  // next region is already buffered
+  if (!this->m_ImageIO->CanStreamRead()
+      || m_NextRequestedRegion.GetNumberOfPixels() == 0
+      || output->GetBufferedRegion().IsInside(m_NextRequestedRegion)
+      || !output->GetLargestPossibleRegion().IsInside(m_NextRequestedRegion))
+    {
+    return;
+    }
+
+  m_PrefetchImage = TOutputImage::New();
+  m_PrefetchImage->CopyInformation(output);
+  m_PrefetchImage->SetNumberOfComponentsPerPixel(output->GetNumberOfComponentsPerPixel());
+  m_PrefetchImage->SetBufferedRegion(m_NextRequestedRegion);
+  m_PrefetchImage->SetRequestedRegion(m_NextRequestedRegion);
+  m_PrefetchImage->Allocate();
+  m_PrefetchFailed = false;
+
+  if (m_PrefetchThreader.IsNull())
+    {
+    m_PrefetchThreader = itk::MultiThreader::New();
+    }
+
+  otbMsgDevMacro(<< "Prefetching region " << m_NextRequestedRegion);
+  m_PrefetchThreadId = m_PrefetchThreader->SpawnThread(PrefetchThreadCallback, this);
+  m_PrefetchThreadRunning = true;
+}
+
+template <class TOutputImage, class ConvertPixelTraits>
+void
+ImageFileReader<TOutputImage, ConvertPixelTraits>
+::WaitForPrefetch()
+{
+  if (m_PrefetchThreadRunning)
+    {
+    // Joins the prefetch thread
+    m_PrefetchThreader->TerminateThread(m_PrefetchThreadId);
+    m_PrefetchThreadRunning = false;
+    }
+}
+
+template <class TOutputImage, class ConvertPixelTraits>
+ITK_THREAD_RETURN_TYPE
+ImageFileReader<TOutputImage, ConvertPixelTraits>
+::PrefetchThreadCallback(void * arg)
+{
+  struct itk::MultiThreader::ThreadInfoStruct * pInfo = (itk::MultiThreader::ThreadInfoStruct *) (arg);
+  Self * reader = static_cast<Self *>(pInfo->UserData);
+
+  try
+    {
+    reader->ReadRegion(reader->m_PrefetchImage);
+    }
+  catch (...)
+    {
+    // The region will be read again synchronously, which reports the error
+    reader->m_PrefetchFailed = true;
+    }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
 template <class TOutputImage, class ConvertPixelTraits>
 void
 ImageFileReader<TOutputImage, ConvertPixelTraits>
@@ -251,6 +380,9 @@ void
 ImageFileReader<TOutputImage, ConvertPixelTraits>
 ::GenerateOutputInformation(void)
 {
+  // The ImageIO may be reading ahead
+  this->WaitForPrefetch();
+
   typename TOutputImage::Pointer output = this->GetOutput();
 
   // Check to see if we can read the file given the name or prefix
@@ -315,6 +447,7 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>
   //
   this->m_ImageIO->SetFileName(this->m_FileName.c_str());
   this->m_ImageIO->ReadImageInformation();
+
   // Initialize the number of component per pixel
   // THOMAS: This is not in ITK!
   // output->SetNumberOfComponentsPerPixel(this->m_ImageIO->GetNumberOfComponents());
@@ -490,6 +623,29 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>
     this->SetMetaDataDictionary(dictLight);
     }
 
+  // Report the GDAL block cache, which grows as blocks are read, to the
+  // pipeline memory print estimation. This is done after the copy of the
+  // ImageIO dictionary, which would drop it. Only the share of the cache
+  // used by the blocks of a stream piece is reported: one row of blocks
+  // of the file (the whole file if it has no block layout).
+  if (dynamic_cast<GDALImageIO*>(this->m_ImageIO.GetPointer()) != ITK_NULLPTR)
+    {
+    itk::ImageIOBase::SizeType blockRowSize = this->m_ImageIO->GetImageSizeInBytes();
+    unsigned int tileHintY = 0;
+    if (itk::ExposeMetaData<unsigned int>(this->m_ImageIO->GetMetaDataDictionary(),
+                                          MetaDataKey::TileHintY, tileHintY)
+        && tileHintY > 0 && this->m_ImageIO->GetNumberOfDimensions() > 1
+        && tileHintY < this->m_ImageIO->GetDimensions(1))
+      {
+      blockRowSize = blockRowSize / this->m_ImageIO->GetDimensions(1) * tileHintY;
+      }
+    const unsigned int cacheSize = static_cast<unsigned int>(
+      std::min<itk::ImageIOBase::SizeType>(GDALImageIO::GetCacheSizeInBytes(), blockRowSize));
+    itk::EncapsulateMetaData<unsigned int>(this->GetMetaDataDictionary(),
+                                           MetaDataKey::CacheSizeInBytes,
+                                           cacheSize);
+    }
+
   typedef typename TOutputImage::IndexType IndexType;
 
   IndexType start;
@@ -642,6 +798,8 @@ void
 ImageFileReader<TOutputImage, ConvertPixelTraits>
 ::SetFileName(const char* in)
 {
+  this->WaitForPrefetch();
+
   const std::string skip_geom_key = "skipgeom";
   const std::string geom_key = "geom";
 
@@ -726,10 +884,20 @@ void
 ImageFileReader<TOutputImage, ConvertPixelTraits>
 ::DoConvertBuffer(void* inputData,
                   size_t numberOfPixels)
+{
+  this->DoConvertBuffer(inputData, numberOfPixels, this->GetOutput());
+}
+
+template <class TOutputImage, class ConvertPixelTraits>
+void
+ImageFileReader<TOutputImage, ConvertPixelTraits>
+::DoConvertBuffer(void* inputData,
+                  size_t numberOfPixels,
+                  TOutputImage* image)
 {
   // get the pointer to the destination buffer
   OutputImagePixelType *outputData =
-    this->GetOutput()->GetPixelContainer()->GetBufferPointer();
+    image->GetPixelContainer()->GetBufferPointer();
 
   // TODO:
   // Pass down the PixelType (RGB, VECTOR, etc.) so that any vector to
@@ -25,6 +25,11 @@
 #include "itkProcessObject.h"
 #include "otbStreamingManager.h"
 #include "otbExtendedFilenameToWriterOptions.h"
+#include "otbStreamingPipelineFactory.h"
+#include "itkMultiThreader.h"
+#include "itkConditionVariable.h"
+#include <deque>
+#include <map>
 
 namespace otb
 {
@@ -46,6 +51,16 @@ namespace otb
  * ImageFileWriter will write directly the streaming buffer in the image file, so
  * that the output image never needs to be completely allocated
  *
+ * ImageFileWriter can also write asynchronously (see SetWriteQueueDepth):
+ * each stream piece is then copied into a bounded queue which is written to
+ * the file by a dedicated thread, so that the upstream pipeline computes the
+ * next piece while the previous one is being written.
+ *
+ * With SetPrefetch, the upstream readers are told the footprint of the
+ * next stream piece before the current one is computed, so that they read
+ * it in background while the current piece is processed (see
+ * RegionPrefetcher).
+ *
  * ImageFileWriter supports extended filenames, which allow controlling
  * some properties of the output file. See
  * http://wiki.orfeo-toolbox.org/index.php/ExtendedFileName for more
@@ -159,6 +174,61 @@ public:
    *   is set from the CMake configuration option */
   void SetAutomaticAdaptativeStreaming(unsigned int availableRAM = 0, double bias = 1.0);
 
+  /**  Set the streaming mode to 'aligned' and configure the number of MB
+   *   available. The actual number of divisions is computed automatically
+   *   by estimating the memory consumption of the pipeline.
+   *   Divisions will cover whole blocks of the output file (as far as its
+   *   layout can be deduced from the ImageIO), and will also match the
+   *   input file tile scheme when both layouts are compatible.
+   *   Setting the availableRAM parameter to 0 means that the available RAM
+   *   is set from the CMake configuration option */
+  void SetAutomaticBlockAlignedStreaming(unsigned int availableRAM = 0, double bias = 1.0);
+
+  /** Set the depth of the asynchronous write queue. When different from 0,
+   *  stream pieces are written by a dedicated thread while the pipeline
+   *  computes the next pieces. The depth is the maximum number of pieces
+   *  waiting to be written (including the one being written): since each
+   *  queued piece holds a copy of the stream buffer, peak memory grows by
+   *  this many stream pieces. Default is 0 (synchronous writing). This
+   *  setting is overridden by the streaming:writequeue extended filename
+   *  option. */
+  itkSetMacro(WriteQueueDepth, unsigned int);
+  itkGetConstMacro(WriteQueueDepth, unsigned int);
+
+  /** Type of the object building independent copies of the upstream
+   *  pipeline. The first output of the pipelines it creates must produce
+   *  the same image as the writer input. */
+  typedef StreamingPipelineFactory PipelineFactoryType;
+
+  /** Set/Get the factory used to build the upstream pipelines of the
+   *  parallel stream pieces. Each of its pipelines must share no filter
+   *  with the writer input pipeline nor with the other ones. The progress
+   *  of the piece being waited for is forwarded as the writer progress. */
+  itkSetObjectMacro(PipelineFactory, PipelineFactoryType);
+  itkGetObjectMacro(PipelineFactory, PipelineFactoryType);
+
+  /** Set the number of stream pieces computed at the same time. When
+   *  greater than 1 and a pipeline factory is set, each piece is computed
+   *  by one of this many pipelines built with the factory, on its own
+   *  thread, while the writer input only provides the image information.
+   *  Pieces are still written in order, so that the output file is the
+   *  same as in sequential mode. Since the filters of each pipeline are
+   *  multi-threaded too, their number of threads should be lowered
+   *  accordingly. Default is 1 (sequential processing). */
+  itkSetMacro(NumberOfParallelPieces, unsigned int);
+  itkGetConstMacro(NumberOfParallelPieces, unsigned int);
+
+  /** Enable the read-ahead of the next stream piece by the upstream
+   *  readers. Before each piece is computed, the region of the next piece
+   *  is propagated through the pipeline, and the resulting footprint is
+   *  read in background by the readers while the current piece is
+   *  processed. Each reader then holds two buffers instead of one. Default
+   *  is false. This setting is overridden by the streaming:prefetch
+   *  extended filename option. */
+  itkSetMacro(Prefetch, bool);
+  itkGetConstMacro(Prefetch, bool);
+  itkBooleanMacro(Prefetch);
+
   /** Set the only input of the writer */
   using Superclass::SetInput;
   virtual void SetInput(const InputImageType *input);
@@ -207,6 +277,9 @@ protected:
   /** Does the real work. */
   void GenerateData(void) ITK_OVERRIDE;
 
+  /** Write the buffer of the given image in the ImageIO region */
+  virtual void WriteStreamPiece(const InputImageType * input);
+
 private:
   ImageFileWriter(const ImageFileWriter &); //purposely not implemented
   void operator =(const ImageFileWriter&); //purposely not implemented
@@ -227,11 +300,58 @@ private:
     this->UpdateFilterProgress();
   }
 
+  /** Record the progress of a parallel piece pipeline (called from the
+   *  piece threads) */
+  void ObservePiecePipelineProgress(itk::Object* object, const itk::EventObject & event);
+
   void UpdateFilterProgress()
   {
     this->UpdateProgress( (m_DivisionProgress + m_CurrentDivision) / m_NumberOfDivisions );
   }
 
+  /** Asynchronous writing: a stream piece waiting to be written */
+  struct WriteQueueItemType
+  {
+    InputImagePointer  Image;
+    itk::ImageIORegion IORegion;
+  };
+
+  /** Spawn the writer thread */
+  void StartWriteThread();
+
+  /** Wait for the writer thread to terminate. If flush is true, every
+   *  queued piece is written before, and errors raised by the writer
+   *  thread are rethrown */
+  void StopWriteThread(bool flush);
+
+  /** Push a stream piece in the write queue, blocking while the queue is full */
+  void PushStreamPiece(const WriteQueueItemType & item);
+
+  /** Entry point of the writer thread */
+  static ITK_THREAD_RETURN_TYPE WriteThreadCallback(void * arg);
+
+  /** Copy the given IO region of the input buffer in a new stream piece */
+  WriteQueueItemType CopyStreamPiece(const InputImageType * input, const itk::ImageIORegion & ioRegion) const;
+
+  /** Build the pipelines and spawn the threads computing the pieces */
+  void StartPieceThreads(const InputImageRegionType & inputRegion);
+
+  /** Stop the piece threads and release their pipelines */
+  void StopPieceThreads();
+
+  /** Wait for the given piece to be computed and take it */
+  WriteQueueItemType PopComputedPiece(unsigned int piece);
+
+  /** Entry point of the piece threads */
+  static ITK_THREAD_RETURN_TYPE PieceThreadCallback(void * arg);
+
+  /** Write the geom file if requested */
+  void WriteGeomFileIfRequested();
+
+  /** Propagate the region of the next stream piece through the pipeline,
+   *  and let the upstream readers record their footprint */
+  void RecordNextStreamPiece(const InputImageRegionType & region);
+
   unsigned int m_NumberOfDivisions;
   unsigned int m_CurrentDivision;
   float m_DivisionProgress;
@@ -270,6 +390,43 @@ private:
    *  This variable can be the number of components in m_ImageIO or the
    *  number of components in the m_BandList (if used) */
   unsigned int m_IOComponents;
+
+  /** Asynchronous writing */
+  unsigned int                         m_WriteQueueDepth;
+  bool                                 m_WriteThreadRunning;
+  bool                                 m_WriteQueueClosed;
+  bool                                 m_WriteQueueFailed;
+  std::string                          m_WriteQueueErrorMessage;
+  std::deque<WriteQueueItemType>       m_WriteQueue;
+  itk::SimpleMutexLock                 m_WriteQueueMutex;
+  itk::ConditionVariable::Pointer      m_WriteQueueNotEmpty;
+  itk::ConditionVariable::Pointer      m_WriteQueueNotFull;
+  itk::MultiThreader::Pointer          m_WriteThreader;
+  itk::ThreadIdType                    m_WriteThreadId;
+
+  /** Parallel processing of the stream pieces */
+  unsigned int                                   m_NumberOfParallelPieces;
+  PipelineFactoryType::Pointer                   m_PipelineFactory;
+  std::vector<itk::ProcessObject::Pointer>       m_PiecePipelines;
+  std::vector<long>                              m_PiecePipelineCurrentPiece;
+  std::vector<float>                             m_PiecePipelineProgress;
+  std::vector<InputImagePointer>                 m_PieceOutputs;
+  std::vector<itk::ImageIORegion>                m_PieceIORegions;
+  std::map<unsigned int, WriteQueueItemType>     m_ComputedPieces;
+  unsigned int                                   m_NextPieceToCompute;
+  unsigned int                                   m_NextPieceToWrite;
+  unsigned int                                   m_NumberOfStartedPieceThreads;
+  bool                                           m_PieceThreadsStopped;
+  bool                                           m_PieceThreadsFailed;
+  std::string                                    m_PieceThreadsErrorMessage;
+  itk::SimpleMutexLock                           m_PieceMutex;
+  itk::ConditionVariable::Pointer                m_PieceComputed;
+  itk::ConditionVariable::Pointer                m_PieceWritten;
+  itk::MultiThreader::Pointer                    m_PieceThreader;
+  std::vector<itk::ThreadIdType>                 m_PieceThreadIds;
+
+  /** Read-ahead of the next stream piece */
+  bool m_Prefetch;
 };
 
 } // end namespace otb
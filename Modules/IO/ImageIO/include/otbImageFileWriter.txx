@@ -36,6 +36,8 @@
 #include "otbMetaDataKey.h"
 
 #include "otbConfigure.h"
+#include "otbConfigurationManager.h"
+#include "otbSystem.h"
 
 #include "otbNumberOfDivisionsStrippedStreamingManager.h"
 #include "otbNumberOfDivisionsTiledStreamingManager.h"
@@ -44,11 +46,16 @@
 #include "otbTileDimensionTiledStreamingManager.h"
 #include "otbRAMDrivenTiledStreamingManager.h"
 #include "otbRAMDrivenAdaptativeStreamingManager.h"
+#include "otbRAMDrivenBlockAlignedStreamingManager.h"
+#include "otbRegionPrefetcher.h"
 
 #include "otb_boost_tokenizer_header.h"
 
 #include "otbStringUtils.h"
 
+#include <algorithm>
+#include <set>
+
 namespace otb
 {
 
@@ -70,7 +77,20 @@ ImageFileWriter<TInputImage>
     m_FilenameHelper(),
     m_IsObserving(true),
     m_ObserverID(0),
-    m_IOComponents(0)
+    m_IOComponents(0),
+    m_WriteQueueDepth(0),
+    m_WriteThreadRunning(false),
+    m_WriteQueueClosed(false),
+    m_WriteQueueFailed(false),
+    m_WriteThreadId(0),
+    m_NumberOfParallelPieces(1),
+    m_PipelineFactory(ITK_NULLPTR),
+    m_NextPieceToCompute(0),
+    m_NextPieceToWrite(0),
+    m_NumberOfStartedPieceThreads(0),
+    m_PieceThreadsStopped(false),
+    m_PieceThreadsFailed(false),
+    m_Prefetch(false)
 {
   //Init output index shift
   m_ShiftOutputIndex.Fill(0);
@@ -89,6 +109,14 @@ template <class TInputImage>
 ImageFileWriter<TInputImage>
 ::~ImageFileWriter()
 {
+  if (!m_PieceThreadIds.empty())
+    {
+    this->StopPieceThreads();
+    }
+  if (m_WriteThreadRunning)
+    {
+    this->StopWriteThread(false);
+    }
 }
 
 template <class TInputImage>
@@ -176,6 +204,18 @@ ImageFileWriter<TInputImage>
   m_StreamingManager = streamingManager;
 }
 
+template <class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::SetAutomaticBlockAlignedStreaming(unsigned int availableRAM, double bias)
+{
+  typedef RAMDrivenBlockAlignedStreamingManager<TInputImage> RAMDrivenBlockAlignedStreamingManagerType;
+  typename RAMDrivenBlockAlignedStreamingManagerType::Pointer streamingManager = RAMDrivenBlockAlignedStreamingManagerType::New();
+  streamingManager->SetAvailableRAMInMB(availableRAM);
+  streamingManager->SetBias(bias);
+  m_StreamingManager = streamingManager;
+}
+
 #ifndef ITK_LEGACY_REMOVE
 
 #endif // ITK_LEGACY_REMOVE
@@ -230,6 +270,9 @@ ImageFileWriter<TInputImage>
     {
     os << indent << "FactorySpecifiedmageIO: Off\n";
     }
+
+  os << indent << "WriteQueueDepth: " << m_WriteQueueDepth << "\n";
+  os << indent << "Prefetch: " << m_Prefetch << "\n";
 }
 
 //---------------------------------------------------------
@@ -375,6 +418,21 @@ ImageFileWriter<TInputImage>
         this->SetNumberOfLinesStrippedStreaming(static_cast<unsigned int>(sizevalue));
         }
 
+      }
+    else if(type == "aligned")
+      {
+      // sizevalue is a RAM value in MB, which only makes sense with the
+      // auto sizemode
+      if(sizemode != "auto")
+        {
+        itkWarningMacro(<<"In aligned streaming type, only the auto sizemode is supported: sizemode and sizevalue will be ignored.");
+        sizevalue = 0.;
+        }
+      else if(sizevalue == 0.)
+        {
+        itkWarningMacro("sizemode is auto but sizevalue is 0. Value will be fetched from the OTB_MAX_RAM_HINT environment variable if set, or else use the default value");
+        }
+      this->SetAutomaticBlockAlignedStreaming(sizevalue);
       }
     else if (type == "none")
       {
@@ -391,6 +449,22 @@ ImageFileWriter<TInputImage>
       {
       itkWarningMacro(<<"No streaming type is set, streaming sizemode and sizevalue will be ignored.");
       }
+    if(m_FilenameHelper->CloudOptimizedIsSet() && m_FilenameHelper->GetCloudOptimized())
+      {
+      // Overviews are computed from the written pieces, which must be
+      // aligned on the output tiles
+      this->SetAutomaticBlockAlignedStreaming(0);
+      }
+    }
+
+  if(m_FilenameHelper->StreamingWriteQueueIsSet())
+    {
+    this->SetWriteQueueDepth(m_FilenameHelper->GetStreamingWriteQueue());
+    }
+
+  if(m_FilenameHelper->StreamingPrefetchIsSet())
+    {
+    this->SetPrefetch(m_FilenameHelper->GetStreamingPrefetch());
     }
 
   this->SetAbortGenerateData(0);
@@ -456,7 +530,8 @@ ImageFileWriter<TInputImage>
 
   // Manage extended filename
   if ((strcmp(m_ImageIO->GetNameOfClass(), "GDALImageIO") == 0)
-      && (m_FilenameHelper->gdalCreationOptionsIsSet() || m_FilenameHelper->WriteRPCTagsIsSet())  )
+      && (m_FilenameHelper->gdalCreationOptionsIsSet() || m_FilenameHelper->WriteRPCTagsIsSet()
+          || m_FilenameHelper->CloudOptimizedIsSet())  )
     {
     typename GDALImageIO::Pointer imageIO = dynamic_cast<GDALImageIO*>(m_ImageIO.GetPointer());
 
@@ -471,6 +546,7 @@ ImageFileWriter<TInputImage>
 
     imageIO->SetOptions(m_FilenameHelper->GetgdalCreationOptions());
     imageIO->SetWriteRPCTags(m_FilenameHelper->GetWriteRPCTags());
+    imageIO->SetCloudOptimized(m_FilenameHelper->GetCloudOptimized());
     }
 
 
@@ -540,6 +616,48 @@ ImageFileWriter<TInputImage>
     otbMsgDevMacro(<< "Buffered region is the largest possible region, there is no need for streaming.");
     this->SetNumberOfDivisionsStrippedStreaming(1);
     }
+
+  /** Give the output file block layout to the block-aligned streaming manager */
+  typedef RAMDrivenBlockAlignedStreamingManager<TInputImage> RAMDrivenBlockAlignedStreamingManagerType;
+  RAMDrivenBlockAlignedStreamingManagerType* alignedStreamingManager =
+    dynamic_cast<RAMDrivenBlockAlignedStreamingManagerType*>(m_StreamingManager.GetPointer());
+  GDALImageIO* gdalImageIO = dynamic_cast<GDALImageIO*>(m_ImageIO.GetPointer());
+  if (alignedStreamingManager != ITK_NULLPTR)
+    {
+    typename InputImageRegionType::SizeType blockSize;
+    blockSize.Fill(0);
+    unsigned int blockSizeX = 0;
+    unsigned int blockSizeY = 0;
+
+    // The default strip height depends on the size of a written line
+    unsigned int nbBands = inputPtr->GetNumberOfComponentsPerPixel();
+    if (m_FilenameHelper->BandRangeIsSet())
+      {
+      std::vector<unsigned int> bandList;
+      if (m_FilenameHelper->ResolveBandRange(m_FilenameHelper->GetBandRange(), nbBands, bandList))
+        {
+        nbBands = bandList.size();
+        }
+      }
+    typedef typename TInputImage::InternalPixelType InternalPixelType;
+    unsigned int bytesPerComponent = sizeof(InternalPixelType);
+    // GDALImageIO writes long integers on 32 bits
+    if (typeid(InternalPixelType) == typeid(long) || typeid(InternalPixelType) == typeid(unsigned long))
+      {
+      bytesPerComponent = 4;
+      }
+
+    if (gdalImageIO != ITK_NULLPTR
+        && gdalImageIO->GetOutputBlockSize(inputRegion.GetSize()[0], nbBands, bytesPerComponent,
+                                           blockSizeX, blockSizeY))
+      {
+      // Strips span whole lines of the written region
+      blockSize[0] = (blockSizeX > 0 ? blockSizeX : inputRegion.GetSize()[0]);
+      blockSize[1] = blockSizeY;
+      }
+    alignedStreamingManager->SetOutputBlockSize(blockSize);
+    }
+
   m_StreamingManager->PrepareStreaming(inputPtr, inputRegion);
   m_NumberOfDivisions = m_StreamingManager->GetNumberOfSplits();
   otbMsgDebugMacro(<< "Number Of Stream Divisions : " << m_NumberOfDivisions);
@@ -585,6 +703,14 @@ ImageFileWriter<TInputImage>
 
   m_ImageIO->WriteImageInformation();
 
+  // Measure the memory actually used by the streaming, to compare it with
+  // the estimation of the streaming manager
+  const bool checkMemoryPrint = ConfigurationManager::GetMemoryPrintCheck();
+  unsigned long long startResidentSetSize = 0;
+  unsigned long long startPeakResidentSetSize = 0;
+  const bool residentSetSizeAvailable = checkMemoryPrint
+    && System::GetResidentSetSize(startResidentSetSize, startPeakResidentSetSize);
+
   this->UpdateProgress(0);
   m_CurrentDivision = 0;
   m_DivisionProgress = 0;
@@ -611,30 +737,107 @@ ImageFileWriter<TInputImage>
     itkWarningMacro(<< "Could not get the source process object. Progress report might be buggy");
     }
 
-  for (m_CurrentDivision = 0;
-       m_CurrentDivision < m_NumberOfDivisions && !this->GetAbortGenerateData();
-       m_CurrentDivision++, m_DivisionProgress = 0, this->UpdateFilterProgress())
+  // Write the stream pieces from a dedicated thread if requested. There is
+  // nothing to overlap when the image is written in a single piece.
+  const bool asynchronousWrite = (m_WriteQueueDepth > 0 && m_NumberOfDivisions > 1);
+  if (asynchronousWrite)
     {
-    streamRegion = m_StreamingManager->GetSplit(m_CurrentDivision);
+    otbMsgDevMacro(<< "Asynchronous writing with a queue of " << m_WriteQueueDepth << " stream pieces");
+    this->StartWriteThread();
+    }
 
-    inputPtr->SetRequestedRegion(streamRegion);
-    inputPtr->PropagateRequestedRegion();
-    inputPtr->UpdateOutputData();
+  // Compute several stream pieces at the same time if requested
+  const bool parallelPieces = (m_NumberOfParallelPieces > 1
+                               && m_PipelineFactory.IsNotNull()
+                               && m_NumberOfDivisions > 1);
 
-    // Write the whole image
-    itk::ImageIORegion ioRegion(TInputImage::ImageDimension);
-    for (unsigned int i = 0; i < TInputImage::ImageDimension; ++i)
+  try
+    {
+    if (parallelPieces)
       {
-      ioRegion.SetSize(i, streamRegion.GetSize(i));
-      ioRegion.SetIndex(i, streamRegion.GetIndex(i));
-      //Set the ioRegion index using the shifted index ( (0,0 without box parameter))
-      ioRegion.SetIndex(i, streamRegion.GetIndex(i) - m_ShiftOutputIndex[i]);
+      otbMsgDevMacro(<< "Computing up to " << m_NumberOfParallelPieces << " stream pieces in parallel");
+      this->StartPieceThreads(inputRegion);
+      }
+
+    for (m_CurrentDivision = 0;
+         m_CurrentDivision < m_NumberOfDivisions && !this->GetAbortGenerateData();
+         m_CurrentDivision++, m_DivisionProgress = 0, this->UpdateFilterProgress())
+      {
+      if (parallelPieces)
+        {
+        // Pieces are written in order, whatever order they are computed in
+        WriteQueueItemType item = this->PopComputedPiece(m_CurrentDivision);
+        this->SetIORegion(item.IORegion);
+
+        if (asynchronousWrite)
+          {
+          this->PushStreamPiece(item);
+          }
+        else
+          {
+          m_ImageIO->SetIORegion(m_IORegion);
+          this->WriteStreamPiece(item.Image);
+          }
+        continue;
+        }
+
+      streamRegion = m_StreamingManager->GetSplit(m_CurrentDivision);
+
+      // Let the readers know the next piece, so that they read it while
+      // the current one is processed
+      if (m_Prefetch && m_CurrentDivision + 1 < m_NumberOfDivisions)
+        {
+        this->RecordNextStreamPiece(m_StreamingManager->GetSplit(m_CurrentDivision + 1));
+        }
+
+      inputPtr->SetRequestedRegion(streamRegion);
+      inputPtr->PropagateRequestedRegion();
+      inputPtr->UpdateOutputData();
+
+      // Write the whole image
+      itk::ImageIORegion ioRegion(TInputImage::ImageDimension);
+      for (unsigned int i = 0; i < TInputImage::ImageDimension; ++i)
+        {
+        ioRegion.SetSize(i, streamRegion.GetSize(i));
+        ioRegion.SetIndex(i, streamRegion.GetIndex(i));
+        //Set the ioRegion index using the shifted index ( (0,0 without box parameter))
+        ioRegion.SetIndex(i, streamRegion.GetIndex(i) - m_ShiftOutputIndex[i]);
+        }
+      this->SetIORegion(ioRegion);
+
+      // In asynchronous mode, the ImageIO belongs to the writer thread
+      if (!asynchronousWrite)
+        {
+        m_ImageIO->SetIORegion(m_IORegion);
+        }
+
+      // Start writing stream region in the image file
+      this->GenerateData();
+      }
+
+    if (parallelPieces)
+      {
+      this->StopPieceThreads();
+      this->WriteGeomFileIfRequested();
       }
-    this->SetIORegion(ioRegion);
-    m_ImageIO->SetIORegion(m_IORegion);
 
-    // Start writing stream region in the image file
-    this->GenerateData();
+    // Wait for the pending stream pieces to be written
+    if (m_WriteThreadRunning)
+      {
+      this->StopWriteThread(true);
+      }
+    }
+  catch (...)
+    {
+    if (!m_PieceThreadIds.empty())
+      {
+      this->StopPieceThreads();
+      }
+    if (m_WriteThreadRunning)
+      {
+      this->StopWriteThread(false);
+      }
+    throw;
     }
 
   /**
@@ -646,6 +849,28 @@ ImageFileWriter<TInputImage>
     this->UpdateProgress(1.0);
     }
 
+  if (residentSetSizeAvailable)
+    {
+    unsigned long long currentResidentSetSize = 0;
+    unsigned long long peakResidentSetSize = 0;
+    System::GetResidentSetSize(currentResidentSetSize, peakResidentSetSize);
+
+    const double predicted = m_StreamingManager->GetEstimatedMemoryPrintPerSplit() / 1048576.;
+    if (peakResidentSetSize > startPeakResidentSetSize)
+      {
+      const double measured = (peakResidentSetSize - startResidentSetSize) / 1048576.;
+      itkWarningMacro(<< "Memory print check for " << m_FileName << ": predicted "
+                      << predicted << " MB per stream division, measured peak "
+                      << measured << " MB (difference " << measured - predicted << " MB)");
+      }
+    else
+      {
+      itkWarningMacro(<< "Memory print check for " << m_FileName << ": predicted "
+                      << predicted << " MB per stream division, peak resident memory "
+                      << "was not raised by the writing");
+      }
+    }
+
   // Notify end event observers
   this->InvokeEvent(itk::EndEvent());
 
@@ -685,6 +910,122 @@ ImageFileWriter<TInputImage>
 ::GenerateData(void)
 {
   const InputImageType * input = this->GetInput();
+
+  if (m_WriteThreadRunning)
+    {
+    // Detach a copy of the stream buffer, since the upstream pipeline will
+    // reuse its output buffer for the next stream piece
+    this->PushStreamPiece(this->CopyStreamPiece(input, m_IORegion));
+    }
+  else
+    {
+    this->WriteStreamPiece(input);
+    }
+
+  this->WriteGeomFileIfRequested();
+}
+
+template<class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::RecordNextStreamPiece(const InputImageRegionType & region)
+{
+  InputImageType * inputPtr = const_cast<InputImageType *>(this->GetInput());
+
+  // Only the requested regions are computed here, no data is generated
+  inputPtr->SetRequestedRegion(region);
+  inputPtr->PropagateRequestedRegion();
+
+  // Walk the pipeline upstream
+  std::vector<itk::ProcessObject *> sources;
+  std::set<itk::ProcessObject *>    visited;
+  if (inputPtr->GetSource())
+    {
+    sources.push_back(inputPtr->GetSource());
+    }
+  while (!sources.empty())
+    {
+    itk::ProcessObject * source = sources.back();
+    sources.pop_back();
+    if (!visited.insert(source).second)
+      {
+      continue;
+      }
+
+    RegionPrefetcher * prefetcher = dynamic_cast<RegionPrefetcher *>(source);
+    if (prefetcher)
+      {
+      prefetcher->RecordNextRequestedRegion();
+      }
+
+    itk::ProcessObject::DataObjectPointerArray inputs = source->GetInputs();
+    for (unsigned int i = 0; i < inputs.size(); ++i)
+      {
+      if (inputs[i].IsNotNull() && inputs[i]->GetSource())
+        {
+        sources.push_back(inputs[i]->GetSource());
+        }
+      }
+    }
+}
+
+template<class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::WriteGeomFileIfRequested()
+{
+  if (m_WriteGeomFile  || m_FilenameHelper->GetWriteGEOMFile())
+    {
+    ImageKeywordlist otb_kwl;
+    itk::MetaDataDictionary dict = this->GetInput()->GetMetaDataDictionary();
+    itk::ExposeMetaData<ImageKeywordlist>(dict, MetaDataKey::OSSIMKeywordlistKey, otb_kwl);
+    WriteGeometry(otb_kwl, this->GetFileName());
+    }
+}
+
+template<class TInputImage>
+typename ImageFileWriter<TInputImage>::WriteQueueItemType
+ImageFileWriter<TInputImage>
+::CopyStreamPiece(const InputImageType * input, const itk::ImageIORegion & ioRegion) const
+{
+  InputImageRegionType pieceRegion;
+  itk::ImageIORegionAdaptor<TInputImage::ImageDimension>::
+    Convert(ioRegion, pieceRegion, m_ShiftOutputIndex);
+
+  // Only keep the requested region when the upstream filter produced a
+  // larger buffer. Otherwise the whole buffer is kept and the region check
+  // is left to WriteStreamPiece()
+  const InputImageRegionType bufferedRegion = input->GetBufferedRegion();
+  if (!bufferedRegion.IsInside(pieceRegion))
+    {
+    pieceRegion = bufferedRegion;
+    }
+
+  WriteQueueItemType item;
+  item.IORegion = ioRegion;
+  item.Image = InputImageType::New();
+  item.Image->CopyInformation(input);
+  item.Image->SetBufferedRegion(pieceRegion);
+  item.Image->Allocate();
+
+  typedef itk::ImageRegionConstIterator<TInputImage> ConstIteratorType;
+  typedef itk::ImageRegionIterator<TInputImage>      IteratorType;
+
+  ConstIteratorType in(input, pieceRegion);
+  IteratorType out(item.Image, pieceRegion);
+  for (in.GoToBegin(), out.GoToBegin(); !in.IsAtEnd(); ++in, ++out)
+    {
+    out.Set(in.Get());
+    }
+
+  return item;
+}
+
+template<class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::WriteStreamPiece(const InputImageType * input)
+{
   InputImagePointer cacheImage;
 
   // Make sure that the image is the right type and no more than
@@ -802,14 +1143,429 @@ ImageFileWriter<TInputImage>
   }
 
   m_ImageIO->Write(dataPtr);
+}
 
-  if (m_WriteGeomFile  || m_FilenameHelper->GetWriteGEOMFile())
+template <class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::StartWriteThread()
+{
+  m_WriteQueue.clear();
+  m_WriteQueueClosed = false;
+  m_WriteQueueFailed = false;
+  m_WriteQueueErrorMessage.clear();
+
+  if (m_WriteQueueNotEmpty.IsNull())
     {
-    ImageKeywordlist otb_kwl;
-    itk::MetaDataDictionary dict = this->GetInput()->GetMetaDataDictionary();
-    itk::ExposeMetaData<ImageKeywordlist>(dict, MetaDataKey::OSSIMKeywordlistKey, otb_kwl);
-    WriteGeometry(otb_kwl, this->GetFileName());
+    m_WriteQueueNotEmpty = itk::ConditionVariable::New();
+    m_WriteQueueNotFull = itk::ConditionVariable::New();
+    m_WriteThreader = itk::MultiThreader::New();
+    }
+
+  m_WriteThreadId = m_WriteThreader->SpawnThread(WriteThreadCallback, this);
+  m_WriteThreadRunning = true;
+}
+
+template <class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::StopWriteThread(bool flush)
+{
+  m_WriteQueueMutex.Lock();
+  m_WriteQueueClosed = true;
+  if (!flush)
+    {
+    // Drop the pending pieces, but leave the one being written (if any)
+    while (m_WriteQueue.size() > 1)
+      {
+      m_WriteQueue.pop_back();
+      }
+    m_WriteQueueFailed = true;
+    }
+  m_WriteQueueNotEmpty->Broadcast();
+  m_WriteQueueMutex.Unlock();
+
+  // Joins the writer thread
+  m_WriteThreader->TerminateThread(m_WriteThreadId);
+  m_WriteThreadRunning = false;
+  m_WriteQueue.clear();
+
+  if (flush && m_WriteQueueFailed)
+    {
+    itk::ImageFileWriterException e(__FILE__, __LINE__);
+    std::ostringstream msg;
+    msg << "Asynchronous writing of " << m_FileName << " failed: " << m_WriteQueueErrorMessage;
+    e.SetDescription(msg.str().c_str());
+    e.SetLocation(ITK_LOCATION);
+    throw e;
+    }
+}
+
+template <class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::PushStreamPiece(const WriteQueueItemType & item)
+{
+  m_WriteQueueMutex.Lock();
+  while (m_WriteQueue.size() >= m_WriteQueueDepth && !m_WriteQueueFailed)
+    {
+    m_WriteQueueNotFull->Wait(&m_WriteQueueMutex);
+    }
+
+  if (m_WriteQueueFailed)
+    {
+    m_WriteQueueMutex.Unlock();
+    // Stop the writer thread and report its error
+    this->StopWriteThread(true);
+    return;
+    }
+
+  m_WriteQueue.push_back(item);
+  m_WriteQueueNotEmpty->Signal();
+  m_WriteQueueMutex.Unlock();
+}
+
+template <class TInputImage>
+ITK_THREAD_RETURN_TYPE
+ImageFileWriter<TInputImage>
+::WriteThreadCallback(void * arg)
+{
+  struct itk::MultiThreader::ThreadInfoStruct * pInfo = (itk::MultiThreader::ThreadInfoStruct *) (arg);
+  Self * writer = static_cast<Self *>(pInfo->UserData);
+
+  while (true)
+    {
+    writer->m_WriteQueueMutex.Lock();
+    while (writer->m_WriteQueue.empty() && !writer->m_WriteQueueClosed)
+      {
+      writer->m_WriteQueueNotEmpty->Wait(&writer->m_WriteQueueMutex);
+      }
+    if (writer->m_WriteQueue.empty())
+      {
+      writer->m_WriteQueueMutex.Unlock();
+      break;
+      }
+    // The piece stays in the queue while it is written, so that it is
+    // accounted for in the queue depth
+    WriteQueueItemType item = writer->m_WriteQueue.front();
+    writer->m_WriteQueueMutex.Unlock();
+
+    std::string error;
+    try
+      {
+      writer->m_ImageIO->SetIORegion(item.IORegion);
+      writer->WriteStreamPiece(item.Image);
+      }
+    catch (itk::ExceptionObject & err)
+      {
+      error = err.GetDescription();
+      }
+    catch (std::exception & err)
+      {
+      error = err.what();
+      }
+
+    // Release the piece buffer before waking up the pipeline
+    item.Image = ITK_NULLPTR;
+
+    writer->m_WriteQueueMutex.Lock();
+    writer->m_WriteQueue.pop_front();
+    if (!error.empty())
+      {
+      writer->m_WriteQueueFailed = true;
+      writer->m_WriteQueueErrorMessage = error;
+      writer->m_WriteQueue.clear();
+      }
+    const bool stop = writer->m_WriteQueueFailed;
+    writer->m_WriteQueueNotFull->Broadcast();
+    writer->m_WriteQueueMutex.Unlock();
+
+    if (stop)
+      {
+      break;
+      }
+    }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template <class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::StartPieceThreads(const InputImageRegionType & inputRegion)
+{
+  m_PieceIORegions.clear();
+  for (unsigned int piece = 0; piece < m_NumberOfDivisions; ++piece)
+    {
+    const InputImageRegionType streamRegion = m_StreamingManager->GetSplit(piece);
+    itk::ImageIORegion ioRegion(TInputImage::ImageDimension);
+    for (unsigned int i = 0; i < TInputImage::ImageDimension; ++i)
+      {
+      ioRegion.SetSize(i, streamRegion.GetSize(i));
+      ioRegion.SetIndex(i, streamRegion.GetIndex(i) - m_ShiftOutputIndex[i]);
+      }
+    m_PieceIORegions.push_back(ioRegion);
+    }
+
+  // Build one pipeline per thread
+  const unsigned int nbThreads = std::min(m_NumberOfParallelPieces, m_NumberOfDivisions);
+  m_PiecePipelines.clear();
+  m_PieceOutputs.clear();
+  for (unsigned int thread = 0; thread < nbThreads; ++thread)
+    {
+    itk::ProcessObject::Pointer pipeline = m_PipelineFactory->CreatePipeline();
+    InputImageType * output = ITK_NULLPTR;
+    if (pipeline.IsNotNull() && !pipeline->GetOutputs().empty())
+      {
+      output = dynamic_cast<InputImageType *>(pipeline->GetOutputs()[0].GetPointer());
+      }
+
+    if (output == ITK_NULLPTR)
+      {
+      itk::ImageFileWriterException e(__FILE__, __LINE__);
+      e.SetDescription("The pipeline factory did not return a process object producing the writer input image type.");
+      e.SetLocation(ITK_LOCATION);
+      throw e;
+      }
+
+    output->UpdateOutputInformation();
+    if (!output->GetLargestPossibleRegion().IsInside(inputRegion))
+      {
+      itk::ImageFileWriterException e(__FILE__, __LINE__);
+      std::ostringstream msg;
+      msg << "The pipeline built by the pipeline factory does not cover the written region." << std::endl;
+      msg << "Written region:" << std::endl << inputRegion;
+      msg << "Pipeline largest possible region:" << std::endl << output->GetLargestPossibleRegion();
+      e.SetDescription(msg.str().c_str());
+      e.SetLocation(ITK_LOCATION);
+      throw e;
+      }
+
+    // Forward the progress of the pipeline to the writer
+    typedef itk::MemberCommand<Self> CommandType;
+    typename CommandType::Pointer command = CommandType::New();
+    command->SetCallbackFunction(this, &Self::ObservePiecePipelineProgress);
+    pipeline->AddObserver(itk::ProgressEvent(), command);
+
+    m_PiecePipelines.push_back(pipeline);
+    m_PieceOutputs.push_back(output);
+    }
+  m_PiecePipelineCurrentPiece = std::vector<long>(nbThreads, -1);
+  m_PiecePipelineProgress = std::vector<float>(nbThreads, 0.f);
+
+  m_ComputedPieces.clear();
+  m_NextPieceToCompute = 0;
+  m_NextPieceToWrite = 0;
+  m_NumberOfStartedPieceThreads = 0;
+  m_PieceThreadsStopped = false;
+  m_PieceThreadsFailed = false;
+  m_PieceThreadsErrorMessage.clear();
+
+  if (m_PieceComputed.IsNull())
+    {
+    m_PieceComputed = itk::ConditionVariable::New();
+    m_PieceWritten = itk::ConditionVariable::New();
+    m_PieceThreader = itk::MultiThreader::New();
+    }
+
+  for (unsigned int thread = 0; thread < nbThreads; ++thread)
+    {
+    m_PieceThreadIds.push_back(m_PieceThreader->SpawnThread(PieceThreadCallback, this));
+    }
+}
+
+template <class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::StopPieceThreads()
+{
+  m_PieceMutex.Lock();
+  m_PieceThreadsStopped = true;
+  m_PieceComputed->Broadcast();
+  m_PieceWritten->Broadcast();
+  m_PieceMutex.Unlock();
+
+  // Joins the piece threads
+  for (unsigned int thread = 0; thread < m_PieceThreadIds.size(); ++thread)
+    {
+    m_PieceThreader->TerminateThread(m_PieceThreadIds[thread]);
+    }
+
+  m_PieceThreadIds.clear();
+  m_ComputedPieces.clear();
+  m_PieceOutputs.clear();
+  m_PiecePipelines.clear();
+  m_PiecePipelineCurrentPiece.clear();
+  m_PiecePipelineProgress.clear();
+}
+
+template <class TInputImage>
+typename ImageFileWriter<TInputImage>::WriteQueueItemType
+ImageFileWriter<TInputImage>
+::PopComputedPiece(unsigned int piece)
+{
+  m_PieceMutex.Lock();
+  typename std::map<unsigned int, WriteQueueItemType>::iterator it = m_ComputedPieces.find(piece);
+  while (it == m_ComputedPieces.end() && !m_PieceThreadsFailed)
+    {
+    m_PieceComputed->Wait(&m_PieceMutex);
+    it = m_ComputedPieces.find(piece);
+
+    // Report the progress of the pipeline computing the awaited piece
+    if (it == m_ComputedPieces.end())
+      {
+      for (unsigned int thread = 0; thread < m_PiecePipelineCurrentPiece.size(); ++thread)
+        {
+        if (m_PiecePipelineCurrentPiece[thread] == static_cast<long>(piece)
+            && m_PiecePipelineProgress[thread] > m_DivisionProgress)
+          {
+          m_DivisionProgress = m_PiecePipelineProgress[thread];
+          m_PieceMutex.Unlock();
+          this->UpdateFilterProgress();
+          m_PieceMutex.Lock();
+          it = m_ComputedPieces.find(piece);
+          break;
+          }
+        }
+      }
+    }
+
+  if (m_PieceThreadsFailed)
+    {
+    const std::string error = m_PieceThreadsErrorMessage;
+    m_PieceMutex.Unlock();
+
+    itk::ImageFileWriterException e(__FILE__, __LINE__);
+    std::ostringstream msg;
+    msg << "Computing stream pieces of " << m_FileName << " failed: " << error;
+    e.SetDescription(msg.str().c_str());
+    e.SetLocation(ITK_LOCATION);
+    throw e;
+    }
+
+  WriteQueueItemType item = it->second;
+  m_ComputedPieces.erase(it);
+  m_NextPieceToWrite = piece + 1;
+  m_PieceWritten->Broadcast();
+  m_PieceMutex.Unlock();
+
+  return item;
+}
+
+template <class TInputImage>
+ITK_THREAD_RETURN_TYPE
+ImageFileWriter<TInputImage>
+::PieceThreadCallback(void * arg)
+{
+  struct itk::MultiThreader::ThreadInfoStruct * pInfo = (itk::MultiThreader::ThreadInfoStruct *) (arg);
+  Self * writer = static_cast<Self *>(pInfo->UserData);
+
+  writer->m_PieceMutex.Lock();
+  const unsigned int threadIndex = writer->m_NumberOfStartedPieceThreads++;
+  InputImageType * output = writer->m_PieceOutputs[threadIndex];
+  writer->m_PieceMutex.Unlock();
+
+  // Bound the number of pieces computed ahead of the written one, since
+  // each computed piece holds a copy of its buffer
+  const unsigned int maxPiecesAhead = writer->m_PieceOutputs.size();
+  const unsigned int nbPieces = writer->m_PieceIORegions.size();
+
+  while (true)
+    {
+    writer->m_PieceMutex.Lock();
+    while (!writer->m_PieceThreadsStopped
+           && writer->m_NextPieceToCompute < nbPieces
+           && writer->m_NextPieceToCompute >= writer->m_NextPieceToWrite + maxPiecesAhead)
+      {
+      writer->m_PieceWritten->Wait(&writer->m_PieceMutex);
+      }
+    if (writer->m_PieceThreadsStopped || writer->m_NextPieceToCompute >= nbPieces)
+      {
+      writer->m_PieceMutex.Unlock();
+      break;
+      }
+    const unsigned int piece = writer->m_NextPieceToCompute++;
+    writer->m_PiecePipelineCurrentPiece[threadIndex] = piece;
+    writer->m_PiecePipelineProgress[threadIndex] = 0.f;
+    writer->m_PieceMutex.Unlock();
+
+    WriteQueueItemType item;
+    std::string error;
+    try
+      {
+      InputImageRegionType streamRegion;
+      itk::ImageIORegionAdaptor<TInputImage::ImageDimension>::
+        Convert(writer->m_PieceIORegions[piece], streamRegion, writer->m_ShiftOutputIndex);
+
+      output->SetRequestedRegion(streamRegion);
+      output->PropagateRequestedRegion();
+      output->UpdateOutputData();
+
+      item = writer->CopyStreamPiece(output, writer->m_PieceIORegions[piece]);
+      }
+    catch (itk::ExceptionObject & err)
+      {
+      error = err.GetDescription();
+      }
+    catch (std::exception & err)
+      {
+      error = err.what();
+      }
+
+    writer->m_PieceMutex.Lock();
+    if (error.empty())
+      {
+      writer->m_ComputedPieces[piece] = item;
+      }
+    else if (!writer->m_PieceThreadsFailed)
+      {
+      writer->m_PieceThreadsFailed = true;
+      writer->m_PieceThreadsStopped = true;
+      writer->m_PieceThreadsErrorMessage = error;
+      }
+    const bool stop = writer->m_PieceThreadsStopped;
+    writer->m_PieceComputed->Broadcast();
+    writer->m_PieceWritten->Broadcast();
+    writer->m_PieceMutex.Unlock();
+
+    if (stop)
+      {
+      break;
+      }
+    }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template <class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::ObservePiecePipelineProgress(itk::Object* object, const itk::EventObject & event)
+{
+  if (typeid(event) != typeid(itk::ProgressEvent))
+    {
+    return;
+    }
+
+  itk::ProcessObject* processObject = dynamic_cast<itk::ProcessObject*>(object);
+  if (processObject == ITK_NULLPTR)
+    {
+    return;
+    }
+
+  // Wake up the writing thread, which updates the writer progress itself
+  // since observers of the writer may not be thread safe
+  m_PieceMutex.Lock();
+  for (unsigned int thread = 0; thread < m_PiecePipelines.size(); ++thread)
+    {
+    if (m_PiecePipelines[thread].GetPointer() == processObject)
+      {
+      m_PiecePipelineProgress[thread] = processObject->GetProgress();
+      m_PieceComputed->Broadcast();
+      break;
+      }
     }
+  m_PieceMutex.Unlock();
 }
 
 template <class TInputImage>
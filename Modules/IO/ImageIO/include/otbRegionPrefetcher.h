@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbRegionPrefetcher_h
+#define otbRegionPrefetcher_h
+
+namespace otb
+{
+
+/** \class RegionPrefetcher
+ * \brief Interface of the sources able to produce their next requested
+ * region in advance.
+ *
+ * A streaming consumer (such as ImageFileWriter) knows the region it will
+ * request at the next update. It propagates this region through the
+ * pipeline, and then calls RecordNextRequestedRegion() on each upstream
+ * RegionPrefetcher: the current output requested region of the source is
+ * then the footprint of the next update, which the source can start
+ * producing (for instance reading from disk) in the background once the
+ * current update is done.
+ *
+ * \sa ImageFileReader
+ * \sa ImageFileWriter
+ *
+ * \ingroup OTBImageIO
+ */
+class RegionPrefetcher
+{
+public:
+  virtual ~RegionPrefetcher() {}
+
+  /** Record the current output requested region as the region that the
+   * next update will request. */
+  virtual void RecordNextRequestedRegion() = 0;
+};
+
+} // namespace otb
+
+#endif
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingPipelineFactory_h
+#define otbStreamingPipelineFactory_h
+
+#include "itkObject.h"
+#include "itkProcessObject.h"
+
+namespace otb
+{
+
+/** \class StreamingPipelineFactory
+ * \brief Base class of the objects building copies of a processing pipeline
+ *
+ * ITK pipelines are not reentrant: two stream pieces can only be computed
+ * at the same time by two distinct pipelines. Subclasses implement
+ * CreatePipeline() so that each call builds a new pipeline, sharing no
+ * filter with the previous ones. The first output of the returned process
+ * object is the image to be processed.
+ *
+ * \sa ImageFileWriter::SetPipelineFactory()
+ *
+ * \ingroup OTBImageIO
+ */
+class ITK_EXPORT StreamingPipelineFactory : public itk::Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef StreamingPipelineFactory      Self;
+  typedef itk::Object                   Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(StreamingPipelineFactory, itk::Object);
+
+  /** Build a new copy of the pipeline, and return its last process object */
+  virtual itk::ProcessObject::Pointer CreatePipeline() const = 0;
+
+protected:
+  StreamingPipelineFactory() {}
+  ~StreamingPipelineFactory() ITK_OVERRIDE {}
+
+private:
+  StreamingPipelineFactory(const Self &); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+};
+
+} // end namespace otb
+
+#endif
@@ -24,6 +24,9 @@
 
 #include "otbImageFileReader.h"
 #include "otbImageFileWriter.h"
+#include "otbPipelineMemoryPrintCalculator.h"
+#include "otbGDALImageIO.h"
+#include "otbMetaDataKey.h"
 
 int otbImageFileReaderTest(int itkNotUsed(argc), char* argv[])
 {
@@ -52,3 +55,46 @@ int otbImageFileReaderTest(int itkNotUsed(argc), char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbImageFileReaderCacheMemoryPrintTest(int itkNotUsed(argc), char* argv[])
+{
+  typedef otb::Image<unsigned char, 2>                         ImageType;
+  typedef otb::ImageFileReader<ImageType>                      ReaderType;
+  typedef otb::PipelineMemoryPrintCalculator::MemoryPrintType  MemoryPrintType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(argv[1]);
+  reader->UpdateOutputInformation();
+
+  // The reader reports the share of the GDAL block cache its blocks can fill
+  unsigned int cacheSize = 0;
+  if (!itk::ExposeMetaData<unsigned int>(reader->GetMetaDataDictionary(),
+                                         otb::MetaDataKey::CacheSizeInBytes, cacheSize)
+      || cacheSize == 0)
+    {
+    std::cerr << "The reader does not report the GDAL block cache" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  if (cacheSize > otb::GDALImageIO::GetCacheSizeInBytes())
+    {
+    std::cerr << "Reported cache share (" << cacheSize << " bytes) exceeds the GDAL cache ("
+              << otb::GDALImageIO::GetCacheSizeInBytes() << " bytes)" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  otb::PipelineMemoryPrintCalculator::Pointer calculator = otb::PipelineMemoryPrintCalculator::New();
+  calculator->SetDataToWrite(reader->GetOutput());
+  calculator->Compute();
+
+  if (calculator->GetCacheMemoryPrint() != static_cast<MemoryPrintType>(cacheSize)
+      || calculator->GetFixedMemoryPrint() < calculator->GetCacheMemoryPrint())
+    {
+    std::cerr << "Fixed memory print is " << calculator->GetFixedMemoryPrint()
+              << " bytes with a cache memory print of " << calculator->GetCacheMemoryPrint()
+              << " bytes, expected to include the " << cacheSize << " bytes of the reader" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbImage.h"
+#include "otbImageFileReader.h"
+#include "otbImageFileWriter.h"
+#include "otbStreamingPipelineFactory.h"
+#include "itkCommand.h"
+#include "itkMeanImageFilter.h"
+
+namespace
+{
+typedef unsigned char                               PixelType;
+typedef otb::Image<PixelType, 2>                    ImageType;
+typedef otb::ImageFileReader<ImageType>             ReaderType;
+typedef otb::ImageFileWriter<ImageType>             WriterType;
+typedef itk::MeanImageFilter<ImageType, ImageType>  FilterType;
+
+/** Build reader -> mean filter pipelines on a given file */
+class MeanPipelineFactory : public otb::StreamingPipelineFactory
+{
+public:
+  typedef MeanPipelineFactory                  Self;
+  typedef otb::StreamingPipelineFactory        Superclass;
+  typedef itk::SmartPointer<Self>              Pointer;
+  typedef itk::SmartPointer<const Self>        ConstPointer;
+
+  itkNewMacro(Self);
+  itkTypeMacro(MeanPipelineFactory, otb::StreamingPipelineFactory);
+
+  itkSetStringMacro(FileName);
+
+  itk::ProcessObject::Pointer CreatePipeline() const ITK_OVERRIDE
+  {
+    ReaderType::Pointer reader = ReaderType::New();
+    reader->SetFileName(m_FileName);
+
+    FilterType::Pointer filter = FilterType::New();
+    filter->SetInput(reader->GetOutput());
+    ImageType::SizeType radius;
+    radius.Fill(2);
+    filter->SetRadius(radius);
+    filter->SetNumberOfThreads(1);
+
+    return filter.GetPointer();
+  }
+
+protected:
+  MeanPipelineFactory() {}
+  ~MeanPipelineFactory() ITK_OVERRIDE {}
+
+private:
+  std::string m_FileName;
+};
+
+/** Count the progress events of the writer and check they never decrease */
+class ProgressObserver : public itk::Command
+{
+public:
+  typedef ProgressObserver         Self;
+  typedef itk::Command             Superclass;
+  typedef itk::SmartPointer<Self>  Pointer;
+
+  itkNewMacro(Self);
+
+  void Execute(itk::Object * caller, const itk::EventObject & event) ITK_OVERRIDE
+  {
+    this->Execute(const_cast<const itk::Object *>(caller), event);
+  }
+
+  void Execute(const itk::Object * caller, const itk::EventObject & event) ITK_OVERRIDE
+  {
+    const itk::ProcessObject * process = dynamic_cast<const itk::ProcessObject *>(caller);
+    if (process != ITK_NULLPTR && itk::ProgressEvent().CheckEvent(&event))
+      {
+      if (process->GetProgress() < m_LastProgress)
+        {
+        m_Decreased = true;
+        }
+      m_LastProgress = process->GetProgress();
+      ++m_NumberOfEvents;
+      }
+  }
+
+  unsigned int m_NumberOfEvents;
+  float        m_LastProgress;
+  bool         m_Decreased;
+
+protected:
+  ProgressObserver() : m_NumberOfEvents(0), m_LastProgress(0.f), m_Decreased(false) {}
+};
+}
+
+int otbImageFileWriterParallelPiecesTest(int itkNotUsed(argc), char* argv[])
+{
+  const char * inputFilename = argv[1];
+  const char * sequentialFilename = argv[2];
+  const char * parallelFilename = argv[3];
+  const unsigned int nbParallelPieces = atoi(argv[4]);
+
+  MeanPipelineFactory::Pointer factory = MeanPipelineFactory::New();
+  factory->SetFileName(inputFilename);
+
+  // Sequential processing of the stream pieces
+  itk::ProcessObject::Pointer sequentialPipeline = factory->CreatePipeline();
+
+  WriterType::Pointer sequentialWriter = WriterType::New();
+  sequentialWriter->SetFileName(sequentialFilename);
+  sequentialWriter->SetInput(static_cast<FilterType *>(sequentialPipeline.GetPointer())->GetOutput());
+  sequentialWriter->SetNumberOfDivisionsStrippedStreaming(10);
+  sequentialWriter->Update();
+
+  // Parallel processing of the stream pieces
+  itk::ProcessObject::Pointer parallelPipeline = factory->CreatePipeline();
+
+  WriterType::Pointer parallelWriter = WriterType::New();
+  parallelWriter->SetFileName(parallelFilename);
+  parallelWriter->SetInput(static_cast<FilterType *>(parallelPipeline.GetPointer())->GetOutput());
+  parallelWriter->SetNumberOfDivisionsStrippedStreaming(10);
+  parallelWriter->SetPipelineFactory(factory);
+  parallelWriter->SetNumberOfParallelPieces(nbParallelPieces);
+
+  ProgressObserver::Pointer observer = ProgressObserver::New();
+  parallelWriter->AddObserver(itk::ProgressEvent(), observer);
+  parallelWriter->Update();
+
+  if (observer->m_Decreased || observer->m_LastProgress != 1.f)
+    {
+    std::cerr << "Progress of the parallel writer is not monotonic up to 1 (last progress: "
+              << observer->m_LastProgress << ")" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
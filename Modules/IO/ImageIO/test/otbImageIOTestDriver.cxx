@@ -90,6 +90,7 @@ void RegisterTests()
   REGISTER_TEST(otbImageFileReaderServerName);
   REGISTER_TEST(otbPNGIndexedNbBandsTest);
   REGISTER_TEST(otbImageFileReaderTest);
+  REGISTER_TEST(otbImageFileReaderCacheMemoryPrintTest);
   REGISTER_TEST(otbVectorImageFileWriterScalarTestWithoutInputShort);
   REGISTER_TEST(otbVectorImageFileWriterScalarTestWithoutInputInt);
   REGISTER_TEST(otbVectorImageFileWriterScalarTestWithoutInputFloat);
@@ -100,6 +101,7 @@ void RegisterTests()
   REGISTER_TEST(otbVectorImageFileWriterComplexTestWithoutInputDouble);
   REGISTER_TEST(otbWritingComplexDataWithComplexImageTest);
   REGISTER_TEST(otbImageFileWriterWithFilterTest);
+  REGISTER_TEST(otbImageFileWriterParallelPiecesTest);
   REGISTER_TEST(otbImageFileReaderRADComplexDouble);
   REGISTER_TEST(otbPipeline);
   REGISTER_TEST(otbStreamingImageFilterTest);
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbContiguousListSample_h
+#define otbContiguousListSample_h
+
+#include "itkListSample.h"
+#include <vector>
+
+namespace otb
+{
+
+/** \class ContiguousListSample
+ *  \brief ListSample of VariableLengthVector keeping all the samples
+ *  in a single buffer.
+ *
+ *  The values of the samples are stored row by row in one buffer and
+ *  each sample of the list is a VariableLengthVector viewing its row,
+ *  which avoids one heap allocation per sample. The class can be used
+ *  wherever a ListSample is expected.
+ *
+ *  Samples are bound to the buffer by Allocate() or SwapBuffer().
+ *  Samples added afterwards with PushBack(), or replaced by
+ *  SetMeasurementVector(), own their own memory: the list is then no
+ *  longer contiguous (see GetContiguousSampleData()). Values can be
+ *  changed in place through GetBufferPointer().
+ *
+ *  \sa GetContiguousSampleData
+ *
+ * \ingroup OTBLearningBase
+ */
+template <class TMeasurementVector>
+class ITK_EXPORT ContiguousListSample
+  : public itk::Statistics::ListSample<TMeasurementVector>
+{
+public:
+  /** Standard class typedefs. */
+  typedef ContiguousListSample                             Self;
+  typedef itk::Statistics::ListSample<TMeasurementVector>  Superclass;
+  typedef itk::SmartPointer<Self>                          Pointer;
+  typedef itk::SmartPointer<const Self>                    ConstPointer;
+
+  /** Run-time type information (and related methods). */
+  itkNewMacro(Self);
+  itkTypeMacro(ContiguousListSample, ListSample);
+
+  typedef typename Superclass::MeasurementVectorType       MeasurementVectorType;
+  typedef typename Superclass::InstanceIdentifier          InstanceIdentifier;
+  typedef typename MeasurementVectorType::ValueType        ValueType;
+  typedef std::vector<ValueType>                           BufferType;
+
+  /** Allocate nbSamples samples of GetMeasurementVectorSize() values,
+   *  set to zero. Previous samples are removed. */
+  void Allocate(InstanceIdentifier nbSamples);
+
+  /** Use the given values, stored row by row, as the samples of the
+   *  list. The previous buffer is returned in buffer. */
+  void SwapBuffer(BufferType & buffer);
+
+  /** Buffer holding the samples bound by Allocate() or SwapBuffer() */
+  ValueType * GetBufferPointer()
+  {
+    return m_Buffer.empty() ? ITK_NULLPTR : &m_Buffer[0];
+  }
+
+  const ValueType * GetBufferPointer() const
+  {
+    return m_Buffer.empty() ? ITK_NULLPTR : &m_Buffer[0];
+  }
+
+protected:
+  ContiguousListSample() {}
+  ~ContiguousListSample() ITK_OVERRIDE {}
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
+
+private:
+  ContiguousListSample(const Self &); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+
+  /** Make the samples of the list views on the rows of m_Buffer */
+  void BindSamples();
+
+  BufferType m_Buffer;
+};
+
+/** Returns the address of the first value of a list sample when its
+ *  samples are stored row by row in a single buffer, as in a
+ *  ContiguousListSample, and ITK_NULLPTR otherwise. Backends can use it
+ *  to read the samples without copying them. */
+template <class TListSample>
+const typename TListSample::MeasurementVectorType::ValueType *
+GetContiguousSampleData(const TListSample * listSample);
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbContiguousListSample.txx"
+#endif
+
+#endif
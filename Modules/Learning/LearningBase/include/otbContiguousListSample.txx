@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbContiguousListSample_txx
+#define otbContiguousListSample_txx
+
+#include "otbContiguousListSample.h"
+
+namespace otb
+{
+
+template <class TMeasurementVector>
+void
+ContiguousListSample<TMeasurementVector>
+::Allocate(InstanceIdentifier nbSamples)
+{
+  BufferType buffer(nbSamples * this->GetMeasurementVectorSize(), 0);
+  this->SwapBuffer(buffer);
+}
+
+template <class TMeasurementVector>
+void
+ContiguousListSample<TMeasurementVector>
+::SwapBuffer(BufferType & buffer)
+{
+  const unsigned int sampleSize = this->GetMeasurementVectorSize();
+  if (sampleSize == 0)
+    {
+    itkExceptionMacro(<< "The measurement vector size must be set before binding samples");
+    }
+  if (buffer.size() % sampleSize != 0)
+    {
+    itkExceptionMacro(<< "The buffer holds " << buffer.size() << " values, which is not a multiple of the sample size " << sampleSize);
+    }
+
+  m_Buffer.swap(buffer);
+  this->BindSamples();
+  this->Modified();
+}
+
+template <class TMeasurementVector>
+void
+ContiguousListSample<TMeasurementVector>
+::BindSamples()
+{
+  const unsigned int sampleSize = this->GetMeasurementVectorSize();
+  const InstanceIdentifier nbSamples = m_Buffer.size() / sampleSize;
+
+  // Default constructed vectors do not allocate anything
+  this->Superclass::Clear();
+  this->Superclass::Resize(nbSamples);
+
+  for (InstanceIdentifier id = 0; id < nbSamples; ++id)
+    {
+    // ListSample only gives const access to its samples
+    MeasurementVectorType & sample = const_cast<MeasurementVectorType &>(this->GetMeasurementVector(id));
+    sample.SetData(&m_Buffer[id * sampleSize], sampleSize, false);
+    }
+}
+
+template <class TMeasurementVector>
+void
+ContiguousListSample<TMeasurementVector>
+::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Contiguous: " << (GetContiguousSampleData(this) != ITK_NULLPTR ? "yes" : "no") << std::endl;
+}
+
+template <class TListSample>
+const typename TListSample::MeasurementVectorType::ValueType *
+GetContiguousSampleData(const TListSample * listSample)
+{
+  typedef typename TListSample::MeasurementVectorType::ValueType ValueType;
+
+  if (listSample == ITK_NULLPTR || listSample->Size() == 0)
+    {
+    return ITK_NULLPTR;
+    }
+
+  const unsigned int sampleSize = listSample->GetMeasurementVectorSize();
+  const ValueType * data = listSample->GetMeasurementVector(0).GetDataPointer();
+
+  for (typename TListSample::InstanceIdentifier id = 0; id < listSample->Size(); ++id)
+    {
+    if (listSample->GetMeasurementVector(id).GetDataPointer() != data + id * sampleSize)
+      {
+      return ITK_NULLPTR;
+      }
+    }
+  return data;
+}
+
+} // end namespace otb
+
+#endif
@@ -172,6 +172,27 @@ public:
   void SetRegressionMode(bool flag);
   //@}
 
+  /**\name Quantized inference */
+  //@{
+  /** Query capacity to predict from quantized features and weights */
+  bool HasQuantizedInference() const {return m_IsQuantizedInferenceSupported;}
+
+  /** Predict from int16 quantized features and weights instead of the
+   *  floating point model. Child classes supporting it should override
+   *  this method to build their quantized model. */
+  itkGetMacro(QuantizedInference,bool);
+  virtual void SetQuantizedInference(bool flag);
+
+  /** Fraction of the input samples for which the quantized inference
+   *  predicts the same target as the floating point inference. Throws an
+   *  exception in regression mode. */
+  double ComputeQuantizationAgreement(const InputListSampleType * input);
+
+  /** Root mean square difference between the targets predicted by the
+   *  quantized and the floating point inferences, for regression */
+  double ComputeQuantizationError(const InputListSampleType * input);
+  //@}
+
 protected:
   /** Constructor */
   MachineLearningModel();
@@ -201,6 +222,25 @@ protected:
   /** flag that tells if the model support confidence index output */
   bool m_ConfidenceIndex;
 
+  /** flag to predict from the quantized model */
+  bool m_QuantizedInference;
+
+  /** flag that indicates if the model supports quantized inference,
+   *  child classes should modify it in their constructor if they
+   *  support it */
+  bool m_IsQuantizedInferenceSupported;
+
+  /** Check the arguments given to DoPredictBatch() : the target and
+   *  confidence lists must have the size of the input list, and the
+   *  requested range must be inside the input list. Throws if it is not. */
+  void CheckPredictBatchArguments(const InputListSampleType * input, const unsigned int & startIndex, const unsigned int & size, const TargetListSampleType * targets, const ConfidenceListSampleType * quality) const;
+
+  /** Predict the input samples with the floating point and the quantized
+   *  inferences, keeping the current mode */
+  void PredictWithBothInferences(const InputListSampleType * input,
+                                 typename TargetListSampleType::Pointer & floatTargets,
+                                 typename TargetListSampleType::Pointer & quantizedTargets);
+
   /** Is DoPredictBatch multi-threaded ? */
   bool m_IsDoPredictBatchMultiThreaded;
 
@@ -29,6 +29,8 @@
 
 #include "itkMultiThreader.h"
 
+#include <cmath>
+
 namespace otb
 {
 
@@ -38,6 +40,8 @@ MachineLearningModel<TInputValue,TOutputValue,TConfidenceValue>
   m_RegressionMode(false),
   m_IsRegressionSupported(false),
   m_ConfidenceIndex(false),
+  m_QuantizedInference(false),
+  m_IsQuantizedInferenceSupported(false),
   m_IsDoPredictBatchMultiThreaded(false)
 {}
 
@@ -63,6 +67,97 @@ MachineLearningModel<TInputValue,TOutputValue,TConfidenceValue>
     }
 }
 
+template <class TInputValue, class TOutputValue, class TConfidenceValue>
+void
+MachineLearningModel<TInputValue,TOutputValue,TConfidenceValue>
+::SetQuantizedInference(bool flag)
+{
+  if (flag && !m_IsQuantizedInferenceSupported)
+    {
+    itkGenericExceptionMacro(<< "Quantized inference not implemented.");
+    }
+  if (m_QuantizedInference != flag)
+    {
+    m_QuantizedInference = flag;
+    this->Modified();
+    }
+}
+
+template <class TInputValue, class TOutputValue, class TConfidenceValue>
+void
+MachineLearningModel<TInputValue,TOutputValue,TConfidenceValue>
+::PredictWithBothInferences(const InputListSampleType * input,
+                            typename TargetListSampleType::Pointer & floatTargets,
+                            typename TargetListSampleType::Pointer & quantizedTargets)
+{
+  // Predict the same samples with both inferences, then restore the mode
+  const bool quantized = m_QuantizedInference;
+  this->SetQuantizedInference(false);
+  floatTargets = this->PredictBatch(input);
+  this->SetQuantizedInference(true);
+  quantizedTargets = this->PredictBatch(input);
+  this->SetQuantizedInference(quantized);
+}
+
+template <class TInputValue, class TOutputValue, class TConfidenceValue>
+double
+MachineLearningModel<TInputValue,TOutputValue,TConfidenceValue>
+::ComputeQuantizationAgreement(const InputListSampleType * input)
+{
+  if (m_RegressionMode)
+    {
+    itkExceptionMacro(<< "Quantization agreement is meaningless in regression mode, use ComputeQuantizationError().");
+    }
+  if (input == ITK_NULLPTR || input->Size() == 0)
+    {
+    return 1.;
+    }
+
+  typename TargetListSampleType::Pointer floatTargets;
+  typename TargetListSampleType::Pointer quantizedTargets;
+  this->PredictWithBothInferences(input, floatTargets, quantizedTargets);
+
+  unsigned long nbAgreements = 0;
+  for (unsigned long id = 0; id < input->Size(); ++id)
+    {
+    if (floatTargets->GetMeasurementVector(id) == quantizedTargets->GetMeasurementVector(id))
+      {
+      ++nbAgreements;
+      }
+    }
+  return static_cast<double>(nbAgreements) / static_cast<double>(input->Size());
+}
+
+template <class TInputValue, class TOutputValue, class TConfidenceValue>
+double
+MachineLearningModel<TInputValue,TOutputValue,TConfidenceValue>
+::ComputeQuantizationError(const InputListSampleType * input)
+{
+  if (input == ITK_NULLPTR || input->Size() == 0)
+    {
+    return 0.;
+    }
+
+  typename TargetListSampleType::Pointer floatTargets;
+  typename TargetListSampleType::Pointer quantizedTargets;
+  this->PredictWithBothInferences(input, floatTargets, quantizedTargets);
+
+  double sumOfSquares = 0.;
+  unsigned long nbValues = 0;
+  for (unsigned long id = 0; id < input->Size(); ++id)
+    {
+    const TargetSampleType & floatTarget = floatTargets->GetMeasurementVector(id);
+    const TargetSampleType & quantizedTarget = quantizedTargets->GetMeasurementVector(id);
+    for (unsigned int i = 0; i < floatTarget.Size(); ++i)
+      {
+      const double diff = static_cast<double>(floatTarget[i]) - static_cast<double>(quantizedTarget[i]);
+      sumOfSquares += diff * diff;
+      ++nbValues;
+      }
+    }
+  return nbValues > 0 ? std::sqrt(sumOfSquares / static_cast<double>(nbValues)) : 0.;
+}
+
 template <class TInputValue, class TOutputValue, class TConfidenceValue>
 typename MachineLearningModel<TInputValue,TOutputValue,TConfidenceValue>
 ::TargetSampleType
@@ -134,18 +229,30 @@ MachineLearningModel<TInputValue,TOutputValue,TConfidenceValue>
 template <class TInputValue, class TOutputValue, class TConfidenceValue>
 void
 MachineLearningModel<TInputValue,TOutputValue,TConfidenceValue>
-::DoPredictBatch(const InputListSampleType * input, const unsigned int & startIndex, const unsigned int & size, TargetListSampleType * targets, ConfidenceListSampleType * quality) const
+::CheckPredictBatchArguments(const InputListSampleType * input, const unsigned int & startIndex, const unsigned int & size, const TargetListSampleType * targets, const ConfidenceListSampleType * quality) const
 {
   assert(input != ITK_NULLPTR);
   assert(targets != ITK_NULLPTR);
-  
+
   assert(input->Size()==targets->Size()&&"Input sample list and target label list do not have the same size.");
   assert(((quality==ITK_NULLPTR)||(quality->Size()==input->Size()))&&"Quality samples list is not null and does not have the same size as input samples list");
 
+  // Avoid unused parameter warnings in release builds
+  (void)targets;
+  (void)quality;
+
   if(startIndex+size>input->Size())
     {
     itkExceptionMacro(<<"requested range ["<<startIndex<<", "<<startIndex+size<<"[ partially outside input sample list range.[0,"<<input->Size()<<"[");
     }
+}
+
+template <class TInputValue, class TOutputValue, class TConfidenceValue>
+void
+MachineLearningModel<TInputValue,TOutputValue,TConfidenceValue>
+::DoPredictBatch(const InputListSampleType * input, const unsigned int & startIndex, const unsigned int & size, TargetListSampleType * targets, ConfidenceListSampleType * quality) const
+{
+  this->CheckPredictBatchArguments(input, startIndex, size, targets, quality);
 
   if(quality != ITK_NULLPTR)
     {
@@ -174,6 +281,7 @@ MachineLearningModel<TInputValue,TOutputValue,TConfidenceValue>
 {
   // Call superclass implementation
   Superclass::PrintSelf(os,indent);
+  os << indent << "QuantizedInference: " << m_QuantizedInference << std::endl;
 }
 }
 
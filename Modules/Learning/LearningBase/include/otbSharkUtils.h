@@ -111,6 +111,72 @@ template <class T> void ListSampleRangeToSharkVector(const T * listSample, std::
     } 
 }
 
+/** Converts the samples [start, start+size[ of a ListSample directly
+ *  into the batches of a shark::Data, in one pass and without an
+ *  intermediate vector per sample */
+template <class T> void ListSampleRangeToSharkData(const T * listSample, shark::Data<shark::RealVector> & output, unsigned int start, unsigned int size)
+{
+  assert(listSample != ITK_NULLPTR);
+
+  if(start+size>listSample->Size())
+    {
+    itkGenericExceptionMacro(<<"Requested range ["<<start<<", "<<start+size<<"[ is out of bound for input list sample (range [0, "<<listSample->Size()<<"[");
+    }
+
+  const unsigned int sampleSize = listSample->GetMeasurementVectorSize();
+  output = shark::Data<shark::RealVector>(size, shark::RealVector(sampleSize));
+
+  unsigned int sampleIdx = start;
+  for (std::size_t b = 0; b < output.numberOfBatches(); ++b)
+    {
+    shark::RealMatrix & batch = output.batch(b);
+    for (std::size_t row = 0; row < batch.size1(); ++row, ++sampleIdx)
+      {
+      typename T::MeasurementVectorType const & sample = listSample->GetMeasurementVector(sampleIdx);
+      for (unsigned int i = 0; i < sampleSize; ++i)
+        {
+        batch(row, i) = sample[i];
+        }
+      }
+    }
+}
+
+/** Converts the labels [start, start+size[ of a ListSample directly
+ *  into the batches of a shark::Data */
+template <class T> void ListSampleRangeToSharkData(const T * listSample, shark::Data<unsigned int> & output, unsigned int start, unsigned int size)
+{
+  assert(listSample != ITK_NULLPTR);
+
+  if(start+size>listSample->Size())
+    {
+    itkGenericExceptionMacro(<<"Requested range ["<<start<<", "<<start+size<<"[ is out of bound for input list sample (range [0, "<<listSample->Size()<<"[");
+    }
+
+  output = shark::Data<unsigned int>(size, 0u);
+
+  unsigned int sampleIdx = start;
+  for (std::size_t b = 0; b < output.numberOfBatches(); ++b)
+    {
+    shark::UIntVector & batch = output.batch(b);
+    for (std::size_t row = 0; row < batch.size(); ++row, ++sampleIdx)
+      {
+      batch(row) = listSample->GetMeasurementVector(sampleIdx)[0];
+      }
+    }
+}
+
+template <class T> void ListSampleToSharkData(const T * listSample, shark::Data<shark::RealVector> & output)
+{
+  assert(listSample != ITK_NULLPTR);
+  ListSampleRangeToSharkData(listSample,output,0U,static_cast<unsigned int>(listSample->Size()));
+}
+
+template <class T> void ListSampleToSharkData(const T * listSample, shark::Data<unsigned int> & output)
+{
+  assert(listSample != ITK_NULLPTR);
+  ListSampleRangeToSharkData(listSample,output,0U,static_cast<unsigned int>(listSample->Size()));
+}
+
 template <class T> void ListSampleToSharkVector(const T * listSample, std::vector<shark::RealVector> & output)
 {
   assert(listSample != ITK_NULLPTR);
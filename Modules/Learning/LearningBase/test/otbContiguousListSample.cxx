@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbContiguousListSample.h"
+#include "itkVariableLengthVector.h"
+
+#include <iostream>
+
+int otbContiguousListSample(int itkNotUsed(argc), char * itkNotUsed(argv) [])
+{
+  typedef itk::VariableLengthVector<float>               SampleType;
+  typedef otb::ContiguousListSample<SampleType>          ListSampleType;
+
+  const unsigned int nbSamples = 10;
+  const unsigned int sampleSize = 3;
+
+  ListSampleType::Pointer listSample = ListSampleType::New();
+  listSample->SetMeasurementVectorSize(sampleSize);
+
+  ListSampleType::BufferType values(nbSamples * sampleSize);
+  for (unsigned int i = 0; i < values.size(); ++i)
+    {
+    values[i] = static_cast<float>(i);
+    }
+  listSample->SwapBuffer(values);
+
+  if (listSample->Size() != nbSamples)
+    {
+    std::cout << "Wrong number of samples: " << listSample->Size() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Samples are views on the rows of the buffer
+  const float * data = otb::GetContiguousSampleData(listSample.GetPointer());
+  if (data == ITK_NULLPTR || data != listSample->GetBufferPointer())
+    {
+    std::cout << "Samples are not contiguous" << std::endl;
+    return EXIT_FAILURE;
+    }
+  for (unsigned int id = 0; id < nbSamples; ++id)
+    {
+    for (unsigned int j = 0; j < sampleSize; ++j)
+      {
+      if (listSample->GetMeasurementVector(id)[j] != static_cast<float>(id * sampleSize + j))
+        {
+        std::cout << "Wrong value for sample " << id << ", component " << j << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  // Iterators see the same samples
+  unsigned int id = 0;
+  for (ListSampleType::ConstIterator it = listSample->Begin(); it != listSample->End(); ++it, ++id)
+    {
+    if (it.GetMeasurementVector().GetDataPointer() != data + id * sampleSize)
+      {
+      std::cout << "Iterator does not view sample " << id << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // An added sample owns its memory, the list is no longer contiguous
+  SampleType sample(sampleSize);
+  sample.Fill(0.f);
+  listSample->PushBack(sample);
+  if (otb::GetContiguousSampleData(listSample.GetPointer()) != ITK_NULLPTR
+      || listSample->GetMeasurementVector(nbSamples - 1)[0] != static_cast<float>((nbSamples - 1) * sampleSize))
+    {
+    std::cout << "PushBack should break contiguity and keep values" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Allocate binds zeroed samples again
+  listSample->Allocate(4);
+  if (listSample->Size() != 4
+      || otb::GetContiguousSampleData(listSample.GetPointer()) != listSample->GetBufferPointer()
+      || listSample->GetMeasurementVector(3)[2] != 0.f)
+    {
+    std::cout << "Allocate failed" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
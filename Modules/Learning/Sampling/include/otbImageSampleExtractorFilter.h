@@ -73,7 +73,11 @@ public:
   /** Get the output samples OGR container */
   ogr::DataSource* GetOutputSamples();
 
-  void Synthetize(void) ITK_OVERRIDE{}
+  /** Close the sample file, if any */
+  void Synthetize(void) ITK_OVERRIDE
+  {
+    this->CloseSampleFile();
+  }
 
   /** Reset method called before starting the streaming*/
   void Reset(void) ITK_OVERRIDE;
@@ -174,15 +178,43 @@ public:
   void SetClassFieldName(const std::string &name);
   std::string GetClassFieldName(void);
 
+  /** Number of features written within one OGR transaction */
+  void SetOGRTransactionSize(unsigned long size);
+  unsigned long GetOGRTransactionSize();
+
+  /** Write the samples to a columnar binary sample file instead of the
+   *  output samples (see PersistentSamplingFilterBase::SetSampleFileName) */
+  void SetSampleFileName(const std::string &name);
+  std::string GetSampleFileName();
+
+  /** Enable the sparse sampling mode: only the blocks of the input image
+   *  (and mask) touched by the input geometries are streamed, instead of
+   *  the whole image extent */
+  itkSetMacro(SparseSampling, bool);
+  itkGetMacro(SparseSampling, bool);
+  itkBooleanMacro(SparseSampling);
+
+  /** RAM used to group the touched blocks in sparse sampling mode (if 0,
+   *  the configuration option is used) */
+  itkSetMacro(AvailableRAMInMB, unsigned int);
+  itkGetMacro(AvailableRAMInMB, unsigned int);
+
 protected:
   /** Constructor */
-  ImageSampleExtractorFilter() {}
+  ImageSampleExtractorFilter() : m_SparseSampling(false), m_AvailableRAMInMB(0) {}
   /** Destructor */
   ~ImageSampleExtractorFilter() ITK_OVERRIDE {}
 
+  /** Stream only the touched blocks in sparse sampling mode */
+  void GenerateData(void) ITK_OVERRIDE;
+
 private:
   ImageSampleExtractorFilter(const Self &); //purposely not implemented
   void operator =(const Self&); //purposely not implemented
+
+  bool m_SparseSampling;
+
+  unsigned int m_AvailableRAMInMB;
 };
 
 } // end of namespace otb
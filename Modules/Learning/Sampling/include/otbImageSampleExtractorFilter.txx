@@ -93,6 +93,7 @@ PersistentImageSampleExtractorFilter<TInputImage>
   ogr::DataSource* inputDS = const_cast<ogr::DataSource*>(this->GetOGRData());
   ogr::DataSource* output  = this->GetOutputSamples();
   this->InitializeOutputDataSource(inputDS,output);
+  this->OpenSampleFile();
 }
 
 template<class TInputImage>
@@ -346,6 +347,78 @@ ImageSampleExtractorFilter<TInputImage>
   return this->GetFilter()->GetFieldName();
 }
 
+template<class TInputImage>
+void
+ImageSampleExtractorFilter<TInputImage>
+::SetOGRTransactionSize(unsigned long size)
+{
+  this->GetFilter()->SetOGRTransactionSize(size);
+}
+
+template<class TInputImage>
+unsigned long
+ImageSampleExtractorFilter<TInputImage>
+::GetOGRTransactionSize()
+{
+  return this->GetFilter()->GetOGRTransactionSize();
+}
+
+template<class TInputImage>
+void
+ImageSampleExtractorFilter<TInputImage>
+::SetSampleFileName(const std::string &name)
+{
+  this->GetFilter()->SetSampleFileName(name);
+}
+
+template<class TInputImage>
+std::string
+ImageSampleExtractorFilter<TInputImage>
+::GetSampleFileName()
+{
+  return this->GetFilter()->GetSampleFileName();
+}
+
+template<class TInputImage>
+void
+ImageSampleExtractorFilter<TInputImage>
+::GenerateData(void)
+{
+  if (!m_SparseSampling)
+    {
+    Superclass::GenerateData();
+    return;
+    }
+
+  // Reset the filter before the generation.
+  this->GetFilter()->Reset();
+  this->GetFilter()->UpdateOutputInformation();
+
+  typedef SparseBlockStreamingManager<TInputImage> SparseManagerType;
+  typename SparseManagerType::Pointer sparseManager = SparseManagerType::New();
+  sparseManager->SetAvailableRAMInMB(m_AvailableRAMInMB);
+  this->GetFilter()->AddSampledRegions(sparseManager);
+
+  // Stream the touched blocks only, then restore the streaming mode
+  typename Superclass::StreamerType::StreamingManagerPointerType
+    previousManager = this->GetStreamer()->GetStreamingManager();
+  this->GetStreamer()->SetStreamingManager(sparseManager);
+  this->GetStreamer()->SetInput(this->GetFilter()->GetOutput());
+  try
+    {
+    this->GetStreamer()->Update();
+    }
+  catch (...)
+    {
+    this->GetStreamer()->SetStreamingManager(previousManager);
+    throw;
+    }
+  this->GetStreamer()->SetStreamingManager(previousManager);
+
+  // Synthetize data after the streaming of the touched blocks.
+  this->GetFilter()->Synthetize();
+}
+
 } // end of namespace otb
 
 #endif
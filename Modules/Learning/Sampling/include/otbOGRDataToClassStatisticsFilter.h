@@ -97,6 +97,12 @@ protected:
                      typename TInputImage::PointType& imgPoint,
                      itk::ThreadIdType& threadid) ITK_OVERRIDE;
 
+  /** Count a whole run of pixels inside a polygon at once */
+  void ProcessSpan(const ogr::Feature& feature,
+                   typename TInputImage::IndexType& startIndex,
+                   unsigned long length,
+                   itk::ThreadIdType& threadid) ITK_OVERRIDE;
+
   /** Prepare temporary variables for the current feature */
   void PrepareFeature(const ogr::Feature& feature,
                       itk::ThreadIdType& threadid) ITK_OVERRIDE;
@@ -189,6 +189,23 @@ PersistentOGRDataToClassStatisticsFilter<TInputImage,TMaskImage>
   m_NbPixelsThread[threadid]++;
 }
 
+template<class TInputImage, class TMaskImage>
+void
+PersistentOGRDataToClassStatisticsFilter<TInputImage,TMaskImage>
+::ProcessSpan(
+  const ogr::Feature&,
+  typename TInputImage::IndexType&,
+  unsigned long length,
+  itk::ThreadIdType& threadid)
+{
+  std::string& className = m_CurrentClass[threadid];
+  unsigned long& fId = m_CurrentFID[threadid];
+
+  m_ElmtsInClassThread[threadid][className] += length;
+  m_PolygonThread[threadid][fId] += length;
+  m_NbPixelsThread[threadid] += length;
+}
+
 template<class TInputImage, class TMaskImage>
 void
 PersistentOGRDataToClassStatisticsFilter<TInputImage,TMaskImage>
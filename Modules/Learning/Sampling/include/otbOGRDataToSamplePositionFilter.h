@@ -252,15 +252,38 @@ public:
   /** Get the field name storing the original FID of each sample*/
   std::string GetOriginFieldName();
 
+  /** Number of features written within one OGR transaction */
+  void SetOGRTransactionSize(unsigned long size);
+  unsigned long GetOGRTransactionSize();
+
+  /** Enable the sparse sampling mode: only the blocks of the input image
+   *  (and mask) touched by the input geometries are streamed, instead of
+   *  the whole image extent */
+  itkSetMacro(SparseSampling, bool);
+  itkGetMacro(SparseSampling, bool);
+  itkBooleanMacro(SparseSampling);
+
+  /** RAM used to group the touched blocks in sparse sampling mode (if 0,
+   *  the configuration option is used) */
+  itkSetMacro(AvailableRAMInMB, unsigned int);
+  itkGetMacro(AvailableRAMInMB, unsigned int);
+
 protected:
   /** Constructor */
-  OGRDataToSamplePositionFilter() {}
+  OGRDataToSamplePositionFilter() : m_SparseSampling(false), m_AvailableRAMInMB(0) {}
   /** Destructor */
   ~OGRDataToSamplePositionFilter() ITK_OVERRIDE {}
 
+  /** Stream only the touched blocks in sparse sampling mode */
+  void GenerateData(void) ITK_OVERRIDE;
+
 private:
   OGRDataToSamplePositionFilter(const Self &); //purposely not implemented
   void operator =(const Self&); //purposely not implemented
+
+  bool m_SparseSampling;
+
+  unsigned int m_AvailableRAMInMB;
 };
 
 } // end of namespace otb
@@ -446,6 +446,62 @@ OGRDataToSamplePositionFilter<TInputImage,TMaskImage,TSampler>
   return this->GetFilter()->GetOriginFieldName();
 }
 
+template<class TInputImage, class TMaskImage, class TSampler>
+void
+OGRDataToSamplePositionFilter<TInputImage,TMaskImage,TSampler>
+::SetOGRTransactionSize(unsigned long size)
+{
+  this->GetFilter()->SetOGRTransactionSize(size);
+}
+
+template<class TInputImage, class TMaskImage, class TSampler>
+unsigned long
+OGRDataToSamplePositionFilter<TInputImage,TMaskImage,TSampler>
+::GetOGRTransactionSize()
+{
+  return this->GetFilter()->GetOGRTransactionSize();
+}
+
+template<class TInputImage, class TMaskImage, class TSampler>
+void
+OGRDataToSamplePositionFilter<TInputImage,TMaskImage,TSampler>
+::GenerateData(void)
+{
+  if (!m_SparseSampling)
+    {
+    Superclass::GenerateData();
+    return;
+    }
+
+  // Reset the filter before the generation.
+  this->GetFilter()->Reset();
+  this->GetFilter()->UpdateOutputInformation();
+
+  typedef SparseBlockStreamingManager<TInputImage> SparseManagerType;
+  typename SparseManagerType::Pointer sparseManager = SparseManagerType::New();
+  sparseManager->SetAvailableRAMInMB(m_AvailableRAMInMB);
+  this->GetFilter()->AddSampledRegions(sparseManager);
+
+  // Stream the touched blocks only, then restore the streaming mode
+  typename Superclass::StreamerType::StreamingManagerPointerType
+    previousManager = this->GetStreamer()->GetStreamingManager();
+  this->GetStreamer()->SetStreamingManager(sparseManager);
+  this->GetStreamer()->SetInput(this->GetFilter()->GetOutput());
+  try
+    {
+    this->GetStreamer()->Update();
+    }
+  catch (...)
+    {
+    this->GetStreamer()->SetStreamingManager(previousManager);
+    throw;
+    }
+  this->GetStreamer()->SetStreamingManager(previousManager);
+
+  // Synthetize data after the streaming of the touched blocks.
+  this->GetFilter()->Synthetize();
+}
+
 } // end of namespace otb
 
 #endif
@@ -24,6 +24,11 @@
 #include "otbPersistentImageFilter.h"
 #include "otbOGRDataSourceWrapper.h"
 #include "otbImage.h"
+#include "otbSparseBlockStreamingManager.h"
+#include "otbPolygonScanlineRasterizer.h"
+#include "otbSampleFileWriter.h"
+#include "itkMutexLock.h"
+#include "itkConditionVariable.h"
 
 namespace otb
 {
@@ -93,6 +98,23 @@ public:
   itkSetMacro(OutLayerName, std::string);
   itkGetMacro(OutLayerName, std::string);
 
+  /** Set/Get the number of features written to an output layer within
+   *  one OGR transaction (0 means one transaction per thread output) */
+  itkSetMacro(OGRTransactionSize, unsigned long);
+  itkGetMacro(OGRTransactionSize, unsigned long);
+
+  /** Set/Get the name of a columnar binary sample file (see
+   *  SampleFileWriter). When it is set, the features of the first OGR
+   *  output are written to this file instead of the output layer : one
+   *  column per numeric field (integer or real), string fields are not
+   *  written. */
+  itkSetMacro(SampleFileName, std::string);
+  itkGetMacro(SampleFileName, std::string);
+
+  /** Add to a sparse streaming manager the image regions covered by the
+   *  input features (bounding region of each geometry) */
+  void AddSampledRegions(SparseBlockStreamingManager<TInputImage>* manager);
+
 protected:
   /** Constructor */
   PersistentSamplingFilterBase();
@@ -140,6 +162,14 @@ protected:
                              typename TInputImage::PointType& imgPoint,
                              itk::ThreadIdType& threadid);
 
+  /** Method called for each run of consecutive pixels of a row found
+   *  inside a polygon (and not masked). Default calls ProcessSample() on
+   *  each pixel of the run. */
+  virtual void ProcessSpan(const ogr::Feature& feature,
+                           typename TInputImage::IndexType& startIndex,
+                           unsigned long length,
+                           itk::ThreadIdType& threadid);
+
   /** Generic method called once before processing each feature */
   virtual void PrepareFeature(const ogr::Feature& feature,
                               itk::ThreadIdType& threadid);
@@ -165,9 +195,27 @@ protected:
   /** Gather the content of in-memory output layer into the filter outputs */
   virtual void GatherOutputVectors(void);
 
+  /** Write the in-memory output layers of a thread into the filter
+   *  outputs, and release them */
+  void WriteThreadOutputVectors(unsigned int threadId);
+
+  /** Called by each thread once its vector data is generated. Threads
+   *  write their outputs in thread order, so that a thread writes while
+   *  the next ones are still processing. When write is false, the
+   *  thread only lets the next one write. */
+  void HandOffThreadOutputVectors(unsigned int threadId, unsigned int threadCount, bool write);
+
   /** Utility method to add new fields on an output layer */
   virtual void InitializeOutputDataSource(ogr::DataSource* inputDS, ogr::DataSource* outputDS);
 
+  /** Create the sample file (if a name is set) with the numeric fields
+   *  of the first OGR output layer. To be called once the output fields
+   *  are created, before the streaming. */
+  void OpenSampleFile();
+
+  /** Close the sample file, to be called after the streaming */
+  void CloseSampleFile();
+
   typedef struct {
     std::string Name;
     OGRFieldType Type;
@@ -230,6 +278,28 @@ private:
   /** In-memory containers storing position during iteration loop*/
   std::vector<std::vector<OGRDataPointer> > m_InMemoryOutputs;
 
+  /** Number of features written within one OGR transaction */
+  unsigned long m_OGRTransactionSize;
+
+  /** Columnar binary sample file replacing the first OGR output */
+  std::string m_SampleFileName;
+  SampleFileWriter m_SampleFileWriter;
+  /** Output layer fields written to the sample file */
+  std::vector<std::string> m_SampleFileFields;
+
+  /** Next thread allowed to write its in-memory outputs */
+  unsigned int m_NextThreadToWrite;
+
+  /** Protects m_NextThreadToWrite */
+  itk::SimpleMutexLock m_WriteMutex;
+
+  /** Signaled each time a thread is done writing */
+  itk::ConditionVariable::Pointer m_WriteCondition;
+
+  /** Error raised by a thread while writing its outputs */
+  bool m_WriteFailed;
+  itk::ExceptionObject m_WriteError;
+
 };
 } // End namespace otb
 
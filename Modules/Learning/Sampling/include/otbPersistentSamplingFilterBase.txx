@@ -43,6 +43,11 @@ PersistentSamplingFilterBase<TInputImage,TMaskImage>
   , m_AdditionalFields()
   , m_InMemoryInputs()
   , m_InMemoryOutputs()
+  , m_OGRTransactionSize(100000)
+  , m_SampleFileName()
+  , m_NextThreadToWrite(0)
+  , m_WriteCondition(itk::ConditionVariable::New())
+  , m_WriteFailed(false)
 {
   this->SetNthOutput(0,TInputImage::New());
 }
@@ -178,6 +183,9 @@ PersistentSamplingFilterBase<TInputImage,TMaskImage>
   VectorThreadStruct str;
   str.Filter = this;
 
+  this->m_NextThreadToWrite = 0;
+  this->m_WriteFailed = false;
+
   // Get the output pointer
   //const InputImageType *outputPtr = this->GetOutput();
 
@@ -275,70 +283,186 @@ PersistentSamplingFilterBase<TInputImage,TMaskImage>
   // clean temporary inputs
   this->m_InMemoryInputs.clear();
 
-  unsigned int numberOfThreads = this->GetNumberOfThreads();
-  
-  // gather temporary outputs and write to output
-  const otb::ogr::DataSource* vectors = this->GetOGRData();
+  if (this->m_WriteFailed)
+    {
+    this->m_InMemoryOutputs.clear();
+    throw this->m_WriteError;
+    }
+
+  // write the outputs of the threads that did not hand them off
   itk::TimeProbe chrono;
   chrono.Start();
+  for (unsigned int thread=this->m_NextThreadToWrite ; thread < this->m_InMemoryOutputs.size() ; thread++)
+    {
+    this->WriteThreadOutputVectors(thread);
+    }
+  chrono.Stop();
+  otbMsgDebugMacro(<< "write ogr points took " << chrono.GetTotal() << " sec after processing");
+  this->m_InMemoryOutputs.clear();
+}
+
+template <class TInputImage, class TMaskImage>
+void
+PersistentSamplingFilterBase<TInputImage,TMaskImage>
+::WriteThreadOutputVectors(unsigned int threadId)
+{
+  const otb::ogr::DataSource* vectors = this->GetOGRData();
   unsigned int count = 0;
   for (unsigned int k=0 ; k < this->GetNumberOfOutputs() ; k++)
     {
     ogr::DataSource* realOutput = dynamic_cast<ogr::DataSource *>(
         this->itk::ProcessObject::GetOutput(k));
-    if (realOutput)
+    if (!realOutput)
+      {
+      continue;
+      }
+    const bool firstOutput = (count == 0);
+    ogr::Layer inLayer = this->m_InMemoryOutputs[threadId][count++]->GetLayerChecked(0);
+    if (!inLayer)
       {
-      ogr::Layer outLayer = realOutput->GetLayersCount() == 1
-                            ? realOutput->GetLayer(0)
-                            : realOutput->GetLayer(m_OutLayerName);
+      continue;
+      }
 
-      OGRErr err = outLayer.ogr().StartTransaction();
-      if (err != OGRERR_NONE)
+    if (firstOutput && m_SampleFileWriter.IsOpen())
+      {
+      // Write the numeric fields as one block of columns
+      OGRFeatureDefn &inLayerDefn = inLayer.GetLayerDefn();
+      const unsigned int nbFields = static_cast<unsigned int>(m_SampleFileFields.size());
+      std::vector<int> fieldIndex(nbFields);
+      for (unsigned int f=0 ; f < nbFields ; f++)
         {
-        itkExceptionMacro(<< "Unable to start transaction for OGR layer " << outLayer.ogr().GetName() << ".");
+        fieldIndex[f] = inLayerDefn.GetFieldIndex(m_SampleFileFields[f].c_str());
         }
-  
-      for (unsigned int thread=0 ; thread < numberOfThreads ; thread++)
+      const unsigned long nbSamples = inLayer.GetFeatureCount(true);
+      std::vector<double> columns(static_cast<size_t>(nbSamples) * nbFields, 0.);
+      unsigned long sample = 0;
+      ogr::Layer::const_iterator tmpIt = inLayer.begin();
+      for(; tmpIt!=inLayer.end() && sample < nbSamples; ++tmpIt, ++sample)
         {
-        ogr::Layer inLayer = this->m_InMemoryOutputs[thread][count]->GetLayerChecked(0);
-        if (!inLayer)
-          {
-          continue;
-          }
-  
-        ogr::Layer::const_iterator tmpIt = inLayer.begin();
-        // This test only uses 1 input, not compatible with multiple OGRData inputs
-        if (vectors == realOutput)
+        for (unsigned int f=0 ; f < nbFields ; f++)
           {
-          // Update mode
-          for(; tmpIt!=inLayer.end(); ++tmpIt)
+          if (fieldIndex[f] >= 0)
             {
-            outLayer.SetFeature( *tmpIt );
+            columns[static_cast<size_t>(f) * nbSamples + sample] = tmpIt->ogr().GetFieldAsDouble(fieldIndex[f]);
             }
           }
+        }
+      m_SampleFileWriter.WriteBlock(columns.empty() ? ITK_NULLPTR : &columns[0], nbSamples);
+      continue;
+      }
+    ogr::Layer outLayer = realOutput->GetLayersCount() == 1
+                          ? realOutput->GetLayer(0)
+                          : realOutput->GetLayer(m_OutLayerName);
+
+    // This test only uses 1 input, not compatible with multiple OGRData inputs
+    const bool updateMode = (vectors == realOutput);
+
+    // Match the fields once for the whole layer
+    OGRFeatureDefn &inLayerDefn = inLayer.GetLayerDefn();
+    OGRFeatureDefn &outLayerDefn = outLayer.GetLayerDefn();
+    std::vector<int> fieldMap(inLayerDefn.GetFieldCount());
+    for (int f=0 ; f < inLayerDefn.GetFieldCount() ; f++)
+      {
+      fieldMap[f] = outLayerDefn.GetFieldIndex(inLayerDefn.GetFieldDefn(f)->GetNameRef());
+      }
+    ogr::Feature dstFeature(outLayerDefn);
+
+    unsigned long nbFeaturesInTransaction = 0;
+    ogr::Layer::const_iterator tmpIt = inLayer.begin();
+    for(; tmpIt!=inLayer.end(); ++tmpIt)
+      {
+      if (nbFeaturesInTransaction == 0)
+        {
+        if (outLayer.ogr().StartTransaction() != OGRERR_NONE)
+          {
+          itkExceptionMacro(<< "Unable to start transaction for OGR layer " << outLayer.ogr().GetName() << ".");
+          }
+        }
+
+      if (updateMode)
+        {
+        outLayer.SetFeature( *tmpIt );
+        }
+      else
+        {
+        // Copy mode, the destination feature is reused
+        if (fieldMap.empty())
+          {
+          dstFeature.SetFrom( *tmpIt, TRUE );
+          }
         else
           {
-          // Copy mode
-          for(; tmpIt!=inLayer.end(); ++tmpIt)
-            {
-            ogr::Feature dstFeature(outLayer.GetLayerDefn());
-            dstFeature.SetFrom( *tmpIt, TRUE );
-            outLayer.CreateFeature( dstFeature );
-            }
+          dstFeature.SetFrom( *tmpIt, &fieldMap[0], TRUE );
           }
+        dstFeature.SetFID(OGRNullFID);
+        outLayer.CreateFeature( dstFeature );
         }
-  
-      err = outLayer.ogr().CommitTransaction();
-      if (err != OGRERR_NONE)
+
+      if (++nbFeaturesInTransaction == m_OGRTransactionSize)
+        {
+        if (outLayer.ogr().CommitTransaction() != OGRERR_NONE)
+          {
+          itkExceptionMacro(<< "Unable to commit transaction for OGR layer " << outLayer.ogr().GetName() << ".");
+          }
+        nbFeaturesInTransaction = 0;
+        }
+      }
+
+    if (nbFeaturesInTransaction > 0)
+      {
+      if (outLayer.ogr().CommitTransaction() != OGRERR_NONE)
         {
         itkExceptionMacro(<< "Unable to commit transaction for OGR layer " << outLayer.ogr().GetName() << ".");
         }
-      count++;
       }
     }
-  chrono.Stop();
-  otbMsgDebugMacro(<< "write ogr points took " << chrono.GetTotal() << " sec");
-  this->m_InMemoryOutputs.clear();
+
+  // the in-memory outputs of this thread are not needed anymore
+  this->m_InMemoryOutputs[threadId].clear();
+}
+
+template <class TInputImage, class TMaskImage>
+void
+PersistentSamplingFilterBase<TInputImage,TMaskImage>
+::HandOffThreadOutputVectors(unsigned int threadId, unsigned int threadCount, bool write)
+{
+  // When the threader did not start one thread per in-memory layer,
+  // everything is written by GatherOutputVectors()
+  if (threadCount != this->m_InMemoryOutputs.size())
+    {
+    return;
+    }
+
+  // Wait for the previous threads, to keep the features in thread order
+  this->m_WriteMutex.Lock();
+  while (this->m_NextThreadToWrite != threadId)
+    {
+    this->m_WriteCondition->Wait(&this->m_WriteMutex);
+    }
+  const bool previousWriteFailed = this->m_WriteFailed;
+  this->m_WriteMutex.Unlock();
+
+  if (write && !previousWriteFailed)
+    {
+    try
+      {
+      itk::TimeProbe chrono;
+      chrono.Start();
+      this->WriteThreadOutputVectors(threadId);
+      chrono.Stop();
+      otbMsgDebugMacro(<< "thread " << threadId << " wrote its ogr points in " << chrono.GetTotal() << " sec");
+      }
+    catch (itk::ExceptionObject & err)
+      {
+      this->m_WriteError = err;
+      this->m_WriteFailed = true;
+      }
+    }
+
+  this->m_WriteMutex.Lock();
+  ++this->m_NextThreadToWrite;
+  this->m_WriteCondition->Broadcast();
+  this->m_WriteMutex.Unlock();
 }
 
 template <class TInputImage, class TMaskImage>
@@ -529,6 +653,56 @@ PersistentSamplingFilterBase<TInputImage,TMaskImage>
   typename TInputImage::PointType imgPoint;
   OGRPoint tmpPoint;
 
+  typename TInputImage::DirectionType identity;
+  identity.SetIdentity();
+  if (img->GetDirection() == identity)
+    {
+    // Scanline rasterization: only the pixel runs inside the polygon are
+    // visited, the polygon edges are tested once per row
+    PolygonScanlineRasterizer rasterizer;
+    rasterizer.SetGrid(img->GetOrigin()[0], img->GetOrigin()[1],
+                       img->GetSpacing()[0], img->GetSpacing()[1]);
+    PolygonScanlineRasterizer::SpanListType spans;
+    rasterizer.Rasterize(polygon,
+                         region.GetIndex()[0], region.GetIndex()[1],
+                         region.GetUpperIndex()[0], region.GetUpperIndex()[1],
+                         spans);
+
+    PolygonScanlineRasterizer::SpanListType::const_iterator spanIt = spans.begin();
+    for (; spanIt != spans.end(); ++spanIt)
+      {
+      imgIndex[1] = spanIt->Y;
+      if (mask == ITK_NULLPTR)
+        {
+        imgIndex[0] = spanIt->StartX;
+        this->ProcessSpan(feature, imgIndex, spanIt->EndX - spanIt->StartX + 1, threadid);
+        continue;
+        }
+      // Split the span into runs of unmasked pixels
+      long x = spanIt->StartX;
+      while (x <= spanIt->EndX)
+        {
+        imgIndex[0] = x;
+        if (!mask->GetPixel(imgIndex))
+          {
+          ++x;
+          continue;
+          }
+        typename TInputImage::IndexType runStart = imgIndex;
+        for (++x; x <= spanIt->EndX; ++x)
+          {
+          imgIndex[0] = x;
+          if (!mask->GetPixel(imgIndex))
+            {
+            break;
+            }
+          }
+        this->ProcessSpan(feature, runStart, x - runStart[0], threadid);
+        }
+      }
+    return;
+    }
+
   if (mask)
     {
     // For pixels in consideredRegion and not masked
@@ -583,6 +757,24 @@ PersistentSamplingFilterBase<TInputImage,TMaskImage>
   itkExceptionMacro("Method ProcessSample not implemented !");
 }
 
+template <class TInputImage, class TMaskImage>
+void
+PersistentSamplingFilterBase<TInputImage,TMaskImage>
+::ProcessSpan(const ogr::Feature& feature,
+              typename TInputImage::IndexType& startIndex,
+              unsigned long length,
+              itk::ThreadIdType& threadid)
+{
+  const TInputImage* img = this->GetInput();
+  typename TInputImage::IndexType imgIndex = startIndex;
+  typename TInputImage::PointType imgPoint;
+  for (unsigned long i=0 ; i < length ; ++i, ++imgIndex[0])
+    {
+    img->TransformIndexToPhysicalPoint(imgIndex,imgPoint);
+    this->ProcessSample(feature, imgIndex, imgPoint, threadid);
+    }
+}
+
 template <class TInputImage, class TMaskImage>
 void
 PersistentSamplingFilterBase<TInputImage,TMaskImage>
@@ -685,6 +877,27 @@ PersistentSamplingFilterBase<TInputImage,TMaskImage>
   return region;
 }
 
+template<class TInputImage, class TMaskImage>
+void
+PersistentSamplingFilterBase<TInputImage,TMaskImage>
+::AddSampledRegions(SparseBlockStreamingManager<TInputImage>* manager)
+{
+  const TInputImage* image = this->GetInput();
+  ogr::DataSource* vectors = const_cast<ogr::DataSource*>(this->GetOGRData());
+  ogr::Layer inLayer = vectors->GetLayer(m_LayerIndex);
+
+  ogr::Layer::const_iterator featIt = inLayer.begin();
+  for(; featIt!=inLayer.end(); ++featIt)
+    {
+    if (featIt->GetGeometry() == ITK_NULLPTR)
+      {
+      continue;
+      }
+    RegionType region = this->FeatureBoundingRegion(image, featIt);
+    manager->AddRegion(region);
+    }
+}
+
 template<class TInputImage, class TMaskImage>
 void
 PersistentSamplingFilterBase<TInputImage,TMaskImage>
@@ -740,7 +953,11 @@ PersistentSamplingFilterBase<TInputImage,TMaskImage>
     dstFeature.SetFID(featIt->GetFID());
     tmpLayers[counter].CreateFeature( dstFeature );
     cptFeat++;
-    if (cptFeat > nbFeatThread) counter++; cptFeat=0;
+    if (cptFeat >= nbFeatThread && counter + 1 < numberOfThreads)
+      {
+      counter++;
+      cptFeat=0;
+      }
     }
 
   inLayer.SetSpatialFilter(ITK_NULLPTR);
@@ -822,6 +1039,52 @@ PersistentSamplingFilterBase<TInputImage,TMaskImage>
 }
 
 
+template<class TInputImage, class TMaskImage>
+void
+PersistentSamplingFilterBase<TInputImage,TMaskImage>
+::OpenSampleFile()
+{
+  m_SampleFileWriter.Close();
+  m_SampleFileFields.clear();
+  if (m_SampleFileName.empty())
+    {
+    return;
+    }
+
+  for (unsigned int k=0 ; k < this->GetNumberOfOutputs() ; k++)
+    {
+    ogr::DataSource* realOutput = dynamic_cast<ogr::DataSource *>(
+      this->itk::ProcessObject::GetOutput(k));
+    if (!realOutput)
+      {
+      continue;
+      }
+    ogr::Layer realLayer = realOutput->GetLayersCount() == 1
+                           ? realOutput->GetLayer(0)
+                           : realOutput->GetLayer(m_OutLayerName);
+    OGRFeatureDefn &layerDefn = realLayer.GetLayerDefn();
+    for (int f=0 ; f < layerDefn.GetFieldCount() ; f++)
+      {
+      const OGRFieldType fieldType = layerDefn.GetFieldDefn(f)->GetType();
+      if (fieldType == OFTInteger || ogr::version_proxy::IsOFTInteger64(fieldType) || fieldType == OFTReal)
+        {
+        m_SampleFileFields.push_back(layerDefn.GetFieldDefn(f)->GetNameRef());
+        }
+      }
+    m_SampleFileWriter.Open(m_SampleFileName, m_SampleFileFields);
+    return;
+    }
+  itkExceptionMacro(<< "No OGR output to write to the sample file " << m_SampleFileName);
+}
+
+template<class TInputImage, class TMaskImage>
+void
+PersistentSamplingFilterBase<TInputImage,TMaskImage>
+::CloseSampleFile()
+{
+  m_SampleFileWriter.Close();
+}
+
 template<class TInputImage, class TMaskImage>
 void
 PersistentSamplingFilterBase<TInputImage,TMaskImage>
@@ -870,7 +1133,17 @@ PersistentSamplingFilterBase<TInputImage,TMaskImage>
 
   if (threadId < threadCount)
     {
-    str->Filter->ThreadedGenerateVectorData(layer,threadId);
+    try
+      {
+      str->Filter->ThreadedGenerateVectorData(layer,threadId);
+      }
+    catch (...)
+      {
+      // do not block the next threads
+      str->Filter->HandOffThreadOutputVectors(threadId, threadCount, false);
+      throw;
+      }
+    str->Filter->HandOffThreadOutputVectors(threadId, threadCount, true);
     }
 
   return ITK_THREAD_RETURN_VALUE;
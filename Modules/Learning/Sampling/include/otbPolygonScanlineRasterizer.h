@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbPolygonScanlineRasterizer_h
+#define otbPolygonScanlineRasterizer_h
+
+#include "ogr_geometry.h"
+#include <vector>
+#include <utility>
+
+namespace otb
+{
+/** \class PolygonScanlineRasterizer
+ *  \brief Computes the runs of pixels whose center is inside a polygon.
+ *
+ * The polygon is rasterized row by row: on each row of pixel centers, the
+ * edges of the rings crossing the row give the column where the inside
+ * state changes, and the pixels between two consecutive changes form a
+ * span. The edges are sorted by their first row, so that each row only
+ * considers the edges crossing it.
+ *
+ * A pixel belongs to the polygon when its center is inside the exterior
+ * ring and outside all interior rings. The crossing rule is the one of
+ * OGRLinearRing::isPointInRing, evaluated with the same expression, so
+ * that the spans hold the same pixels as a per-pixel test.
+ *
+ * The pixel grid is given by the physical position of the center of
+ * pixel (0,0) and the signed pixel spacing. Rotated grids are not
+ * supported.
+ *
+ * \ingroup OTBSampling
+ */
+class ITK_EXPORT PolygonScanlineRasterizer
+{
+public:
+  /** Run of pixels from (StartX, Y) to (EndX, Y), bounds included */
+  struct Span
+    {
+    long Y;
+    long StartX;
+    long EndX;
+    };
+
+  typedef std::vector<Span> SpanListType;
+
+  PolygonScanlineRasterizer();
+
+  /** Set the position of the center of pixel (0,0) and the spacing */
+  void SetGrid(double originX, double originY, double spacingX, double spacingY);
+
+  /** Compute the spans of the polygon, restricted to the pixels with
+   *  startX <= x <= endX and startY <= y <= endY. Spans are given in
+   *  raster order. */
+  void Rasterize(const OGRPolygon* polygon,
+                 long startX, long startY,
+                 long endX, long endY,
+                 SpanListType& spans);
+
+private:
+  /** Ring edge, from (X1,Y1) to (X2,Y2), crossing rows FirstRow to LastRow */
+  struct Edge
+    {
+    double X1;
+    double Y1;
+    double X2;
+    double Y2;
+    long FirstRow;
+    long LastRow;
+    unsigned int Ring;
+    };
+
+  static bool EdgeFirstRowLess(const Edge& a, const Edge& b);
+
+  /** Physical coordinates of pixel centers */
+  double PixelX(long x) const { return m_OriginX + m_SpacingX * x; }
+  double PixelY(long y) const { return m_OriginY + m_SpacingY * y; }
+
+  /** Crossing test of isPointInRing for an edge and a pixel center */
+  static bool IsCrossedOnTheRight(const Edge& edge, double x, double y);
+
+  /** Whether the row of pixel centers at y crosses the edge */
+  static bool IsRowCrossed(const Edge& edge, double y);
+
+  /** Add the edges of a ring crossing rows startY to endY */
+  void AddRingEdges(const OGRLinearRing* ring, unsigned int ringIndex, long startY, long endY);
+
+  /** First column in [startX, endX+1] where the crossing state of the edge
+   *  on row y changes */
+  long FindEdgeColumn(const Edge& edge, double y, long startX, long endX) const;
+
+  /** Column intervals [first, second) */
+  typedef std::vector<std::pair<long, long> > IntervalListType;
+
+  /** Turns the change columns of a ring into inside intervals */
+  static void ColumnsToIntervals(std::vector<long>& columns, IntervalListType& intervals);
+
+  double m_OriginX;
+  double m_OriginY;
+  double m_SpacingX;
+  double m_SpacingY;
+
+  /** Work buffers */
+  std::vector<Edge> m_Edges;
+  std::vector<unsigned int> m_Active;
+  std::vector<std::vector<long> > m_RingColumns;
+  IntervalListType m_Inside;
+  IntervalListType m_Holes;
+  IntervalListType m_HoleIntervals;
+};
+
+} // end of namespace otb
+
+#endif
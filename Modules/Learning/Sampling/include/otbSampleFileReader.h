@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSampleFileReader_h
+#define otbSampleFileReader_h
+
+#include "itkMacro.h"
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace otb
+{
+/** \class SampleFileReader
+ *  \brief Reads the samples of a columnar binary sample file.
+ *
+ * Open() reads the field names and locates the blocks of samples, then
+ * ReadBlock() reads the selected fields of the samples of one block.
+ * The columns of the other fields are skipped without being read. See
+ * SampleFileWriter for the file layout.
+ *
+ * \sa SampleFileWriter
+ *
+ * \ingroup OTBSampling
+ */
+class ITK_EXPORT SampleFileReader
+{
+public:
+  SampleFileReader();
+
+  /** Check whether a file starts with the header of a sample file */
+  static bool CanReadFile(const std::string& fileName);
+
+  /** Open the file, read its header and locate its blocks */
+  void Open(const std::string& fileName);
+
+  const std::vector<std::string>& GetFieldNames() const
+  {
+    return m_FieldNames;
+  }
+
+  /** Index of a field, -1 if the file has no such field */
+  int GetFieldIndex(const std::string& name) const;
+
+  unsigned int GetNumberOfBlocks() const
+  {
+    return static_cast<unsigned int>(m_BlockOffsets.size());
+  }
+
+  unsigned long GetBlockSize(unsigned int block) const
+  {
+    return m_BlockSizes[block];
+  }
+
+  unsigned long long GetNumberOfSamples() const
+  {
+    return m_NumberOfSamples;
+  }
+
+  /** Read the given fields of the samples of a block, sample by
+   *  sample : values[i * fields.size() + j] receives the field
+   *  fields[j] of sample i. values must hold GetBlockSize(block) *
+   *  fields.size() doubles. */
+  void ReadBlock(unsigned int block, const std::vector<unsigned int>& fields, double* values);
+
+  void Close();
+
+private:
+  SampleFileReader(const SampleFileReader&); //purposely not implemented
+  void operator=(const SampleFileReader&); //purposely not implemented
+
+  std::ifstream m_Stream;
+  std::string m_FileName;
+  std::vector<std::string> m_FieldNames;
+  /** Position of the first column of each block */
+  std::vector<std::streamoff> m_BlockOffsets;
+  std::vector<unsigned long> m_BlockSizes;
+  unsigned long long m_NumberOfSamples;
+  /** Work buffer holding one column */
+  std::vector<double> m_Column;
+};
+
+} // end of namespace otb
+
+#endif
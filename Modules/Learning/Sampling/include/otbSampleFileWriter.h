@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSampleFileWriter_h
+#define otbSampleFileWriter_h
+
+#include "itkMacro.h"
+#include "stdint.h"
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace otb
+{
+/** \class SampleFileWriter
+ *  \brief Writes samples to a columnar binary sample file.
+ *
+ * A sample file starts with a header holding the field names, followed
+ * by blocks of samples. Each block stores its number of samples, then
+ * the values of each field for all the samples of the block, as one
+ * contiguous column of doubles per field. Blocks are appended as the
+ * samples are produced, and SampleFileReader only reads the columns it
+ * needs.
+ *
+ * Layout, in native byte order :
+ *  - the 8 characters "OTBSMPL1", then the 32 bits value 0x01020304 as
+ *    a byte order mark
+ *  - the number of fields (32 bits), then for each field the length of
+ *    its name (32 bits) and its name
+ *  - the blocks : number of samples n (64 bits), then n doubles per field
+ *
+ * \sa SampleFileReader
+ *
+ * \ingroup OTBSampling
+ */
+class ITK_EXPORT SampleFileWriter
+{
+public:
+  /** First bytes of a sample file */
+  static const char Magic[8];
+
+  /** Written after Magic, to detect files of another byte order */
+  static const uint32_t ByteOrderMark = 0x01020304;
+
+  SampleFileWriter();
+  ~SampleFileWriter();
+
+  /** Create the file and write its header */
+  void Open(const std::string& fileName, const std::vector<std::string>& fieldNames);
+
+  bool IsOpen() const
+  {
+    return m_Stream.is_open();
+  }
+
+  const std::vector<std::string>& GetFieldNames() const
+  {
+    return m_FieldNames;
+  }
+
+  /** Append a block of nbSamples samples. columns holds the values of
+   *  the first field for all the samples, then those of the second
+   *  field, and so on. */
+  void WriteBlock(const double* columns, unsigned long nbSamples);
+
+  /** Number of samples written since Open() */
+  unsigned long long GetNumberOfSamples() const
+  {
+    return m_NumberOfSamples;
+  }
+
+  /** Flush and close the file */
+  void Close();
+
+private:
+  SampleFileWriter(const SampleFileWriter&); //purposely not implemented
+  void operator=(const SampleFileWriter&); //purposely not implemented
+
+  std::ofstream m_Stream;
+  std::string m_FileName;
+  std::vector<std::string> m_FieldNames;
+  unsigned long long m_NumberOfSamples;
+};
+
+} // end of namespace otb
+
+#endif
@@ -0,0 +1,291 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbPolygonScanlineRasterizer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace otb
+{
+
+PolygonScanlineRasterizer::PolygonScanlineRasterizer()
+  : m_OriginX(0.0),
+    m_OriginY(0.0),
+    m_SpacingX(1.0),
+    m_SpacingY(1.0)
+{
+}
+
+void
+PolygonScanlineRasterizer::SetGrid(double originX, double originY, double spacingX, double spacingY)
+{
+  m_OriginX = originX;
+  m_OriginY = originY;
+  m_SpacingX = spacingX;
+  m_SpacingY = spacingY;
+}
+
+bool
+PolygonScanlineRasterizer::EdgeFirstRowLess(const Edge& a, const Edge& b)
+{
+  return a.FirstRow < b.FirstRow;
+}
+
+bool
+PolygonScanlineRasterizer::IsRowCrossed(const Edge& edge, double y)
+{
+  const double y1 = edge.Y1 - y;
+  const double y2 = edge.Y2 - y;
+  return ( ( y1 > 0 ) && ( y2 <= 0 ) ) || ( ( y2 > 0 ) && ( y1 <= 0 ) );
+}
+
+bool
+PolygonScanlineRasterizer::IsCrossedOnTheRight(const Edge& edge, double x, double y)
+{
+  // Same expression as OGRLinearRing::isPointInRing
+  const double x1 = edge.X1 - x;
+  const double y1 = edge.Y1 - y;
+  const double x2 = edge.X2 - x;
+  const double y2 = edge.Y2 - y;
+  if ( ( ( y1 > 0 ) && ( y2 <= 0 ) ) || ( ( y2 > 0 ) && ( y1 <= 0 ) ) )
+    {
+    const double intersection = ( x1 * y2 - x2 * y1 ) / ( y2 - y1 );
+    return 0.0 < intersection;
+    }
+  return false;
+}
+
+void
+PolygonScanlineRasterizer::AddRingEdges(const OGRLinearRing* ring, unsigned int ringIndex, long startY, long endY)
+{
+  if (ring == NULL)
+    {
+    return;
+    }
+  const int nbPoints = ring->getNumPoints();
+  for (int i = 0; i < nbPoints; ++i)
+    {
+    const int prev = (i + nbPoints - 1) % nbPoints;
+    Edge edge;
+    edge.X1 = ring->getX(i);
+    edge.Y1 = ring->getY(i);
+    edge.X2 = ring->getX(prev);
+    edge.Y2 = ring->getY(prev);
+    edge.Ring = ringIndex;
+
+    const double yMin = std::min(edge.Y1, edge.Y2);
+    const double yMax = std::max(edge.Y1, edge.Y2);
+    if (!(yMin < yMax))
+      {
+      // horizontal edges are never crossed
+      continue;
+      }
+
+    // Rows whose center satisfies yMin <= y < yMax, estimated then checked
+    double rowA = (yMin - m_OriginY) / m_SpacingY;
+    double rowB = (yMax - m_OriginY) / m_SpacingY;
+    if (rowA > rowB)
+      {
+      std::swap(rowA, rowB);
+      }
+    if (rowB < startY - 1 || rowA > endY + 1)
+      {
+      continue;
+      }
+    long first = std::max(startY, static_cast<long>(std::floor(rowA)) - 1);
+    long last = std::min(endY, static_cast<long>(std::ceil(rowB)) + 1);
+    while (first <= last && !IsRowCrossed(edge, PixelY(first)))
+      {
+      ++first;
+      }
+    while (last >= first && !IsRowCrossed(edge, PixelY(last)))
+      {
+      --last;
+      }
+    if (first > last)
+      {
+      continue;
+      }
+    edge.FirstRow = first;
+    edge.LastRow = last;
+    m_Edges.push_back(edge);
+    }
+}
+
+long
+PolygonScanlineRasterizer::FindEdgeColumn(const Edge& edge, double y, long startX, long endX) const
+{
+  // Pixel centers on the left of the crossing (in physical space) count
+  // the edge. Along increasing columns, the state changes from counted to
+  // not counted for a positive spacing, and the other way round otherwise.
+  const bool changedState = (m_SpacingX < 0);
+
+  const double crossing = edge.X1 + (y - edge.Y1) * (edge.X2 - edge.X1) / (edge.Y2 - edge.Y1);
+  const double estimate = std::ceil((crossing - m_OriginX) / m_SpacingX);
+  long column;
+  if (!(estimate > startX))
+    {
+    column = startX;
+    }
+  else if (estimate > endX + 1)
+    {
+    column = endX + 1;
+    }
+  else
+    {
+    column = static_cast<long>(estimate);
+    }
+
+  while (column > startX && IsCrossedOnTheRight(edge, PixelX(column - 1), y) == changedState)
+    {
+    --column;
+    }
+  while (column <= endX && IsCrossedOnTheRight(edge, PixelX(column), y) != changedState)
+    {
+    ++column;
+    }
+  return column;
+}
+
+void
+PolygonScanlineRasterizer::ColumnsToIntervals(std::vector<long>& columns, IntervalListType& intervals)
+{
+  // A ring is crossed an even number of times on a row: the pixel state
+  // only depends on the parity of the changes on its left
+  intervals.clear();
+  std::sort(columns.begin(), columns.end());
+  for (size_t i = 0; i + 1 < columns.size(); i += 2)
+    {
+    if (columns[i] < columns[i + 1])
+      {
+      intervals.push_back(std::make_pair(columns[i], columns[i + 1]));
+      }
+    }
+}
+
+void
+PolygonScanlineRasterizer::Rasterize(const OGRPolygon* polygon,
+                                     long startX, long startY,
+                                     long endX, long endY,
+                                     SpanListType& spans)
+{
+  spans.clear();
+  if (polygon == NULL || startX > endX || startY > endY)
+    {
+    return;
+    }
+  const OGRLinearRing* exterior = polygon->getExteriorRing();
+  if (exterior == NULL)
+    {
+    return;
+    }
+
+  const unsigned int nbRings = 1 + polygon->getNumInteriorRings();
+  m_Edges.clear();
+  this->AddRingEdges(exterior, 0, startY, endY);
+  for (unsigned int k = 1; k < nbRings; ++k)
+    {
+    this->AddRingEdges(polygon->getInteriorRing(k - 1), k, startY, endY);
+    }
+  if (m_Edges.empty())
+    {
+    return;
+    }
+  std::sort(m_Edges.begin(), m_Edges.end(), EdgeFirstRowLess);
+
+  m_RingColumns.resize(nbRings);
+  m_Active.clear();
+  size_t next = 0;
+  long y = m_Edges[0].FirstRow;
+
+  while (y <= endY && (next < m_Edges.size() || !m_Active.empty()))
+    {
+    if (m_Active.empty() && m_Edges[next].FirstRow > y)
+      {
+      // skip the rows crossing no edge
+      y = m_Edges[next].FirstRow;
+      }
+    while (next < m_Edges.size() && m_Edges[next].FirstRow <= y)
+      {
+      m_Active.push_back(next++);
+      }
+    size_t kept = 0;
+    for (size_t i = 0; i < m_Active.size(); ++i)
+      {
+      if (m_Edges[m_Active[i]].LastRow >= y)
+        {
+        m_Active[kept++] = m_Active[i];
+        }
+      }
+    m_Active.resize(kept);
+
+    const double py = PixelY(y);
+    for (unsigned int k = 0; k < nbRings; ++k)
+      {
+      m_RingColumns[k].clear();
+      }
+    for (size_t i = 0; i < m_Active.size(); ++i)
+      {
+      const Edge& edge = m_Edges[m_Active[i]];
+      m_RingColumns[edge.Ring].push_back(this->FindEdgeColumn(edge, py, startX, endX));
+      }
+
+    ColumnsToIntervals(m_RingColumns[0], m_Inside);
+    if (!m_Inside.empty())
+      {
+      m_Holes.clear();
+      for (unsigned int k = 1; k < nbRings; ++k)
+        {
+        ColumnsToIntervals(m_RingColumns[k], m_HoleIntervals);
+        m_Holes.insert(m_Holes.end(), m_HoleIntervals.begin(), m_HoleIntervals.end());
+        }
+      std::sort(m_Holes.begin(), m_Holes.end());
+
+      // Remove the holes from the exterior intervals
+      for (size_t i = 0; i < m_Inside.size(); ++i)
+        {
+        long start = m_Inside[i].first;
+        const long end = m_Inside[i].second;
+        for (size_t h = 0; h < m_Holes.size() && start < end; ++h)
+          {
+          if (m_Holes[h].second <= start || m_Holes[h].first >= end)
+            {
+            continue;
+            }
+          if (m_Holes[h].first > start)
+            {
+            Span span = {y, start, m_Holes[h].first - 1};
+            spans.push_back(span);
+            }
+          start = std::max(start, m_Holes[h].second);
+          }
+        if (start < end)
+          {
+          Span span = {y, start, end - 1};
+          spans.push_back(span);
+          }
+        }
+      }
+    ++y;
+    }
+}
+
+} // end of namespace otb
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbSampleFileReader.h"
+#include "otbSampleFileWriter.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace otb
+{
+
+SampleFileReader::SampleFileReader()
+  : m_NumberOfSamples(0)
+{
+}
+
+bool
+SampleFileReader::CanReadFile(const std::string& fileName)
+{
+  std::ifstream stream(fileName.c_str(), std::ios::in | std::ios::binary);
+  char magic[sizeof(SampleFileWriter::Magic)];
+  uint32_t byteOrderMark = 0;
+  stream.read(magic, sizeof(magic));
+  stream.read(reinterpret_cast<char*>(&byteOrderMark), sizeof(byteOrderMark));
+  return stream && std::memcmp(magic, SampleFileWriter::Magic, sizeof(magic)) == 0
+    && byteOrderMark == SampleFileWriter::ByteOrderMark;
+}
+
+void
+SampleFileReader::Open(const std::string& fileName)
+{
+  if (!CanReadFile(fileName))
+    {
+    itkGenericExceptionMacro(<< fileName << " is not a sample file, or was written with another byte order");
+    }
+  this->Close();
+  m_FileName = fileName;
+  m_Stream.open(fileName.c_str(), std::ios::in | std::ios::binary);
+  m_Stream.seekg(sizeof(SampleFileWriter::Magic) + sizeof(SampleFileWriter::ByteOrderMark));
+
+  uint32_t nbFields = 0;
+  m_Stream.read(reinterpret_cast<char*>(&nbFields), sizeof(nbFields));
+  for (uint32_t i = 0; i < nbFields && m_Stream; ++i)
+    {
+    uint32_t length = 0;
+    m_Stream.read(reinterpret_cast<char*>(&length), sizeof(length));
+    std::string name(length, ' ');
+    if (length > 0)
+      {
+      m_Stream.read(&name[0], length);
+      }
+    m_FieldNames.push_back(name);
+    }
+  if (!m_Stream)
+    {
+    itkGenericExceptionMacro(<< "Unable to read the header of the sample file " << fileName);
+    }
+
+  // Locate the blocks
+  m_Stream.seekg(0, std::ios::end);
+  const std::streamoff fileSize = m_Stream.tellg();
+  std::streamoff position = static_cast<std::streamoff>(sizeof(SampleFileWriter::Magic) + sizeof(SampleFileWriter::ByteOrderMark)
+                                                         + sizeof(nbFields));
+  for (unsigned int i = 0; i < m_FieldNames.size(); ++i)
+    {
+    position += sizeof(uint32_t) + m_FieldNames[i].size();
+    }
+  while (position < fileSize)
+    {
+    uint64_t blockSize = 0;
+    m_Stream.seekg(position);
+    m_Stream.read(reinterpret_cast<char*>(&blockSize), sizeof(blockSize));
+    position += sizeof(blockSize);
+    const std::streamoff blockEnd = position + static_cast<std::streamoff>(blockSize * sizeof(double) * m_FieldNames.size());
+    if (!m_Stream || blockEnd > fileSize)
+      {
+      itkGenericExceptionMacro(<< "The sample file " << fileName << " is truncated");
+      }
+    m_BlockOffsets.push_back(position);
+    m_BlockSizes.push_back(static_cast<unsigned long>(blockSize));
+    m_NumberOfSamples += blockSize;
+    position = blockEnd;
+    }
+}
+
+int
+SampleFileReader::GetFieldIndex(const std::string& name) const
+{
+  std::vector<std::string>::const_iterator it = std::find(m_FieldNames.begin(), m_FieldNames.end(), name);
+  return (it == m_FieldNames.end() ? -1 : static_cast<int>(it - m_FieldNames.begin()));
+}
+
+void
+SampleFileReader::ReadBlock(unsigned int block, const std::vector<unsigned int>& fields, double* values)
+{
+  if (block >= m_BlockOffsets.size())
+    {
+    itkGenericExceptionMacro(<< "Block " << block << " out of the " << m_BlockOffsets.size()
+                             << " blocks of the sample file " << m_FileName);
+    }
+
+  const unsigned long nbSamples = m_BlockSizes[block];
+  const size_t nbSelected = fields.size();
+  if (nbSamples == 0)
+    {
+    return;
+    }
+  m_Column.resize(nbSamples);
+  for (size_t j = 0; j < nbSelected; ++j)
+    {
+    if (fields[j] >= m_FieldNames.size())
+      {
+      itkGenericExceptionMacro(<< "Field " << fields[j] << " out of the " << m_FieldNames.size()
+                               << " fields of the sample file " << m_FileName);
+      }
+    // Only the selected columns are read
+    m_Stream.seekg(m_BlockOffsets[block] + static_cast<std::streamoff>(sizeof(double) * nbSamples * fields[j]));
+    m_Stream.read(reinterpret_cast<char*>(&m_Column[0]), static_cast<std::streamsize>(sizeof(double) * nbSamples));
+    if (!m_Stream)
+      {
+      itkGenericExceptionMacro(<< "Unable to read block " << block << " of the sample file " << m_FileName);
+      }
+    for (unsigned long i = 0; i < nbSamples; ++i)
+      {
+      values[i * nbSelected + j] = m_Column[i];
+      }
+    }
+}
+
+void
+SampleFileReader::Close()
+{
+  if (m_Stream.is_open())
+    {
+    m_Stream.close();
+    }
+  m_Stream.clear();
+  m_FieldNames.clear();
+  m_BlockOffsets.clear();
+  m_BlockSizes.clear();
+  m_NumberOfSamples = 0;
+}
+
+} // end of namespace otb
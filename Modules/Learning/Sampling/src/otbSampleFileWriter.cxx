@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbSampleFileWriter.h"
+
+namespace otb
+{
+
+const char SampleFileWriter::Magic[8] = {'O','T','B','S','M','P','L','1'};
+const uint32_t SampleFileWriter::ByteOrderMark;
+
+SampleFileWriter::SampleFileWriter()
+  : m_NumberOfSamples(0)
+{
+}
+
+SampleFileWriter::~SampleFileWriter()
+{
+  if (m_Stream.is_open())
+    {
+    m_Stream.close();
+    }
+}
+
+void
+SampleFileWriter::Open(const std::string& fileName, const std::vector<std::string>& fieldNames)
+{
+  if (m_Stream.is_open())
+    {
+    this->Close();
+    }
+  m_FileName = fileName;
+  m_FieldNames = fieldNames;
+  m_NumberOfSamples = 0;
+
+  m_Stream.open(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!m_Stream)
+    {
+    itkGenericExceptionMacro(<< "Unable to create the sample file " << fileName);
+    }
+
+  m_Stream.write(Magic, sizeof(Magic));
+  m_Stream.write(reinterpret_cast<const char*>(&ByteOrderMark), sizeof(ByteOrderMark));
+  const uint32_t nbFields = static_cast<uint32_t>(fieldNames.size());
+  m_Stream.write(reinterpret_cast<const char*>(&nbFields), sizeof(nbFields));
+  for (unsigned int i = 0; i < fieldNames.size(); ++i)
+    {
+    const uint32_t length = static_cast<uint32_t>(fieldNames[i].size());
+    m_Stream.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    m_Stream.write(fieldNames[i].data(), length);
+    }
+  if (!m_Stream)
+    {
+    itkGenericExceptionMacro(<< "Unable to write the header of the sample file " << fileName);
+    }
+}
+
+void
+SampleFileWriter::WriteBlock(const double* columns, unsigned long nbSamples)
+{
+  if (!m_Stream.is_open())
+    {
+    itkGenericExceptionMacro(<< "The sample file is not open");
+    }
+  if (nbSamples == 0)
+    {
+    return;
+    }
+
+  const uint64_t blockSize = nbSamples;
+  m_Stream.write(reinterpret_cast<const char*>(&blockSize), sizeof(blockSize));
+  m_Stream.write(reinterpret_cast<const char*>(columns),
+                 static_cast<std::streamsize>(sizeof(double) * nbSamples * m_FieldNames.size()));
+  if (!m_Stream)
+    {
+    itkGenericExceptionMacro(<< "Unable to write samples to the sample file " << m_FileName);
+    }
+  m_NumberOfSamples += nbSamples;
+}
+
+void
+SampleFileWriter::Close()
+{
+  if (!m_Stream.is_open())
+    {
+    return;
+    }
+  m_Stream.close();
+  if (!m_Stream)
+    {
+    itkGenericExceptionMacro(<< "Unable to close the sample file " << m_FileName);
+    }
+}
+
+} // end of namespace otb
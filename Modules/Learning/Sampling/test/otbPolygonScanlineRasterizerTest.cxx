@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "otbPolygonScanlineRasterizer.h"
+#include "otbMath.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+bool IsInsidePolygon(OGRPolygon& polygon, double x, double y)
+{
+  OGRPoint point(x, y);
+  if (!polygon.getExteriorRing()->isPointInRing(&point))
+    {
+    return false;
+    }
+  for (int k=0 ; k<polygon.getNumInteriorRings() ; k++)
+    {
+    if (polygon.getInteriorRing(k)->isPointInRing(&point))
+      {
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+int otbPolygonScanlineRasterizer(int itkNotUsed(argc), char* itkNotUsed(argv) [])
+{
+  // Star shaped polygon with a hole, on a grid with a negative Y spacing.
+  // Some vertices lie exactly on pixel centers.
+  const double originX = 100.5;
+  const double originY = 200.5;
+  const double spacingX = 2.0;
+  const double spacingY = -2.0;
+
+  OGRLinearRing exterior;
+  const unsigned int nbBranches = 7;
+  for (unsigned int i=0 ; i<2*nbBranches ; i++)
+    {
+    const double angle = otb::CONST_PI * i / nbBranches;
+    const double radius = (i % 2) ? 14.0 : 40.0;
+    exterior.addPoint(std::floor(150.0 + radius * std::cos(angle)) + 0.5,
+                      std::floor(150.0 + radius * std::sin(angle)) + 0.5);
+    }
+  exterior.closeRings();
+
+  OGRLinearRing hole;
+  hole.addPoint(144.5, 144.5);
+  hole.addPoint(156.5, 144.5);
+  hole.addPoint(150.5, 155.0);
+  hole.closeRings();
+
+  OGRPolygon polygon;
+  polygon.addRing(&exterior);
+  polygon.addRing(&hole);
+
+  otb::PolygonScanlineRasterizer rasterizer;
+  rasterizer.SetGrid(originX, originY, spacingX, spacingY);
+
+  // Restricted area cutting the polygon
+  const long startX = 5;
+  const long startY = 8;
+  const long endX = 40;
+  const long endY = 45;
+  otb::PolygonScanlineRasterizer::SpanListType spans;
+  rasterizer.Rasterize(&polygon, startX, startY, endX, endY, spans);
+
+  const long width = endX - startX + 1;
+  std::vector<unsigned int> hits(width * (endY - startY + 1), 0);
+  long previousY = startY - 1;
+  long previousEnd = endX;
+  for (unsigned int i=0 ; i<spans.size() ; i++)
+    {
+    const otb::PolygonScanlineRasterizer::Span& span = spans[i];
+    if (span.Y < startY || span.Y > endY || span.StartX < startX || span.EndX > endX
+        || span.StartX > span.EndX
+        || span.Y < previousY || (span.Y == previousY && span.StartX <= previousEnd))
+      {
+      std::cerr << "Span " << i << " is out of the area or not in raster order" << std::endl;
+      return EXIT_FAILURE;
+      }
+    previousY = span.Y;
+    previousEnd = span.EndX;
+    for (long x=span.StartX ; x<=span.EndX ; x++)
+      {
+      hits[(span.Y - startY) * width + x - startX]++;
+      }
+    }
+
+  unsigned long nbInside = 0;
+  for (long y=startY ; y<=endY ; y++)
+    {
+    for (long x=startX ; x<=endX ; x++)
+      {
+      const bool inside = IsInsidePolygon(polygon, originX + spacingX * x, originY + spacingY * y);
+      const unsigned int hit = hits[(y - startY) * width + x - startX];
+      if (hit > 1 || (hit == 1) != inside)
+        {
+        std::cerr << "Pixel (" << x << "," << y << ") : found " << hit
+                  << " times, expected inside = " << inside << std::endl;
+        return EXIT_FAILURE;
+        }
+      nbInside += hit;
+      }
+    }
+
+  std::cout << spans.size() << " spans, " << nbInside << " pixels" << std::endl;
+  if (nbInside == 0)
+    {
+    std::cerr << "No pixel found inside the polygon" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbSampleFileWriter.h"
+#include "otbSampleFileReader.h"
+
+#include <iostream>
+#include <vector>
+
+int otbSampleFile(int argc, char* argv[])
+{
+  if (argc != 2)
+    {
+    std::cout << "Usage : " << argv[0] << " sample_file" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Value of field f for sample i
+  const unsigned int nbFields = 3;
+  const unsigned long blockSizes[2] = {5, 7};
+  std::vector<std::string> names;
+  names.push_back("class");
+  names.push_back("value_0");
+  names.push_back("value_1");
+
+  otb::SampleFileWriter writer;
+  writer.Open(argv[1], names);
+  unsigned long first = 0;
+  for (unsigned int b = 0; b < 2; ++b)
+    {
+    std::vector<double> columns(blockSizes[b] * nbFields);
+    for (unsigned int f = 0; f < nbFields; ++f)
+      {
+      for (unsigned long i = 0; i < blockSizes[b]; ++i)
+        {
+        columns[f * blockSizes[b] + i] = 100. * f + (first + i) + 0.25;
+        }
+      }
+    writer.WriteBlock(&columns[0], blockSizes[b]);
+    first += blockSizes[b];
+    }
+  writer.Close();
+
+  if (!otb::SampleFileReader::CanReadFile(argv[1]))
+    {
+    std::cout << "The sample file is not recognized" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  otb::SampleFileReader reader;
+  reader.Open(argv[1]);
+  if (reader.GetFieldNames() != names || reader.GetNumberOfBlocks() != 2
+      || reader.GetNumberOfSamples() != first || reader.GetFieldIndex("value_1") != 2
+      || reader.GetFieldIndex("missing") != -1)
+    {
+    std::cout << "Wrong sample file header" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Read two of the fields, in another order
+  std::vector<unsigned int> fields;
+  fields.push_back(2);
+  fields.push_back(0);
+  unsigned int nbErrors = 0;
+  first = 0;
+  for (unsigned int b = 0; b < reader.GetNumberOfBlocks(); ++b)
+    {
+    std::vector<double> values(reader.GetBlockSize(b) * fields.size());
+    reader.ReadBlock(b, fields, &values[0]);
+    for (unsigned long i = 0; i < reader.GetBlockSize(b); ++i)
+      {
+      for (unsigned int j = 0; j < fields.size(); ++j)
+        {
+        const double expected = 100. * fields[j] + (first + i) + 0.25;
+        if (values[i * fields.size() + j] != expected)
+          {
+          std::cout << "Sample " << first + i << ", field " << fields[j] << ": "
+                    << values[i * fields.size() + j] << " instead of " << expected << std::endl;
+          ++nbErrors;
+          }
+        }
+      }
+    first += reader.GetBlockSize(b);
+    }
+
+  return (nbErrors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -34,4 +34,6 @@ void RegisterTests()
   REGISTER_TEST(otbImageSampleExtractorFilterUpdate);
   REGISTER_TEST(otbSamplingRateCalculatorListNew);
   REGISTER_TEST(otbSamplingRateCalculatorList);
+  REGISTER_TEST(otbPolygonScanlineRasterizer);
+  REGISTER_TEST(otbSampleFile);
 }
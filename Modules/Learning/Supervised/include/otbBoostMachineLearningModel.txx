@@ -137,6 +137,62 @@ BoostMachineLearningModel<TInputValue,TOutputValue>
   return target;
 }
 
+template <class TInputValue, class TOutputValue>
+void
+BoostMachineLearningModel<TInputValue,TOutputValue>
+::DoPredictBatch(const InputListSampleType * input, const unsigned int & startIndex, const unsigned int & size, TargetListSampleType * targets, ConfidenceListSampleType * quality) const
+{
+  this->CheckPredictBatchArguments(input, startIndex, size, targets, quality);
+
+  if(size == 0)
+    {
+    return;
+    }
+
+  // Convert the whole range of samples at once
+  cv::Mat samples;
+  otb::ListSampleRangeToMat(input, startIndex, size, samples);
+
+#ifdef OTB_OPENCV_3
+  cv::Mat results;
+  m_BoostModel->predict(samples, results);
+  cv::Mat rawOutputs;
+  if (quality != ITK_NULLPTR)
+    {
+    m_BoostModel->predict(samples, rawOutputs, cv::ml::StatModel::RAW_OUTPUT);
+    }
+#else
+  // OpenCV 2 boosting only predicts one sample at a time
+  cv::Mat missing  = cv::Mat(1,samples.cols, CV_8U );
+  missing.setTo(0);
+#endif
+
+  for(unsigned int i = 0; i < size; ++i)
+    {
+    TargetSampleType target;
+#ifdef OTB_OPENCV_3
+    target[0] = static_cast<TOutputValue>(results.at<float>(i));
+#else
+    const cv::Mat sample = samples.row(i);
+    target[0] = static_cast<TOutputValue>(m_BoostModel->predict(sample,missing));
+#endif
+    targets->SetMeasurementVector(startIndex + i, target);
+
+    if (quality != ITK_NULLPTR)
+      {
+      ConfidenceSampleType confidence;
+      confidence[0] = static_cast<ConfidenceValueType>(
+#ifdef OTB_OPENCV_3
+        rawOutputs.at<float>(i)
+#else
+        m_BoostModel->predict(sample,missing,cv::Range::all(),false,true)
+#endif
+        );
+      quality->SetMeasurementVector(startIndex + i, confidence);
+      }
+    }
+}
+
 template <class TInputValue, class TOutputValue>
 void
 BoostMachineLearningModel<TInputValue,TOutputValue>
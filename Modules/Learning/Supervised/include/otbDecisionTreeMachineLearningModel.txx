@@ -144,6 +144,45 @@ DecisionTreeMachineLearningModel<TInputValue,TOutputValue>
   return target;
 }
 
+template <class TInputValue, class TOutputValue>
+void
+DecisionTreeMachineLearningModel<TInputValue,TOutputValue>
+::DoPredictBatch(const InputListSampleType * input, const unsigned int & startIndex, const unsigned int & size, TargetListSampleType * targets, ConfidenceListSampleType * quality) const
+{
+  this->CheckPredictBatchArguments(input, startIndex, size, targets, quality);
+
+  if (quality != ITK_NULLPTR && !this->m_ConfidenceIndex)
+    {
+    itkExceptionMacro("Confidence index not available for this classifier !");
+    }
+
+  if(size == 0)
+    {
+    return;
+    }
+
+  // Convert the whole range of samples at once
+  cv::Mat samples;
+  otb::ListSampleRangeToMat(input, startIndex, size, samples);
+
+#ifdef OTB_OPENCV_3
+  cv::Mat results;
+  m_DTreeModel->predict(samples, results);
+#endif
+
+  for(unsigned int i = 0; i < size; ++i)
+    {
+    TargetSampleType target;
+#ifdef OTB_OPENCV_3
+    target[0] = static_cast<TOutputValue>(results.at<float>(i));
+#else
+    // CvDTree only predicts one sample at a time
+    target[0] = static_cast<TOutputValue>(m_DTreeModel->predict(samples.row(i), cv::Mat(), false)->value);
+#endif
+    targets->SetMeasurementVector(startIndex + i, target);
+    }
+}
+
 template <class TInputValue, class TOutputValue>
 void
 DecisionTreeMachineLearningModel<TInputValue,TOutputValue>
@@ -22,6 +22,7 @@
 #define otbExhaustiveExponentialOptimizer_h
 
 #include "itkSingleValuedNonLinearOptimizer.h"
+#include <vector>
 
 namespace otb
 {
@@ -67,6 +68,12 @@ public:
   void ResumeWalking(void);
   void StopWalking(void);
 
+  /** Compute the positions evaluated by StartWalking(), in the same
+   * order: the initial position first, then every node of the grid.
+   * This lets the caller evaluate the cost function at several
+   * positions at once. */
+  void GetGridPositions(std::vector<ParametersType>& positions) const;
+
   itkSetMacro(GeometricProgression, double);
   itkSetMacro(NumberOfSteps, StepsType);
   itkSetMacro(StepLength, double);
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbFlatForest_h
+#define otbFlatForest_h
+
+#include "OTBSupervisedExport.h"
+#include <vector>
+
+namespace otb
+{
+
+/** \class FlatForest
+ * \brief Flat copy of a trained forest of binary decision trees
+ *
+ * The nodes of all trees are stored as a structure of arrays (split
+ * feature, split threshold, index of the left child, leaf index), the
+ * right child of a split always directly following its left child. A
+ * sample goes to the left child when its feature value is lower or
+ * equal to the threshold, as in OpenCV and Shark.
+ *
+ * Accumulate() evaluates blocks of samples against one tree at a time,
+ * so that the nodes of the tree stay in cache while the whole block
+ * goes through it. All the samples of a block are moved down one level
+ * at a time: leaves loop onto themselves, so that the inner loop has no
+ * data dependent branch.
+ *
+ * Leaves either vote for one output (classification forests) or hold a
+ * vector of values summed over the trees (regression, probabilities).
+ * All the leaves of a forest must be of the same kind.
+ *
+ * The forest is built with AddTree(), SetSplit() and SetLeaf(): each
+ * node created by AddTree() or SetSplit() must be turned into a split or
+ * a leaf before the next tree is added.
+ *
+ * \ingroup OTBSupervised
+ */
+class OTBSupervised_EXPORT FlatForest
+{
+public:
+  /** Number of samples going through a tree together */
+  static const unsigned int BlockSize = 64;
+
+  FlatForest();
+
+  /** Remove all trees */
+  void Clear();
+
+  /** Returns true when the forest has no tree */
+  bool IsEmpty() const
+  {
+    return m_Roots.empty();
+  }
+
+  unsigned int GetNumberOfTrees() const
+  {
+    return static_cast<unsigned int>(m_Roots.size());
+  }
+
+  /** Number of values accumulated per sample. It must be set before
+   *  adding value leaves. */
+  void SetNumberOfOutputs(unsigned int nbOutputs);
+
+  unsigned int GetNumberOfOutputs() const
+  {
+    return m_NumberOfOutputs;
+  }
+
+  /** Add a tree, returns the index of its root node */
+  unsigned int AddTree();
+
+  /** Turn a node into a split, returns the index of its left child, the
+   *  right child being the next index. The threshold is kept as given for
+   *  double features, and rounded down to the nearest float for float
+   *  features, which keeps the comparison with float features exact. */
+  unsigned int SetSplit(unsigned int node, unsigned int feature, double threshold);
+
+  /** Turn a node into a leaf voting for the given output */
+  void SetLeaf(unsigned int node, unsigned int output);
+
+  /** Turn a node into a leaf holding GetNumberOfOutputs() values */
+  void SetLeaf(unsigned int node, const double * values);
+
+  /** Add the votes or values of all trees to sums. Samples are stored
+   *  row by row with nbFeatures values per sample, sums must hold
+   *  nbSamples * GetNumberOfOutputs() values. */
+  void Accumulate(const float * samples,
+                  unsigned int nbSamples,
+                  unsigned int nbFeatures,
+                  double * sums) const;
+
+  /** Same as above for double samples, compared to the thresholds at
+   *  double precision. Double features converted to float would not
+   *  always take the same branch as in the original forest. */
+  void Accumulate(const double * samples,
+                  unsigned int nbSamples,
+                  unsigned int nbFeatures,
+                  double * sums) const;
+
+private:
+  unsigned int AddNode(unsigned int depth);
+
+  /** Check that the forest is complete and matches nbFeatures */
+  void CheckForEvaluation(unsigned int nbFeatures) const;
+
+  template <class TSample>
+  void AccumulateSamples(const TSample * samples,
+                         const TSample * threshold,
+                         unsigned int nbSamples,
+                         unsigned int nbFeatures,
+                         double * sums) const;
+
+  /** Node arrays */
+  std::vector<unsigned int> m_Feature;
+  std::vector<float>        m_Threshold;
+  std::vector<double>       m_DoubleThreshold;
+  std::vector<unsigned int> m_Children;
+  /** Index of the leaf (or voted output), -1 for splits */
+  std::vector<int>          m_Leaf;
+  /** Depth of each node, only used while building */
+  std::vector<unsigned int> m_Depth;
+
+  /** Tree arrays */
+  std::vector<unsigned int> m_Roots;
+  std::vector<unsigned int> m_TreeDepths;
+
+  /** Leaf values, GetNumberOfOutputs() per leaf */
+  std::vector<double>       m_LeafValues;
+
+  unsigned int m_NumberOfOutputs;
+  unsigned int m_NumberOfLeaves;
+  bool         m_VoteLeaves;
+  /** Nodes not yet turned into a split or a leaf */
+  unsigned int m_NumberOfPendingNodes;
+  /** Bounds checked before evaluation */
+  unsigned int m_MaxFeature;
+  unsigned int m_MaxOutput;
+};
+
+} // end namespace otb
+
+#endif
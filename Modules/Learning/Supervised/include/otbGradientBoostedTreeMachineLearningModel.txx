@@ -107,6 +107,36 @@ GradientBoostedTreeMachineLearningModel<TInputValue,TOutputValue>
   return target;
 }
 
+template <class TInputValue, class TOutputValue>
+void
+GradientBoostedTreeMachineLearningModel<TInputValue,TOutputValue>
+::DoPredictBatch(const InputListSampleType * input, const unsigned int & startIndex, const unsigned int & size, TargetListSampleType * targets, ConfidenceListSampleType * quality) const
+{
+  this->CheckPredictBatchArguments(input, startIndex, size, targets, quality);
+
+  if (quality != ITK_NULLPTR && !this->m_ConfidenceIndex)
+    {
+    itkExceptionMacro("Confidence index not available for this classifier !");
+    }
+
+  if(size == 0)
+    {
+    return;
+    }
+
+  // Convert the whole range of samples at once
+  cv::Mat samples;
+  otb::ListSampleRangeToMat(input, startIndex, size, samples);
+
+  // CvGBTrees only predicts one sample at a time
+  for(unsigned int i = 0; i < size; ++i)
+    {
+    TargetSampleType target;
+    target[0] = static_cast<TOutputValue>(m_GBTreeModel->predict(samples.row(i)));
+    targets->SetMeasurementVector(startIndex + i, target);
+    }
+}
+
 template <class TInputValue, class TOutputValue>
 void
 GradientBoostedTreeMachineLearningModel<TInputValue,TOutputValue>
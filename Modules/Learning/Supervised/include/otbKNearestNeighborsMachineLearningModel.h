@@ -106,6 +106,10 @@ protected:
   /** Predict values using the model */
   TargetSampleType DoPredict(const InputSampleType& input, ConfidenceValueType *quality=ITK_NULLPTR) const ITK_OVERRIDE;
 
+  /** Predict values for a range of samples, converted at once to a
+   *  matrix handed to the OpenCV batch prediction */
+  void DoPredictBatch(const InputListSampleType *, const unsigned int & startIndex, const unsigned int & size, TargetListSampleType *, ConfidenceListSampleType * = ITK_NULLPTR) const ITK_OVERRIDE;
+
   
   /** PrintSelf method */
   void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
@@ -114,6 +118,11 @@ private:
   KNearestNeighborsMachineLearningModel(const Self &); //purposely not implemented
   void operator =(const Self&); //purposely not implemented
 
+  /** Apply the decision rule to the OpenCV result and the responses of
+   *  the K nearest neighbors of a sample, and compute the confidence
+   *  if quality is not null */
+  TargetSampleType NeighborsToTarget(float result, const float * nearest, ConfidenceValueType *quality) const;
+
 #ifdef OTB_OPENCV_3
   cv::Ptr<cv::ml::KNearest> m_KNearestModel;
 #else
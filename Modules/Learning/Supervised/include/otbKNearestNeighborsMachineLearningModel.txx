@@ -108,8 +108,6 @@ typename KNearestNeighborsMachineLearningModel<TInputValue,TTargetValue>
 KNearestNeighborsMachineLearningModel<TInputValue,TTargetValue>
 ::DoPredict(const InputSampleType & input, ConfidenceValueType *quality) const
 {
-  TargetSampleType target;
-
   //convert listsample to Mat
   cv::Mat sample;
   otb::SampleToMat<InputSampleType>(input, sample);
@@ -121,6 +119,18 @@ KNearestNeighborsMachineLearningModel<TInputValue,TTargetValue>
 #else
   result = m_KNearestModel->find_nearest(sample, m_K,ITK_NULLPTR,ITK_NULLPTR,&nearest,ITK_NULLPTR);
 #endif
+
+  return this->NeighborsToTarget(result, nearest.ptr<float>(0), quality);
+}
+
+template <class TInputValue, class TTargetValue>
+typename KNearestNeighborsMachineLearningModel<TInputValue,TTargetValue>
+::TargetSampleType
+KNearestNeighborsMachineLearningModel<TInputValue,TTargetValue>
+::NeighborsToTarget(float result, const float * nearest, ConfidenceValueType *quality) const
+{
+  TargetSampleType target;
+
   // compute quality if asked (only happens in classification mode)
   if (quality != ITK_NULLPTR)
     {
@@ -128,7 +138,7 @@ KNearestNeighborsMachineLearningModel<TInputValue,TTargetValue>
     unsigned int accuracy = 0;
     for (int k=0 ; k < m_K ; ++k)
       {
-      if (nearest.at<float>(0,k) == result)
+      if (nearest[k] == result)
         {
         accuracy++;
         }
@@ -145,7 +155,7 @@ KNearestNeighborsMachineLearningModel<TInputValue,TTargetValue>
     std::multiset<float> values;
     for (int k=0 ; k < m_K ; ++k)
       {
-      values.insert(nearest.at<float>(0,k));
+      values.insert(nearest[k]);
       }
     std::multiset<float>::iterator median = values.begin();
     int pos = (m_K >> 1);
@@ -157,6 +167,47 @@ KNearestNeighborsMachineLearningModel<TInputValue,TTargetValue>
   return target;
 }
 
+template <class TInputValue, class TTargetValue>
+void
+KNearestNeighborsMachineLearningModel<TInputValue,TTargetValue>
+::DoPredictBatch(const InputListSampleType * input, const unsigned int & startIndex, const unsigned int & size, TargetListSampleType * targets, ConfidenceListSampleType * quality) const
+{
+  this->CheckPredictBatchArguments(input, startIndex, size, targets, quality);
+
+  if(size == 0)
+    {
+    return;
+    }
+
+  // Convert the whole range of samples at once
+  cv::Mat samples;
+  otb::ListSampleRangeToMat(input, startIndex, size, samples);
+
+  // Results and neighbors responses of all the samples in one call
+  cv::Mat results;
+  cv::Mat nearest(size,m_K,CV_32FC1);
+#ifdef OTB_OPENCV_3
+  m_KNearestModel->findNearest(samples, m_K, results, nearest, cv::noArray());
+#else
+  m_KNearestModel->find_nearest(samples, m_K, &results, ITK_NULLPTR, &nearest, ITK_NULLPTR);
+#endif
+
+  for(unsigned int i = 0; i < size; ++i)
+    {
+    ConfidenceValueType confidence = 0;
+    const TargetSampleType target = this->NeighborsToTarget(results.at<float>(i), nearest.ptr<float>(i),
+                                                            quality != ITK_NULLPTR ? &confidence : ITK_NULLPTR);
+    targets->SetMeasurementVector(startIndex + i, target);
+
+    if (quality != ITK_NULLPTR)
+      {
+      ConfidenceSampleType confidenceSample;
+      confidenceSample[0] = confidence;
+      quality->SetMeasurementVector(startIndex + i, confidenceSample);
+      }
+    }
+}
+
 template <class TInputValue, class TTargetValue>
 void
 KNearestNeighborsMachineLearningModel<TInputValue,TTargetValue>
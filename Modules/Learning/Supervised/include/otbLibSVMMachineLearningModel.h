@@ -24,6 +24,10 @@
 #include "itkLightObject.h"
 #include "itkFixedArray.h"
 #include "otbMachineLearningModel.h"
+#include "otbExhaustiveExponentialOptimizer.h"
+#include "otbQuantizationUtils.h"
+#include "itkMultiThreader.h"
+#include "itkMutexLock.h"
 
 #include "svm.h"
 
@@ -48,6 +52,8 @@ public:
   typedef typename Superclass::TargetListSampleType       TargetListSampleType;
   typedef typename Superclass::ConfidenceValueType        ConfidenceValueType;
 
+  typedef ExhaustiveExponentialOptimizer::ParametersType  ParametersType;
+
   /** enum to choose the way confidence is computed
    *   CM_INDEX : compute the difference between highest and second highest probability
    *   CM_PROBA : returns probabilities for all classes
@@ -226,6 +232,14 @@ public:
   itkSetMacro(CVFolders, unsigned int);
   itkGetMacro(CVFolders, unsigned int);
 
+  /** Run the cross validation folds and the grid points of the parameter
+   * optimization concurrently, on folds shared by all the grid points.
+   * Grid points that can no longer reach the best accuracy are dropped
+   * before all their folds are trained. Default : false */
+  itkSetMacro(ParallelCrossValidation, bool);
+  itkGetMacro(ParallelCrossValidation, bool);
+  itkBooleanMacro(ParallelCrossValidation);
+
   itkGetMacro(InitialCrossValidationAccuracy, double);
 
   itkGetMacro(FinalCrossValidationAccuracy, double);
@@ -241,7 +255,7 @@ public:
     if (m_ConfidenceMode != static_cast<ConfidenceMode>(mode) )
       {
       m_ConfidenceMode = static_cast<ConfidenceMode>(mode);
-      this->m_ConfidenceIndex = this->HasProbabilities();
+      this->m_ConfidenceIndex = this->HasProbabilities() && !this->m_QuantizedInference;
       this->Modified();
       }
     }
@@ -264,6 +278,17 @@ public:
     return 0;
     }
 
+  /** Predict from int16 quantized features and weights. Only the linear
+   *  and RBF kernels are supported. The decision values are computed
+   *  from the quantized support vectors (from the quantized hyperplanes
+   *  for the linear kernel), and the label is voted one-against-one as
+   *  in svm_predict(). The features scale is calibrated on the range of
+   *  the support vectors, that is on the normalized training samples.
+   *  The quantized model gives no confidence index: HasConfidenceIndex()
+   *  is false while it is used, and predictions asking for a confidence
+   *  throw an exception. */
+  void SetQuantizedInference(bool flag) ITK_OVERRIDE;
+
 protected:
   /** Constructor */
   LibSVMMachineLearningModel();
@@ -274,6 +299,10 @@ protected:
   /** Predict values using the model */
   TargetSampleType DoPredict(const InputSampleType& input, ConfidenceValueType *quality=ITK_NULLPTR) const ITK_OVERRIDE;
 
+  /** Predict values for a range of samples, reusing the same libsvm
+   *  node and estimate buffers for all of them */
+  void DoPredictBatch(const InputListSampleType *, const unsigned int & startIndex, const unsigned int & size, TargetListSampleType *, ConfidenceListSampleType * = ITK_NULLPTR) const ITK_OVERRIDE;
+
   /** PrintSelf method */
   void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
 
@@ -283,6 +312,13 @@ private:
 
   void BuildProblem(void);
 
+  /** Predict the target of a sample converted to libsvm nodes. The
+   *  estimates buffer must hold GetEstimatesSize() values. */
+  TargetSampleType PredictNodes(const struct svm_node * x, double * estimates, ConfidenceValueType *quality) const;
+
+  /** Size of the probability / decision values buffer used by PredictNodes() */
+  unsigned int GetEstimatesSize() const;
+
   void ConsistencyCheck(void);
 
   void DeleteProblem(void);
@@ -291,6 +327,62 @@ private:
 
   void OptimizeParameters(void);
 
+  /** Evaluate the cross validation accuracy at each position and return
+   * the index of the best one (the first one in case of ties) */
+  unsigned int ParallelCrossValidation(const std::vector<ParametersType>& positions, double& bestAccuracy);
+
+  /** Shared state of a parallel cross validation */
+  struct CrossValidationGridStruct
+  {
+    Self *                                        Model;
+    const std::vector<ParametersType> *           Positions;
+    /** Training subproblem of each fold, pointing into m_Problem */
+    std::vector<struct svm_problem>               TrainingFolds;
+    std::vector<std::vector<double> >             TrainingTargets;
+    std::vector<std::vector<struct svm_node*> >   TrainingNodes;
+    /** Indices of the test samples of each fold */
+    std::vector<std::vector<unsigned int> >       TestFolds;
+    /** Correct predictions, untested samples and trained folds per position */
+    std::vector<unsigned long>                    Correct;
+    std::vector<unsigned long>                    Remaining;
+    std::vector<unsigned int>                     FoldsDone;
+    std::vector<bool>                             Pruned;
+    unsigned long                                 NextTask;
+    long                                          BestPosition;
+    itk::SimpleMutexLock                          Mutex;
+  };
+
+  /** Static function used as a "callback" by the MultiThreader */
+  static ITK_THREAD_RETURN_TYPE CrossValidationThreaderCallback(void *arg);
+
+  /** Quantized copy of the model, used by the quantized inference */
+  struct QuantizedModelStruct
+  {
+    /** Number of features of the dense support vectors */
+    unsigned int                                NumberOfFeatures;
+    /** Scale of the features levels */
+    double                                      InputScale;
+    /** Support vectors (RBF), or one hyperplane per decision function (linear) */
+    std::vector<Quantization::LevelType>        Vectors;
+    /** Scale of each hyperplane (linear) */
+    std::vector<double>                         VectorScales;
+    /** Squared norm of each support vector (RBF) */
+    std::vector<Quantization::AccumulatorType>  SquaredNorms;
+    /** Index of the first support vector of each class */
+    std::vector<int>                            Starts;
+  };
+
+  /** Build m_QuantizedModel from m_Model */
+  void BuildQuantizedModel(void);
+
+  /** Predict the target of a sample with m_QuantizedModel. The levels
+   *  and values buffers are resized as needed. */
+  TargetSampleType PredictQuantized(const InputSampleType & input,
+                                    std::vector<Quantization::LevelType> & levels,
+                                    std::vector<double> & values) const;
+
+  QuantizedModelStruct m_QuantizedModel;
+
   /** Container to hold the SVM model itself */
   struct svm_model* m_Model;
 
@@ -306,6 +398,9 @@ private:
   /** Number of Cross Validation folders*/
   unsigned int m_CVFolders;
 
+  /** Run the cross validation on several threads, default : false */
+  bool m_ParallelCrossValidation;
+
   /** Initial cross validation accuracy */
   double m_InitialCrossValidationAccuracy;
 
@@ -22,6 +22,10 @@
 #define otbLibSVMMachineLearningModel_txx
 
 #include <fstream>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <cmath>
 #include "otbLibSVMMachineLearningModel.h"
 #include "otbSVMCrossValidationCostFunction.h"
 #include "otbExhaustiveExponentialOptimizer.h"
@@ -50,12 +54,16 @@ LibSVMMachineLearningModel<TInputValue,TOutputValue>
   this->m_ParameterOptimization = false;
   this->m_IsRegressionSupported = true;
   this->SetCVFolders(5);
+  this->m_ParallelCrossValidation = false;
   this->m_InitialCrossValidationAccuracy = 0.;
   this->m_FinalCrossValidationAccuracy = 0.;
   this->m_CoarseOptimizationNumberOfSteps = 5;
   this->m_FineOptimizationNumberOfSteps = 5;
   this->m_ConfidenceMode =
     LibSVMMachineLearningModel<TInputValue,TOutputValue>::CM_INDEX;
+  this->m_IsQuantizedInferenceSupported = true;
+  this->m_QuantizedModel.NumberOfFeatures = 0;
+  this->m_QuantizedModel.InputScale = 1.;
 
   this->m_Parameters.nr_weight = 0;
   this->m_Parameters.weight_label = ITK_NULLPTR;
@@ -100,7 +108,12 @@ LibSVMMachineLearningModel<TInputValue,TOutputValue>
   // train the model
   m_Model = svm_train(&m_Problem, &m_Parameters);
 
-  this->m_ConfidenceIndex = this->HasProbabilities();
+  this->m_ConfidenceIndex = this->HasProbabilities() && !this->m_QuantizedInference;
+
+  if (this->m_QuantizedInference)
+    {
+    this->BuildQuantizedModel();
+    }
 }
 
 template <class TInputValue, class TOutputValue>
@@ -109,15 +122,19 @@ typename LibSVMMachineLearningModel<TInputValue,TOutputValue>
 LibSVMMachineLearningModel<TInputValue,TOutputValue>
 ::DoPredict(const InputSampleType & input, ConfidenceValueType *quality) const
 {
-  TargetSampleType target;
-  target.Fill(0);
-
-  // Get type and number of classes
-  int svm_type = svm_get_svm_type(m_Model);
+  if (this->m_QuantizedInference)
+    {
+    if (quality != ITK_NULLPTR)
+      {
+      itkExceptionMacro(<< "Quantized inference does not compute a confidence index.");
+      }
+    std::vector<Quantization::LevelType> levels;
+    std::vector<double> values;
+    return this->PredictQuantized(input, levels, values);
+    }
 
-  // Allocate nodes (/TODO if performances problems are related to too
-  // many allocations, a cache approach can be set)
-  struct svm_node * x = new struct svm_node[input.Size() + 1];
+  // Allocate nodes
+  std::vector<struct svm_node> x(input.Size() + 1);
 
   // Fill the node
   for (unsigned int i = 0 ; i < input.Size() ; i++)
@@ -130,6 +147,94 @@ LibSVMMachineLearningModel<TInputValue,TOutputValue>
   x[input.Size()].index = -1;
   x[input.Size()].value = 0;
 
+  std::vector<double> estimates(this->GetEstimatesSize());
+  return this->PredictNodes(&x[0], &estimates[0], quality);
+}
+
+template <class TInputValue, class TOutputValue>
+void
+LibSVMMachineLearningModel<TInputValue,TOutputValue>
+::DoPredictBatch(const InputListSampleType * input, const unsigned int & startIndex, const unsigned int & size, TargetListSampleType * targets, ConfidenceListSampleType * quality) const
+{
+  this->CheckPredictBatchArguments(input, startIndex, size, targets, quality);
+
+  if(size == 0)
+    {
+    return;
+    }
+
+  if (this->m_QuantizedInference)
+    {
+    if (quality != ITK_NULLPTR)
+      {
+      itkExceptionMacro(<< "Quantized inference does not compute a confidence index.");
+      }
+    std::vector<Quantization::LevelType> levels;
+    std::vector<double> values;
+    for(unsigned int id = startIndex; id < startIndex + size; ++id)
+      {
+      targets->SetMeasurementVector(id, this->PredictQuantized(input->GetMeasurementVector(id), levels, values));
+      }
+    return;
+    }
+
+  // libsvm predicts one sample at a time : allocate the buffers once
+  // for the whole range
+  const unsigned int sampleSize = input->GetMeasurementVectorSize();
+  std::vector<struct svm_node> x(sampleSize + 1);
+  for (unsigned int i = 0 ; i < sampleSize ; i++)
+    {
+    x[i].index = i + 1;
+    }
+  x[sampleSize].index = -1;
+  x[sampleSize].value = 0;
+
+  std::vector<double> estimates(this->GetEstimatesSize());
+
+  for(unsigned int id = startIndex; id < startIndex + size; ++id)
+    {
+    const InputSampleType & sample = input->GetMeasurementVector(id);
+    for (unsigned int i = 0 ; i < sampleSize ; i++)
+      {
+      x[i].value = sample[i];
+      }
+
+    ConfidenceValueType confidence = 0;
+    targets->SetMeasurementVector(id,
+      this->PredictNodes(&x[0], &estimates[0], quality != ITK_NULLPTR ? &confidence : ITK_NULLPTR));
+
+    if (quality != ITK_NULLPTR)
+      {
+      ConfidenceSampleType confidenceSample;
+      confidenceSample[0] = confidence;
+      quality->SetMeasurementVector(id, confidenceSample);
+      }
+    }
+}
+
+template <class TInputValue, class TOutputValue>
+unsigned int
+LibSVMMachineLearningModel<TInputValue,TOutputValue>
+::GetEstimatesSize() const
+{
+  // Probabilities need one value per class, decision values one per
+  // pair of classes
+  const unsigned int nr_class = svm_get_nr_class(m_Model);
+  return std::max(1u, std::max(nr_class, nr_class * (nr_class - 1) / 2));
+}
+
+template <class TInputValue, class TOutputValue>
+typename LibSVMMachineLearningModel<TInputValue,TOutputValue>
+::TargetSampleType
+LibSVMMachineLearningModel<TInputValue,TOutputValue>
+::PredictNodes(const struct svm_node * x, double * estimates, ConfidenceValueType *quality) const
+{
+  TargetSampleType target;
+  target.Fill(0);
+
+  // Get type and number of classes
+  int svm_type = svm_get_svm_type(m_Model);
+
   if (quality != ITK_NULLPTR)
     {
     if (!this->m_ConfidenceIndex)
@@ -140,28 +245,24 @@ LibSVMMachineLearningModel<TInputValue,TOutputValue>
       {
       if (svm_type == C_SVC || svm_type == NU_SVC)
         {
-        // Eventually allocate space for probabilities
         unsigned int nr_class = svm_get_nr_class(m_Model);
-        double *prob_estimates = new double[nr_class];
         // predict
-        target[0] = static_cast<TargetValueType>(svm_predict_probability(m_Model, x, prob_estimates));
+        target[0] = static_cast<TargetValueType>(svm_predict_probability(m_Model, x, estimates));
         double maxProb = 0.0;
         double secProb = 0.0;
         for (unsigned int i=0 ; i< nr_class ; ++i)
           {
-          if (maxProb < prob_estimates[i])
+          if (maxProb < estimates[i])
             {
             secProb = maxProb;
-            maxProb = prob_estimates[i];
+            maxProb = estimates[i];
             }
-          else if (secProb < prob_estimates[i])
+          else if (secProb < estimates[i])
             {
-            secProb = prob_estimates[i];
+            secProb = estimates[i];
             }
           }
         (*quality) = static_cast<ConfidenceValueType>(maxProb - secProb);
-
-        delete[] prob_estimates;
         }
       else
         {
@@ -174,11 +275,15 @@ LibSVMMachineLearningModel<TInputValue,TOutputValue>
       }
     else if (this->m_ConfidenceMode == CM_PROBA)
       {
-      target[0] = static_cast<TargetValueType>(svm_predict_probability(m_Model, x, quality));
+      // Only the first estimate is reported
+      target[0] = static_cast<TargetValueType>(svm_predict_probability(m_Model, x, estimates));
+      (*quality) = static_cast<ConfidenceValueType>(estimates[0]);
       }
     else if (this->m_ConfidenceMode == CM_HYPER)
       {
-      target[0] = static_cast<TargetValueType>(svm_predict_values(m_Model, x, quality));
+      // Only the first estimate is reported
+      target[0] = static_cast<TargetValueType>(svm_predict_values(m_Model, x, estimates));
+      (*quality) = static_cast<ConfidenceValueType>(estimates[0]);
       }
     }
   else
@@ -187,10 +292,7 @@ LibSVMMachineLearningModel<TInputValue,TOutputValue>
     // which gives different results than svm_predict()
     if (svm_check_probability_model(m_Model))
       {
-      unsigned int nr_class = svm_get_nr_class(m_Model);
-      double *prob_estimates = new double[nr_class];
-      target[0] = static_cast<TargetValueType>(svm_predict_probability(m_Model, x, prob_estimates));
-      delete[] prob_estimates;
+      target[0] = static_cast<TargetValueType>(svm_predict_probability(m_Model, x, estimates));
       }
     else
       {
@@ -198,9 +300,6 @@ LibSVMMachineLearningModel<TInputValue,TOutputValue>
       }
     }
 
-  // Free allocated memory
-  delete[] x;
-
   return target;
 }
 
@@ -228,7 +327,260 @@ LibSVMMachineLearningModel<TInputValue,TOutputValue>
     }
   m_Parameters = m_Model->param;
 
-  this->m_ConfidenceIndex = this->HasProbabilities();
+  this->m_ConfidenceIndex = this->HasProbabilities() && !this->m_QuantizedInference;
+
+  if (this->m_QuantizedInference)
+    {
+    this->BuildQuantizedModel();
+    }
+}
+
+template <class TInputValue, class TOutputValue>
+void
+LibSVMMachineLearningModel<TInputValue,TOutputValue>
+::SetQuantizedInference(bool flag)
+{
+  const bool build = flag && !this->m_QuantizedInference;
+  Superclass::SetQuantizedInference(flag);
+  if (build && m_Model)
+    {
+    this->BuildQuantizedModel();
+    }
+  // The quantized model has no probability estimates
+  this->m_ConfidenceIndex = this->HasProbabilities() && !this->m_QuantizedInference;
+}
+
+template <class TInputValue, class TOutputValue>
+void
+LibSVMMachineLearningModel<TInputValue,TOutputValue>
+::BuildQuantizedModel()
+{
+  const int kernelType = m_Model->param.kernel_type;
+  if (kernelType != LINEAR && kernelType != RBF)
+    {
+    itkExceptionMacro(<< "Quantized inference is only available for linear and RBF kernels.");
+    }
+
+  const int svmType = m_Model->param.svm_type;
+  const int nbSV = m_Model->l;
+  const int nrClass = m_Model->nr_class;
+  QuantizedModelStruct & q = m_QuantizedModel;
+
+  // Dense copy of the sparse support vectors
+  unsigned int nbFeatures = 0;
+  for (int i = 0; i < nbSV; ++i)
+    {
+    for (const struct svm_node * node = m_Model->SV[i]; node->index != -1; ++node)
+      {
+      nbFeatures = std::max(nbFeatures, static_cast<unsigned int>(node->index));
+      }
+    }
+  std::vector<double> dense(nbSV * nbFeatures, 0.);
+  for (int i = 0; i < nbSV; ++i)
+    {
+    for (const struct svm_node * node = m_Model->SV[i]; node->index != -1; ++node)
+      {
+      dense[i * nbFeatures + node->index - 1] = node->value;
+      }
+    }
+
+  // The support vectors are training samples : their range calibrates
+  // the scale of the features
+  q.NumberOfFeatures = nbFeatures;
+  q.InputScale = Quantization::ComputeScale(Quantization::MaxAbs(dense.data(), dense.size()));
+
+  q.Starts.assign(1, 0);
+  if (svmType == C_SVC || svmType == NU_SVC)
+    {
+    for (int c = 1; c < nrClass; ++c)
+      {
+      q.Starts.push_back(q.Starts[c - 1] + m_Model->nSV[c - 1]);
+      }
+    }
+
+  q.VectorScales.clear();
+  q.SquaredNorms.clear();
+  if (kernelType == RBF)
+    {
+    q.Vectors.resize(dense.size());
+    Quantization::Quantize(dense.data(), dense.size(), q.InputScale, q.Vectors.data());
+    for (int i = 0; i < nbSV; ++i)
+      {
+      q.SquaredNorms.push_back(Quantization::SquaredNorm(q.Vectors.data() + i * nbFeatures, nbFeatures));
+      }
+    return;
+    }
+
+  // Linear kernel : collapse the support vectors of each decision
+  // function into its hyperplane
+  std::vector<std::vector<double> > hyperplanes;
+  if (svmType == C_SVC || svmType == NU_SVC)
+    {
+    for (int i = 0; i < nrClass; ++i)
+      {
+      for (int j = i + 1; j < nrClass; ++j)
+        {
+        std::vector<double> w(nbFeatures, 0.);
+        const double * coef1 = m_Model->sv_coef[j - 1];
+        const double * coef2 = m_Model->sv_coef[i];
+        for (int k = q.Starts[i]; k < q.Starts[i] + m_Model->nSV[i]; ++k)
+          {
+          for (unsigned int f = 0; f < nbFeatures; ++f)
+            {
+            w[f] += coef1[k] * dense[k * nbFeatures + f];
+            }
+          }
+        for (int k = q.Starts[j]; k < q.Starts[j] + m_Model->nSV[j]; ++k)
+          {
+          for (unsigned int f = 0; f < nbFeatures; ++f)
+            {
+            w[f] += coef2[k] * dense[k * nbFeatures + f];
+            }
+          }
+        hyperplanes.push_back(w);
+        }
+      }
+    }
+  else
+    {
+    std::vector<double> w(nbFeatures, 0.);
+    for (int k = 0; k < nbSV; ++k)
+      {
+      for (unsigned int f = 0; f < nbFeatures; ++f)
+        {
+        w[f] += m_Model->sv_coef[0][k] * dense[k * nbFeatures + f];
+        }
+      }
+    hyperplanes.push_back(w);
+    }
+
+  q.Vectors.resize(hyperplanes.size() * nbFeatures);
+  for (unsigned int p = 0; p < hyperplanes.size(); ++p)
+    {
+    const double scale = Quantization::ComputeScale(Quantization::MaxAbs(hyperplanes[p].data(), nbFeatures));
+    Quantization::Quantize(hyperplanes[p].data(), nbFeatures, scale, q.Vectors.data() + p * nbFeatures);
+    q.VectorScales.push_back(scale);
+    }
+}
+
+template <class TInputValue, class TOutputValue>
+typename LibSVMMachineLearningModel<TInputValue,TOutputValue>
+::TargetSampleType
+LibSVMMachineLearningModel<TInputValue,TOutputValue>
+::PredictQuantized(const InputSampleType & input,
+                   std::vector<Quantization::LevelType> & levels,
+                   std::vector<double> & values) const
+{
+  const QuantizedModelStruct & q = m_QuantizedModel;
+  const unsigned int nbFeatures = q.NumberOfFeatures;
+  const unsigned int inputSize = input.Size();
+  const unsigned int nbQuantized = std::min(inputSize, nbFeatures);
+
+  levels.assign(nbFeatures, 0);
+  Quantization::Quantize(input.GetDataPointer(), nbQuantized, q.InputScale, levels.data());
+
+  const int svmType = m_Model->param.svm_type;
+  const int nrClass = m_Model->nr_class;
+  const bool classification = (svmType == C_SVC || svmType == NU_SVC);
+  const unsigned int nbDecisions = classification ? nrClass * (nrClass - 1) / 2 : 1;
+
+  double * decisions = ITK_NULLPTR;
+  if (m_Model->param.kernel_type == LINEAR)
+    {
+    values.resize(nbDecisions);
+    decisions = values.data();
+    for (unsigned int p = 0; p < nbDecisions; ++p)
+      {
+      decisions[p] = static_cast<double>(Quantization::Dot(q.Vectors.data() + p * nbFeatures, levels.data(), nbFeatures))
+        * q.VectorScales[p] * q.InputScale - m_Model->rho[p];
+      }
+    }
+  else
+    {
+    // Kernel values first, then the decision values
+    const int nbSV = m_Model->l;
+    values.resize(nbSV + nbDecisions);
+    double * kvalues = values.data();
+    decisions = kvalues + nbSV;
+
+    // Features absent from the support vectors still add to the distances
+    double extraSquaredNorm = 0.;
+    for (unsigned int f = nbQuantized; f < inputSize; ++f)
+      {
+      extraSquaredNorm += static_cast<double>(input[f]) * static_cast<double>(input[f]);
+      }
+
+    const Quantization::AccumulatorType xNorm = Quantization::SquaredNorm(levels.data(), nbFeatures);
+    const double scale2 = q.InputScale * q.InputScale;
+    const double gamma = m_Model->param.gamma;
+    for (int i = 0; i < nbSV; ++i)
+      {
+      const Quantization::AccumulatorType d2 = xNorm + q.SquaredNorms[i]
+        - 2 * Quantization::Dot(q.Vectors.data() + i * nbFeatures, levels.data(), nbFeatures);
+      kvalues[i] = std::exp(-gamma * (static_cast<double>(d2) * scale2 + extraSquaredNorm));
+      }
+
+    if (classification)
+      {
+      unsigned int p = 0;
+      for (int i = 0; i < nrClass; ++i)
+        {
+        for (int j = i + 1; j < nrClass; ++j)
+          {
+          const double * coef1 = m_Model->sv_coef[j - 1];
+          const double * coef2 = m_Model->sv_coef[i];
+          double sum = 0.;
+          for (int k = q.Starts[i]; k < q.Starts[i] + m_Model->nSV[i]; ++k)
+            {
+            sum += coef1[k] * kvalues[k];
+            }
+          for (int k = q.Starts[j]; k < q.Starts[j] + m_Model->nSV[j]; ++k)
+            {
+            sum += coef2[k] * kvalues[k];
+            }
+          decisions[p] = sum - m_Model->rho[p];
+          ++p;
+          }
+        }
+      }
+    else
+      {
+      double sum = 0.;
+      for (int i = 0; i < nbSV; ++i)
+        {
+        sum += m_Model->sv_coef[0][i] * kvalues[i];
+        }
+      decisions[0] = sum - m_Model->rho[0];
+      }
+    }
+
+  TargetSampleType target;
+  target.Fill(0);
+  if (classification)
+    {
+    // One-against-one vote, ties go to the first class as in svm_predict()
+    std::vector<int> votes(nrClass, 0);
+    unsigned int p = 0;
+    for (int i = 0; i < nrClass; ++i)
+      {
+      for (int j = i + 1; j < nrClass; ++j)
+        {
+        ++votes[decisions[p] > 0 ? i : j];
+        ++p;
+        }
+      }
+    const int best = std::max_element(votes.begin(), votes.end()) - votes.begin();
+    target[0] = static_cast<TargetValueType>(m_Model->label[best]);
+    }
+  else if (svmType == ONE_CLASS)
+    {
+    target[0] = static_cast<TargetValueType>(decisions[0] > 0 ? 1 : -1);
+    }
+  else
+    {
+    target[0] = static_cast<TargetValueType>(decisions[0]);
+    }
+  return target;
 }
 
 template <class TInputValue, class TOutputValue>
@@ -321,9 +673,11 @@ LibSVMMachineLearningModel<TInputValue,TOutputValue>
   m_Problem.l = probl;
   m_Problem.y = new double[probl];
   m_Problem.x = new struct svm_node*[probl];
-  for (int i = 0; i < probl; ++i)
+  // All the nodes are allocated in a single block owned by the first sample
+  m_Problem.x[0] = new struct svm_node[probl * (elements+1)];
+  for (int i = 1; i < probl; ++i)
     {
-    m_Problem.x[i] = new struct svm_node[elements+1];
+    m_Problem.x[i] = m_Problem.x[0] + i * (elements+1);
     }
 
   // Iterate on the samples
@@ -392,12 +746,10 @@ LibSVMMachineLearningModel<TInputValue,TOutputValue>
     }
   if (m_Problem.x)
     {
-    for (int i = 0; i < m_Problem.l; ++i)
+    // The first sample owns the nodes of all samples
+    if (m_Problem.l > 0)
       {
-      if (m_Problem.x[i])
-        {
-        delete[] m_Problem.x[i];
-        }
+      delete[] m_Problem.x[0];
       }
     delete[] m_Problem.x;
     m_Problem.x = ITK_NULLPTR;
@@ -495,7 +847,15 @@ LibSVMMachineLearningModel<TInputValue,TOutputValue>
   if (nbParams > 1) initialParameters[1] = this->GetKernelGamma();
   if (nbParams > 2) initialParameters[2] = this->GetKernelCoef0();
 
-  m_InitialCrossValidationAccuracy = crossValidationFunction->GetValue(initialParameters);
+  if (m_ParallelCrossValidation)
+    {
+    std::vector<ParametersType> positions(1, initialParameters);
+    this->ParallelCrossValidation(positions, m_InitialCrossValidationAccuracy);
+    }
+  else
+    {
+    m_InitialCrossValidationAccuracy = crossValidationFunction->GetValue(initialParameters);
+    }
   m_FinalCrossValidationAccuracy = m_InitialCrossValidationAccuracy;
 
   otbMsgDebugMacro(<< "Initial accuracy : " << m_InitialCrossValidationAccuracy
@@ -511,14 +871,27 @@ LibSVMMachineLearningModel<TInputValue,TOutputValue>
     coarseOptimizer->SetNumberOfSteps(coarseNbSteps);
     coarseOptimizer->SetCostFunction(crossValidationFunction);
     coarseOptimizer->SetInitialPosition(initialParameters);
-    coarseOptimizer->StartOptimization();
 
-    coarseBestParameters = coarseOptimizer->GetMaximumMetricValuePosition();
+    if (m_ParallelCrossValidation)
+      {
+      std::vector<ParametersType> positions;
+      coarseOptimizer->GetGridPositions(positions);
+      double coarseAccuracy = 0.;
+      coarseBestParameters = positions[this->ParallelCrossValidation(positions, coarseAccuracy)];
+
+      otbMsgDevMacro( << "Coarse maximum accuracy: " << coarseAccuracy << " " << coarseBestParameters );
+      }
+    else
+      {
+      coarseOptimizer->StartOptimization();
+
+      coarseBestParameters = coarseOptimizer->GetMaximumMetricValuePosition();
 
-    otbMsgDevMacro( << "Coarse minimum accuracy: " << coarseOptimizer->GetMinimumMetricValue() << " " <<
-      coarseOptimizer->GetMinimumMetricValuePosition() );
-    otbMsgDevMacro( << "Coarse maximum accuracy: " << coarseOptimizer->GetMaximumMetricValue() << " " <<
-      coarseOptimizer->GetMaximumMetricValuePosition() );
+      otbMsgDevMacro( << "Coarse minimum accuracy: " << coarseOptimizer->GetMinimumMetricValue() << " " <<
+        coarseOptimizer->GetMinimumMetricValuePosition() );
+      otbMsgDevMacro( << "Coarse maximum accuracy: " << coarseOptimizer->GetMaximumMetricValue() << " " <<
+        coarseOptimizer->GetMaximumMetricValuePosition() );
+      }
 
     typename ExhaustiveExponentialOptimizer::Pointer fineOptimizer = ExhaustiveExponentialOptimizer::New();
     typename ExhaustiveExponentialOptimizer::StepsType fineNbSteps(initialParameters.Size());
@@ -530,16 +903,28 @@ LibSVMMachineLearningModel<TInputValue,TOutputValue>
     fineOptimizer->SetStepLength(stepLength);
     fineOptimizer->SetCostFunction(crossValidationFunction);
     fineOptimizer->SetInitialPosition(coarseBestParameters);
-    fineOptimizer->StartOptimization();
 
-    otbMsgDevMacro(<< "Fine minimum accuracy: " << fineOptimizer->GetMinimumMetricValue() << " " <<
-      fineOptimizer->GetMinimumMetricValuePosition() );
-    otbMsgDevMacro(<< "Fine maximum accuracy: " << fineOptimizer->GetMaximumMetricValue() << " " <<
-      fineOptimizer->GetMaximumMetricValuePosition() );
+    if (m_ParallelCrossValidation)
+      {
+      std::vector<ParametersType> positions;
+      fineOptimizer->GetGridPositions(positions);
+      fineBestParameters = positions[this->ParallelCrossValidation(positions, m_FinalCrossValidationAccuracy)];
+
+      otbMsgDevMacro(<< "Fine maximum accuracy: " << m_FinalCrossValidationAccuracy << " " << fineBestParameters );
+      }
+    else
+      {
+      fineOptimizer->StartOptimization();
+
+      otbMsgDevMacro(<< "Fine minimum accuracy: " << fineOptimizer->GetMinimumMetricValue() << " " <<
+        fineOptimizer->GetMinimumMetricValuePosition() );
+      otbMsgDevMacro(<< "Fine maximum accuracy: " << fineOptimizer->GetMaximumMetricValue() << " " <<
+        fineOptimizer->GetMaximumMetricValuePosition() );
 
-    fineBestParameters = fineOptimizer->GetMaximumMetricValuePosition();
+      fineBestParameters = fineOptimizer->GetMaximumMetricValuePosition();
 
-    m_FinalCrossValidationAccuracy = fineOptimizer->GetMaximumMetricValue();
+      m_FinalCrossValidationAccuracy = fineOptimizer->GetMaximumMetricValue();
+      }
 
     this->SetC(fineBestParameters[0]);
     if (nbParams > 1) this->SetKernelGamma(fineBestParameters[1]);
@@ -547,6 +932,188 @@ LibSVMMachineLearningModel<TInputValue,TOutputValue>
     }
 }
 
+template <class TInputValue, class TOutputValue>
+unsigned int
+LibSVMMachineLearningModel<TInputValue,TOutputValue>
+::ParallelCrossValidation(const std::vector<ParametersType>& positions, double& bestAccuracy)
+{
+  bestAccuracy = 0.;
+  const unsigned int length = m_Problem.l;
+  if (length == 0 || positions.empty())
+    {
+    return 0;
+    }
+
+  const unsigned int nbFolds = std::min(m_CVFolders, length);
+  if (nbFolds < 2)
+    {
+    itkExceptionMacro(<< "Cross validation needs at least 2 folds, got " << nbFolds);
+    }
+
+  // Assign the samples to the folds once, the same folds are used for
+  // every position. Classes are spread evenly across the folds.
+  const bool isClassification = (m_Parameters.svm_type == C_SVC || m_Parameters.svm_type == NU_SVC);
+  std::vector<std::pair<double, unsigned int> > order(length);
+  for (unsigned int i = 0; i < length; ++i)
+    {
+    order[i] = std::make_pair(isClassification ? m_Problem.y[i] : 0., i);
+    }
+  std::sort(order.begin(), order.end());
+
+  CrossValidationGridStruct str;
+  str.Model = this;
+  str.Positions = &positions;
+  str.TestFolds.resize(nbFolds);
+  for (unsigned int j = 0; j < length; ++j)
+    {
+    str.TestFolds[j % nbFolds].push_back(order[j].second);
+    }
+  for (unsigned int f = 0; f < nbFolds; ++f)
+    {
+    std::sort(str.TestFolds[f].begin(), str.TestFolds[f].end());
+    }
+
+  // Training subproblems only hold pointers to the shared samples
+  str.TrainingFolds.resize(nbFolds);
+  str.TrainingTargets.resize(nbFolds);
+  str.TrainingNodes.resize(nbFolds);
+  for (unsigned int f = 0; f < nbFolds; ++f)
+    {
+    const std::vector<unsigned int>& testFold = str.TestFolds[f];
+    str.TrainingTargets[f].reserve(length - testFold.size());
+    str.TrainingNodes[f].reserve(length - testFold.size());
+    std::vector<unsigned int>::const_iterator testIt = testFold.begin();
+    for (unsigned int i = 0; i < length; ++i)
+      {
+      if (testIt != testFold.end() && *testIt == i)
+        {
+        ++testIt;
+        continue;
+        }
+      str.TrainingTargets[f].push_back(m_Problem.y[i]);
+      str.TrainingNodes[f].push_back(m_Problem.x[i]);
+      }
+    str.TrainingFolds[f].l = static_cast<int>(str.TrainingTargets[f].size());
+    str.TrainingFolds[f].y = &(str.TrainingTargets[f][0]);
+    str.TrainingFolds[f].x = &(str.TrainingNodes[f][0]);
+    }
+
+  str.Correct.assign(positions.size(), 0);
+  str.Remaining.assign(positions.size(), length);
+  str.FoldsDone.assign(positions.size(), 0);
+  str.Pruned.assign(positions.size(), false);
+  str.NextTask = 0;
+  str.BestPosition = -1;
+
+  const unsigned long nbTasks = positions.size() * nbFolds;
+  itk::MultiThreader::Pointer threader = itk::MultiThreader::New();
+  threader->SetNumberOfThreads(
+    static_cast<itk::ThreadIdType>(std::min<unsigned long>(threader->GetNumberOfThreads(), nbTasks)));
+  threader->SetSingleMethod(Self::CrossValidationThreaderCallback, &str);
+  threader->SingleMethodExecute();
+
+  unsigned long nbPruned = std::count(str.Pruned.begin(), str.Pruned.end(), true);
+  otbMsgDevMacro(<< "Cross validation of " << positions.size() << " positions, "
+                 << nbPruned << " dropped before the last fold");
+
+  const unsigned int best = static_cast<unsigned int>(str.BestPosition);
+  bestAccuracy = static_cast<double>(str.Correct[best]) / length;
+  return best;
+}
+
+template <class TInputValue, class TOutputValue>
+ITK_THREAD_RETURN_TYPE
+LibSVMMachineLearningModel<TInputValue,TOutputValue>
+::CrossValidationThreaderCallback(void *arg)
+{
+  CrossValidationGridStruct *str = (CrossValidationGridStruct*)(((itk::MultiThreader::ThreadInfoStruct *)(arg))->UserData);
+  const struct svm_problem& problem = str->Model->m_Problem;
+  const unsigned int nbFolds = str->TestFolds.size();
+  const unsigned long nbTasks = str->Positions->size() * nbFolds;
+
+  while (true)
+    {
+    // Pick the next fold to train, in grid order, skipping the positions
+    // that cannot beat the best accuracy even if all their untested
+    // samples were predicted right. Ties go to the first position, as in
+    // ExhaustiveExponentialOptimizer.
+    bool found = false;
+    unsigned long task = 0;
+    str->Mutex.Lock();
+    while (str->NextTask < nbTasks)
+      {
+      const unsigned int pos = str->NextTask / nbFolds;
+      if (!str->Pruned[pos] && str->BestPosition >= 0)
+        {
+        const unsigned long reachable = str->Correct[pos] + str->Remaining[pos];
+        const unsigned long best = str->Correct[str->BestPosition];
+        if (reachable < best || (reachable == best && static_cast<long>(pos) > str->BestPosition))
+          {
+          str->Pruned[pos] = true;
+          }
+        }
+      if (str->Pruned[pos])
+        {
+        str->NextTask = (pos + 1) * static_cast<unsigned long>(nbFolds);
+        continue;
+        }
+      task = str->NextTask++;
+      found = true;
+      break;
+      }
+    str->Mutex.Unlock();
+
+    if (!found)
+      {
+      break;
+      }
+
+    const unsigned int pos = task / nbFolds;
+    const unsigned int fold = task % nbFolds;
+    const ParametersType& position = (*str->Positions)[pos];
+    const std::vector<unsigned int>& testFold = str->TestFolds[fold];
+
+    // Same convention as SVMCrossValidationCostFunction for a non-positive C
+    unsigned long correct = 0;
+    if (position[0] > 0)
+      {
+      struct svm_parameter parameters = str->Model->m_Parameters;
+      parameters.C = position[0];
+      if (position.Size() > 1) parameters.gamma = position[1];
+      if (position.Size() > 2) parameters.coef0 = position[2];
+      // Predict with the decision function only, so that the scores do not
+      // depend on the order in which the threads draw random numbers
+      parameters.probability = 0;
+
+      struct svm_model* model = svm_train(&(str->TrainingFolds[fold]), &parameters);
+      for (unsigned int i = 0; i < testFold.size(); ++i)
+        {
+        if (svm_predict(model, problem.x[testFold[i]]) == problem.y[testFold[i]])
+          {
+          ++correct;
+          }
+        }
+      svm_free_and_destroy_model(&model);
+      }
+
+    str->Mutex.Lock();
+    str->Correct[pos] += correct;
+    str->Remaining[pos] -= testFold.size();
+    if (++(str->FoldsDone[pos]) == nbFolds && !str->Pruned[pos])
+      {
+      if (str->BestPosition < 0
+          || str->Correct[pos] > str->Correct[str->BestPosition]
+          || (str->Correct[pos] == str->Correct[str->BestPosition] && static_cast<long>(pos) < str->BestPosition))
+        {
+        str->BestPosition = pos;
+        }
+      }
+    str->Mutex.Unlock();
+    }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
 } //end namespace otb
 
 #endif
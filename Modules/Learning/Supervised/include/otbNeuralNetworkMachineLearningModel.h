@@ -27,6 +27,7 @@
 #include "itkLightObject.h"
 #include "itkFixedArray.h"
 #include "otbMachineLearningModel.h"
+#include "otbQuantizationUtils.h"
 
 namespace otb
 {
@@ -152,6 +153,14 @@ public:
   itkGetMacro(Epsilon, double);
   itkSetMacro(Epsilon, double);
 
+  /** Predict from int16 quantized activations and weights. The layers
+   *  are quantized with one scale per neuron, and the activations with
+   *  the range of the activation function. The inputs are quantized
+   *  after the input scaling of the network, which standardizes them
+   *  with the statistics of the training samples. Only the SIGMOID_SYM
+   *  and GAUSSIAN activation functions are supported. */
+  void SetQuantizedInference(bool flag) ITK_OVERRIDE;
+
   /** Train the machine learning model */
   void Train() ITK_OVERRIDE;
 
@@ -179,6 +188,10 @@ protected:
 
   /** Predict values using the model */
   TargetSampleType DoPredict(const InputSampleType& input, ConfidenceValueType *quality=ITK_NULLPTR) const ITK_OVERRIDE;
+
+  /** Predict values for a range of samples, converted at once to a
+   *  matrix handed to the OpenCV batch prediction */
+  void DoPredictBatch(const InputListSampleType *, const unsigned int & startIndex, const unsigned int & size, TargetListSampleType *, ConfidenceListSampleType * = ITK_NULLPTR) const ITK_OVERRIDE;
   
   void LabelsToMat(const TargetListSampleType * listSample, cv::Mat & output);
 
@@ -189,6 +202,46 @@ private:
   NeuralNetworkMachineLearningModel(const Self &); //purposely not implemented
   void operator =(const Self&); //purposely not implemented
 
+  /** Compute the target (and the confidence if quality is not null) from
+   *  the output layer responses to a sample */
+  TargetSampleType ResponseToTarget(const float * response, ConfidenceValueType *quality) const;
+
+  /** Quantized layer of the network */
+  struct QuantizedLayerStruct
+  {
+    unsigned int                          InputSize;
+    unsigned int                          OutputSize;
+    /** Weights of each neuron, OutputSize rows of InputSize levels */
+    std::vector<Quantization::LevelType>  Weights;
+    /** Scale of the weights of each neuron */
+    std::vector<double>                   WeightScales;
+    std::vector<double>                   Bias;
+    /** Scale of the activation levels feeding the layer */
+    double                                InputScale;
+  };
+
+  /** Build the quantized network from m_ANNModel */
+  void BuildQuantizedNetwork();
+
+  /** Output layer responses of the quantized network to a sample. The
+   *  levels and values buffers are resized as needed. */
+  void PredictQuantized(const InputSampleType & input,
+                        std::vector<Quantization::LevelType> & levels,
+                        std::vector<double> & values,
+                        std::vector<float> & response) const;
+
+  /** Range of the standardized inputs covered by the levels */
+  static const double QuantizedInputRange;
+
+  std::vector<QuantizedLayerStruct> m_QuantizedLayers;
+  /** (scale, shift) pairs of the input and output scalings of the network */
+  std::vector<double> m_QuantizedInputScaling;
+  std::vector<double> m_QuantizedOutputScaling;
+  /** Activation function and parameters read back from the network */
+  int    m_QuantizedActivateFunction;
+  double m_QuantizedAlpha;
+  double m_QuantizedBeta;
+
   void CreateNetwork();
   void SetupNetworkAndTrain(cv::Mat& labels);
 #ifdef OTB_OPENCV_3
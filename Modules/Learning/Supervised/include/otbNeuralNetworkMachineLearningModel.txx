@@ -22,12 +22,16 @@
 #define otbNeuralNetworkMachineLearningModel_txx
 
 #include <fstream>
+#include <cmath>
 #include "otbNeuralNetworkMachineLearningModel.h"
 #include "itkMacro.h" // itkExceptionMacro
 
 namespace otb
 {
 
+template<class TInputValue, class TOutputValue>
+const double NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::QuantizedInputRange = 8.;
+
 template<class TInputValue, class TOutputValue>
 NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::NeuralNetworkMachineLearningModel() :
 #ifdef OTB_OPENCV_3
@@ -51,6 +55,10 @@ NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::NeuralNetworkMachi
 {
   this->m_ConfidenceIndex = true;
   this->m_IsRegressionSupported = true;
+  this->m_IsQuantizedInferenceSupported = true;
+  m_QuantizedActivateFunction = CvANN_MLP::SIGMOID_SYM;
+  m_QuantizedAlpha = 0.;
+  m_QuantizedBeta = 0.;
 }
 
 template<class TInputValue, class TOutputValue>
@@ -230,13 +238,169 @@ void NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::Train()
     LabelsToMat(this->GetTargetListSample(), matOutputANN);
     }
   this->SetupNetworkAndTrain(matOutputANN);
+
+  if (this->m_QuantizedInference)
+    {
+    this->BuildQuantizedNetwork();
+    }
+}
+
+template<class TInputValue, class TOutputValue>
+void NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::SetQuantizedInference(bool flag)
+{
+  const bool build = flag && !this->m_QuantizedInference;
+  Superclass::SetQuantizedInference(flag);
+#ifdef OTB_OPENCV_3
+  const bool trained = m_ANNModel->isTrained();
+#else
+  const bool trained = m_ANNModel->get_layer_count() > 0;
+#endif
+  if (build && trained)
+    {
+    this->BuildQuantizedNetwork();
+    }
+}
+
+template<class TInputValue, class TOutputValue>
+void NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::BuildQuantizedNetwork()
+{
+  // The weights and the activation function are read back from the
+  // serialization of the network, which has the same layout for all the
+  // OpenCV versions
+  cv::FileStorage wfs(".xml", cv::FileStorage::WRITE + cv::FileStorage::MEMORY);
+#ifdef OTB_OPENCV_3
+  wfs << "nn" << "{";
+  m_ANNModel->write(wfs);
+  wfs << "}";
+#else
+  m_ANNModel->write(*wfs, "nn");
+#endif
+  const std::string buffer = wfs.releaseAndGetString();
+  cv::FileStorage fs(buffer, cv::FileStorage::READ + cv::FileStorage::MEMORY);
+  cv::FileNode node = fs["nn"];
+
+  const std::string activation = (std::string) node["activation_function"];
+  if (activation == "SIGMOID_SYM")
+    {
+    m_QuantizedActivateFunction = CvANN_MLP::SIGMOID_SYM;
+    }
+  else if (activation == "GAUSSIAN")
+    {
+    m_QuantizedActivateFunction = CvANN_MLP::GAUSSIAN;
+    }
+  else
+    {
+    itkExceptionMacro(<< "Quantized inference is not available for the activation function " << activation);
+    }
+  m_QuantizedAlpha = (double) node["f_param1"];
+  m_QuantizedBeta = (double) node["f_param2"];
+
+  cv::Mat layerSizes;
+  node["layer_sizes"] >> layerSizes;
+  const unsigned int nbLayers = layerSizes.total();
+
+  node["input_scale"] >> m_QuantizedInputScaling;
+  node["output_scale"] >> m_QuantizedOutputScaling;
+
+  m_QuantizedLayers.clear();
+  cv::FileNodeIterator weightsIt = node["weights"].begin();
+  for (unsigned int l = 1; l < nbLayers; ++l, ++weightsIt)
+    {
+    std::vector<double> weights;
+    (*weightsIt) >> weights;
+
+    QuantizedLayerStruct layer;
+    layer.InputSize = layerSizes.at<int>(l - 1);
+    layer.OutputSize = layerSizes.at<int>(l);
+    if (weights.size() != (layer.InputSize + 1) * layer.OutputSize)
+      {
+      itkExceptionMacro(<< "Unexpected number of weights in layer " << l);
+      }
+
+    // The first layer is fed with standardized inputs, the next ones
+    // with activations bounded by beta
+    layer.InputScale = Quantization::ComputeScale(l == 1 ? QuantizedInputRange : std::abs(m_QuantizedBeta));
+
+    // OpenCV stores one row per input, the bias being the last row :
+    // gather the weights of each neuron
+    layer.Weights.resize(layer.InputSize * layer.OutputSize);
+    std::vector<double> neuron(layer.InputSize);
+    for (unsigned int k = 0; k < layer.OutputSize; ++k)
+      {
+      for (unsigned int i = 0; i < layer.InputSize; ++i)
+        {
+        neuron[i] = weights[i * layer.OutputSize + k];
+        }
+      const double scale = Quantization::ComputeScale(Quantization::MaxAbs(neuron.data(), layer.InputSize));
+      Quantization::Quantize(neuron.data(), layer.InputSize, scale, layer.Weights.data() + k * layer.InputSize);
+      layer.WeightScales.push_back(scale);
+      layer.Bias.push_back(weights[layer.InputSize * layer.OutputSize + k]);
+      }
+    m_QuantizedLayers.push_back(layer);
+    }
+  fs.release();
+}
+
+template<class TInputValue, class TOutputValue>
+void NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>
+::PredictQuantized(const InputSampleType & input,
+                   std::vector<Quantization::LevelType> & levels,
+                   std::vector<double> & values,
+                   std::vector<float> & response) const
+{
+  // Input scaling of the network
+  const unsigned int nbInputs = m_QuantizedLayers.front().InputSize;
+  values.resize(nbInputs);
+  for (unsigned int i = 0; i < nbInputs; ++i)
+    {
+    values[i] = static_cast<double>(input[i]) * m_QuantizedInputScaling[2 * i] + m_QuantizedInputScaling[2 * i + 1];
+    }
+
+  for (unsigned int l = 0; l < m_QuantizedLayers.size(); ++l)
+    {
+    const QuantizedLayerStruct & layer = m_QuantizedLayers[l];
+    levels.resize(layer.InputSize);
+    Quantization::Quantize(values.data(), layer.InputSize, layer.InputScale, levels.data());
+
+    values.resize(layer.OutputSize);
+    for (unsigned int k = 0; k < layer.OutputSize; ++k)
+      {
+      const double x = static_cast<double>(Quantization::Dot(layer.Weights.data() + k * layer.InputSize, levels.data(), layer.InputSize))
+        * layer.WeightScales[k] * layer.InputScale + layer.Bias[k];
+      // Same activation functions as OpenCV, the symmetrical sigmoid
+      // being written with tanh
+      if (m_QuantizedActivateFunction == CvANN_MLP::SIGMOID_SYM)
+        {
+        values[k] = m_QuantizedBeta * std::tanh(0.5 * m_QuantizedAlpha * x);
+        }
+      else
+        {
+        values[k] = m_QuantizedBeta * std::exp(-m_QuantizedAlpha * m_QuantizedAlpha * x * x);
+        }
+      }
+    }
+
+  // Output scaling of the network
+  response.resize(values.size());
+  for (unsigned int k = 0; k < values.size(); ++k)
+    {
+    response[k] = static_cast<float>(values[k] * m_QuantizedOutputScaling[2 * k] + m_QuantizedOutputScaling[2 * k + 1]);
+    }
 }
 
 template<class TInputValue, class TOutputValue>
 typename NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::TargetSampleType NeuralNetworkMachineLearningModel<
   TInputValue, TOutputValue>::DoPredict(const InputSampleType & input, ConfidenceValueType *quality) const
 {
-  TargetSampleType target;
+  if (this->m_QuantizedInference)
+    {
+    std::vector<Quantization::LevelType> levels;
+    std::vector<double> values;
+    std::vector<float> response;
+    this->PredictQuantized(input, levels, values, response);
+    return this->ResponseToTarget(response.data(), quality);
+    }
+
   //convert listsample to Mat
   cv::Mat sample;
 
@@ -245,8 +409,17 @@ typename NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::TargetSam
   cv::Mat response; //(1, 1, CV_32FC1);
   m_ANNModel->predict(sample, response);
 
+  return this->ResponseToTarget(response.ptr<float>(0), quality);
+}
+
+template<class TInputValue, class TOutputValue>
+typename NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::TargetSampleType NeuralNetworkMachineLearningModel<
+  TInputValue, TOutputValue>::ResponseToTarget(const float * response, ConfidenceValueType *quality) const
+{
+  TargetSampleType target;
+
   float currentResponse = 0;
-  float maxResponse = response.at<float> (0, 0);
+  float maxResponse = response[0];
 
   if (this->m_RegressionMode)
     {
@@ -262,7 +435,7 @@ typename NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::TargetSam
   unsigned int nbClasses = m_CvMatOfLabels->cols;
   for (unsigned itLabel = 1; itLabel < nbClasses; ++itLabel)
     {
-    currentResponse = response.at<float> (0, itLabel);
+    currentResponse = response[itLabel];
     if (currentResponse > maxResponse)
       {
       secondResponse = maxResponse;
@@ -285,6 +458,62 @@ typename NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::TargetSam
   return target;
 }
 
+template<class TInputValue, class TOutputValue>
+void NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>
+::DoPredictBatch(const InputListSampleType * input, const unsigned int & startIndex, const unsigned int & size, TargetListSampleType * targets, ConfidenceListSampleType * quality) const
+{
+  this->CheckPredictBatchArguments(input, startIndex, size, targets, quality);
+
+  if(size == 0)
+    {
+    return;
+    }
+
+  if (this->m_QuantizedInference)
+    {
+    std::vector<Quantization::LevelType> levels;
+    std::vector<double> values;
+    std::vector<float> response;
+    for(unsigned int i = 0; i < size; ++i)
+      {
+      this->PredictQuantized(input->GetMeasurementVector(startIndex + i), levels, values, response);
+      ConfidenceValueType confidence = 0;
+      targets->SetMeasurementVector(startIndex + i,
+        this->ResponseToTarget(response.data(), quality != ITK_NULLPTR ? &confidence : ITK_NULLPTR));
+      if (quality != ITK_NULLPTR)
+        {
+        ConfidenceSampleType confidenceSample;
+        confidenceSample[0] = confidence;
+        quality->SetMeasurementVector(startIndex + i, confidenceSample);
+        }
+      }
+    return;
+    }
+
+  // Convert the whole range of samples at once
+  cv::Mat samples;
+  otb::ListSampleRangeToMat(input, startIndex, size, samples);
+
+  // One row of output layer responses per sample
+  cv::Mat responses;
+  m_ANNModel->predict(samples, responses);
+
+  for(unsigned int i = 0; i < size; ++i)
+    {
+    ConfidenceValueType confidence = 0;
+    const TargetSampleType target =
+      this->ResponseToTarget(responses.ptr<float>(i), quality != ITK_NULLPTR ? &confidence : ITK_NULLPTR);
+    targets->SetMeasurementVector(startIndex + i, target);
+
+    if (quality != ITK_NULLPTR)
+      {
+      ConfidenceSampleType confidenceSample;
+      confidenceSample[0] = confidence;
+      quality->SetMeasurementVector(startIndex + i, confidenceSample);
+      }
+    }
+}
+
 template<class TInputValue, class TOutputValue>
 void NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::Save(const std::string & filename,
                                                                         const std::string & name)
@@ -358,6 +587,11 @@ void NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::Load(const st
 
   fs.release();
 #endif
+
+  if (this->m_QuantizedInference)
+    {
+    this->BuildQuantizedNetwork();
+    }
 }
 
 template<class TInputValue, class TOutputValue>
@@ -110,6 +110,42 @@ NormalBayesMachineLearningModel<TInputValue,TOutputValue>
   return target;
 }
 
+template <class TInputValue, class TOutputValue>
+void
+NormalBayesMachineLearningModel<TInputValue,TOutputValue>
+::DoPredictBatch(const InputListSampleType * input, const unsigned int & startIndex, const unsigned int & size, TargetListSampleType * targets, ConfidenceListSampleType * quality) const
+{
+  this->CheckPredictBatchArguments(input, startIndex, size, targets, quality);
+
+  if (quality != ITK_NULLPTR && !this->HasConfidenceIndex())
+    {
+    itkExceptionMacro("Confidence index not available for this classifier !");
+    }
+
+  if(size == 0)
+    {
+    return;
+    }
+
+  // Convert the whole range of samples at once
+  cv::Mat samples;
+  otb::ListSampleRangeToMat(input, startIndex, size, samples);
+
+  cv::Mat results;
+#ifdef OTB_OPENCV_3
+  m_NormalBayesModel->predict(samples, results);
+#else
+  m_NormalBayesModel->predict(samples, &results);
+#endif
+
+  for(unsigned int i = 0; i < size; ++i)
+    {
+    TargetSampleType target;
+    target[0] = static_cast<TOutputValue>(results.at<float>(i));
+    targets->SetMeasurementVector(startIndex + i, target);
+    }
+}
+
 template <class TInputValue, class TOutputValue>
 void
 NormalBayesMachineLearningModel<TInputValue,TOutputValue>
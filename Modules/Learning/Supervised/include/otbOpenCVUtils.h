@@ -46,6 +46,9 @@
 #include "OTBSupervisedExport.h"
 
 #include "itkListSample.h"
+#include "otbContiguousListSample.h"
+
+#include <type_traits>
 
 #ifdef OTB_OPENCV_3
 #define CV_TYPE_NAME_ML_SVM         "opencv-ml-svm"
@@ -93,12 +96,24 @@ namespace otb
        // Retrieve samples count
        unsigned int sampleCount = listSample->Size();
 
-       // Build an iterator
-       typename T::ConstIterator sampleIt = listSample->Begin();
-
        // Retrieve samples size alike
        const unsigned int sampleSize = listSample->GetMeasurementVectorSize();
 
+       // Float samples stored in a single buffer (see ContiguousListSample)
+       // are viewed without copy: the matrix is only valid as long as
+       // the list sample is
+       typedef typename T::MeasurementVectorType::ValueType ValueType;
+       const ValueType * data = GetContiguousSampleData(listSample);
+       if(std::is_same<ValueType, float>::value && data != ITK_NULLPTR)
+         {
+         output = cv::Mat(sampleCount, sampleSize, CV_32FC1,
+                          const_cast<void *>(static_cast<const void *>(data)));
+         return;
+         }
+
+       // Build an iterator
+       typename T::ConstIterator sampleIt = listSample->Begin();
+
        // Allocate CvMat
        output.create(sampleCount,sampleSize,CV_32FC1);
 
@@ -117,6 +132,25 @@ namespace otb
       }
   }
 
+  /** Converts the samples [startIndex, startIndex+size[ of a ListSample
+   *  to the rows of a CV_32FC1 matrix, allocated once.
+   */
+  template <class T> void ListSampleRangeToMat(const T * listSample, unsigned int startIndex,
+                                               unsigned int size, cv::Mat & output) {
+    const unsigned int sampleSize = listSample->GetMeasurementVectorSize();
+    output.create(size,sampleSize,CV_32FC1);
+
+    for(unsigned int sampleIdx = 0; sampleIdx < size; ++sampleIdx)
+      {
+      const typename T::MeasurementVectorType & sample = listSample->GetMeasurementVector(startIndex + sampleIdx);
+      float * row = output.ptr<float>(sampleIdx);
+      for(unsigned int i = 0; i < sampleSize; ++i)
+        {
+        row[i] = static_cast<float>(sample[i]);
+        }
+      }
+  }
+
   template <typename T> void ListSampleToMat(typename T::Pointer listSample, cv::Mat & output) {
     return ListSampleToMat(listSample.GetPointer(), output);
   }
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbQuantizationUtils_h
+#define otbQuantizationUtils_h
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+namespace otb
+{
+/** \namespace Quantization
+ * \brief Helpers for the quantized inference of the machine learning models
+ *
+ * Values are stored as int16 levels : value = scale * level, with
+ * levels saturated to [-MaxLevel, MaxLevel]. Dot products of levels are
+ * accumulated exactly in 64 bits integers. The loops are kept simple so
+ * that the compiler can vectorize them.
+ *
+ * \ingroup OTBSupervised
+ */
+namespace Quantization
+{
+
+typedef short     LevelType;
+typedef long long AccumulatorType;
+
+static const int MaxLevel = 32767;
+
+/** Scale mapping [-maxAbs, maxAbs] on the full range of levels */
+inline double ComputeScale(double maxAbs)
+{
+  return maxAbs > 0. ? maxAbs / static_cast<double>(MaxLevel) : 1.;
+}
+
+/** Largest absolute value of a buffer */
+template <class T>
+inline double MaxAbs(const T * values, unsigned int size)
+{
+  double maxAbs = 0.;
+  for (unsigned int i = 0; i < size; ++i)
+    {
+    maxAbs = std::max(maxAbs, std::abs(static_cast<double>(values[i])));
+    }
+  return maxAbs;
+}
+
+/** Quantize size values with the given scale, saturating out of range values */
+template <class T>
+inline void Quantize(const T * values, unsigned int size, double scale, LevelType * levels)
+{
+  const double invScale = 1. / scale;
+  for (unsigned int i = 0; i < size; ++i)
+    {
+    double level = std::floor(static_cast<double>(values[i]) * invScale + 0.5);
+    level = std::min(std::max(level, static_cast<double>(-MaxLevel)), static_cast<double>(MaxLevel));
+    levels[i] = static_cast<LevelType>(level);
+    }
+}
+
+/** Exact dot product of two vectors of levels */
+inline AccumulatorType Dot(const LevelType * a, const LevelType * b, unsigned int size)
+{
+  AccumulatorType sum = 0;
+  for (unsigned int i = 0; i < size; ++i)
+    {
+    sum += static_cast<int>(a[i]) * static_cast<int>(b[i]);
+    }
+  return sum;
+}
+
+/** Exact squared norm of a vector of levels */
+inline AccumulatorType SquaredNorm(const LevelType * a, unsigned int size)
+{
+  return Dot(a, a, size);
+}
+
+} // end namespace Quantization
+} // end namespace otb
+
+#endif
@@ -28,6 +28,7 @@
 #include "otbMachineLearningModel.h"
 #include "itkVariableSizeMatrix.h"
 #include "otbCvRTreesWrapper.h"
+#include "otbFlatForest.h"
 
 class CvRTreesWrapper;
 
@@ -125,6 +126,14 @@ public:
   itkGetMacro(ComputeMargin, bool);
   itkSetMacro(ComputeMargin, bool);
 
+  /** Use a flat copy of the forest (see FlatForest) in batch
+   * predictions instead of the OpenCV trees. The copy is made when the
+   * forest is trained or loaded. Forests with categorical splits keep
+   * using OpenCV. */
+  void SetFlatForestInference(bool flag);
+  itkGetMacro(FlatForestInference, bool);
+  itkBooleanMacro(FlatForestInference);
+
   /** Returns a matrix containing variable importance */
   VariableImportanceMatrixType GetVariableImportance();
   
@@ -140,6 +149,10 @@ protected:
   /** Predict values using the model */
   TargetSampleType DoPredict(const InputSampleType& input, ConfidenceValueType *quality=ITK_NULLPTR) const ITK_OVERRIDE;
 
+  /** Predict values for a range of samples, converted at once to a
+   *  matrix handed to the OpenCV batch prediction */
+  void DoPredictBatch(const InputListSampleType *, const unsigned int & startIndex, const unsigned int & size, TargetListSampleType *, ConfidenceListSampleType * = ITK_NULLPTR) const ITK_OVERRIDE;
+
   
   /** PrintSelf method */
   void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
@@ -154,6 +167,9 @@ private:
   RandomForestsMachineLearningModel(const Self &); //purposely not implemented
   void operator =(const Self&); //purposely not implemented
 
+  /** Copy the OpenCV forest into m_FlatForest */
+  void BuildFlatForest();
+
 #ifdef OTB_OPENCV_3
   cv::Ptr<CvRTreesWrapper> m_RFModel;
 #else
@@ -222,6 +238,14 @@ private:
    * 2 most voted classes) instead of confidence (probability of the most
    * voted class) in prediction*/
   bool m_ComputeMargin;
+  /** Whether batch predictions go through m_FlatForest */
+  bool m_FlatForestInference;
+  /** Flat copy of the forest, empty when not available */
+  FlatForest m_FlatForest;
+  /** Class labels indexed by the outputs of m_FlatForest */
+  std::vector<double> m_FlatForestLabels;
+  /** Whether m_FlatForest is a regression forest */
+  bool m_FlatForestRegression;
 };
 } // end namespace otb
 
@@ -22,6 +22,7 @@
 #define otbRandomForestsMachineLearningModel_txx
 
 #include <fstream>
+#include <algorithm>
 #include "itkMacro.h"
 #include "otbRandomForestsMachineLearningModel.h"
 #include "otbOpenCVUtils.h"
@@ -47,7 +48,9 @@ RandomForestsMachineLearningModel<TInputValue,TOutputValue>
   m_MaxNumberOfTrees(100),
   m_ForestAccuracy(0.01),
   m_TerminationCriteria(CV_TERMCRIT_ITER | CV_TERMCRIT_EPS), // identic for v3 ?
-  m_ComputeMargin(false)
+  m_ComputeMargin(false),
+  m_FlatForestInference(false),
+  m_FlatForestRegression(false)
 {
   this->m_ConfidenceIndex = true;
   this->m_IsRegressionSupported = true;
@@ -165,6 +168,164 @@ RandomForestsMachineLearningModel<TInputValue,TOutputValue>
   m_RFModel->train(samples, CV_ROW_SAMPLE, labels,
                    cv::Mat(), cv::Mat(), var_type, cv::Mat(), params);
 #endif
+
+  this->BuildFlatForest();
+}
+
+template <class TInputValue, class TOutputValue>
+void
+RandomForestsMachineLearningModel<TInputValue,TOutputValue>
+::SetFlatForestInference(bool flag)
+{
+  if (flag != m_FlatForestInference)
+    {
+    m_FlatForestInference = flag;
+    this->BuildFlatForest();
+    this->Modified();
+    }
+}
+
+template <class TInputValue, class TOutputValue>
+void
+RandomForestsMachineLearningModel<TInputValue,TOutputValue>
+::BuildFlatForest()
+{
+  m_FlatForest.Clear();
+  m_FlatForestLabels.clear();
+
+  if (!m_FlatForestInference)
+    {
+    return;
+    }
+
+#ifdef OTB_OPENCV_3
+  if (!m_RFModel->isTrained())
+    {
+    return;
+    }
+  m_FlatForestRegression = !m_RFModel->isClassifier();
+  if (m_FlatForestRegression)
+    {
+    m_FlatForest.SetNumberOfOutputs(1);
+    }
+
+  const std::vector<cv::ml::DTrees::Node> & nodes = m_RFModel->getNodes();
+  const std::vector<cv::ml::DTrees::Split> & splits = m_RFModel->getSplits();
+  const std::vector<int> & roots = m_RFModel->getRoots();
+
+  // (OpenCV node, flat node) pairs still to copy
+  std::vector<std::pair<int, unsigned int> > pending;
+
+  for (unsigned int t = 0; t < roots.size(); ++t)
+    {
+    pending.push_back(std::make_pair(roots[t], m_FlatForest.AddTree()));
+
+    while (!pending.empty())
+      {
+      const cv::ml::DTrees::Node & node = nodes[pending.back().first];
+      const unsigned int flatNode = pending.back().second;
+      pending.pop_back();
+
+      if (node.split < 0)
+        {
+        if (m_FlatForestRegression)
+          {
+          m_FlatForest.SetLeaf(flatNode, &node.value);
+          }
+        else
+          {
+          const unsigned int classIdx = static_cast<unsigned int>(node.classIdx);
+          if (classIdx >= m_FlatForestLabels.size())
+            {
+            m_FlatForestLabels.resize(classIdx + 1, 0.);
+            }
+          m_FlatForestLabels[classIdx] = node.value;
+          m_FlatForest.SetLeaf(flatNode, classIdx);
+          }
+        continue;
+        }
+
+      const cv::ml::DTrees::Split & split = splits[node.split];
+      if (split.subsetOfs >= 0)
+        {
+        itkWarningMacro(<< "Categorical splits can not be flattened, batch predictions will use OpenCV");
+        m_FlatForest.Clear();
+        m_FlatForestLabels.clear();
+        return;
+        }
+      // Same traversal as CvRTreesWrapper::get_votes()
+      const unsigned int left = m_FlatForest.SetSplit(flatNode, split.varIdx, split.c);
+      pending.push_back(std::make_pair(node.left, left));
+      pending.push_back(std::make_pair(node.right, left + 1));
+      }
+    }
+#else
+  const int nbTrees = m_RFModel->get_tree_count();
+  if (nbTrees == 0)
+    {
+    return;
+    }
+  const CvDTreeTrainData * data = m_RFModel->get_tree(0)->get_data();
+  m_FlatForestRegression = !data->is_classifier;
+  if (m_FlatForestRegression)
+    {
+    m_FlatForest.SetNumberOfOutputs(1);
+    }
+
+  // (OpenCV node, flat node) pairs still to copy
+  std::vector<std::pair<const CvDTreeNode *, unsigned int> > pending;
+
+  for (int t = 0; t < nbTrees; ++t)
+    {
+    pending.push_back(std::make_pair(m_RFModel->get_tree(t)->get_root(), m_FlatForest.AddTree()));
+
+    while (!pending.empty())
+      {
+      const CvDTreeNode * node = pending.back().first;
+      const unsigned int flatNode = pending.back().second;
+      pending.pop_back();
+
+      if (node->left == ITK_NULLPTR)
+        {
+        if (m_FlatForestRegression)
+          {
+          m_FlatForest.SetLeaf(flatNode, &node->value);
+          }
+        else
+          {
+          const unsigned int classIdx = static_cast<unsigned int>(node->class_idx);
+          if (classIdx >= m_FlatForestLabels.size())
+            {
+            m_FlatForestLabels.resize(classIdx + 1, 0.);
+            }
+          m_FlatForestLabels[classIdx] = node->value;
+          m_FlatForest.SetLeaf(flatNode, classIdx);
+          }
+        continue;
+        }
+
+      // Surrogate splits are only used for missing values, which batch
+      // predictions do not handle
+      const CvDTreeSplit * split = node->split;
+      if (data->var_type->data.i[split->var_idx] >= 0)
+        {
+        itkWarningMacro(<< "Categorical splits can not be flattened, batch predictions will use OpenCV");
+        m_FlatForest.Clear();
+        m_FlatForestLabels.clear();
+        return;
+        }
+      // Same traversal as CvDTree::predict()
+      const unsigned int left = m_FlatForest.SetSplit(flatNode, split->var_idx, split->ord.c);
+      pending.push_back(std::make_pair(node->left, split->inversed ? left + 1 : left));
+      pending.push_back(std::make_pair(node->right, split->inversed ? left : left + 1));
+      }
+    }
+#endif
+
+  if (!m_FlatForestRegression)
+    {
+    m_FlatForest.SetNumberOfOutputs(std::max<unsigned int>(m_FlatForestLabels.size(), 1));
+    }
 }
 
 template <class TInputValue, class TOutputValue>
@@ -193,6 +354,102 @@ RandomForestsMachineLearningModel<TInputValue,TOutputValue>
   return target[0];
 }
 
+template <class TInputValue, class TOutputValue>
+void
+RandomForestsMachineLearningModel<TInputValue,TOutputValue>
+::DoPredictBatch(const InputListSampleType * input, const unsigned int & startIndex, const unsigned int & size, TargetListSampleType * targets, ConfidenceListSampleType * quality) const
+{
+  this->CheckPredictBatchArguments(input, startIndex, size, targets, quality);
+
+  if(size == 0)
+    {
+    return;
+    }
+
+  // Convert the whole range of samples at once
+  cv::Mat samples;
+  otb::ListSampleRangeToMat(input, startIndex, size, samples);
+
+  // OpenCV has no confidence for regression forests
+  if (!m_FlatForest.IsEmpty() && (!m_FlatForestRegression || quality == ITK_NULLPTR))
+    {
+    const unsigned int nbOutputs = m_FlatForest.GetNumberOfOutputs();
+    const double nbTrees = m_FlatForest.GetNumberOfTrees();
+    std::vector<double> sums(static_cast<size_t>(size) * nbOutputs, 0.);
+    m_FlatForest.Accumulate(samples.ptr<float>(), size, samples.cols, &sums[0]);
+
+    for(unsigned int i = 0; i < size; ++i)
+      {
+      const double * votes = &sums[static_cast<size_t>(i) * nbOutputs];
+      TargetSampleType target;
+      if (m_FlatForestRegression)
+        {
+        target[0] = static_cast<TOutputValue>(votes[0] / nbTrees);
+        targets->SetMeasurementVector(startIndex + i, target);
+        continue;
+        }
+
+      // Most voted class, ties going to the lowest class index as in OpenCV
+      unsigned int best = 0;
+      double second = 0.;
+      for (unsigned int k = 1; k < nbOutputs; ++k)
+        {
+        if (votes[k] > votes[best])
+          {
+          second = votes[best];
+          best = k;
+          }
+        else if (votes[k] > second)
+          {
+          second = votes[k];
+          }
+        }
+      target[0] = static_cast<TOutputValue>(m_FlatForestLabels[best]);
+      targets->SetMeasurementVector(startIndex + i, target);
+
+      if (quality != ITK_NULLPTR)
+        {
+        ConfidenceSampleType confidence;
+        if(m_ComputeMargin)
+          confidence[0] = static_cast<float>((votes[best] - second) / nbTrees);
+        else
+          confidence[0] = static_cast<float>(votes[best] / nbTrees);
+        quality->SetMeasurementVector(startIndex + i, confidence);
+        }
+      }
+    return;
+    }
+
+#ifdef OTB_OPENCV_3
+  cv::Mat results;
+  m_RFModel->predict(samples, results);
+#endif
+
+  for(unsigned int i = 0; i < size; ++i)
+    {
+    // Row header, no copy
+    const cv::Mat sample = samples.row(i);
+
+    TargetSampleType target;
+#ifdef OTB_OPENCV_3
+    target[0] = static_cast<TOutputValue>(results.at<float>(i));
+#else
+    target[0] = static_cast<TOutputValue>(m_RFModel->predict(sample));
+#endif
+    targets->SetMeasurementVector(startIndex + i, target);
+
+    if (quality != ITK_NULLPTR)
+      {
+      ConfidenceSampleType confidence;
+      if(m_ComputeMargin)
+        confidence[0] = m_RFModel->predict_margin(sample);
+      else
+        confidence[0] = m_RFModel->predict_confidence(sample);
+      quality->SetMeasurementVector(startIndex + i, confidence);
+      }
+    }
+}
+
 template <class TInputValue, class TOutputValue>
 void
 RandomForestsMachineLearningModel<TInputValue,TOutputValue>
@@ -226,6 +483,8 @@ RandomForestsMachineLearningModel<TInputValue,TOutputValue>
   else
     m_RFModel->load(filename.c_str(), name.c_str());
 #endif
+
+  this->BuildFlatForest();
 }
 
 template <class TInputValue, class TOutputValue>
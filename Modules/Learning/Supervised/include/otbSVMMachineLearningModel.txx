@@ -201,6 +201,53 @@ SVMMachineLearningModel<TInputValue,TOutputValue>
   return target;
 }
 
+template <class TInputValue, class TOutputValue>
+void
+SVMMachineLearningModel<TInputValue,TOutputValue>
+::DoPredictBatch(const InputListSampleType * input, const unsigned int & startIndex, const unsigned int & size, TargetListSampleType * targets, ConfidenceListSampleType * quality) const
+{
+  this->CheckPredictBatchArguments(input, startIndex, size, targets, quality);
+
+  if(size == 0)
+    {
+    return;
+    }
+
+  // Convert the whole range of samples at once
+  cv::Mat samples;
+  otb::ListSampleRangeToMat(input, startIndex, size, samples);
+
+  cv::Mat results;
+  m_SVMModel->predict(samples, results);
+
+#ifdef OTB_OPENCV_3
+  cv::Mat rawOutputs;
+  if (quality != ITK_NULLPTR)
+    {
+    m_SVMModel->predict(samples, rawOutputs, cv::ml::StatModel::RAW_OUTPUT);
+    }
+#endif
+
+  for(unsigned int i = 0; i < size; ++i)
+    {
+    TargetSampleType target;
+    target[0] = static_cast<TOutputValue>(results.at<float>(i));
+    targets->SetMeasurementVector(startIndex + i, target);
+
+    if (quality != ITK_NULLPTR)
+      {
+      ConfidenceSampleType confidence;
+#ifdef OTB_OPENCV_3
+      confidence[0] = rawOutputs.at<float>(i);
+#else
+      // No batch decision function values in OpenCV 2
+      confidence[0] = m_SVMModel->predict(samples.row(i),true);
+#endif
+      quality->SetMeasurementVector(startIndex + i, confidence);
+      }
+    }
+}
+
 template <class TInputValue, class TOutputValue>
 void
 SVMMachineLearningModel<TInputValue,TOutputValue>
@@ -23,6 +23,7 @@
 
 #include "itkLightObject.h"
 #include "otbMachineLearningModel.h"
+#include "otbFlatForest.h"
 
 #if defined(__GNUC__) || defined(__clang__)
 #pragma GCC diagnostic push
@@ -134,6 +135,13 @@ public:
   /** If true, margin confidence value will be computed */
   itkSetMacro(ComputeMargin, bool);
 
+  /** Use a flat copy of the forest (see FlatForest) in batch
+   * predictions instead of the Shark trees. The copy is made when the
+   * forest is trained or loaded. */
+  void SetFlatForestInference(bool flag);
+  itkGetMacro(FlatForestInference, bool);
+  itkBooleanMacro(FlatForestInference);
+
 protected:
   /** Constructor */
   SharkRandomForestsMachineLearningModel();
@@ -167,6 +175,14 @@ private:
   ConfidenceValueType ComputeConfidence(shark::RealVector & probas, 
                                         bool computeMargin) const;
 
+  /** Copy the Shark forest into m_FlatForest */
+  void BuildFlatForest();
+
+  /** Whether batch predictions go through m_FlatForest */
+  bool m_FlatForestInference;
+  /** Flat copy of the forest, empty when not available */
+  FlatForest m_FlatForest;
+
 };
 } // end namespace otb
 
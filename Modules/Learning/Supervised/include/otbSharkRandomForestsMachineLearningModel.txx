@@ -41,13 +41,16 @@
 
 #include "otbSharkUtils.h"
 #include <algorithm>
+#include <map>
+#include <type_traits>
 
 namespace otb
 {
 
 template <class TInputValue, class TOutputValue>
 SharkRandomForestsMachineLearningModel<TInputValue,TOutputValue>
-::SharkRandomForestsMachineLearningModel()
+::SharkRandomForestsMachineLearningModel() :
+  m_FlatForestInference(false)
 {
   this->m_ConfidenceIndex = true;
   this->m_IsRegressionSupported = false;
@@ -71,12 +74,12 @@ SharkRandomForestsMachineLearningModel<TInputValue,TOutputValue>
   omp_set_num_threads(itk::MultiThreader::GetGlobalDefaultNumberOfThreads());
 #endif
   
-  std::vector<shark::RealVector> features;
-  std::vector<unsigned int> class_labels;
+  shark::Data<shark::RealVector> features;
+  shark::Data<unsigned int> class_labels;
 
-  Shark::ListSampleToSharkVector(this->GetInputListSample(), features);
-  Shark::ListSampleToSharkVector(this->GetTargetListSample(), class_labels);
-  shark::ClassificationDataset TrainSamples = shark::createLabeledDataFromRange(features,class_labels);
+  Shark::ListSampleToSharkData(this->GetInputListSample(), features);
+  Shark::ListSampleToSharkData(this->GetTargetListSample(), class_labels);
+  shark::ClassificationDataset TrainSamples(features,class_labels);
 
   //Set parameters
   m_RFTrainer.setMTry(m_MTry);
@@ -85,6 +88,86 @@ SharkRandomForestsMachineLearningModel<TInputValue,TOutputValue>
   m_RFTrainer.setOOBratio(m_OobRatio);
   m_RFTrainer.train(m_RFModel, TrainSamples);
 
+  this->BuildFlatForest();
+}
+
+template <class TInputValue, class TOutputValue>
+void
+SharkRandomForestsMachineLearningModel<TInputValue,TOutputValue>
+::SetFlatForestInference(bool flag)
+{
+  if (flag != m_FlatForestInference)
+    {
+    m_FlatForestInference = flag;
+    this->BuildFlatForest();
+    this->Modified();
+    }
+}
+
+template <class TInputValue, class TOutputValue>
+void
+SharkRandomForestsMachineLearningModel<TInputValue,TOutputValue>
+::BuildFlatForest()
+{
+  typedef shark::CARTClassifier<shark::RealVector> TreeType;
+
+  m_FlatForest.Clear();
+
+  if (!m_FlatForestInference)
+    {
+    return;
+    }
+
+  // (split matrix row, flat node) pairs still to copy
+  std::vector<std::pair<std::size_t, unsigned int> > pending;
+  std::map<std::size_t, std::size_t> rows;
+  std::vector<double> values;
+
+  for (std::size_t t = 0; t < m_RFModel.numberOfModels(); ++t)
+    {
+    const typename TreeType::SplitMatrixType splitMatrix = m_RFModel.model(t).getSplitMatrix();
+    if (splitMatrix.empty())
+      {
+      m_FlatForest.Clear();
+      return;
+      }
+    rows.clear();
+    for (std::size_t i = 0; i < splitMatrix.size(); ++i)
+      {
+      rows[splitMatrix[i].nodeId] = i;
+      }
+
+    pending.push_back(std::make_pair(0, m_FlatForest.AddTree()));
+
+    while (!pending.empty())
+      {
+      const typename TreeType::SplitInfo & info = splitMatrix[pending.back().first];
+      const unsigned int flatNode = pending.back().second;
+      pending.pop_back();
+
+      if (info.leftNodeId == 0)
+        {
+        // Leaves hold the class probabilities
+        if (values.empty())
+          {
+          values.resize(info.label.size());
+          m_FlatForest.SetNumberOfOutputs(values.size());
+          }
+        if (info.label.size() != values.size())
+          {
+          itkExceptionMacro(<< "Leaves of the forest do not have the same number of classes");
+          }
+        std::copy(info.label.begin(), info.label.end(), values.begin());
+        m_FlatForest.SetLeaf(flatNode, &values[0]);
+        continue;
+        }
+
+      // Same traversal as CARTClassifier::evalPattern()
+      const unsigned int left = m_FlatForest.SetSplit(flatNode, info.attributeIndex, info.attributeValue);
+      pending.push_back(std::make_pair(rows[info.leftNodeId], left));
+      pending.push_back(std::make_pair(rows[info.rightNodeId], left + 1));
+      }
+    }
 }
 
 template <class TInputValue, class TOutputValue>
@@ -142,20 +225,68 @@ void
 SharkRandomForestsMachineLearningModel<TInputValue,TOutputValue>
 ::DoPredictBatch(const InputListSampleType *input, const unsigned int & startIndex, const unsigned int & size, TargetListSampleType * targets, ConfidenceListSampleType * quality) const
 {
-  assert(input != ITK_NULLPTR);
-  assert(targets != ITK_NULLPTR);
-
-  assert(input->Size()==targets->Size()&&"Input sample list and target label list do not have the same size.");
-  assert(((quality==ITK_NULLPTR)||(quality->Size()==input->Size()))&&"Quality samples list is not null and does not have the same size as input samples list");
+  this->CheckPredictBatchArguments(input, startIndex, size, targets, quality);
   
-  if(startIndex+size>input->Size())
+  if (!m_FlatForest.IsEmpty())
     {
-    itkExceptionMacro(<<"requested range ["<<startIndex<<", "<<startIndex+size<<"[ partially outside input sample list range.[0,"<<input->Size()<<"[");
+    const unsigned int nbFeatures = input->GetMeasurementVectorSize();
+    const unsigned int nbClasses = m_FlatForest.GetNumberOfOutputs();
+    const double nbTrees = m_FlatForest.GetNumberOfTrees();
+
+    // Shark compares the features in double precision: only float
+    // features can be evaluated at float precision without changing
+    // the branches taken
+    typedef typename std::conditional<std::is_same<TInputValue, float>::value, float, double>::type FlatSampleType;
+    std::vector<FlatSampleType> samples(static_cast<size_t>(size) * nbFeatures);
+    for (unsigned int i = 0; i < size; ++i)
+      {
+      const InputSampleType sample = input->GetMeasurementVector(startIndex + i);
+      for (unsigned int j = 0; j < nbFeatures; ++j)
+        {
+        samples[static_cast<size_t>(i) * nbFeatures + j] = static_cast<FlatSampleType>(sample[j]);
+        }
+      }
+
+    // Blocks are independent, spread them on the threads
+    std::vector<double> sums(static_cast<size_t>(size) * nbClasses, 0.);
+    const int nbBlocks = (size + FlatForest::BlockSize - 1) / FlatForest::BlockSize;
+    #ifdef _OPENMP
+    omp_set_num_threads(itk::MultiThreader::GetGlobalDefaultNumberOfThreads());
+    #pragma omp parallel for schedule(dynamic)
+    #endif
+    for (int b = 0; b < nbBlocks; ++b)
+      {
+      const unsigned int start = b * FlatForest::BlockSize;
+      m_FlatForest.Accumulate(&samples[static_cast<size_t>(start) * nbFeatures],
+                              std::min(FlatForest::BlockSize, size - start),
+                              nbFeatures,
+                              &sums[static_cast<size_t>(start) * nbClasses]);
+      }
+
+    shark::RealVector probas(nbClasses);
+    for (unsigned int i = 0; i < size; ++i)
+      {
+      for (unsigned int k = 0; k < nbClasses; ++k)
+        {
+        probas[k] = sums[static_cast<size_t>(i) * nbClasses + k] / nbTrees;
+        }
+
+      TargetSampleType target;
+      target[0] = static_cast<TOutputValue>(std::max_element(probas.begin(), probas.end()) - probas.begin());
+      targets->SetMeasurementVector(startIndex + i, target);
+
+      if (quality != ITK_NULLPTR)
+        {
+        ConfidenceSampleType confidence;
+        confidence[0] = ComputeConfidence(probas, m_ComputeMargin);
+        quality->SetMeasurementVector(startIndex + i, confidence);
+        }
+      }
+    return;
     }
-  
-  std::vector<shark::RealVector> features;
-  Shark::ListSampleRangeToSharkVector(input, features,startIndex,size);
-  shark::Data<shark::RealVector> inputSamples = shark::createDataFromRange(features);
+
+  shark::Data<shark::RealVector> inputSamples;
+  Shark::ListSampleRangeToSharkData(input, inputSamples, startIndex, size);
 
   #ifdef _OPENMP
   omp_set_num_threads(itk::MultiThreader::GetGlobalDefaultNumberOfThreads());
@@ -229,6 +360,8 @@ SharkRandomForestsMachineLearningModel<TInputValue,TOutputValue>
     shark::TextInArchive ia( ifs );
     m_RFModel.load( ia, 0 );
     }
+
+  this->BuildFlatForest();
 }
 
 template <class TInputValue, class TOutputValue>
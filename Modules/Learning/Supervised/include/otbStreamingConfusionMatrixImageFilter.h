@@ -0,0 +1,285 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingConfusionMatrixImageFilter_h
+#define otbStreamingConfusionMatrixImageFilter_h
+
+#include "otbPersistentImageFilter.h"
+#include "otbPersistentFilterStreamingDecorator.h"
+#include "otbConfusionMatrixMeasurements.h"
+#include "itkVariableSizeMatrix.h"
+#include <map>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+
+namespace otb
+{
+
+/** \class PersistentConfusionMatrixImageFilter
+ * \brief Compute the confusion matrix between a produced label image and a reference label image
+ *
+ * Each thread counts the (reference, produced) label pairs of its region
+ * in its own sparse table, so that the memory does not depend on the number
+ * of pixels, and only on the number of distinct pairs actually observed.
+ * Runs of identical pairs are counted before touching the table.
+ * Pixels equal to the no-data value of either image are ignored when the
+ * corresponding flag is set.
+ *
+ * Synthetize() merges the tables, builds the square confusion matrix over
+ * the reference labels (rows = reference labels, columns = produced labels,
+ * sorted by increasing label) and computes the ConfusionMatrixMeasurements.
+ *
+ * \sa PersistentImageFilter
+ * \sa ConfusionMatrixMeasurements
+ * \ingroup Streamed
+ * \ingroup Multithreaded
+ *
+ * \ingroup OTBSupervised
+ */
+template<class TInputImage, class TReferenceImage = TInputImage>
+class ITK_EXPORT PersistentConfusionMatrixImageFilter :
+  public PersistentImageFilter<TInputImage, TInputImage>
+{
+public:
+  /** Standard Self typedef */
+  typedef PersistentConfusionMatrixImageFilter            Self;
+  typedef PersistentImageFilter<TInputImage, TInputImage> Superclass;
+  typedef itk::SmartPointer<Self>                         Pointer;
+  typedef itk::SmartPointer<const Self>                   ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(PersistentConfusionMatrixImageFilter, PersistentImageFilter);
+
+  /** Image related typedefs. */
+  typedef TInputImage                             ImageType;
+  typedef typename TInputImage::Pointer           InputImagePointer;
+  typedef typename TInputImage::RegionType        RegionType;
+  typedef typename TInputImage::PixelType         PixelType;
+  typedef TReferenceImage                         ReferenceImageType;
+  typedef typename TReferenceImage::PixelType     ReferencePixelType;
+
+  /** Label and confusion matrix typedefs */
+  typedef PixelType                                                             ClassLabelType;
+  typedef unsigned long                                                         ConfusionMatrixEltType;
+  typedef itk::VariableSizeMatrix<ConfusionMatrixEltType>                       ConfusionMatrixType;
+  typedef otb::ConfusionMatrixMeasurements<ConfusionMatrixType, ClassLabelType> ConfusionMatrixMeasurementsType;
+  typedef typename ConfusionMatrixMeasurementsType::MapOfClassesType            MapOfClassesType;
+
+  /** Sparse confusion matrix: reference label -> produced label -> count */
+  typedef std::map<ClassLabelType, std::map<ClassLabelType, ConfusionMatrixEltType> > SparseConfusionMatrixType;
+
+  /** Set/Get the reference label image */
+  void SetReferenceImage(const ReferenceImageType * reference);
+  const ReferenceImageType * GetReferenceImage();
+
+  /** Ignore the pixels whose produced label is ProducedNoDataValue */
+  itkSetMacro(ProducedNoDataValue, ClassLabelType);
+  itkGetMacro(ProducedNoDataValue, ClassLabelType);
+  itkSetMacro(ProducedNoDataFlag, bool);
+  itkGetMacro(ProducedNoDataFlag, bool);
+  itkBooleanMacro(ProducedNoDataFlag);
+
+  /** Ignore the pixels whose reference label is ReferenceNoDataValue */
+  itkSetMacro(ReferenceNoDataValue, ClassLabelType);
+  itkGetMacro(ReferenceNoDataValue, ClassLabelType);
+  itkSetMacro(ReferenceNoDataFlag, bool);
+  itkGetMacro(ReferenceNoDataFlag, bool);
+  itkBooleanMacro(ReferenceNoDataFlag);
+
+  /** Counts of all the observed label pairs */
+  itkGetConstReferenceMacro(SparseConfusionMatrix, SparseConfusionMatrixType);
+
+  /** Reference labels and their row index in the confusion matrix */
+  itkGetConstReferenceMacro(ReferenceMapOfClasses, MapOfClassesType);
+
+  /** Produced labels and their rank */
+  itkGetConstReferenceMacro(ProducedMapOfClasses, MapOfClassesType);
+
+  /** Square confusion matrix over the reference labels */
+  itkGetConstReferenceMacro(ConfusionMatrix, ConfusionMatrixType);
+
+  /** Number of pixels counted */
+  itkGetMacro(NumberOfSamples, unsigned long);
+
+  /** Measurements computed over the confusion matrix */
+  const ConfusionMatrixMeasurementsType * GetMeasurements() const
+  {
+    return m_Measurements;
+  }
+
+  /** Pass the input through unmodified. Do this by Grafting in the
+   *  AllocateOutputs method.
+   */
+  void AllocateOutputs() ITK_OVERRIDE;
+  void GenerateOutputInformation() ITK_OVERRIDE;
+  void Synthetize(void) ITK_OVERRIDE;
+  void Reset(void) ITK_OVERRIDE;
+
+protected:
+  PersistentConfusionMatrixImageFilter();
+  ~PersistentConfusionMatrixImageFilter() ITK_OVERRIDE {}
+  void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
+  /** Multi-thread version GenerateData. */
+  void ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId) ITK_OVERRIDE;
+
+  /** Only the regions of the two images have to match, this is checked in Reset() */
+  void VerifyInputInformation() ITK_OVERRIDE {}
+
+private:
+  PersistentConfusionMatrixImageFilter(const Self &); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+
+  typedef std::pair<ClassLabelType, ClassLabelType> LabelPairType;
+
+  struct LabelPairHash
+  {
+    size_t operator()(const LabelPairType & p) const
+    {
+      const size_t h = std::hash<ClassLabelType>()(p.first);
+      return h ^ (std::hash<ClassLabelType>()(p.second) + 0x9e3779b9 + (h << 6) + (h >> 2));
+    }
+  };
+
+  typedef std::unordered_map<LabelPairType, ConfusionMatrixEltType, LabelPairHash> ThreadCountsType;
+
+  /** Label pair counts (per thread) */
+  std::vector<ThreadCountsType>  m_ThreadCounts;
+
+  ClassLabelType                 m_ProducedNoDataValue;
+  bool                           m_ProducedNoDataFlag;
+  ClassLabelType                 m_ReferenceNoDataValue;
+  bool                           m_ReferenceNoDataFlag;
+
+  SparseConfusionMatrixType      m_SparseConfusionMatrix;
+  MapOfClassesType               m_ReferenceMapOfClasses;
+  MapOfClassesType               m_ProducedMapOfClasses;
+  ConfusionMatrixType            m_ConfusionMatrix;
+  unsigned long                  m_NumberOfSamples;
+  typename ConfusionMatrixMeasurementsType::Pointer m_Measurements;
+
+}; // end of class PersistentConfusionMatrixImageFilter
+
+/**===========================================================================*/
+
+/** \class StreamingConfusionMatrixImageFilter
+ * \brief This class streams the whole input image through the PersistentConfusionMatrixImageFilter.
+ *
+ * \sa PersistentConfusionMatrixImageFilter
+ * \sa PersistentFilterStreamingDecorator
+ * \sa StreamingImageVirtualWriter
+ * \ingroup Streamed
+ * \ingroup Multithreaded
+ *
+ * \ingroup OTBSupervised
+ */
+template<class TInputImage, class TReferenceImage = TInputImage>
+class ITK_EXPORT StreamingConfusionMatrixImageFilter :
+  public PersistentFilterStreamingDecorator<PersistentConfusionMatrixImageFilter<TInputImage, TReferenceImage> >
+{
+public:
+  /** Standard Self typedef */
+  typedef StreamingConfusionMatrixImageFilter Self;
+  typedef PersistentFilterStreamingDecorator
+  <PersistentConfusionMatrixImageFilter<TInputImage, TReferenceImage> > Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(StreamingConfusionMatrixImageFilter, PersistentFilterStreamingDecorator);
+
+  typedef TInputImage                                                 InputImageType;
+  typedef TReferenceImage                                             ReferenceImageType;
+  typedef typename Superclass::FilterType                             ConfusionMatrixFilterType;
+  typedef typename ConfusionMatrixFilterType::ClassLabelType          ClassLabelType;
+  typedef typename ConfusionMatrixFilterType::ConfusionMatrixType     ConfusionMatrixType;
+  typedef typename ConfusionMatrixFilterType::SparseConfusionMatrixType SparseConfusionMatrixType;
+  typedef typename ConfusionMatrixFilterType::MapOfClassesType        MapOfClassesType;
+  typedef typename ConfusionMatrixFilterType::ConfusionMatrixMeasurementsType ConfusionMatrixMeasurementsType;
+
+  using Superclass::SetInput;
+  void SetInput(InputImageType * input)
+  {
+    this->GetFilter()->SetInput(input);
+  }
+  const InputImageType * GetInput()
+  {
+    return this->GetFilter()->GetInput();
+  }
+
+  void SetReferenceImage(const ReferenceImageType * reference)
+  {
+    this->GetFilter()->SetReferenceImage(reference);
+  }
+
+  otbSetObjectMemberMacro(Filter, ProducedNoDataValue, ClassLabelType);
+  otbSetObjectMemberMacro(Filter, ProducedNoDataFlag, bool);
+  otbSetObjectMemberMacro(Filter, ReferenceNoDataValue, ClassLabelType);
+  otbSetObjectMemberMacro(Filter, ReferenceNoDataFlag, bool);
+
+  const SparseConfusionMatrixType & GetSparseConfusionMatrix() const
+  {
+    return this->GetFilter()->GetSparseConfusionMatrix();
+  }
+
+  const MapOfClassesType & GetReferenceMapOfClasses() const
+  {
+    return this->GetFilter()->GetReferenceMapOfClasses();
+  }
+
+  const MapOfClassesType & GetProducedMapOfClasses() const
+  {
+    return this->GetFilter()->GetProducedMapOfClasses();
+  }
+
+  const ConfusionMatrixType & GetConfusionMatrix() const
+  {
+    return this->GetFilter()->GetConfusionMatrix();
+  }
+
+  const ConfusionMatrixMeasurementsType * GetMeasurements() const
+  {
+    return this->GetFilter()->GetMeasurements();
+  }
+
+protected:
+  /** Constructor */
+  StreamingConfusionMatrixImageFilter() {}
+  /** Destructor */
+  ~StreamingConfusionMatrixImageFilter() ITK_OVERRIDE {}
+
+private:
+  StreamingConfusionMatrixImageFilter(const Self &); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbStreamingConfusionMatrixImageFilter.txx"
+#endif
+
+#endif
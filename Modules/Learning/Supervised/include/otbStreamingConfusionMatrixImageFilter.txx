@@ -0,0 +1,249 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingConfusionMatrixImageFilter_txx
+#define otbStreamingConfusionMatrixImageFilter_txx
+#include "otbStreamingConfusionMatrixImageFilter.h"
+
+#include "itkImageRegionConstIterator.h"
+#include "itkNumericTraits.h"
+#include "itkProgressReporter.h"
+#include "otbMacro.h"
+
+namespace otb
+{
+
+template<class TInputImage, class TReferenceImage>
+PersistentConfusionMatrixImageFilter<TInputImage, TReferenceImage>
+::PersistentConfusionMatrixImageFilter()
+  : m_ProducedNoDataValue(itk::NumericTraits<ClassLabelType>::Zero),
+    m_ProducedNoDataFlag(false),
+    m_ReferenceNoDataValue(itk::NumericTraits<ClassLabelType>::Zero),
+    m_ReferenceNoDataFlag(false),
+    m_NumberOfSamples(0)
+{
+  this->SetNumberOfRequiredInputs(2);
+  m_Measurements = ConfusionMatrixMeasurementsType::New();
+}
+
+template<class TInputImage, class TReferenceImage>
+void
+PersistentConfusionMatrixImageFilter<TInputImage, TReferenceImage>
+::SetReferenceImage(const ReferenceImageType * reference)
+{
+  this->itk::ProcessObject::SetNthInput(1, const_cast<ReferenceImageType *>(reference));
+}
+
+template<class TInputImage, class TReferenceImage>
+const typename PersistentConfusionMatrixImageFilter<TInputImage, TReferenceImage>::ReferenceImageType *
+PersistentConfusionMatrixImageFilter<TInputImage, TReferenceImage>
+::GetReferenceImage()
+{
+  if (this->GetNumberOfInputs() < 2)
+    {
+    return ITK_NULLPTR;
+    }
+  return static_cast<const ReferenceImageType *>(this->itk::ProcessObject::GetInput(1));
+}
+
+template<class TInputImage, class TReferenceImage>
+void
+PersistentConfusionMatrixImageFilter<TInputImage, TReferenceImage>
+::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+  if (this->GetInput())
+    {
+    this->GetOutput()->CopyInformation(this->GetInput());
+    this->GetOutput()->SetLargestPossibleRegion(this->GetInput()->GetLargestPossibleRegion());
+
+    if (this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() == 0)
+      {
+      this->GetOutput()->SetRequestedRegion(this->GetOutput()->GetLargestPossibleRegion());
+      }
+    }
+}
+
+template<class TInputImage, class TReferenceImage>
+void
+PersistentConfusionMatrixImageFilter<TInputImage, TReferenceImage>
+::AllocateOutputs()
+{
+  // This is commented to prevent the streaming of the whole image for the first stream strip
+  // It shall not cause any problem because the output image of this filter is not intended to be used.
+  //InputImagePointer image = const_cast< TInputImage * >( this->GetInput() );
+  //this->GraftOutput( image );
+  // Nothing that needs to be allocated for the remaining outputs
+}
+
+template<class TInputImage, class TReferenceImage>
+void
+PersistentConfusionMatrixImageFilter<TInputImage, TReferenceImage>
+::Reset()
+{
+  TInputImage * inputPtr = const_cast<TInputImage *>(this->GetInput());
+  inputPtr->UpdateOutputInformation();
+
+  const ReferenceImageType * referencePtr = this->GetReferenceImage();
+  if (!referencePtr)
+    {
+    itkExceptionMacro(<< "No reference image.");
+    }
+  const_cast<ReferenceImageType *>(referencePtr)->UpdateOutputInformation();
+  if (referencePtr->GetLargestPossibleRegion() != inputPtr->GetLargestPossibleRegion())
+    {
+    itkExceptionMacro(<< "The reference image region " << referencePtr->GetLargestPossibleRegion()
+                      << " differs from the produced image region " << inputPtr->GetLargestPossibleRegion());
+    }
+
+  m_ThreadCounts = std::vector<ThreadCountsType>(this->GetNumberOfThreads());
+
+  m_SparseConfusionMatrix.clear();
+  m_ReferenceMapOfClasses.clear();
+  m_ProducedMapOfClasses.clear();
+  m_ConfusionMatrix.SetSize(0, 0);
+  m_NumberOfSamples = 0;
+}
+
+template<class TInputImage, class TReferenceImage>
+void
+PersistentConfusionMatrixImageFilter<TInputImage, TReferenceImage>
+::Synthetize()
+{
+  // Merge the sparse counts of the threads
+  for (unsigned int t = 0; t < m_ThreadCounts.size(); ++t)
+    {
+    typename ThreadCountsType::const_iterator it = m_ThreadCounts[t].begin();
+    for (; it != m_ThreadCounts[t].end(); ++it)
+      {
+      m_SparseConfusionMatrix[it->first.first][it->first.second] += it->second;
+      m_ProducedMapOfClasses[it->first.second] = 0;
+      m_NumberOfSamples += it->second;
+      }
+    }
+  m_ThreadCounts.clear();
+
+  // Labels are sorted by the maps, give them their index
+  int index = 0;
+  typename SparseConfusionMatrixType::const_iterator rowIt = m_SparseConfusionMatrix.begin();
+  for (; rowIt != m_SparseConfusionMatrix.end(); ++rowIt)
+    {
+    m_ReferenceMapOfClasses[rowIt->first] = index++;
+    }
+  index = 0;
+  typename MapOfClassesType::iterator prodIt = m_ProducedMapOfClasses.begin();
+  for (; prodIt != m_ProducedMapOfClasses.end(); ++prodIt)
+    {
+    prodIt->second = index++;
+    }
+
+  // Square confusion matrix over the reference labels, produced labels
+  // which are not reference labels are left out
+  const unsigned int nbClasses = m_ReferenceMapOfClasses.size();
+  m_ConfusionMatrix.SetSize(nbClasses, nbClasses);
+  m_ConfusionMatrix.Fill(0);
+  for (rowIt = m_SparseConfusionMatrix.begin(); rowIt != m_SparseConfusionMatrix.end(); ++rowIt)
+    {
+    const int row = m_ReferenceMapOfClasses[rowIt->first];
+    typename SparseConfusionMatrixType::mapped_type::const_iterator colIt = rowIt->second.begin();
+    for (; colIt != rowIt->second.end(); ++colIt)
+      {
+      typename MapOfClassesType::const_iterator refIt = m_ReferenceMapOfClasses.find(colIt->first);
+      if (refIt != m_ReferenceMapOfClasses.end())
+        {
+        m_ConfusionMatrix(row, refIt->second) = colIt->second;
+        }
+      }
+    }
+
+  if (nbClasses > 0)
+    {
+    m_Measurements->SetMapOfClasses(m_ReferenceMapOfClasses);
+    m_Measurements->SetConfusionMatrix(m_ConfusionMatrix);
+    m_Measurements->Compute();
+    }
+}
+
+template<class TInputImage, class TReferenceImage>
+void
+PersistentConfusionMatrixImageFilter<TInputImage, TReferenceImage>
+::ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId)
+{
+  InputImagePointer inputPtr = const_cast<TInputImage *>(this->GetInput());
+  const ReferenceImageType * referencePtr = this->GetReferenceImage();
+
+  // support progress methods/callbacks
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  itk::ImageRegionConstIterator<TInputImage> prodIt(inputPtr, outputRegionForThread);
+  itk::ImageRegionConstIterator<ReferenceImageType> refIt(referencePtr, outputRegionForThread);
+
+  ThreadCountsType& counts = m_ThreadCounts[threadId];
+
+  // Classification maps are made of long runs of identical label pairs,
+  // count a whole run before looking up the table
+  LabelPairType currentPair;
+  ConfusionMatrixEltType runLength = 0;
+
+  for (prodIt.GoToBegin(), refIt.GoToBegin(); !prodIt.IsAtEnd(); ++prodIt, ++refIt)
+    {
+    const ClassLabelType prodLabel = static_cast<ClassLabelType>(prodIt.Get());
+    const ClassLabelType refLabel = static_cast<ClassLabelType>(refIt.Get());
+
+    if ((!m_ReferenceNoDataFlag || refLabel != m_ReferenceNoDataValue)
+        && (!m_ProducedNoDataFlag || prodLabel != m_ProducedNoDataValue))
+      {
+      if (runLength > 0 && refLabel == currentPair.first && prodLabel == currentPair.second)
+        {
+        ++runLength;
+        }
+      else
+        {
+        if (runLength > 0)
+          {
+          counts[currentPair] += runLength;
+          }
+        currentPair = LabelPairType(refLabel, prodLabel);
+        runLength = 1;
+        }
+      }
+    progress.CompletedPixel();
+    }
+
+  if (runLength > 0)
+    {
+    counts[currentPair] += runLength;
+    }
+}
+
+template<class TInputImage, class TReferenceImage>
+void
+PersistentConfusionMatrixImageFilter<TInputImage, TReferenceImage>
+::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Number of samples: " << m_NumberOfSamples << std::endl;
+  os << indent << "Number of reference classes: " << m_ReferenceMapOfClasses.size() << std::endl;
+  os << indent << "Number of produced classes: " << m_ProducedMapOfClasses.size() << std::endl;
+}
+
+} // end namespace otb
+#endif
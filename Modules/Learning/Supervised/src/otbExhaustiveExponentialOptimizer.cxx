@@ -213,6 +213,71 @@ ExhaustiveExponentialOptimizer
     }
 }
 
+void
+ExhaustiveExponentialOptimizer
+::GetGridPositions(std::vector<ParametersType>& positions) const
+{
+  const ParametersType& initialPos = this->GetInitialPosition();
+  const unsigned int spaceDimension = initialPos.GetSize();
+  const ScalesType& scales = this->GetScales();
+
+  if (scales.size() != spaceDimension)
+    {
+    itkExceptionMacro(<< "The size of Scales is "
+                      << scales.size()
+                      << ", but the NumberOfParameters is "
+                      << spaceDimension
+                      << ".");
+    }
+
+  unsigned long nbPositions = 1;
+  for (unsigned int i = 0; i < spaceDimension; ++i)
+    {
+    nbPositions *= (2 * m_NumberOfSteps[i] + 1);
+    }
+
+  positions.clear();
+  positions.reserve(nbPositions + 1);
+  positions.push_back(initialPos);
+
+  // First grid position, computed as in StartWalking()
+  ParametersType position(spaceDimension);
+  for (unsigned int i = 0; i < spaceDimension; ++i)
+    {
+    position[i] = initialPos[i] *
+                  vcl_pow(m_GeometricProgression, -static_cast<double>(m_NumberOfSteps[i]) * m_StepLength) * scales[i];
+    }
+  positions.push_back(position);
+
+  // Following positions, computed as in IncrementIndex()
+  ParametersType index(spaceDimension);
+  index.Fill(0);
+  for (unsigned long n = 1; n < nbPositions; ++n)
+    {
+    for (unsigned int idx = 0; idx < spaceDimension; ++idx)
+      {
+      index[idx]++;
+      if (index[idx] > (2 * m_NumberOfSteps[idx]))
+        {
+        index[idx] = 0;
+        }
+      else
+        {
+        break;
+        }
+      }
+
+    for (unsigned int i = 0; i < spaceDimension; ++i)
+      {
+      position[i] = initialPos[i]
+                    * scales[i]
+                    * vcl_pow(m_GeometricProgression,
+                              static_cast<double>(index[i] - m_NumberOfSteps[i]) * m_StepLength);
+      }
+    positions.push_back(position);
+    }
+}
+
 void
 ExhaustiveExponentialOptimizer
 ::PrintSelf(std::ostream& os, itk::Indent indent) const
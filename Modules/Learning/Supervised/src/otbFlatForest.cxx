@@ -0,0 +1,293 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbFlatForest.h"
+#include "itkMacro.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace otb
+{
+
+const unsigned int FlatForest::BlockSize;
+
+FlatForest
+::FlatForest() :
+  m_NumberOfOutputs(1),
+  m_NumberOfLeaves(0),
+  m_VoteLeaves(false),
+  m_NumberOfPendingNodes(0),
+  m_MaxFeature(0),
+  m_MaxOutput(0)
+{
+}
+
+void
+FlatForest
+::Clear()
+{
+  m_Feature.clear();
+  m_Threshold.clear();
+  m_DoubleThreshold.clear();
+  m_Children.clear();
+  m_Leaf.clear();
+  m_Depth.clear();
+  m_Roots.clear();
+  m_TreeDepths.clear();
+  m_LeafValues.clear();
+  m_NumberOfLeaves = 0;
+  m_VoteLeaves = false;
+  m_NumberOfPendingNodes = 0;
+  m_MaxFeature = 0;
+  m_MaxOutput = 0;
+}
+
+void
+FlatForest
+::SetNumberOfOutputs(unsigned int nbOutputs)
+{
+  if (nbOutputs == 0)
+    {
+    itkGenericExceptionMacro(<< "A forest needs at least one output");
+    }
+  if (m_NumberOfLeaves > 0 && !m_VoteLeaves && nbOutputs != m_NumberOfOutputs)
+    {
+    itkGenericExceptionMacro(<< "Can not change the number of outputs of a forest with value leaves");
+    }
+  m_NumberOfOutputs = nbOutputs;
+}
+
+unsigned int
+FlatForest
+::AddNode(unsigned int depth)
+{
+  const unsigned int node = static_cast<unsigned int>(m_Feature.size());
+  m_Feature.push_back(0);
+  m_Threshold.push_back(0.f);
+  m_DoubleThreshold.push_back(0.);
+  m_Children.push_back(node);
+  m_Leaf.push_back(-1);
+  m_Depth.push_back(depth);
+  ++m_NumberOfPendingNodes;
+  return node;
+}
+
+unsigned int
+FlatForest
+::AddTree()
+{
+  const unsigned int root = this->AddNode(0);
+  m_Roots.push_back(root);
+  m_TreeDepths.push_back(0);
+  return root;
+}
+
+unsigned int
+FlatForest
+::SetSplit(unsigned int node, unsigned int feature, double threshold)
+{
+  if (m_Roots.empty() || node < m_Roots.back() || node >= m_Feature.size()
+      || m_Leaf[node] >= 0 || m_Children[node] != node)
+    {
+    itkGenericExceptionMacro(<< "Node " << node << " is not a pending node of the last tree");
+    }
+
+  // Largest float lower or equal to the threshold: for any float x,
+  // x <= threshold if and only if x <= this value
+  float fthreshold = static_cast<float>(threshold);
+  if (static_cast<double>(fthreshold) > threshold)
+    {
+    fthreshold = std::nextafter(fthreshold, -std::numeric_limits<float>::infinity());
+    }
+
+  const unsigned int depth = m_Depth[node] + 1;
+  const unsigned int left = this->AddNode(depth);
+  this->AddNode(depth);
+
+  m_Feature[node] = feature;
+  m_Threshold[node] = fthreshold;
+  m_DoubleThreshold[node] = threshold;
+  m_Children[node] = left;
+  m_MaxFeature = std::max(m_MaxFeature, feature);
+  --m_NumberOfPendingNodes;
+  m_TreeDepths.back() = std::max(m_TreeDepths.back(), depth);
+  return left;
+}
+
+void
+FlatForest
+::SetLeaf(unsigned int node, unsigned int output)
+{
+  if (m_NumberOfLeaves > 0 && !m_VoteLeaves)
+    {
+    itkGenericExceptionMacro(<< "Can not mix vote and value leaves");
+    }
+  if (node >= m_Feature.size() || m_Leaf[node] >= 0 || m_Children[node] != node)
+    {
+    itkGenericExceptionMacro(<< "Node " << node << " is not a pending node");
+    }
+  m_VoteLeaves = true;
+  m_MaxOutput = std::max(m_MaxOutput, output);
+  ++m_NumberOfLeaves;
+  --m_NumberOfPendingNodes;
+
+  // The comparison with a NaN threshold always fails, which moves the
+  // sample to the "right child" of the leaf, i.e. the leaf itself
+  m_Feature[node] = 0;
+  m_Threshold[node] = std::numeric_limits<float>::quiet_NaN();
+  m_DoubleThreshold[node] = std::numeric_limits<double>::quiet_NaN();
+  m_Children[node] = node - 1;
+  m_Leaf[node] = static_cast<int>(output);
+}
+
+void
+FlatForest
+::SetLeaf(unsigned int node, const double * values)
+{
+  if (m_NumberOfLeaves > 0 && m_VoteLeaves)
+    {
+    itkGenericExceptionMacro(<< "Can not mix vote and value leaves");
+    }
+  if (node >= m_Feature.size() || m_Leaf[node] >= 0 || m_Children[node] != node)
+    {
+    itkGenericExceptionMacro(<< "Node " << node << " is not a pending node");
+    }
+  m_VoteLeaves = false;
+  --m_NumberOfPendingNodes;
+
+  m_Feature[node] = 0;
+  m_Threshold[node] = std::numeric_limits<float>::quiet_NaN();
+  m_DoubleThreshold[node] = std::numeric_limits<double>::quiet_NaN();
+  m_Children[node] = node - 1;
+  m_Leaf[node] = static_cast<int>(m_NumberOfLeaves);
+  m_LeafValues.insert(m_LeafValues.end(), values, values + m_NumberOfOutputs);
+  ++m_NumberOfLeaves;
+}
+
+void
+FlatForest
+::CheckForEvaluation(unsigned int nbFeatures) const
+{
+  if (m_NumberOfPendingNodes > 0)
+    {
+    itkGenericExceptionMacro(<< m_NumberOfPendingNodes << " nodes of the forest are neither splits nor leaves");
+    }
+  if (!m_Roots.empty() && m_MaxFeature >= nbFeatures)
+    {
+    itkGenericExceptionMacro(<< "The forest uses feature " << m_MaxFeature << " but samples only have " << nbFeatures);
+    }
+  if (m_VoteLeaves && m_MaxOutput >= m_NumberOfOutputs)
+    {
+    itkGenericExceptionMacro(<< "A leaf votes for output " << m_MaxOutput << " out of " << m_NumberOfOutputs);
+    }
+}
+
+void
+FlatForest
+::Accumulate(const float * samples,
+             unsigned int nbSamples,
+             unsigned int nbFeatures,
+             double * sums) const
+{
+  this->CheckForEvaluation(nbFeatures);
+  this->AccumulateSamples(samples, m_Threshold.empty() ? ITK_NULLPTR : &m_Threshold[0],
+                          nbSamples, nbFeatures, sums);
+}
+
+void
+FlatForest
+::Accumulate(const double * samples,
+             unsigned int nbSamples,
+             unsigned int nbFeatures,
+             double * sums) const
+{
+  this->CheckForEvaluation(nbFeatures);
+  this->AccumulateSamples(samples, m_DoubleThreshold.empty() ? ITK_NULLPTR : &m_DoubleThreshold[0],
+                          nbSamples, nbFeatures, sums);
+}
+
+template <class TSample>
+void
+FlatForest
+::AccumulateSamples(const TSample * samples,
+                    const TSample * threshold,
+                    unsigned int nbSamples,
+                    unsigned int nbFeatures,
+                    double * sums) const
+{
+  const unsigned int * feature = m_Feature.empty() ? ITK_NULLPTR : &m_Feature[0];
+  const unsigned int * children = m_Children.empty() ? ITK_NULLPTR : &m_Children[0];
+
+  unsigned int current[BlockSize];
+
+  for (unsigned int start = 0; start < nbSamples; start += BlockSize)
+    {
+    const unsigned int blockSize = std::min(BlockSize, nbSamples - start);
+    const TSample * block = samples + static_cast<size_t>(start) * nbFeatures;
+    double * blockSums = sums + static_cast<size_t>(start) * m_NumberOfOutputs;
+
+    for (unsigned int t = 0; t < m_Roots.size(); ++t)
+      {
+      std::fill(current, current + blockSize, m_Roots[t]);
+
+      for (unsigned int level = 0; level < m_TreeDepths[t]; ++level)
+        {
+        unsigned int moved = 0;
+        for (unsigned int s = 0; s < blockSize; ++s)
+          {
+          const unsigned int node = current[s];
+          const TSample value = block[static_cast<size_t>(s) * nbFeatures + feature[node]];
+          const unsigned int next = children[node] + !(value <= threshold[node]);
+          moved |= next ^ node;
+          current[s] = next;
+          }
+        // Stop as soon as every sample of the block reached a leaf
+        if (!moved)
+          {
+          break;
+          }
+        }
+
+      if (m_VoteLeaves)
+        {
+        for (unsigned int s = 0; s < blockSize; ++s)
+          {
+          blockSums[static_cast<size_t>(s) * m_NumberOfOutputs + m_Leaf[current[s]]] += 1.;
+          }
+        }
+      else
+        {
+        for (unsigned int s = 0; s < blockSize; ++s)
+          {
+          const double * values = &m_LeafValues[static_cast<size_t>(m_Leaf[current[s]]) * m_NumberOfOutputs];
+          double * out = blockSums + static_cast<size_t>(s) * m_NumberOfOutputs;
+          for (unsigned int k = 0; k < m_NumberOfOutputs; ++k)
+            {
+            out[k] += values[k];
+            }
+          }
+        }
+      }
+    }
+}
+
+} // end namespace otb
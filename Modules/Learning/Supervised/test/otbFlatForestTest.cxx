@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbFlatForest.h"
+#include "itkMacro.h"
+
+#include <iostream>
+#include <vector>
+
+namespace
+{
+// Evaluate the samples with the forest built in otbFlatForestTest and
+// count the outputs that differ from the double precision reference
+template <class TSample>
+unsigned int CheckForest(const otb::FlatForest & forest, const std::vector<TSample> & samples,
+                         unsigned int nbSamples, unsigned int nbFeatures)
+{
+  std::vector<double> sums(nbSamples * forest.GetNumberOfOutputs(), 0.);
+  forest.Accumulate(&samples[0], nbSamples, nbFeatures, &sums[0]);
+
+  unsigned int nbErrors = 0;
+  for (unsigned int i = 0; i < nbSamples; ++i)
+    {
+    // Thresholds are compared in double precision
+    const double x0 = samples[i * nbFeatures];
+    const double x1 = samples[i * nbFeatures + 1];
+    double expected[3] = {0., 1., 0.};
+    expected[x0 <= 0.5 ? (x1 <= 0.1 ? 0 : 1) : 2] += 1.;
+
+    for (unsigned int k = 0; k < 3; ++k)
+      {
+      if (sums[i * 3 + k] != expected[k])
+        {
+        std::cout << "Sample " << i << ", output " << k << ": " << sums[i * 3 + k]
+                  << " instead of " << expected[k] << std::endl;
+        ++nbErrors;
+        }
+      }
+    }
+  return nbErrors;
+}
+}
+
+int otbFlatForestTest(int itkNotUsed(argc), char * itkNotUsed(argv) [])
+{
+  const unsigned int nbSamples = 200;
+  const unsigned int nbFeatures = 2;
+
+  // Tree 1: x0 <= 0.5 ? (x1 <= 0.1 ? class 0 : class 1) : class 2
+  // Tree 2: always class 1
+  otb::FlatForest forest;
+  forest.SetNumberOfOutputs(3);
+  const unsigned int root = forest.AddTree();
+  const unsigned int left = forest.SetSplit(root, 0, 0.5);
+  const unsigned int leftLeft = forest.SetSplit(left, 1, 0.1);
+  forest.SetLeaf(leftLeft, 0u);
+  forest.SetLeaf(leftLeft + 1, 1u);
+  forest.SetLeaf(left + 1, 2u);
+  forest.SetLeaf(forest.AddTree(), 1u);
+
+  // More samples than a block, to cover a partial block
+  std::vector<float> samples(nbSamples * nbFeatures);
+  for (unsigned int i = 0; i < nbSamples; ++i)
+    {
+    samples[i * nbFeatures] = i / 100.f;
+    samples[i * nbFeatures + 1] = (i % 3) * 0.1f;
+    }
+  unsigned int nbErrors = CheckForest(forest, samples, nbSamples, nbFeatures);
+
+  // Double samples closer to the 0.1 threshold than a float step: they
+  // would all go right once converted to float
+  std::vector<double> doubleSamples(nbSamples * nbFeatures);
+  for (unsigned int i = 0; i < nbSamples; ++i)
+    {
+    doubleSamples[i * nbFeatures] = i / 100.;
+    doubleSamples[i * nbFeatures + 1] = 0.1 + (static_cast<int>(i % 5) - 2) * 1e-10;
+    }
+  nbErrors += CheckForest(forest, doubleSamples, nbSamples, nbFeatures);
+
+  return (nbErrors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
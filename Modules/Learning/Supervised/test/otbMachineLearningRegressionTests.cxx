@@ -231,6 +231,17 @@ int testRegression(SampleGeneratorType& sg, RegressionType& rgrsn, RegressionTes
     return EXIT_FAILURE;
     }
 
+  if (rgrsn->HasQuantizedInference())
+    {
+    const double quantizationError = rgrsn->ComputeQuantizationError(sg.m_isl);
+    std::cout << "Quantization RMS error = " << quantizationError << std::endl;
+    if (quantizationError > param.eps || vnl_math_isnan(quantizationError))
+      {
+      std::cout << "Failed : quantized inference above expected precision !" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
   return EXIT_SUCCESS;
 }
 
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbImage.h"
+#include "otbStreamingConfusionMatrixImageFilter.h"
+#include "itkImageRegionIterator.h"
+
+int otbStreamingConfusionMatrixImageFilter(int itkNotUsed(argc), char* itkNotUsed(argv) [])
+{
+  typedef int                                                   ClassLabelType;
+  typedef otb::Image<ClassLabelType, 2>                         LabelImageType;
+  typedef otb::StreamingConfusionMatrixImageFilter<LabelImageType> FilterType;
+  typedef FilterType::ConfusionMatrixType                       ConfusionMatrixType;
+
+  // Same samples as otbConfusionMatrixCalculatorComputeWithBaseline,
+  // repeated on 3 lines. The 4th line is no-data in the reference.
+  const int nbClasses = 4;
+  const int width = 12;
+  const int height = 4;
+  const ClassLabelType noData = 0;
+  const ClassLabelType refPattern[width]  = {1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4};
+  const ClassLabelType prodPattern[width] = {1, 3, 3, 4, 4, 2, 3, 4, 4, 4, 4, 3};
+
+  LabelImageType::RegionType region;
+  region.SetSize(0, width);
+  region.SetSize(1, height);
+
+  LabelImageType::Pointer reference = LabelImageType::New();
+  reference->SetRegions(region);
+  reference->Allocate();
+  LabelImageType::Pointer produced = LabelImageType::New();
+  produced->SetRegions(region);
+  produced->Allocate();
+
+  itk::ImageRegionIterator<LabelImageType> itRef(reference, region);
+  itk::ImageRegionIterator<LabelImageType> itProd(produced, region);
+  for (itRef.GoToBegin(), itProd.GoToBegin(); !itRef.IsAtEnd(); ++itRef, ++itProd)
+    {
+    LabelImageType::IndexType idx = itRef.GetIndex();
+    itRef.Set(idx[1] < height - 1 ? refPattern[idx[0]] : noData);
+    itProd.Set(prodPattern[idx[0]]);
+    }
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(produced);
+  filter->SetReferenceImage(reference);
+  filter->SetReferenceNoDataFlag(true);
+  filter->SetReferenceNoDataValue(noData);
+  filter->GetStreamer()->SetNumberOfLinesStrippedStreaming(1);
+  filter->Update();
+
+  ConfusionMatrixType blConfmat;
+  blConfmat.SetSize(nbClasses, nbClasses);
+  blConfmat.Fill(0);
+  blConfmat[0][0] = 3;
+  blConfmat[0][3] = 6;
+  blConfmat[1][1] = 3;
+  blConfmat[1][2] = 3;
+  blConfmat[1][3] = 3;
+  blConfmat[2][2] = 6;
+  blConfmat[2][3] = 3;
+  blConfmat[3][2] = 3;
+  blConfmat[3][3] = 6;
+
+  const ConfusionMatrixType & confmat = filter->GetConfusionMatrix();
+  std::cout << "confusion matrix" << std::endl << confmat << std::endl;
+
+  if (confmat != blConfmat)
+    {
+    std::cout << "ERROR in Confusion Matrix" << std::endl;
+    std::cout << "baseline confmat = " << std::endl << blConfmat << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  if (filter->GetFilter()->GetNumberOfSamples() != static_cast<unsigned long>(width * (height - 1)))
+    {
+    std::cout << "ERROR in number of samples: " << filter->GetFilter()->GetNumberOfSamples() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Same proportions as the list sample baseline: OA = 6/12, chance agreement = 1/4
+  const double blKappa = 1. / 3.;
+  const double blOA = 0.5;
+  std::cout << "Kappa = " << filter->GetMeasurements()->GetKappaIndex() << std::endl;
+  std::cout << "OA = " << filter->GetMeasurements()->GetOverallAccuracy() << std::endl;
+
+  if (vcl_abs(filter->GetMeasurements()->GetOverallAccuracy() - blOA) > 1e-6
+      || vcl_abs(filter->GetMeasurements()->GetKappaIndex() - blKappa) > 1e-6)
+    {
+    std::cout << "ERROR in Kappa/OA" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
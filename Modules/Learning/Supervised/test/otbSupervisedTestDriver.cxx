@@ -34,13 +34,17 @@ void RegisterTests()
   REGISTER_TEST(otbConfusionMatrixMeasurementsNew);
   REGISTER_TEST(otbConfusionMatrixMeasurementsTest);
   REGISTER_TEST(otbConfusionMatrixConcatenateTest);
+  REGISTER_TEST(otbStreamingConfusionMatrixImageFilter);
   REGISTER_TEST(otbExhaustiveExponentialOptimizerNew);
   REGISTER_TEST(otbExhaustiveExponentialOptimizerTest);
+  REGISTER_TEST(otbFlatForestTest);
   
   #ifdef OTB_USE_LIBSVM
   REGISTER_TEST(otbLibSVMMachineLearningModelCanRead);
   REGISTER_TEST(otbLibSVMMachineLearningModelNew);
   REGISTER_TEST(otbLibSVMMachineLearningModel);
+  REGISTER_TEST(otbLibSVMMachineLearningModelParallelCV);
+  REGISTER_TEST(otbLibSVMMachineLearningModelQuantized);
   REGISTER_TEST(otbLibSVMRegressionTests);
   REGISTER_TEST(otbLabelMapClassifierNew);
   REGISTER_TEST(otbLabelMapClassifier);
@@ -64,10 +68,13 @@ void RegisterTests()
   REGISTER_TEST(otbKNearestNeighborsMachineLearningModel);
   REGISTER_TEST(otbRandomForestsMachineLearningModelNew);
   REGISTER_TEST(otbRandomForestsMachineLearningModel);
+  REGISTER_TEST(otbRandomForestsMachineLearningModelPredictBatch);
+  REGISTER_TEST(otbRandomForestsMachineLearningModelFlatForest);
   REGISTER_TEST(otbBoostMachineLearningModelNew);
   REGISTER_TEST(otbBoostMachineLearningModel);
   REGISTER_TEST(otbANNMachineLearningModelNew);
   REGISTER_TEST(otbANNMachineLearningModel);
+  REGISTER_TEST(otbANNMachineLearningModelQuantized);
   REGISTER_TEST(otbNormalBayesMachineLearningModelNew);
   REGISTER_TEST(otbNormalBayesMachineLearningModel);
   REGISTER_TEST(otbDecisionTreeMachineLearningModelNew);
@@ -91,6 +98,7 @@ void RegisterTests()
   REGISTER_TEST(otbSharkRFMachineLearningModelNew);
   REGISTER_TEST(otbSharkRFMachineLearningModel);
   REGISTER_TEST(otbSharkRFMachineLearningModelCanRead);
+  REGISTER_TEST(otbSharkRFMachineLearningModelFlatForest);
   REGISTER_TEST(otbSharkImageClassificationFilter);
 #endif
 
@@ -182,6 +182,46 @@ bool ReadDataRegressionFile(const std::string & infname, InputListSampleRegressi
   return true;
 }
 
+// Check that the batch prediction gives the same labels, and the same
+// confidences when the model has a confidence index, as the per sample
+// prediction
+template <class TModel>
+bool CheckBatchPrediction(const TModel * model, const InputListSampleType * samples)
+{
+  typedef typename TModel::ConfidenceValueType      ConfidenceValueType;
+  typedef typename TModel::ConfidenceListSampleType ConfidenceListSampleType;
+
+  typename ConfidenceListSampleType::Pointer confidences;
+  if (model->HasConfidenceIndex())
+    {
+    confidences = ConfidenceListSampleType::New();
+    }
+  typename TModel::TargetListSampleType::Pointer predicted = model->PredictBatch(samples, confidences);
+
+  unsigned int nbErrors = 0;
+  for (unsigned int id = 0; id < samples->Size(); ++id)
+    {
+    ConfidenceValueType confidence = 0;
+    const typename TModel::TargetSampleType target =
+      model->Predict(samples->GetMeasurementVector(id), confidences.IsNotNull() ? &confidence : ITK_NULLPTR);
+    if (target[0] != predicted->GetMeasurementVector(id)[0])
+      {
+      ++nbErrors;
+      }
+    else if (confidences.IsNotNull())
+      {
+      const ConfidenceValueType batchConfidence = confidences->GetMeasurementVector(id)[0];
+      if (vcl_abs(confidence - batchConfidence) > 0.000001 * std::max(1., vcl_abs(static_cast<double>(confidence))))
+        {
+        ++nbErrors;
+        }
+      }
+    }
+
+  std::cout<<"Samples predicted differently in batch mode: "<<nbErrors<<std::endl;
+  return nbErrors == 0;
+}
+
 #ifdef OTB_USE_LIBSVM
 #include "otbLibSVMMachineLearningModel.h"
 int otbLibSVMMachineLearningModelNew(int itkNotUsed(argc), char * itkNotUsed(argv) [])
@@ -216,6 +256,11 @@ int otbLibSVMMachineLearningModel(int argc, char * argv[])
   classifier->SetTargetListSample(labels);
   classifier->Train();
 
+  if (!CheckBatchPrediction(classifier.GetPointer(), samples.GetPointer()))
+    {
+    return EXIT_FAILURE;
+    }
+
   TargetListSampleType::Pointer predicted = classifier->PredictBatch(samples, NULL);
 
   ConfusionMatrixCalculatorType::Pointer cmCalculator = ConfusionMatrixCalculatorType::New();
@@ -260,6 +305,129 @@ int otbLibSVMMachineLearningModel(int argc, char * argv[])
     return EXIT_FAILURE;
     }
 }
+
+int otbLibSVMMachineLearningModelParallelCV(int argc, char * argv[])
+{
+  if (argc != 2)
+    {
+      std::cout<<"Wrong number of arguments "<<std::endl;
+      std::cout<<"Usage : sample file "<<std::endl;
+      return EXIT_FAILURE;
+    }
+
+  typedef otb::LibSVMMachineLearningModel<InputValueType, TargetValueType> SVMType;
+  InputListSampleType::Pointer samples = InputListSampleType::New();
+  TargetListSampleType::Pointer labels = TargetListSampleType::New();
+
+  if (!ReadDataFile(argv[1], samples, labels))
+    {
+    std::cout << "Failed to read samples file " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Train twice, the selected parameters must not depend on the scheduling
+  double finalAccuracy[2];
+  double bestC[2];
+  for (unsigned int run = 0; run < 2; ++run)
+    {
+    SVMType::Pointer classifier = SVMType::New();
+    classifier->SetInputListSample(samples);
+    classifier->SetTargetListSample(labels);
+    classifier->SetParameterOptimization(true);
+    classifier->SetCoarseOptimizationNumberOfSteps(2);
+    classifier->SetFineOptimizationNumberOfSteps(2);
+    classifier->ParallelCrossValidationOn();
+    classifier->Train();
+
+    finalAccuracy[run] = classifier->GetFinalCrossValidationAccuracy();
+    bestC[run] = classifier->GetC();
+    std::cout << "Run " << run << ": initial accuracy " << classifier->GetInitialCrossValidationAccuracy()
+              << ", final accuracy " << finalAccuracy[run] << ", C " << bestC[run] << std::endl;
+
+    if (finalAccuracy[run] < classifier->GetInitialCrossValidationAccuracy())
+      {
+      std::cout << "The optimization decreased the accuracy" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  if (finalAccuracy[0] != finalAccuracy[1] || bestC[0] != bestC[1])
+    {
+    std::cout << "The parallel cross validation is not reproducible" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
+
+int otbLibSVMMachineLearningModelQuantized(int argc, char * argv[])
+{
+  if (argc != 2)
+    {
+      std::cout<<"Wrong number of arguments "<<std::endl;
+      std::cout<<"Usage : sample file "<<std::endl;
+      return EXIT_FAILURE;
+    }
+
+  typedef otb::LibSVMMachineLearningModel<InputValueType, TargetValueType> SVMType;
+  InputListSampleType::Pointer samples = InputListSampleType::New();
+  TargetListSampleType::Pointer labels = TargetListSampleType::New();
+
+  if (!ReadDataFile(argv[1], samples, labels))
+    {
+    std::cout << "Failed to read samples file " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  const int kernels[2] = {LINEAR, RBF};
+  for (unsigned int k = 0; k < 2; ++k)
+    {
+    SVMType::Pointer classifier = SVMType::New();
+    classifier->SetInputListSample(samples);
+    classifier->SetTargetListSample(labels);
+    classifier->SetKernelType(kernels[k]);
+    classifier->Train();
+
+    const double agreement = classifier->ComputeQuantizationAgreement(samples);
+    std::cout << "Kernel " << kernels[k] << ": agreement " << agreement << std::endl;
+
+    if (classifier->GetQuantizedInference() || agreement < 0.99)
+      {
+      return EXIT_FAILURE;
+      }
+    }
+
+  // The quantized model has no probability estimates
+  SVMType::Pointer probabilityClassifier = SVMType::New();
+  probabilityClassifier->SetInputListSample(samples);
+  probabilityClassifier->SetTargetListSample(labels);
+  probabilityClassifier->SetDoProbabilityEstimates(true);
+  probabilityClassifier->Train();
+  probabilityClassifier->SetQuantizedInference(true);
+  if (probabilityClassifier->HasConfidenceIndex())
+    {
+    std::cout << "Confidence index announced with the quantized inference" << std::endl;
+    return EXIT_FAILURE;
+    }
+  try
+    {
+    SVMType::ConfidenceValueType confidence;
+    probabilityClassifier->Predict(samples->GetMeasurementVector(0), &confidence);
+    std::cout << "No exception when asking a confidence to the quantized inference" << std::endl;
+    return EXIT_FAILURE;
+    }
+  catch (itk::ExceptionObject &)
+    {
+    }
+  probabilityClassifier->SetQuantizedInference(false);
+  if (!probabilityClassifier->HasConfidenceIndex())
+    {
+    std::cout << "Confidence index lost with the floating point inference" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
 #endif
 
 #ifdef OTB_USE_OPENCV
@@ -305,6 +473,11 @@ int otbSVMMachineLearningModel(int argc, char * argv[])
   classifier->SetTargetListSample(labels);
   classifier->Train();
 
+  if (!CheckBatchPrediction(classifier.GetPointer(), samples.GetPointer()))
+    {
+    return EXIT_FAILURE;
+    }
+
   TargetListSampleType::Pointer predicted = classifier->PredictBatch(samples, NULL);
 
   classifier->Save(argv[2]);
@@ -452,6 +625,11 @@ int otbKNearestNeighborsMachineLearningModel(int argc, char * argv[])
   //write the model
   classifier->Save(argv[2]);
 
+  if (!CheckBatchPrediction(classifier.GetPointer(), samples.GetPointer()))
+    {
+    return EXIT_FAILURE;
+    }
+
   TargetListSampleType::Pointer predicted = classifier->PredictBatch(samples, NULL);
 
   ConfusionMatrixCalculatorType::Pointer cmCalculator = ConfusionMatrixCalculatorType::New();
@@ -582,6 +760,79 @@ int otbRandomForestsMachineLearningModel(int argc, char * argv[])
     }
 }
 
+int otbRandomForestsMachineLearningModelPredictBatch(int argc, char * argv[])
+{
+  if (argc != 3 )
+    {
+    std::cout<<"Wrong number of arguments "<<std::endl;
+    std::cout<<"Usage : sample file, model file "<<std::endl;
+    return EXIT_FAILURE;
+    }
+
+  typedef otb::RandomForestsMachineLearningModel<InputValueType,TargetValueType> RandomForestType;
+  InputListSampleType::Pointer samples = InputListSampleType::New();
+  TargetListSampleType::Pointer labels = TargetListSampleType::New();
+
+  if(!ReadDataFile(argv[1],samples,labels))
+    {
+    std::cout<<"Failed to read samples file "<<argv[1]<<std::endl;
+    return EXIT_FAILURE;
+    }
+
+  RandomForestType::Pointer classifier = RandomForestType::New();
+  classifier->Load(argv[2]);
+
+  // The batch prediction must give the same labels and confidences as
+  // the per sample prediction
+  return (CheckBatchPrediction(classifier.GetPointer(), samples.GetPointer()) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+int otbRandomForestsMachineLearningModelFlatForest(int argc, char * argv[])
+{
+  if (argc != 3 )
+    {
+    std::cout<<"Wrong number of arguments "<<std::endl;
+    std::cout<<"Usage : sample file, model file "<<std::endl;
+    return EXIT_FAILURE;
+    }
+
+  typedef otb::RandomForestsMachineLearningModel<InputValueType,TargetValueType> RandomForestType;
+  typedef RandomForestType::ConfidenceValueType                                   ConfidenceValueType;
+  typedef RandomForestType::ConfidenceListSampleType                              ConfidenceListSampleType;
+  InputListSampleType::Pointer samples = InputListSampleType::New();
+  TargetListSampleType::Pointer labels = TargetListSampleType::New();
+
+  if(!ReadDataFile(argv[1],samples,labels))
+    {
+    std::cout<<"Failed to read samples file "<<argv[1]<<std::endl;
+    return EXIT_FAILURE;
+    }
+
+  RandomForestType::Pointer classifier = RandomForestType::New();
+  classifier->FlatForestInferenceOn();
+  classifier->Load(argv[2]);
+
+  // The batch prediction through the flat forest must give the same
+  // labels and confidences as the OpenCV per sample prediction
+  ConfidenceListSampleType::Pointer confidences = ConfidenceListSampleType::New();
+  TargetListSampleType::Pointer predicted = classifier->PredictBatch(samples, confidences);
+
+  unsigned int nbErrors = 0;
+  for (unsigned int id = 0; id < samples->Size(); ++id)
+    {
+    ConfidenceValueType confidence = 0;
+    const TargetSampleType target = classifier->Predict(samples->GetMeasurementVector(id), &confidence);
+    if (target[0] != predicted->GetMeasurementVector(id)[0]
+        || vcl_abs(confidence - confidences->GetMeasurementVector(id)[0]) > 0.000001)
+      {
+      ++nbErrors;
+      }
+    }
+
+  std::cout<<"Samples predicted differently by the flat forest: "<<nbErrors<<std::endl;
+  return (nbErrors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
 int otbBoostMachineLearningModelNew(int itkNotUsed(argc), char * itkNotUsed(argv) [])
 {
   typedef otb::BoostMachineLearningModel<InputValueType,TargetValueType> BoostType;
@@ -623,6 +874,11 @@ int otbBoostMachineLearningModel(int argc, char * argv[])
   classifier->SetTargetListSample(labels);
   classifier->Train();
 
+  if (!CheckBatchPrediction(classifier.GetPointer(), samples.GetPointer()))
+    {
+    return EXIT_FAILURE;
+    }
+
   TargetListSampleType::Pointer predicted = classifier->PredictBatch(samples, NULL);
 
   classifier->Save(argv[2]);
@@ -713,6 +969,11 @@ int otbANNMachineLearningModel(int argc, char * argv[])
   classifier->SetEpsilon(0.01); */
   classifier->Train();
 
+  if (!CheckBatchPrediction(classifier.GetPointer(), samples.GetPointer()))
+    {
+    return EXIT_FAILURE;
+    }
+
   TargetListSampleType::Pointer predicted = classifier->PredictBatch(samples, NULL);
 
   ConfusionMatrixCalculatorType::Pointer cmCalculator = ConfusionMatrixCalculatorType::New();
@@ -758,6 +1019,47 @@ int otbANNMachineLearningModel(int argc, char * argv[])
     }
 }
 
+int otbANNMachineLearningModelQuantized(int argc, char * argv[])
+{
+  if (argc != 2)
+    {
+      std::cout<<"Wrong number of arguments "<<std::endl;
+      std::cout<<"Usage : sample file "<<std::endl;
+      return EXIT_FAILURE;
+    }
+
+  typedef otb::NeuralNetworkMachineLearningModel<InputValueType, TargetValueType> ANNType;
+  InputListSampleType::Pointer samples = InputListSampleType::New();
+  TargetListSampleType::Pointer labels = TargetListSampleType::New();
+
+  if (!ReadDataFile(argv[1], samples, labels))
+    {
+    std::cout << "Failed to read samples file " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  std::vector<unsigned int> layerSizes;
+  layerSizes.push_back(16);
+  layerSizes.push_back(100);
+  layerSizes.push_back(26);
+
+  ANNType::Pointer classifier = ANNType::New();
+  classifier->SetInputListSample(samples);
+  classifier->SetTargetListSample(labels);
+  classifier->SetLayerSizes(layerSizes);
+  classifier->Train();
+
+  const double agreement = classifier->ComputeQuantizationAgreement(samples);
+  std::cout << "Agreement: " << agreement << std::endl;
+
+  if (classifier->GetQuantizedInference() || agreement < 0.99)
+    {
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
+
 int otbNormalBayesMachineLearningModelNew(int itkNotUsed(argc), char * itkNotUsed(argv) [])
 {
   typedef otb::NormalBayesMachineLearningModel<InputValueType,TargetValueType> NormalBayesType;
@@ -790,6 +1092,11 @@ int otbNormalBayesMachineLearningModel(int argc, char * argv[])
   classifier->SetTargetListSample(labels);
   classifier->Train();
 
+  if (!CheckBatchPrediction(classifier.GetPointer(), samples.GetPointer()))
+    {
+    return EXIT_FAILURE;
+    }
+
   TargetListSampleType::Pointer predicted = classifier->PredictBatch(samples, NULL);
 
   classifier->Save(argv[2]);
@@ -867,6 +1174,11 @@ int otbDecisionTreeMachineLearningModel(int argc, char * argv[])
   classifier->SetTargetListSample(labels);
   classifier->Train();
 
+  if (!CheckBatchPrediction(classifier.GetPointer(), samples.GetPointer()))
+    {
+    return EXIT_FAILURE;
+    }
+
   TargetListSampleType::Pointer predicted = classifier->PredictBatch(samples, NULL);
 
   classifier->Save(argv[2]);
@@ -945,6 +1257,11 @@ int otbGradientBoostedTreeMachineLearningModel(int argc, char * argv[])
   classifier->SetTargetListSample(labels);
   classifier->Train();
 
+  if (!CheckBatchPrediction(classifier.GetPointer(), samples.GetPointer()))
+    {
+    return EXIT_FAILURE;
+    }
+
   TargetListSampleType::Pointer predicted = classifier->PredictBatch(samples, NULL);
 
   classifier->Save(argv[2]);
@@ -1237,5 +1554,50 @@ int otbSharkRFMachineLearningModel(int argc, char * argv[])
    return EXIT_SUCCESS;
 }
 
+int otbSharkRFMachineLearningModelFlatForest(int argc, char * argv[])
+{
+  if (argc != 3 )
+    {
+    std::cout<<"Wrong number of arguments "<<std::endl;
+    std::cout<<"Usage : sample file, model file "<<std::endl;
+    return EXIT_FAILURE;
+    }
+
+  typedef otb::SharkRandomForestsMachineLearningModel<InputValueType,TargetValueType> RandomForestType;
+  typedef RandomForestType::ConfidenceListSampleType                                   ConfidenceListSampleType;
+  InputListSampleType::Pointer samples = InputListSampleType::New();
+  TargetListSampleType::Pointer labels = TargetListSampleType::New();
+
+  if(!SharkReadDataFile(argv[1],samples,labels))
+    {
+    std::cout<<"Failed to read samples file "<<argv[1]<<std::endl;
+    return EXIT_FAILURE;
+    }
+
+  RandomForestType::Pointer classifier = RandomForestType::New();
+  classifier->Load(argv[2]);
+  ConfidenceListSampleType::Pointer confidences = ConfidenceListSampleType::New();
+  TargetListSampleType::Pointer predicted = classifier->PredictBatch(samples, confidences);
+
+  RandomForestType::Pointer flatClassifier = RandomForestType::New();
+  flatClassifier->FlatForestInferenceOn();
+  flatClassifier->Load(argv[2]);
+  ConfidenceListSampleType::Pointer flatConfidences = ConfidenceListSampleType::New();
+  TargetListSampleType::Pointer flatPredicted = flatClassifier->PredictBatch(samples, flatConfidences);
+
+  unsigned int nbErrors = 0;
+  for (unsigned int id = 0; id < samples->Size(); ++id)
+    {
+    if (predicted->GetMeasurementVector(id)[0] != flatPredicted->GetMeasurementVector(id)[0]
+        || vcl_abs(confidences->GetMeasurementVector(id)[0] - flatConfidences->GetMeasurementVector(id)[0]) > 0.000001)
+      {
+      ++nbErrors;
+      }
+    }
+
+  std::cout<<"Samples predicted differently by the flat forest: "<<nbErrors<<std::endl;
+  return (nbErrors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
 
 #endif
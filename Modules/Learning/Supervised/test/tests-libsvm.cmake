@@ -26,6 +26,16 @@ otb_add_test(NAME leTvLibSVMMachineLearningModel COMMAND otbSupervisedTestDriver
 otb_add_test(NAME leTuLibSVMMachineLearningModelNew COMMAND otbSupervisedTestDriver
   otbLibSVMMachineLearningModelNew)
 
+otb_add_test(NAME leTvLibSVMMachineLearningModelParallelCV COMMAND otbSupervisedTestDriver
+  otbLibSVMMachineLearningModelParallelCV
+  ${INPUTDATA}/letter.scale
+  )
+
+otb_add_test(NAME leTvLibSVMMachineLearningModelQuantized COMMAND otbSupervisedTestDriver
+  otbLibSVMMachineLearningModelQuantized
+  ${INPUTDATA}/letter.scale
+  )
+
 otb_add_test(NAME leTvImageClassificationFilterLibSVM COMMAND otbSupervisedTestDriver
   --compare-image ${NOTOL}
   ${BASELINE}/leSVMImageClassificationFilterOutput.tif
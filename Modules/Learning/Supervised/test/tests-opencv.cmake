@@ -30,6 +30,11 @@ otb_add_test(NAME leTvANNMachineLearningModel COMMAND otbSupervisedTestDriver
   ${TEMP}/ann_model.txt
   )
 
+otb_add_test(NAME leTvANNMachineLearningModelQuantized COMMAND otbSupervisedTestDriver
+  otbANNMachineLearningModelQuantized
+  ${INPUTDATA}/letter.scale
+  )
+
 # ------------------ Regression tests --------------------
 otb_add_test(NAME leTvANNMachineLearningModelReg COMMAND otbSupervisedTestDriver
   otbNeuralNetworkRegressionTests
@@ -181,6 +186,20 @@ otb_add_test(NAME leTvRandomForestsMachineLearningModelCanRead COMMAND otbSuperv
   )
 set_property(TEST leTvRandomForestsMachineLearningModelCanRead PROPERTY DEPENDS leTvRandomForestsMachineLearningModel)
 
+otb_add_test(NAME leTvRandomForestsMachineLearningModelPredictBatch COMMAND otbSupervisedTestDriver
+  otbRandomForestsMachineLearningModelPredictBatch
+  ${INPUTDATA}/letter.scale
+  ${TEMP}/rf_model.txt
+  )
+set_property(TEST leTvRandomForestsMachineLearningModelPredictBatch PROPERTY DEPENDS leTvRandomForestsMachineLearningModel)
+
+otb_add_test(NAME leTvRandomForestsMachineLearningModelFlatForest COMMAND otbSupervisedTestDriver
+  otbRandomForestsMachineLearningModelFlatForest
+  ${INPUTDATA}/letter.scale
+  ${TEMP}/rf_model.txt
+  )
+set_property(TEST leTvRandomForestsMachineLearningModelFlatForest PROPERTY DEPENDS leTvRandomForestsMachineLearningModel)
+
 otb_add_test(NAME leTvKNNMachineLearningModelCanRead COMMAND otbSupervisedTestDriver
   otbKNNMachineLearningModelCanRead
   ${TEMP}/knn_model.txt
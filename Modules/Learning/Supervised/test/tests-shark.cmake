@@ -27,6 +27,13 @@ otb_add_test(NAME leTvSharkRFMachineLearningModel COMMAND otbSupervisedTestDrive
   ${TEMP}/shark_rf_model.txt
   )
 
+otb_add_test(NAME leTvSharkRFMachineLearningModelFlatForest COMMAND otbSupervisedTestDriver
+  otbSharkRFMachineLearningModelFlatForest
+  ${INPUTDATA}/letter.scale
+  ${TEMP}/shark_rf_model.txt
+  )
+set_property(TEST leTvSharkRFMachineLearningModelFlatForest PROPERTY DEPENDS leTvSharkRFMachineLearningModel)
+
 otb_add_test(NAME leTvSharkRFMachineLearningModelCanRead COMMAND otbSupervisedTestDriver
   otbSharkRFMachineLearningModelCanRead
   ${INPUTDATA}/Classification/otbSharkImageClassificationFilter_RFmodel.txt
@@ -121,6 +121,13 @@ public:
   itkGetMacro( Normalized, bool );
   itkSetMacro( Normalized, bool );
 
+  /** Get the centroids of the model, one sample per cluster */
+  void GetCentroids(InputListSampleType * centroids) const;
+
+  /** Set the centroids of the model, one sample per cluster. This allows
+   * using centroids estimated outside of Train(). */
+  void SetCentroids(const InputListSampleType * centroids);
+
 protected:
   /** Constructor */
   SharkKMeansMachineLearningModel();
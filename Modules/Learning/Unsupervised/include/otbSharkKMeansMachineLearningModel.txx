@@ -72,9 +72,8 @@ SharkKMeansMachineLearningModel<TInputValue, TOutputValue>
 ::Train()
 {
   // Parse input data and convert to Shark Data
-  std::vector<shark::RealVector> vector_data;
-  otb::Shark::ListSampleToSharkVector( this->GetInputListSample(), vector_data );
-  shark::Data<shark::RealVector> data = shark::createDataFromRange( vector_data );
+  shark::Data<shark::RealVector> data;
+  otb::Shark::ListSampleToSharkData( this->GetInputListSample(), data );
 
   // Normalized input value if necessary
   if( m_Normalized )
@@ -85,6 +84,46 @@ SharkKMeansMachineLearningModel<TInputValue, TOutputValue>
   m_ClusteringModel = boost::make_shared<ClusteringModelType>( &m_Centroids );
 }
 
+template<class TInputValue, class TOutputValue>
+void
+SharkKMeansMachineLearningModel<TInputValue, TOutputValue>
+::GetCentroids(InputListSampleType * centroids) const
+{
+  assert( centroids != ITK_NULLPTR );
+
+  centroids->Clear();
+  bool sizeSet = false;
+  for( const auto &c : m_Centroids.centroids().elements() )
+    {
+    if( !sizeSet )
+      {
+      centroids->SetMeasurementVectorSize( c.size() );
+      sizeSet = true;
+      }
+    InputSampleType sample( c.size() );
+    for( size_t i = 0; i < c.size(); ++i )
+      {
+      sample[i] = static_cast<InputValueType>(c( i ));
+      }
+    centroids->PushBack( sample );
+    }
+}
+
+template<class TInputValue, class TOutputValue>
+void
+SharkKMeansMachineLearningModel<TInputValue, TOutputValue>
+::SetCentroids(const InputListSampleType * centroids)
+{
+  assert( centroids != ITK_NULLPTR );
+
+  shark::Data<shark::RealVector> data;
+  otb::Shark::ListSampleToSharkData( centroids, data );
+  m_Centroids.setCentroids( data );
+  m_K = static_cast<unsigned int>(centroids->Size());
+  m_ClusteringModel = boost::make_shared<ClusteringModelType>( &m_Centroids );
+  this->Modified();
+}
+
 template<class TInputValue, class TOutputValue>
 template<typename DataType>
 DataType
@@ -132,24 +171,11 @@ SharkKMeansMachineLearningModel<TInputValue, TOutputValue>
                  ConfidenceListSampleType *quality) const
 {
 
-  // Perform check on input values
-  assert( input != ITK_NULLPTR );
-  assert( targets != ITK_NULLPTR );
-
-  // input list sample and target list sample should be initialized and without
-  assert( input->Size() == targets->Size() && "Input sample list and target label list do not have the same size." );
-  assert( ( ( quality == ITK_NULLPTR ) || ( quality->Size() == input->Size() ) ) &&
-          "Quality samples list is not null and does not have the same size as input samples list" );
-  if( startIndex + size > input->Size() )
-    {
-    itkExceptionMacro(
-            <<"requested range ["<<startIndex<<", "<<startIndex+size<<"[ partially outside input sample list range.[0,"<<input->Size()<<"[" );
-    }
+  this->CheckPredictBatchArguments(input, startIndex, size, targets, quality);
 
   // Convert input list of features to shark data format
-  std::vector<shark::RealVector> features;
-  otb::Shark::ListSampleRangeToSharkVector( input, features, startIndex, size );
-  shark::Data<shark::RealVector> inputSamples = shark::createDataFromRange( features );
+  shark::Data<shark::RealVector> inputSamples;
+  otb::Shark::ListSampleRangeToSharkData( input, inputSamples, startIndex, size );
 
   shark::Data<ClusteringOutputType> clusters;
   try
@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingMiniBatchKMeansImageFilter_h
+#define otbStreamingMiniBatchKMeansImageFilter_h
+
+#include "otbPersistentImageFilter.h"
+#include "otbPersistentFilterStreamingDecorator.h"
+#include "otbImage.h"
+#include "itkVariableLengthVector.h"
+#include <vector>
+
+namespace otb
+{
+
+/** \class PersistentMiniBatchKMeansImageFilter
+ * \brief Refine KMeans centroids with mini-batches of streamed pixels
+ *
+ * Each piece of the image processed by this filter is a mini-batch:
+ * its pixels are assigned to the nearest centroid, the per-thread sums
+ * are merged, then every centroid moves toward the mean of the pixels
+ * assigned to it, with a learning rate equal to the inverse of the number
+ * of pixels it received since the last Reset(). Memory does not depend on
+ * the image size, so all the pixels of a large image can be used.
+ *
+ * The centroids start from the initial centroids at Reset(). Pixels
+ * where the optional mask is zero are ignored.
+ *
+ * \sa PersistentImageFilter
+ * \ingroup Streamed
+ * \ingroup Multithreaded
+ *
+ * \ingroup OTBUnsupervised
+ */
+template<class TInputImage, class TMaskImage = otb::Image<unsigned char, 2> >
+class ITK_EXPORT PersistentMiniBatchKMeansImageFilter :
+  public PersistentImageFilter<TInputImage, TInputImage>
+{
+public:
+  /** Standard Self typedef */
+  typedef PersistentMiniBatchKMeansImageFilter            Self;
+  typedef PersistentImageFilter<TInputImage, TInputImage> Superclass;
+  typedef itk::SmartPointer<Self>                         Pointer;
+  typedef itk::SmartPointer<const Self>                   ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(PersistentMiniBatchKMeansImageFilter, PersistentImageFilter);
+
+  /** Image related typedefs. */
+  typedef TInputImage                             ImageType;
+  typedef typename TInputImage::Pointer           InputImagePointer;
+  typedef typename TInputImage::RegionType        RegionType;
+  typedef typename TInputImage::PixelType         PixelType;
+  typedef typename TInputImage::InternalPixelType InternalPixelType;
+  typedef TMaskImage                              MaskImageType;
+
+  /** Type to use for computations. */
+  typedef typename itk::NumericTraits<InternalPixelType>::RealType RealType;
+  typedef itk::VariableLengthVector<RealType>                      RealPixelType;
+  typedef std::vector<RealPixelType>                               CentroidsType;
+  typedef std::vector<unsigned long>                               CountsType;
+
+  /** Set/Get the optional validity mask */
+  void SetMask(const MaskImageType * mask);
+  const MaskImageType * GetMask();
+
+  /** Centroids used at the first piece after Reset() */
+  void SetInitialCentroids(const CentroidsType & centroids);
+  itkGetConstReferenceMacro(InitialCentroids, CentroidsType);
+
+  /** Current centroids */
+  itkGetConstReferenceMacro(Centroids, CentroidsType);
+
+  /** Number of pixels assigned to each centroid since the last Reset() */
+  itkGetConstReferenceMacro(Counts, CountsType);
+
+  /** Pass the input through unmodified. Do this by Grafting in the
+   *  AllocateOutputs method.
+   */
+  void AllocateOutputs() ITK_OVERRIDE;
+  void GenerateOutputInformation() ITK_OVERRIDE;
+  void Synthetize(void) ITK_OVERRIDE;
+  void Reset(void) ITK_OVERRIDE;
+
+protected:
+  PersistentMiniBatchKMeansImageFilter();
+  ~PersistentMiniBatchKMeansImageFilter() ITK_OVERRIDE {}
+  void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
+
+  /** Clear the per-thread sums of the piece */
+  void BeforeThreadedGenerateData() ITK_OVERRIDE;
+  /** Multi-thread version GenerateData. */
+  void ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId) ITK_OVERRIDE;
+  /** Merge the per-thread sums and move the centroids */
+  void AfterThreadedGenerateData() ITK_OVERRIDE;
+
+private:
+  PersistentMiniBatchKMeansImageFilter(const Self &); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+
+  CentroidsType              m_InitialCentroids;
+  CentroidsType              m_Centroids;
+  CountsType                 m_Counts;
+
+  /** Sum and number of the pixels assigned to each centroid (per thread) */
+  std::vector<CentroidsType> m_ThreadSums;
+  std::vector<CountsType>    m_ThreadCounts;
+
+}; // end of class PersistentMiniBatchKMeansImageFilter
+
+/**===========================================================================*/
+
+/** \class StreamingMiniBatchKMeansImageFilter
+ * \brief This class streams the whole input image through the PersistentMiniBatchKMeansImageFilter.
+ *
+ * The image is streamed NumberOfPasses times. The centroids are reset to
+ * the initial centroids before the first pass only, so that every pass
+ * keeps refining them.
+ *
+ * \sa PersistentMiniBatchKMeansImageFilter
+ * \sa PersistentFilterStreamingDecorator
+ * \sa StreamingImageVirtualWriter
+ * \ingroup Streamed
+ * \ingroup Multithreaded
+ *
+ * \ingroup OTBUnsupervised
+ */
+template<class TInputImage, class TMaskImage = otb::Image<unsigned char, 2> >
+class ITK_EXPORT StreamingMiniBatchKMeansImageFilter :
+  public PersistentFilterStreamingDecorator<PersistentMiniBatchKMeansImageFilter<TInputImage, TMaskImage> >
+{
+public:
+  /** Standard Self typedef */
+  typedef StreamingMiniBatchKMeansImageFilter Self;
+  typedef PersistentFilterStreamingDecorator
+  <PersistentMiniBatchKMeansImageFilter<TInputImage, TMaskImage> > Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(StreamingMiniBatchKMeansImageFilter, PersistentFilterStreamingDecorator);
+
+  typedef TInputImage                               InputImageType;
+  typedef TMaskImage                                MaskImageType;
+  typedef typename Superclass::FilterType           KMeansFilterType;
+  typedef typename KMeansFilterType::RealPixelType  RealPixelType;
+  typedef typename KMeansFilterType::CentroidsType  CentroidsType;
+  typedef typename KMeansFilterType::CountsType     CountsType;
+
+  using Superclass::SetInput;
+  void SetInput(InputImageType * input)
+  {
+    this->GetFilter()->SetInput(input);
+  }
+  const InputImageType * GetInput()
+  {
+    return this->GetFilter()->GetInput();
+  }
+
+  void SetMask(const MaskImageType * mask)
+  {
+    this->GetFilter()->SetMask(mask);
+  }
+
+  void SetInitialCentroids(const CentroidsType & centroids)
+  {
+    this->GetFilter()->SetInitialCentroids(centroids);
+  }
+
+  /** Return the refined centroids */
+  const CentroidsType & GetCentroids() const
+  {
+    return this->GetFilter()->GetCentroids();
+  }
+
+  /** Return the number of pixels assigned to each centroid */
+  const CountsType & GetCounts() const
+  {
+    return this->GetFilter()->GetCounts();
+  }
+
+  /** Number of times the whole image is streamed, default : 1 */
+  itkSetMacro(NumberOfPasses, unsigned int);
+  itkGetMacro(NumberOfPasses, unsigned int);
+
+protected:
+  /** Constructor */
+  StreamingMiniBatchKMeansImageFilter() : m_NumberOfPasses(1) {}
+  /** Destructor */
+  ~StreamingMiniBatchKMeansImageFilter() ITK_OVERRIDE {}
+
+  /** Stream the image NumberOfPasses times between Reset() and Synthetize() */
+  void GenerateData(void) ITK_OVERRIDE;
+
+private:
+  StreamingMiniBatchKMeansImageFilter(const Self &); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+
+  unsigned int m_NumberOfPasses;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbStreamingMiniBatchKMeansImageFilter.txx"
+#endif
+
+#endif
@@ -0,0 +1,287 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingMiniBatchKMeansImageFilter_txx
+#define otbStreamingMiniBatchKMeansImageFilter_txx
+#include "otbStreamingMiniBatchKMeansImageFilter.h"
+
+#include "itkImageRegionConstIterator.h"
+#include "itkNumericTraits.h"
+#include "itkProgressReporter.h"
+#include "otbMacro.h"
+
+namespace otb
+{
+
+template<class TInputImage, class TMaskImage>
+PersistentMiniBatchKMeansImageFilter<TInputImage, TMaskImage>
+::PersistentMiniBatchKMeansImageFilter()
+{
+  this->SetNumberOfRequiredInputs(1);
+}
+
+template<class TInputImage, class TMaskImage>
+void
+PersistentMiniBatchKMeansImageFilter<TInputImage, TMaskImage>
+::SetMask(const MaskImageType * mask)
+{
+  this->itk::ProcessObject::SetNthInput(1, const_cast<MaskImageType *>(mask));
+}
+
+template<class TInputImage, class TMaskImage>
+const typename PersistentMiniBatchKMeansImageFilter<TInputImage, TMaskImage>::MaskImageType *
+PersistentMiniBatchKMeansImageFilter<TInputImage, TMaskImage>
+::GetMask()
+{
+  if (this->GetNumberOfInputs() < 2)
+    {
+    return ITK_NULLPTR;
+    }
+  return static_cast<const MaskImageType *>(this->itk::ProcessObject::GetInput(1));
+}
+
+template<class TInputImage, class TMaskImage>
+void
+PersistentMiniBatchKMeansImageFilter<TInputImage, TMaskImage>
+::SetInitialCentroids(const CentroidsType & centroids)
+{
+  m_InitialCentroids = centroids;
+  this->Modified();
+}
+
+template<class TInputImage, class TMaskImage>
+void
+PersistentMiniBatchKMeansImageFilter<TInputImage, TMaskImage>
+::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+  if (this->GetInput())
+    {
+    this->GetOutput()->CopyInformation(this->GetInput());
+    this->GetOutput()->SetLargestPossibleRegion(this->GetInput()->GetLargestPossibleRegion());
+
+    if (this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() == 0)
+      {
+      this->GetOutput()->SetRequestedRegion(this->GetOutput()->GetLargestPossibleRegion());
+      }
+    }
+}
+
+template<class TInputImage, class TMaskImage>
+void
+PersistentMiniBatchKMeansImageFilter<TInputImage, TMaskImage>
+::AllocateOutputs()
+{
+  // This is commented to prevent the streaming of the whole image for the first stream strip
+  // It shall not cause any problem because the output image of this filter is not intended to be used.
+  //InputImagePointer image = const_cast< TInputImage * >( this->GetInput() );
+  //this->GraftOutput( image );
+  // Nothing that needs to be allocated for the remaining outputs
+}
+
+template<class TInputImage, class TMaskImage>
+void
+PersistentMiniBatchKMeansImageFilter<TInputImage, TMaskImage>
+::Reset()
+{
+  TInputImage * inputPtr = const_cast<TInputImage *>(this->GetInput());
+  inputPtr->UpdateOutputInformation();
+
+  const unsigned int numberOfComponent = inputPtr->GetNumberOfComponentsPerPixel();
+
+  if (m_InitialCentroids.empty())
+    {
+    itkExceptionMacro(<< "No initial centroids.");
+    }
+  for (unsigned int k = 0; k < m_InitialCentroids.size(); ++k)
+    {
+    if (m_InitialCentroids[k].GetSize() != numberOfComponent)
+      {
+      itkExceptionMacro(<< "Centroid " << k << " has " << m_InitialCentroids[k].GetSize()
+                        << " components, the image has " << numberOfComponent << ".");
+      }
+    }
+
+  m_Centroids = m_InitialCentroids;
+  m_Counts = CountsType(m_Centroids.size(), 0);
+}
+
+template<class TInputImage, class TMaskImage>
+void
+PersistentMiniBatchKMeansImageFilter<TInputImage, TMaskImage>
+::Synthetize()
+{
+  // The centroids are updated after each piece, nothing left to merge
+  for (unsigned int k = 0; k < m_Centroids.size(); ++k)
+    {
+    otbMsgDevMacro(<< "Centroid " << k << ": " << m_Centroids[k] << " (" << m_Counts[k] << " pixels)");
+    }
+}
+
+template<class TInputImage, class TMaskImage>
+void
+PersistentMiniBatchKMeansImageFilter<TInputImage, TMaskImage>
+::BeforeThreadedGenerateData()
+{
+  const unsigned int numberOfThreads = this->GetNumberOfThreads();
+  const unsigned int numberOfComponent = this->GetInput()->GetNumberOfComponentsPerPixel();
+
+  RealPixelType zero(numberOfComponent);
+  zero.Fill(itk::NumericTraits<RealType>::Zero);
+
+  m_ThreadSums = std::vector<CentroidsType>(numberOfThreads, CentroidsType(m_Centroids.size(), zero));
+  m_ThreadCounts = std::vector<CountsType>(numberOfThreads, CountsType(m_Centroids.size(), 0));
+}
+
+template<class TInputImage, class TMaskImage>
+void
+PersistentMiniBatchKMeansImageFilter<TInputImage, TMaskImage>
+::ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId)
+{
+  InputImagePointer inputPtr = const_cast<TInputImage *>(this->GetInput());
+  const MaskImageType * maskPtr = this->GetMask();
+
+  // support progress methods/callbacks
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  itk::ImageRegionConstIterator<TInputImage> it(inputPtr, outputRegionForThread);
+  itk::ImageRegionConstIterator<MaskImageType> maskIt;
+  if (maskPtr)
+    {
+    maskIt = itk::ImageRegionConstIterator<MaskImageType>(maskPtr, outputRegionForThread);
+    maskIt.GoToBegin();
+    }
+
+  const unsigned int nbCentroids = m_Centroids.size();
+  const unsigned int numberOfComponent = inputPtr->GetNumberOfComponentsPerPixel();
+  CentroidsType& sums = m_ThreadSums[threadId];
+  CountsType& counts = m_ThreadCounts[threadId];
+  RealPixelType value(numberOfComponent);
+
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+    bool valid = true;
+    if (maskPtr)
+      {
+      valid = (maskIt.Get() != 0);
+      ++maskIt;
+      }
+
+    if (valid)
+      {
+      const PixelType& pixel = it.Get();
+      for (unsigned int j = 0; j < numberOfComponent; ++j)
+        {
+        value[j] = static_cast<RealType>(pixel[j]);
+        }
+
+      // Nearest centroid, the first one in case of ties
+      unsigned int nearest = 0;
+      RealType nearestDistance = itk::NumericTraits<RealType>::max();
+      for (unsigned int k = 0; k < nbCentroids; ++k)
+        {
+        RealType distance = itk::NumericTraits<RealType>::Zero;
+        for (unsigned int j = 0; j < numberOfComponent; ++j)
+          {
+          const RealType diff = value[j] - m_Centroids[k][j];
+          distance += diff * diff;
+          }
+        if (distance < nearestDistance)
+          {
+          nearestDistance = distance;
+          nearest = k;
+          }
+        }
+
+      sums[nearest] += value;
+      ++counts[nearest];
+      }
+    progress.CompletedPixel();
+    }
+}
+
+template<class TInputImage, class TMaskImage>
+void
+PersistentMiniBatchKMeansImageFilter<TInputImage, TMaskImage>
+::AfterThreadedGenerateData()
+{
+  const unsigned int numberOfComponent = this->GetInput()->GetNumberOfComponentsPerPixel();
+
+  for (unsigned int k = 0; k < m_Centroids.size(); ++k)
+    {
+    // Merge the threads in a fixed order to get reproducible centroids
+    unsigned long count = 0;
+    RealPixelType sum(numberOfComponent);
+    sum.Fill(itk::NumericTraits<RealType>::Zero);
+    for (unsigned int t = 0; t < m_ThreadSums.size(); ++t)
+      {
+      count += m_ThreadCounts[t][k];
+      sum += m_ThreadSums[t][k];
+      }
+
+    if (count == 0)
+      {
+      continue;
+      }
+
+    // c <- c + (sum - count * c) / n, n being all the pixels seen by c
+    m_Counts[k] += count;
+    const RealType rate = static_cast<RealType>(1) / static_cast<RealType>(m_Counts[k]);
+    for (unsigned int j = 0; j < numberOfComponent; ++j)
+      {
+      m_Centroids[k][j] += rate * (sum[j] - static_cast<RealType>(count) * m_Centroids[k][j]);
+      }
+    }
+}
+
+template<class TInputImage, class TMaskImage>
+void
+PersistentMiniBatchKMeansImageFilter<TInputImage, TMaskImage>
+::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Number of centroids: " << m_Centroids.size() << std::endl;
+  for (unsigned int k = 0; k < m_Centroids.size(); ++k)
+    {
+    os << indent << "Centroid " << k << ": " << m_Centroids[k] << std::endl;
+    }
+}
+
+template<class TInputImage, class TMaskImage>
+void
+StreamingMiniBatchKMeansImageFilter<TInputImage, TMaskImage>
+::GenerateData(void)
+{
+  this->GetFilter()->Reset();
+
+  this->GetStreamer()->SetInput(this->GetFilter()->GetOutput());
+  for (unsigned int pass = 0; pass < m_NumberOfPasses; ++pass)
+    {
+    // Force the pieces to go through the filter again
+    this->GetFilter()->Modified();
+    this->GetStreamer()->Update();
+    }
+
+  this->GetFilter()->Synthetize();
+}
+
+} // end namespace otb
+#endif
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbVectorImage.h"
+#include "otbImage.h"
+#include "otbStreamingMiniBatchKMeansImageFilter.h"
+
+int otbStreamingMiniBatchKMeansImageFilter(int itkNotUsed(argc), char * itkNotUsed(argv) [])
+{
+  typedef otb::VectorImage<float, 2>                                    ImageType;
+  typedef otb::Image<unsigned char, 2>                                  MaskType;
+  typedef otb::StreamingMiniBatchKMeansImageFilter<ImageType, MaskType> KMeansFilterType;
+
+  // Two constant halves, and masked lines with outlier values
+  ImageType::RegionType region;
+  region.SetSize(0, 100);
+  region.SetSize(1, 60);
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->SetNumberOfComponentsPerPixel(2);
+  image->Allocate();
+
+  MaskType::Pointer mask = MaskType::New();
+  mask->SetRegions(region);
+  mask->Allocate();
+
+  ImageType::PixelType pixel(2);
+  for (unsigned int y = 0; y < 60; ++y)
+    {
+    for (unsigned int x = 0; x < 100; ++x)
+      {
+      ImageType::IndexType index;
+      index[0] = x;
+      index[1] = y;
+      pixel[0] = (x < 50 ? 0. : 100.);
+      pixel[1] = (x < 50 ? 10. : 50.);
+      if (y >= 50)
+        {
+        pixel.Fill(1000.);
+        }
+      image->SetPixel(index, pixel);
+      mask->SetPixel(index, (y < 50 ? 1 : 0));
+      }
+    }
+
+  KMeansFilterType::CentroidsType initialCentroids(2, KMeansFilterType::RealPixelType(2));
+  initialCentroids[0][0] = 20.;
+  initialCentroids[0][1] = 20.;
+  initialCentroids[1][0] = 70.;
+  initialCentroids[1][1] = 40.;
+
+  KMeansFilterType::Pointer filter = KMeansFilterType::New();
+  filter->SetInput(image);
+  filter->SetMask(mask);
+  filter->SetInitialCentroids(initialCentroids);
+  filter->SetNumberOfPasses(2);
+  filter->GetStreamer()->SetNumberOfLinesStrippedStreaming(7);
+  filter->Update();
+
+  const KMeansFilterType::CentroidsType & centroids = filter->GetCentroids();
+  const KMeansFilterType::CountsType & counts = filter->GetCounts();
+
+  std::cout << "Centroids: " << centroids[0] << " " << centroids[1] << std::endl;
+  std::cout << "Counts: " << counts[0] << " " << counts[1] << std::endl;
+
+  const double tolerance = 1e-9;
+  if (vcl_abs(centroids[0][0] - 0.) > tolerance || vcl_abs(centroids[0][1] - 10.) > tolerance
+      || vcl_abs(centroids[1][0] - 100.) > tolerance || vcl_abs(centroids[1][1] - 50.) > tolerance)
+    {
+    std::cout << "Wrong centroids" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // 50 x 50 valid pixels per class, seen twice
+  if (counts[0] != 5000 || counts[1] != 5000)
+    {
+    std::cout << "Wrong counts" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
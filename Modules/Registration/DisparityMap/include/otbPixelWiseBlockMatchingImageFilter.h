@@ -25,6 +25,7 @@
 #include "itkImageToImageFilter.h"
 #include "itkConstNeighborhoodIterator.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
 #include "otbImage.h"
 
 namespace otb
@@ -32,6 +33,37 @@ namespace otb
 
 namespace Functor
 {
+/** \class BlockMatchingBoxFilterTraits
+ *  \brief Describe how a block-matching functor decomposes into box sums
+ *
+ *  When a block-matching metric only depends on the sums over the block of
+ *  a few per-pixel terms, the PixelWiseBlockMatchingImageFilter can compute
+ *  it for all the pixels of a disparity at once, with running box sums whose
+ *  cost does not depend on the block radius. The traits give the number of
+ *  terms, how to compute them from a pair of left and right pixel values, and
+ *  how to compute the metric from their sums over a block of a given size.
+ *
+ *  The default traits have no terms: the metric is then always computed
+ *  with the functor. They are specialized for the functors of this file.
+ *
+ * \ingroup OTBDisparityMap
+ */
+template <class TBlockMatchingFunctor>
+class BlockMatchingBoxFilterTraits
+{
+public:
+  itkStaticConstMacro(NumberOfTerms, unsigned int, 0);
+
+  static inline void ComputeTerms(const TBlockMatchingFunctor &, double, double, double *)
+  {
+  }
+
+  static inline double ComputeMetric(const TBlockMatchingFunctor &, const double *, double)
+  {
+    return 0.;
+  }
+};
+
 /** \class SSDBlockMatching
  *  \brief Functor to perform simple SSD block-matching
  *
@@ -65,6 +97,26 @@ public:
   }
 };
 
+/** Box sums decomposition of SSDBlockMatching: sum of (a-b)^2 */
+template <class TInputImage, class TOutputMetricImage>
+class BlockMatchingBoxFilterTraits< SSDBlockMatching<TInputImage, TOutputMetricImage> >
+{
+public:
+  typedef SSDBlockMatching<TInputImage, TOutputMetricImage> FunctorType;
+
+  itkStaticConstMacro(NumberOfTerms, unsigned int, 1);
+
+  static inline void ComputeTerms(const FunctorType &, double a, double b, double * terms)
+  {
+    terms[0] = (a-b)*(a-b);
+  }
+
+  static inline double ComputeMetric(const FunctorType &, const double * sums, double)
+  {
+    return sums[0];
+  }
+};
+
 
 /** \class SSDDivMeanBlockMatching
  *  \brief Functor to perform derived SSD block-matching (SSD divided by mean)
@@ -110,6 +162,33 @@ public:
   }
 };
 
+/** Box sums decomposition of SSDDivMeanBlockMatching: the metric is
+ * expanded on the sums of a, b, a^2, b^2 and ab */
+template <class TInputImage, class TOutputMetricImage>
+class BlockMatchingBoxFilterTraits< SSDDivMeanBlockMatching<TInputImage, TOutputMetricImage> >
+{
+public:
+  typedef SSDDivMeanBlockMatching<TInputImage, TOutputMetricImage> FunctorType;
+
+  itkStaticConstMacro(NumberOfTerms, unsigned int, 5);
+
+  static inline void ComputeTerms(const FunctorType &, double a, double b, double * terms)
+  {
+    terms[0] = a;
+    terms[1] = b;
+    terms[2] = a*a;
+    terms[3] = b*b;
+    terms[4] = a*b;
+  }
+
+  static inline double ComputeMetric(const FunctorType &, const double * sums, double size)
+  {
+    double meana = sums[0]/size;
+    double meanb = sums[1]/size;
+    return sums[2]/(meana*meana) - 2*sums[4]/(meana*meanb) + sums[3]/(meanb*meanb);
+  }
+};
+
 
 /** \class NCCBlockMatching
  *  \brief Functor to perform simple NCC block-matching
@@ -181,6 +260,43 @@ public:
   }
 };
 
+/** Box sums decomposition of NCCBlockMatching: means, variances and
+ * covariance are computed from the sums of a, b, a^2, b^2 and ab */
+template <class TInputImage, class TOutputMetricImage>
+class BlockMatchingBoxFilterTraits< NCCBlockMatching<TInputImage, TOutputMetricImage> >
+{
+public:
+  typedef NCCBlockMatching<TInputImage, TOutputMetricImage> FunctorType;
+
+  itkStaticConstMacro(NumberOfTerms, unsigned int, 5);
+
+  static inline void ComputeTerms(const FunctorType &, double a, double b, double * terms)
+  {
+    terms[0] = a;
+    terms[1] = b;
+    terms[2] = a*a;
+    terms[3] = b*b;
+    terms[4] = a*b;
+  }
+
+  static inline double ComputeMetric(const FunctorType &, const double * sums, double size)
+  {
+    double cov = (sums[4] - sums[0]*sums[1]/size)/(size-1);
+    double varianceA = (sums[2] - sums[0]*sums[0]/size)/(size-1);
+    double varianceB = (sums[3] - sums[1]*sums[1]/size)/(size-1);
+    // Rounding may give slightly negative variances on flat blocks
+    double sigmaA = varianceA > 0 ? vcl_sqrt(varianceA) : 0.;
+    double sigmaB = varianceB > 0 ? vcl_sqrt(varianceB) : 0.;
+
+    if(sigmaA > 1e-20 && sigmaB > 1e-20)
+      {
+      return vcl_abs(cov)/(sigmaA*sigmaB);
+      }
+    return 0.;
+  }
+};
+
+
 /** \class LPBlockMatching
  *  \brief Functor to perform block-matching based on the L^p pseudo-norm
  *
@@ -215,6 +331,11 @@ public:
       }
     }
 
+  double GetP() const
+    {
+    return m_P;
+    }
+
   // Implement the Lp metric
   inline MetricValueType operator()(ConstNeighborhoodIteratorType & a, ConstNeighborhoodIteratorType & b) const
   {
@@ -234,6 +355,26 @@ private:
   double m_P;
 };
 
+/** Box sums decomposition of LPBlockMatching: sum of |a-b|^p */
+template <class TInputImage, class TOutputMetricImage>
+class BlockMatchingBoxFilterTraits< LPBlockMatching<TInputImage, TOutputMetricImage> >
+{
+public:
+  typedef LPBlockMatching<TInputImage, TOutputMetricImage> FunctorType;
+
+  itkStaticConstMacro(NumberOfTerms, unsigned int, 1);
+
+  static inline void ComputeTerms(const FunctorType & functor, double a, double b, double * terms)
+  {
+    terms[0] = vcl_pow(vcl_abs(a-b), functor.GetP());
+  }
+
+  static inline double ComputeMetric(const FunctorType &, const double * sums, double)
+  {
+    return sums[0];
+  }
+};
+
 } // End Namespace Functor
 
 /** \class PixelWiseBlockMatchingImageFilter
@@ -284,6 +425,14 @@ private:
  *  an exploration radius indicates the disparity range to be explored around
  *  the initial estimate (global minimum and maximum values are still in use).
  *
+ *  For the metrics which only depend on sums over the block of per-pixel
+ *  terms (see Functor::BlockMatchingBoxFilterTraits), the box filter mode
+ *  can be enabled with UseBoxFilterOn(). For each disparity, the terms are
+ *  then computed once per pixel and summed over the blocks with running box
+ *  sums, so that the cost no longer depends on the radius. The metric values
+ *  are the same up to rounding errors (the functors accumulate in the metric
+ *  pixel type). This mode is off by default.
+ *
  *  \sa FineRegistrationImageFilter
  *  \sa StereorectificationDisplacementFieldSource
  *  \sa SubPixelDisparityImageFilter
@@ -333,6 +482,8 @@ public:
 
   typedef itk::ConstNeighborhoodIterator<TInputImage>       ConstNeighborhoodIteratorType;
 
+  typedef Functor::BlockMatchingBoxFilterTraits<TBlockMatchingFunctor> BoxFilterTraitsType;
+
   /** Set left input */
   void SetLeftInput( const TInputImage * image);
 
@@ -406,6 +557,12 @@ public:
   itkSetMacro(InitVerticalDisparity,int);
   itkGetConstReferenceMacro(InitVerticalDisparity,int);
 
+  /** Set/Get the box filter mode (only used if the functor has box sums
+   * traits, see Functor::BlockMatchingBoxFilterTraits) */
+  itkSetMacro(UseBoxFilter, bool);
+  itkGetConstReferenceMacro(UseBoxFilter, bool);
+  itkBooleanMacro(UseBoxFilter);
+
   /** Get the functor for parameters setting */
   BlockMatchingFunctorType &  GetFunctor()
   {
@@ -461,6 +618,14 @@ protected:
   /** Threaded generate data */
   void ThreadedGenerateData(const RegionType & outputRegionForThread, itk::ThreadIdType threadId) ITK_OVERRIDE;
 
+  /** Compute the metric of each pixel of the left region for the given
+   * disparity, using running box sums (box filter mode) */
+  void ComputeBoxFilterMetric(const RegionType & leftRegion, int hdisparity, int vdisparity,
+                              std::vector<double> & metric) const;
+
+  /** Read a row of pixels as doubles, with null values outside the buffered region */
+  static void ReadRow(const TInputImage * image, IndexType start, std::vector<double> & values);
+
 private:
   PixelWiseBlockMatchingImageFilter(const Self&); //purposely not implemented
   void operator=(const Self&); //purposely not implemeFnted
@@ -489,6 +654,9 @@ private:
   /** Block-matching functor */
   BlockMatchingFunctorType      m_Functor;
 
+  /** Compute the metric with running box sums when the functor allows it */
+  bool                          m_UseBoxFilter;
+
   /** Initial horizontal disparity (0 by default, used if an exploration radius is set and if no input horizontal
     disparity map is given) */
   int                           m_InitHorizontalDisparity;
@@ -24,6 +24,7 @@
 #include "otbPixelWiseBlockMatchingImageFilter.h"
 #include "itkProgressReporter.h"
 #include "itkConstantBoundaryCondition.h"
+#include <algorithm>
 
 namespace otb
 {
@@ -68,6 +69,9 @@ TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
   // Default grid index
   m_GridIndex[0] = 0;
   m_GridIndex[1] = 0;
+
+  // Metric computed with the functor by default
+  m_UseBoxFilter = false;
 }
 
 
@@ -581,6 +585,10 @@ TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
   // step value as disparityType
   DisparityPixelType stepDisparityInv = 1. / static_cast<DisparityPixelType>(this->m_Step);
 
+  // Use running box sums if the functor allows it
+  const bool useBoxFilter = m_UseBoxFilter && BoxFilterTraitsType::NumberOfTerms > 0;
+  std::vector<double> boxFilterMetric;
+
   // We loop on disparities
   for(int vdisparity = m_MinimumVerticalDisparity; vdisparity <= m_MaximumVerticalDisparity; ++vdisparity)
     {
@@ -610,8 +618,9 @@ TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
     RegionType outputRegion = this->ConvertFullToSubsampledRegion(inputLeftRegion, this->m_Step, this->m_GridIndex);
 
     // Define iterators
-    itk::ConstNeighborhoodIterator<TInputImage>     leftIt(m_Radius,inLeftPtr,inputLeftRegion);
-    itk::ConstNeighborhoodIterator<TInputImage>     rightIt(m_Radius,inRightPtr,inputRightRegion);
+    itk::ImageRegionConstIteratorWithIndex<TInputImage> leftIndexIt(inLeftPtr,inputLeftRegion);
+    itk::ConstNeighborhoodIterator<TInputImage>     leftIt;
+    itk::ConstNeighborhoodIterator<TInputImage>     rightIt;
     itk::ImageRegionIterator<TOutputMetricImage>    outMetricIt(outMetricPtr,outputRegion);
     itk::ImageRegionIterator<TOutputDisparityImage> outHDispIt(outHDispPtr,outputRegion);
     itk::ImageRegionIterator<TOutputDisparityImage> outVDispIt(outVDispPtr,outputRegion);
@@ -624,8 +633,23 @@ TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
     itk::ConstantBoundaryCondition<TInputImage> nbc1;
     itk::ConstantBoundaryCondition<TInputImage> nbc2;
 
-    leftIt.OverrideBoundaryCondition(&nbc1);
-    rightIt.OverrideBoundaryCondition(&nbc2);
+    std::vector<double>::const_iterator boxFilterMetricIt;
+
+    if (useBoxFilter)
+      {
+      // Compute the metric of the whole region at once
+      this->ComputeBoxFilterMetric(inputLeftRegion, hdisparity, vdisparity, boxFilterMetric);
+      boxFilterMetricIt = boxFilterMetric.begin();
+      }
+    else
+      {
+      leftIt = itk::ConstNeighborhoodIterator<TInputImage>(m_Radius,inLeftPtr,inputLeftRegion);
+      rightIt = itk::ConstNeighborhoodIterator<TInputImage>(m_Radius,inRightPtr,inputRightRegion);
+      leftIt.OverrideBoundaryCondition(&nbc1);
+      rightIt.OverrideBoundaryCondition(&nbc2);
+      leftIt.GoToBegin();
+      rightIt.GoToBegin();
+      }
 
     // If we have a mask, define the iterator
     if(inLeftMaskPtr)
@@ -649,23 +673,21 @@ TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
       }
 
     // Initialize iterators
-    leftIt.GoToBegin();
-    rightIt.GoToBegin();
+    leftIndexIt.GoToBegin();
     outMetricIt.GoToBegin();
     outHDispIt.GoToBegin();
     outVDispIt.GoToBegin();
     initIt.GoToBegin();
 
     // Loop on pixels
-    while(!leftIt.IsAtEnd()
-          || !rightIt.IsAtEnd()
+    while(!leftIndexIt.IsAtEnd()
           || !outMetricIt.IsAtEnd()
           || !outHDispIt.IsAtEnd()
           || !outVDispIt.IsAtEnd()
           || !initIt.IsAtEnd())
       {
       // If the pixel location is on the subsampled grid
-      IndexType tmpIndex = leftIt.GetIndex(leftIt.GetCenterNeighborhoodIndex());
+      IndexType tmpIndex = leftIndexIt.GetIndex();
       if (((tmpIndex[0] - this->m_GridIndex[0] + this->m_Step) % this->m_Step == 0) &&
           ((tmpIndex[1] - this->m_GridIndex[1] + this->m_Step) % this->m_Step == 0))
         {
@@ -710,7 +732,7 @@ TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
                 hdisparity >= estimatedMinHDisp && hdisparity <= estimatedMaxHDisp)
               {
               // Compute the block matching value
-            double metric = m_Functor(leftIt,rightIt);
+            double metric = useBoxFilter ? *boxFilterMetricIt : m_Functor(leftIt,rightIt);
 
               // If we are at first loop, fill both outputs
               // We adapt the disparity value to keep consistent with disparity map index space
@@ -742,8 +764,17 @@ TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
         ++initIt;
         progress.CompletedPixel();
         }
-      ++leftIt;
-      ++rightIt;
+      ++leftIndexIt;
+
+      if(useBoxFilter)
+        {
+        ++boxFilterMetricIt;
+        }
+      else
+        {
+        ++leftIt;
+        ++rightIt;
+        }
 
       if(inLeftMaskPtr)
         {
@@ -766,6 +797,141 @@ TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
     }
 }
 
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+PixelWiseBlockMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::ComputeBoxFilterMetric(const RegionType & leftRegion, int hdisparity, int vdisparity,
+                         std::vector<double> & metric) const
+{
+  const TInputImage * inLeftPtr  = this->GetLeftInput();
+  const TInputImage * inRightPtr = this->GetRightInput();
+
+  const unsigned int nbTerms = BoxFilterTraitsType::NumberOfTerms;
+  const long width  = leftRegion.GetSize()[0];
+  const long height = leftRegion.GetSize()[1];
+  const long radiusX = m_Radius[0];
+  const long radiusY = m_Radius[1];
+  const long extendedWidth = width + 2 * radiusX;
+  const long blockHeight = 2 * radiusY + 1;
+  const long rowLength = extendedWidth * static_cast<long>(nbTerms);
+  const double blockSize = static_cast<double>((2 * radiusX + 1) * blockHeight);
+
+  metric.resize(width * height);
+  if (nbTerms == 0 || width == 0 || height == 0)
+    {
+    return;
+    }
+
+  // Terms of the rows currently covered by the blocks (ring buffer), their
+  // sums along the columns of the blocks, and the sums over one block
+  std::vector<double> rowTerms(blockHeight * rowLength);
+  std::vector<double> columnSums(rowLength, 0.);
+  std::vector<double> blockSums(nbTerms);
+  std::vector<double> leftValues(extendedWidth);
+  std::vector<double> rightValues(extendedWidth);
+
+  IndexType leftStart;
+  leftStart[0] = leftRegion.GetIndex()[0] - radiusX;
+  leftStart[1] = leftRegion.GetIndex()[1] - radiusY;
+  IndexType rightStart = leftStart;
+  rightStart[0] += hdisparity;
+  rightStart[1] += vdisparity;
+
+  for (long y = 0; y < height + 2 * radiusY; ++y, ++leftStart[1], ++rightStart[1])
+    {
+    double * terms = &rowTerms[(y % blockHeight) * rowLength];
+
+    // Remove the row leaving the blocks from the column sums
+    if (y >= blockHeight)
+      {
+      for (long k = 0; k < rowLength; ++k)
+        {
+        columnSums[k] -= terms[k];
+        }
+      }
+
+    // Add the row entering the blocks
+    ReadRow(inLeftPtr, leftStart, leftValues);
+    ReadRow(inRightPtr, rightStart, rightValues);
+    for (long x = 0; x < extendedWidth; ++x)
+      {
+      BoxFilterTraitsType::ComputeTerms(m_Functor, leftValues[x], rightValues[x], terms + x * nbTerms);
+      }
+    for (long k = 0; k < rowLength; ++k)
+      {
+      columnSums[k] += terms[k];
+      }
+
+    if (y < blockHeight - 1)
+      {
+      continue;
+      }
+
+    // Slide the block along the row of centers
+    double * rowMetric = &metric[(y - blockHeight + 1) * width];
+    std::fill(blockSums.begin(), blockSums.end(), 0.);
+    for (long x = 0; x < 2 * radiusX; ++x)
+      {
+      for (unsigned int k = 0; k < nbTerms; ++k)
+        {
+        blockSums[k] += columnSums[x * nbTerms + k];
+        }
+      }
+    for (long x = 0; x < width; ++x)
+      {
+      for (unsigned int k = 0; k < nbTerms; ++k)
+        {
+        blockSums[k] += columnSums[(x + 2 * radiusX) * nbTerms + k];
+        }
+      rowMetric[x] = BoxFilterTraitsType::ComputeMetric(m_Functor, &blockSums[0], blockSize);
+      for (unsigned int k = 0; k < nbTerms; ++k)
+        {
+        blockSums[k] -= columnSums[x * nbTerms + k];
+        }
+      }
+    }
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+PixelWiseBlockMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::ReadRow(const TInputImage * image, IndexType start, std::vector<double> & values)
+{
+  // Pixels outside the buffered region are null, as with the constant
+  // boundary condition used by the neighborhood iterators
+  std::fill(values.begin(), values.end(), 0.);
+
+  const RegionType & buffered = image->GetBufferedRegion();
+  const long bufferedBeginX = buffered.GetIndex()[0];
+  const long bufferedEndX = bufferedBeginX + static_cast<long>(buffered.GetSize()[0]);
+  const long bufferedBeginY = buffered.GetIndex()[1];
+  const long bufferedEndY = bufferedBeginY + static_cast<long>(buffered.GetSize()[1]);
+
+  if (start[1] < bufferedBeginY || start[1] >= bufferedEndY)
+    {
+    return;
+    }
+
+  const long beginX = std::max(static_cast<long>(start[0]), bufferedBeginX);
+  const long endX = std::min(static_cast<long>(start[0]) + static_cast<long>(values.size()), bufferedEndX);
+  if (beginX >= endX)
+    {
+    return;
+    }
+
+  IndexType index = start;
+  index[0] = beginX;
+  const typename TInputImage::PixelType * pixel = image->GetBufferPointer() + image->ComputeOffset(index);
+  for (long x = beginX; x < endX; ++x, ++pixel)
+    {
+    values[x - start[0]] = static_cast<double>(*pixel);
+    }
+}
+
 template <class TInputImage, class TOutputMetricImage,
 class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
 typename PixelWiseBlockMatchingImageFilter<TInputImage,TOutputMetricImage,
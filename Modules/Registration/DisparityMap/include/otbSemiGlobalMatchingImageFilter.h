@@ -0,0 +1,275 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSemiGlobalMatchingImageFilter_h
+#define otbSemiGlobalMatchingImageFilter_h
+
+#include "otbPixelWiseBlockMatchingImageFilter.h"
+
+namespace otb
+{
+
+/** \class SemiGlobalMatchingImageFilter
+ *  \brief Perform Semi-Global Matching (SGM) between two images in epipolar geometry
+ *
+ *  This filter estimates dense horizontal disparities between a pair of
+ *  epipolar images. The matching cost of each pixel and each disparity is
+ *  given by the block-matching functor (the opposite of the metric is used
+ *  when the metric is to be maximized, see SetMinimize()). The costs are then
+ *  aggregated along several 1D paths crossing the image (4 or 8, see
+ *  SetNumberOfPaths()) with the recurrence of Hirschmuller:
+ *
+ *  \f$ L_r(p,d) = C(p,d) + \min(L_r(p-r,d), L_r(p-r,d \pm 1) + P_1, \min_k L_r(p-r,k) + P_2) - \min_k L_r(p-r,k) \f$
+ *
+ *  where P1 penalizes small disparity changes and P2 larger ones. The
+ *  disparity minimizing the sum of the aggregated costs is kept.
+ *
+ *  The range of the matching cost depends on the metric and on the image
+ *  radiometry (the opposite of NCC lies in [-1,1], SSD grows with the
+ *  square of the pixel values). By default, P1 and P2 are thus relative to
+ *  a cost scale, which is the mean over the pixels of the difference
+ *  between their highest and lowest matching costs. The cost scale is
+ *  either given with SetCostScale(), or estimated once per pipeline update
+ *  on a window of CostScaleSampleSize pixels at the center of the left
+ *  image, so that it does not depend on the streaming nor on the number of
+ *  threads. The same penalties then fit every metric. With
+ *  NormalizePenaltiesOff(), P1 and P2 are given in the unit of the matching
+ *  cost.
+ *
+ *  The cost volume and the aggregated costs are held in memory for the
+ *  whole output requested region, so that the memory print is
+ *  proportional to its size times the disparity range. It is reported to
+ *  the pipeline memory print estimation, and the streaming splits the image
+ *  accordingly. The cost volume is computed once per stream piece, padded
+ *  by AggregationMargin pixels (or up to the image border), which bounds
+ *  the influence of the streaming on the result. The threads share the
+ *  disparities when computing the costs, and the lines of each path
+ *  direction when aggregating them, so that the result does not depend on
+ *  the number of threads.
+ *
+ *  This filter inherits the inputs, outputs and parameters of
+ *  PixelWiseBlockMatchingImageFilter, so that it can be used in its place
+ *  (for instance before a SubPixelDisparityImageFilter). The following
+ *  restrictions apply: the vertical disparity range must hold a single
+ *  value, the step must be 1, and the exploration radius and initial
+ *  disparity maps are ignored. When the functor allows it, the matching
+ *  costs are computed with running box sums (see UseBoxFilterOn()).
+ *
+ *  Pixels of the left mask with a non-positive value are not processed, and
+ *  disparities pointing to a non-positive value of the right mask are
+ *  excluded.
+ *
+ *  Print reference:
+ *
+ *  H. Hirschmuller. Stereo processing by semiglobal matching and mutual
+ *  information. IEEE Transactions on Pattern Analysis and Machine
+ *  Intelligence, 30(2):328-341, 2008.
+ *
+ *  \sa PixelWiseBlockMatchingImageFilter
+ *  \sa SubPixelDisparityImageFilter
+ *  \sa StereorectificationDisplacementFieldSource
+ *
+ *  \ingroup Streamed
+ *  \ingroup Threaded
+ *
+ *
+ * \ingroup OTBDisparityMap
+ */
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage = TOutputMetricImage, class TMaskImage = otb::Image<unsigned char>,
+          class TBlockMatchingFunctor = Functor::SSDBlockMatching<TInputImage,TOutputMetricImage> >
+class ITK_EXPORT SemiGlobalMatchingImageFilter :
+    public PixelWiseBlockMatchingImageFilter<TInputImage,TOutputMetricImage,TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+{
+public:
+  /** Standard class typedef */
+  typedef SemiGlobalMatchingImageFilter                     Self;
+  typedef PixelWiseBlockMatchingImageFilter<TInputImage,
+    TOutputMetricImage, TOutputDisparityImage,
+    TMaskImage, TBlockMatchingFunctor>                      Superclass;
+  typedef itk::SmartPointer<Self>                           Pointer;
+  typedef itk::SmartPointer<const Self>                     ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(SemiGlobalMatchingImageFilter, PixelWiseBlockMatchingImageFilter);
+
+  /** Useful typedefs */
+  typedef typename Superclass::SizeType                     SizeType;
+  typedef typename Superclass::IndexType                    IndexType;
+  typedef typename Superclass::RegionType                   RegionType;
+  typedef typename Superclass::DisparityPixelType           DisparityPixelType;
+  typedef typename Superclass::BoxFilterTraitsType          BoxFilterTraitsType;
+
+  /** Type of the matching and aggregated costs */
+  typedef float                                             CostType;
+
+  /** Set/Get the penalty of disparity changes of one pixel (0.1 by default) */
+  itkSetMacro(P1, double);
+  itkGetConstMacro(P1, double);
+
+  /** Set/Get the penalty of disparity changes of more than one pixel (0.5
+   * by default) */
+  itkSetMacro(P2, double);
+  itkGetConstMacro(P2, double);
+
+  /** Set/Get whether P1 and P2 are relative to the cost scale (true by
+   * default) or given in the unit of the matching cost */
+  itkSetMacro(NormalizePenalties, bool);
+  itkGetConstMacro(NormalizePenalties, bool);
+  itkBooleanMacro(NormalizePenalties);
+
+  /** Set/Get the cost scale of the normalized penalties, in the unit of
+   * the matching cost (0 by default: estimated from the inputs) */
+  itkSetMacro(CostScale, double);
+  itkGetConstMacro(CostScale, double);
+
+  /** Set/Get the size of the window at the center of the left image used
+   * to estimate the cost scale (128 by default) */
+  itkSetMacro(CostScaleSampleSize, unsigned int);
+  itkGetConstMacro(CostScaleSampleSize, unsigned int);
+
+  /** Set/Get the number of aggregation paths (4 or 8) */
+  itkSetMacro(NumberOfPaths, unsigned int);
+  itkGetConstMacro(NumberOfPaths, unsigned int);
+
+  /** Set/Get the margin (in pixels) added around each stream piece to
+   * start the aggregation paths */
+  itkSetMacro(AggregationMargin, unsigned int);
+  itkGetConstMacro(AggregationMargin, unsigned int);
+
+protected:
+  /** Constructor */
+  SemiGlobalMatchingImageFilter();
+
+  /** Destructor */
+  ~SemiGlobalMatchingImageFilter() ITK_OVERRIDE {}
+
+  /** Generate output information, and estimate the cost scale */
+  void GenerateOutputInformation() ITK_OVERRIDE;
+
+  /** Generate input requested region */
+  void GenerateInputRequestedRegion() ITK_OVERRIDE;
+
+  /** Compute and aggregate the costs of the stream piece */
+  void BeforeThreadedGenerateData() ITK_OVERRIDE;
+
+  /** Select the disparities of the thread region */
+  void ThreadedGenerateData(const RegionType & outputRegionForThread, itk::ThreadIdType threadId) ITK_OVERRIDE;
+
+  /** Release the cost volume */
+  void AfterThreadedGenerateData() ITK_OVERRIDE;
+
+  /** Estimate the cost scale on a window at the center of the left image.
+   * This updates the inputs on this window. */
+  double EstimateCostScale();
+
+  /** Fill the matching costs of the tile for the disparities in
+   * [dBegin,dEnd). Invalid costs are flagged in the validity vector. */
+  void ComputeCostVolume(const RegionType & tile, unsigned int dBegin, unsigned int dEnd,
+                         std::vector<CostType> & costs,
+                         std::vector<unsigned char> & validity) const;
+
+  /** Give the highest valid cost to the invalid costs: they are never
+   * selected, but do not break the aggregation paths */
+  void FillInvalidCosts(std::vector<CostType> & costs,
+                        const std::vector<unsigned char> & validity) const;
+
+  /** Mean over the pixels of the difference between their highest and
+   * lowest valid matching costs */
+  double ComputeCostScale(const std::vector<CostType> & costs,
+                          const std::vector<unsigned char> & validity) const;
+
+  /** Aggregate the costs of the stream piece along the lines
+   * [lineBegin,lineEnd) of one path direction, and add the result to the
+   * aggregated costs. Each pixel belongs to a single line of a direction. */
+  void AggregatePath(int dx, int dy, unsigned long lineBegin, unsigned long lineEnd);
+
+  /** Number of lines of a path direction in the stream piece */
+  unsigned long NumberOfLines(int dx, int dy) const;
+
+  void PrintSelf(std::ostream & os, itk::Indent indent) const ITK_OVERRIDE;
+
+private:
+  SemiGlobalMatchingImageFilter(const Self&); //purposely not implemented
+  void operator=(const Self&); //purposely not implemented
+
+  /** Static functions used by the threads */
+  static ITK_THREAD_RETURN_TYPE CostVolumeThreaderCallback(void *arg);
+  static ITK_THREAD_RETURN_TYPE AggregationThreaderCallback(void *arg);
+
+  /** Data passed to the threads */
+  struct ThreadStruct
+  {
+    Pointer Filter;
+    int     Dx;
+    int     Dy;
+  };
+
+  /** Number of explored disparities */
+  unsigned int NumberOfDisparities() const
+  {
+    return static_cast<unsigned int>(this->GetMaximumHorizontalDisparity() - this->GetMinimumHorizontalDisparity() + 1);
+  }
+
+  /** Penalty of disparity changes of one pixel */
+  double                        m_P1;
+
+  /** Penalty of disparity changes of more than one pixel */
+  double                        m_P2;
+
+  /** Are the penalties relative to the cost scale */
+  bool                          m_NormalizePenalties;
+
+  /** Cost scale given by the user (0 if estimated) */
+  double                        m_CostScale;
+
+  /** Size of the window used to estimate the cost scale */
+  unsigned int                  m_CostScaleSampleSize;
+
+  /** Cost scale estimated at the last pipeline update */
+  double                        m_EstimatedCostScale;
+
+  /** Number of aggregation paths */
+  unsigned int                  m_NumberOfPaths;
+
+  /** Margin around stream pieces */
+  unsigned int                  m_AggregationMargin;
+
+  /** Stream piece padded by the aggregation margin */
+  RegionType                    m_Tile;
+
+  /** Penalties of the stream piece, in the unit of the matching cost */
+  CostType                      m_ScaledP1;
+  CostType                      m_ScaledP2;
+
+  /** Matching costs, validity and aggregated costs of the stream piece */
+  std::vector<CostType>         m_Costs;
+  std::vector<unsigned char>    m_Validity;
+  std::vector<CostType>         m_Aggregated;
+};
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbSemiGlobalMatchingImageFilter.txx"
+#endif
+
+#endif
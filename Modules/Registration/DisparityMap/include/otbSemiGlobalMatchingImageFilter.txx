@@ -0,0 +1,691 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSemiGlobalMatchingImageFilter_txx
+#define otbSemiGlobalMatchingImageFilter_txx
+
+#include "otbSemiGlobalMatchingImageFilter.h"
+#include "itkProgressReporter.h"
+#include "itkConstantBoundaryCondition.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMetaDataObject.h"
+#include "itkMultiThreader.h"
+#include "otbMetaDataKey.h"
+#include "otbMacro.h"
+#include "vnl/vnl_math.h"
+#include <algorithm>
+#include <limits>
+
+namespace otb
+{
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+SemiGlobalMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::SemiGlobalMatchingImageFilter()
+{
+  // Default penalties, relative to the cost scale
+  m_P1 = 0.1;
+  m_P2 = 0.5;
+  m_NormalizePenalties = true;
+  m_CostScale = 0.;
+  m_CostScaleSampleSize = 128;
+  m_EstimatedCostScale = 1.;
+
+  // Default aggregation
+  m_NumberOfPaths = 8;
+  m_AggregationMargin = 32;
+
+  m_ScaledP1 = 0;
+  m_ScaledP2 = 0;
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+SemiGlobalMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::GenerateOutputInformation()
+{
+  // Call superclass implementation
+  Superclass::GenerateOutputInformation();
+
+  // The cost scale is estimated once for the whole image, so that the
+  // penalties do not depend on the streaming
+  if (m_NormalizePenalties && !(m_CostScale > 0.))
+    {
+    m_EstimatedCostScale = this->EstimateCostScale();
+    otbMsgDevMacro(<< "Estimated cost scale: " << m_EstimatedCostScale);
+    }
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+SemiGlobalMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::GenerateInputRequestedRegion()
+{
+  // Call superclass implementation
+  Superclass::GenerateInputRequestedRegion();
+
+  TInputImage * inLeftPtr  = const_cast<TInputImage *>(this->GetLeftInput());
+  TInputImage * inRightPtr = const_cast<TInputImage *>(this->GetRightInput());
+  TMaskImage *  inLeftMaskPtr  = const_cast<TMaskImage * >(this->GetLeftMaskInput());
+  TMaskImage *  inRightMaskPtr  = const_cast<TMaskImage * >(this->GetRightMaskInput());
+  TOutputMetricImage * outMetricPtr = this->GetMetricOutput();
+
+  if(!inLeftPtr || !inRightPtr || !outMetricPtr)
+    {
+    return;
+    }
+
+  // Check the restrictions of SGM
+  if (this->GetStep() != 1)
+    {
+    itkExceptionMacro(<<"Semi-global matching needs a step of 1, got "<<this->GetStep());
+    }
+  if (this->GetMinimumVerticalDisparity() != this->GetMaximumVerticalDisparity())
+    {
+    itkExceptionMacro(<<"Semi-global matching only explores horizontal disparities: minimum and maximum vertical disparities must be equal.");
+    }
+  if (this->GetMaximumHorizontalDisparity() < this->GetMinimumHorizontalDisparity())
+    {
+    itkExceptionMacro(<<"Maximum horizontal disparity is lower than minimum horizontal disparity.");
+    }
+  if (m_NumberOfPaths != 4 && m_NumberOfPaths != 8)
+    {
+    itkExceptionMacro(<<"Number of aggregation paths must be 4 or 8, got "<<m_NumberOfPaths);
+    }
+
+  // Add the aggregation margin to the regions requested by the superclass
+  SizeType margin;
+  margin.Fill(m_AggregationMargin);
+
+  RegionType inputLeftRegion = inLeftPtr->GetRequestedRegion();
+  inputLeftRegion.PadByRadius(margin);
+  inputLeftRegion.Crop(inLeftPtr->GetLargestPossibleRegion());
+  inLeftPtr->SetRequestedRegion(inputLeftRegion);
+
+  RegionType inputRightRegion = inRightPtr->GetRequestedRegion();
+  inputRightRegion.PadByRadius(margin);
+  inputRightRegion.Crop(inRightPtr->GetLargestPossibleRegion());
+  inRightPtr->SetRequestedRegion(inputRightRegion);
+
+  if(inLeftMaskPtr)
+    {
+    inLeftMaskPtr->SetRequestedRegion(inputLeftRegion);
+    }
+  if(inRightMaskPtr)
+    {
+    inRightMaskPtr->SetRequestedRegion(inputRightRegion);
+    }
+
+  // Each pixel of a stream piece holds its matching costs, validity and
+  // aggregated costs, and each thread holds the metric of one disparity.
+  // The margin around the stream piece is allocated once, and not per
+  // thread.
+  const unsigned int nbThreads = std::max<unsigned int>(this->GetNumberOfThreads(), 1);
+  const double bytesPerPixel = this->NumberOfDisparities() * (2 * sizeof(CostType) + 1)
+    + nbThreads * sizeof(double);
+  const double marginPixels = 2. * m_AggregationMargin
+    * (outMetricPtr->GetRequestedRegion().GetSize()[0] + outMetricPtr->GetRequestedRegion().GetSize()[1]
+       + 2 * m_AggregationMargin);
+  itk::EncapsulateMetaData<double>(this->GetMetaDataDictionary(),
+                                   MetaDataKey::MemoryPrintPerOutputPixel,
+                                   bytesPerPixel);
+  itk::EncapsulateMetaData<double>(this->GetMetaDataDictionary(),
+                                   MetaDataKey::MemoryPrintPerThread,
+                                   bytesPerPixel * marginPixels / nbThreads);
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+SemiGlobalMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::BeforeThreadedGenerateData()
+{
+  // Fill outputs with default values
+  Superclass::BeforeThreadedGenerateData();
+
+  const TInputImage * inLeftPtr = this->GetLeftInput();
+  const unsigned int nbDisp = this->NumberOfDisparities();
+
+  // The tile is the stream piece (the step is 1, so full and subsampled
+  // grids only differ by the grid index) padded by the aggregation margin
+  m_Tile = this->ConvertSubsampledToFullRegion(this->GetMetricOutput()->GetRequestedRegion(), 1, this->GetGridIndex());
+  SizeType margin;
+  margin.Fill(m_AggregationMargin);
+  m_Tile.PadByRadius(margin);
+  m_Tile.Crop(inLeftPtr->GetLargestPossibleRegion());
+
+  const unsigned long nbPixels = m_Tile.GetNumberOfPixels();
+
+  // Penalties in the unit of the matching cost
+  double scale = 1.;
+  if (m_NormalizePenalties)
+    {
+    scale = m_CostScale > 0. ? m_CostScale : m_EstimatedCostScale;
+    }
+  m_ScaledP1 = static_cast<CostType>(m_P1 * scale);
+  m_ScaledP2 = static_cast<CostType>(m_P2 * scale);
+
+  ThreadStruct str;
+  str.Filter = this;
+  str.Dx = 0;
+  str.Dy = 0;
+  this->GetMultiThreader()->SetNumberOfThreads(this->GetNumberOfThreads());
+
+  // Matching costs, the threads sharing the disparities
+  m_Costs.assign(nbPixels * nbDisp, 0);
+  m_Validity.assign(nbPixels * nbDisp, 0);
+  this->GetMultiThreader()->SetSingleMethod(Self::CostVolumeThreaderCallback, &str);
+  this->GetMultiThreader()->SingleMethodExecute();
+  this->FillInvalidCosts(m_Costs, m_Validity);
+
+  // Aggregation along the paths, one direction after the other so that
+  // the sum over the directions is done in the same order whatever the
+  // number of threads. The threads share the lines of each direction.
+  static const int directions[8][2] = {{1,0}, {-1,0}, {0,1}, {0,-1}, {1,1}, {-1,1}, {1,-1}, {-1,-1}};
+  m_Aggregated.assign(nbPixels * nbDisp, 0);
+  this->GetMultiThreader()->SetSingleMethod(Self::AggregationThreaderCallback, &str);
+  for (unsigned int path = 0; path < m_NumberOfPaths; ++path)
+    {
+    str.Dx = directions[path][0];
+    str.Dy = directions[path][1];
+    this->GetMultiThreader()->SingleMethodExecute();
+    }
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+SemiGlobalMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId)
+{
+  const TMaskImage  * inLeftMaskPtr  = this->GetLeftMaskInput();
+  TOutputMetricImage    * outMetricPtr = this->GetMetricOutput();
+  TOutputDisparityImage * outHDispPtr  = this->GetHorizontalDisparityOutput();
+  TOutputDisparityImage * outVDispPtr  = this->GetVerticalDisparityOutput();
+
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  const unsigned int nbDisp = this->NumberOfDisparities();
+  const IndexType gridIndex = this->GetGridIndex();
+
+  // Select the disparity of minimum aggregated cost
+  itk::ImageRegionIteratorWithIndex<TOutputDisparityImage> outHDispIt(outHDispPtr, outputRegionForThread);
+  itk::ImageRegionIterator<TOutputDisparityImage>          outVDispIt(outVDispPtr, outputRegionForThread);
+  itk::ImageRegionIterator<TOutputMetricImage>             outMetricIt(outMetricPtr, outputRegionForThread);
+
+  const IndexType tileIndex = m_Tile.GetIndex();
+  const long tileWidth = m_Tile.GetSize()[0];
+  const bool minimize = this->GetMinimize();
+
+  for (outHDispIt.GoToBegin(), outVDispIt.GoToBegin(), outMetricIt.GoToBegin();
+       !outHDispIt.IsAtEnd(); ++outHDispIt, ++outVDispIt, ++outMetricIt)
+    {
+    IndexType index = outHDispIt.GetIndex();
+    index[0] += gridIndex[0];
+    index[1] += gridIndex[1];
+
+    if (!inLeftMaskPtr || inLeftMaskPtr->GetPixel(index) > 0)
+      {
+      const unsigned long offset = ((index[1] - tileIndex[1]) * tileWidth + index[0] - tileIndex[0]) * nbDisp;
+
+      long bestDisp = -1;
+      CostType bestCost = 0;
+      for (unsigned int d = 0; d < nbDisp; ++d)
+        {
+        if (m_Validity[offset + d] && (bestDisp < 0 || m_Aggregated[offset + d] < bestCost))
+          {
+          bestDisp = d;
+          bestCost = m_Aggregated[offset + d];
+          }
+        }
+
+      if (bestDisp >= 0)
+        {
+        const CostType cost = m_Costs[offset + bestDisp];
+        outHDispIt.Set(static_cast<DisparityPixelType>(this->GetMinimumHorizontalDisparity() + bestDisp));
+        outVDispIt.Set(static_cast<DisparityPixelType>(this->GetMinimumVerticalDisparity()));
+        outMetricIt.Set(minimize ? cost : -cost);
+        }
+      }
+    progress.CompletedPixel();
+    }
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+SemiGlobalMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::AfterThreadedGenerateData()
+{
+  // Release the memory of the stream piece
+  std::vector<CostType>().swap(m_Costs);
+  std::vector<unsigned char>().swap(m_Validity);
+  std::vector<CostType>().swap(m_Aggregated);
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+double
+SemiGlobalMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::EstimateCostScale()
+{
+  TInputImage * inLeftPtr  = const_cast<TInputImage *>(this->GetLeftInput());
+  TInputImage * inRightPtr = const_cast<TInputImage *>(this->GetRightInput());
+  TMaskImage *  inLeftMaskPtr  = const_cast<TMaskImage * >(this->GetLeftMaskInput());
+  TMaskImage *  inRightMaskPtr  = const_cast<TMaskImage * >(this->GetRightMaskInput());
+
+  // Invalid settings are reported when generating the input requested region
+  if (!inLeftPtr || !inRightPtr || m_CostScaleSampleSize == 0
+      || this->GetMaximumHorizontalDisparity() < this->GetMinimumHorizontalDisparity())
+    {
+    return 1.;
+    }
+
+  // Window at the center of the left image
+  const RegionType largestRegion = inLeftPtr->GetLargestPossibleRegion();
+  RegionType sample = largestRegion;
+  for (unsigned int dim = 0; dim < 2; ++dim)
+    {
+    const itk::SizeValueType size = std::min<itk::SizeValueType>(m_CostScaleSampleSize, largestRegion.GetSize()[dim]);
+    sample.SetIndex(dim, largestRegion.GetIndex()[dim] + (largestRegion.GetSize()[dim] - size) / 2);
+    sample.SetSize(dim, size);
+    }
+
+  // Regions of the inputs needed to compute its costs
+  RegionType inputLeftRegion = sample;
+  inputLeftRegion.PadByRadius(this->GetRadius());
+  inputLeftRegion.Crop(largestRegion);
+
+  RegionType inputRightRegion = inputLeftRegion;
+  inputRightRegion.SetIndex(0, inputLeftRegion.GetIndex()[0] + this->GetMinimumHorizontalDisparity());
+  inputRightRegion.SetIndex(1, inputLeftRegion.GetIndex()[1] + this->GetMinimumVerticalDisparity());
+  inputRightRegion.SetSize(0, inputLeftRegion.GetSize()[0]
+                           + this->GetMaximumHorizontalDisparity() - this->GetMinimumHorizontalDisparity());
+  if (!inputRightRegion.Crop(inRightPtr->GetLargestPossibleRegion()))
+    {
+    return 1.;
+    }
+
+  // This breaks the pipeline rules, but the scale must not depend on the
+  // stream pieces: update the inputs on the window
+  inLeftPtr->SetRequestedRegion(inputLeftRegion);
+  inLeftPtr->PropagateRequestedRegion();
+  inLeftPtr->UpdateOutputData();
+  inRightPtr->SetRequestedRegion(inputRightRegion);
+  inRightPtr->PropagateRequestedRegion();
+  inRightPtr->UpdateOutputData();
+  if (inLeftMaskPtr)
+    {
+    inLeftMaskPtr->SetRequestedRegion(inputLeftRegion);
+    inLeftMaskPtr->PropagateRequestedRegion();
+    inLeftMaskPtr->UpdateOutputData();
+    }
+  if (inRightMaskPtr)
+    {
+    inRightMaskPtr->SetRequestedRegion(inputRightRegion);
+    inRightMaskPtr->PropagateRequestedRegion();
+    inRightMaskPtr->UpdateOutputData();
+    }
+
+  const unsigned int nbDisp = this->NumberOfDisparities();
+  std::vector<CostType>      costs(sample.GetNumberOfPixels() * nbDisp, 0);
+  std::vector<unsigned char> validity(sample.GetNumberOfPixels() * nbDisp, 0);
+  this->ComputeCostVolume(sample, 0, nbDisp, costs, validity);
+
+  return this->ComputeCostScale(costs, validity);
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+SemiGlobalMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::ComputeCostVolume(const RegionType & tile, unsigned int dBegin, unsigned int dEnd,
+                    std::vector<CostType> & costs,
+                    std::vector<unsigned char> & validity) const
+{
+  const TInputImage * inLeftPtr      = this->GetLeftInput();
+  const TInputImage * inRightPtr     = this->GetRightInput();
+  const TMaskImage  * inLeftMaskPtr  = this->GetLeftMaskInput();
+  const TMaskImage  * inRightMaskPtr = this->GetRightMaskInput();
+
+  const unsigned int nbDisp = this->NumberOfDisparities();
+  const int vdisparity = this->GetMinimumVerticalDisparity();
+  const bool minimize = this->GetMinimize();
+  const bool useBoxFilter = this->GetUseBoxFilter() && BoxFilterTraitsType::NumberOfTerms > 0;
+
+  const IndexType tileIndex = tile.GetIndex();
+  const long tileWidth = tile.GetSize()[0];
+
+  std::vector<double> metric;
+
+  for (unsigned int d = dBegin; d < dEnd; ++d)
+    {
+    const int hdisparity = this->GetMinimumHorizontalDisparity() + static_cast<int>(d);
+
+    // Only keep the pixels whose match lies in the right image
+    RegionType inputRightRegion = tile;
+    IndexType rightIndex = tile.GetIndex();
+    rightIndex[0] += hdisparity;
+    rightIndex[1] += vdisparity;
+    inputRightRegion.SetIndex(rightIndex);
+    if (!inputRightRegion.Crop(inRightPtr->GetLargestPossibleRegion()))
+      {
+      continue;
+      }
+
+    RegionType inputLeftRegion = inputRightRegion;
+    IndexType leftIndex = inputRightRegion.GetIndex();
+    leftIndex[0] -= hdisparity;
+    leftIndex[1] -= vdisparity;
+    inputLeftRegion.SetIndex(leftIndex);
+
+    if (useBoxFilter)
+      {
+      this->ComputeBoxFilterMetric(inputLeftRegion, hdisparity, vdisparity, metric);
+      }
+    else
+      {
+      metric.resize(inputLeftRegion.GetNumberOfPixels());
+
+      itk::ConstNeighborhoodIterator<TInputImage> leftIt(this->GetRadius(), inLeftPtr, inputLeftRegion);
+      itk::ConstNeighborhoodIterator<TInputImage> rightIt(this->GetRadius(), inRightPtr, inputRightRegion);
+      itk::ConstantBoundaryCondition<TInputImage> nbc1;
+      itk::ConstantBoundaryCondition<TInputImage> nbc2;
+      leftIt.OverrideBoundaryCondition(&nbc1);
+      rightIt.OverrideBoundaryCondition(&nbc2);
+
+      std::vector<double>::iterator metricIt = metric.begin();
+      for (leftIt.GoToBegin(), rightIt.GoToBegin(); !leftIt.IsAtEnd(); ++leftIt, ++rightIt, ++metricIt)
+        {
+        *metricIt = this->GetFunctor()(leftIt, rightIt);
+        }
+      }
+
+    // Store the costs in the tile
+    std::vector<double>::const_iterator metricIt = metric.begin();
+    itk::ImageRegionConstIteratorWithIndex<TInputImage> leftIndexIt(inLeftPtr, inputLeftRegion);
+    for (leftIndexIt.GoToBegin(); !leftIndexIt.IsAtEnd(); ++leftIndexIt, ++metricIt)
+      {
+      const IndexType index = leftIndexIt.GetIndex();
+      IndexType rightPixelIndex = index;
+      rightPixelIndex[0] += hdisparity;
+      rightPixelIndex[1] += vdisparity;
+
+      if ((inLeftMaskPtr && !(inLeftMaskPtr->GetPixel(index) > 0))
+          || (inRightMaskPtr && !(inRightMaskPtr->GetPixel(rightPixelIndex) > 0))
+          || !vnl_math_isfinite(*metricIt))
+        {
+        continue;
+        }
+
+      const unsigned long offset = ((index[1] - tileIndex[1]) * tileWidth + index[0] - tileIndex[0]) * nbDisp + d;
+      costs[offset] = static_cast<CostType>(minimize ? *metricIt : -(*metricIt));
+      validity[offset] = 1;
+      }
+    }
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+SemiGlobalMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::FillInvalidCosts(std::vector<CostType> & costs,
+                   const std::vector<unsigned char> & validity) const
+{
+  CostType highestCost = -std::numeric_limits<CostType>::max();
+  for (unsigned long i = 0; i < costs.size(); ++i)
+    {
+    if (validity[i] && costs[i] > highestCost)
+      {
+      highestCost = costs[i];
+      }
+    }
+  if (highestCost == -std::numeric_limits<CostType>::max())
+    {
+    highestCost = 0;
+    }
+  for (unsigned long i = 0; i < costs.size(); ++i)
+    {
+    if (!validity[i])
+      {
+      costs[i] = highestCost;
+      }
+    }
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+double
+SemiGlobalMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::ComputeCostScale(const std::vector<CostType> & costs,
+                   const std::vector<unsigned char> & validity) const
+{
+  const unsigned int nbDisp = this->NumberOfDisparities();
+  const unsigned long nbPixels = costs.size() / nbDisp;
+
+  double sumOfRanges = 0.;
+  unsigned long nbRanges = 0;
+  for (unsigned long pixel = 0; pixel < nbPixels; ++pixel)
+    {
+    unsigned int nbValid = 0;
+    CostType lowest = 0;
+    CostType highest = 0;
+    for (unsigned long i = pixel * nbDisp; i < (pixel + 1) * nbDisp; ++i)
+      {
+      if (!validity[i])
+        {
+        continue;
+        }
+      if (nbValid == 0 || costs[i] < lowest)
+        {
+        lowest = costs[i];
+        }
+      if (nbValid == 0 || costs[i] > highest)
+        {
+        highest = costs[i];
+        }
+      ++nbValid;
+      }
+    // Pixels with a single valid disparity tell nothing about the scale
+    if (nbValid > 1)
+      {
+      sumOfRanges += highest - lowest;
+      ++nbRanges;
+      }
+    }
+
+  // Uniform costs: any penalty gives the same result
+  return (nbRanges > 0 && sumOfRanges > 0.) ? sumOfRanges / nbRanges : 1.;
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+unsigned long
+SemiGlobalMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::NumberOfLines(int dx, int dy) const
+{
+  const unsigned long width  = m_Tile.GetSize()[0];
+  const unsigned long height = m_Tile.GetSize()[1];
+
+  // Horizontal paths start on a column, vertical paths on a row, and
+  // diagonal paths on both
+  if (dy == 0)
+    {
+    return height;
+    }
+  if (dx == 0)
+    {
+    return width;
+    }
+  return width + height - 1;
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+SemiGlobalMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::AggregatePath(int dx, int dy, unsigned long lineBegin, unsigned long lineEnd)
+{
+  const long width  = m_Tile.GetSize()[0];
+  const long height = m_Tile.GetSize()[1];
+  const unsigned int nbDisp = this->NumberOfDisparities();
+  const CostType p1 = m_ScaledP1;
+  const CostType p2 = m_ScaledP2;
+
+  // First column and row of the paths
+  const long x0 = dx >= 0 ? 0 : width - 1;
+  const long y0 = dy >= 0 ? 0 : height - 1;
+
+  // Aggregated costs of the current and previous pixels along the path
+  std::vector<CostType> current(nbDisp);
+  std::vector<CostType> previous(nbDisp);
+
+  for (unsigned long line = lineBegin; line < lineEnd; ++line)
+    {
+    // Start of the line: on the first row (or column for horizontal
+    // paths), then on the first column for diagonal paths
+    long x = x0;
+    long y = y0;
+    if (dy == 0)
+      {
+      y = line;
+      }
+    else if (dx == 0 || static_cast<long>(line) < width)
+      {
+      x = line;
+      }
+    else
+      {
+      const long row = line - width + 1;
+      y = dy > 0 ? row : height - 1 - row;
+      }
+
+    CostType previousMin = 0;
+    for (bool first = true; x >= 0 && x < width && y >= 0 && y < height; x += dx, y += dy, first = false)
+      {
+      const CostType * cost = &m_Costs[(y * width + x) * nbDisp];
+
+      if (first)
+        {
+        std::copy(cost, cost + nbDisp, current.begin());
+        }
+      else
+        {
+        for (unsigned int d = 0; d < nbDisp; ++d)
+          {
+          CostType best = std::min(previous[d], previousMin + p2);
+          if (d > 0)
+            {
+            best = std::min(best, previous[d - 1] + p1);
+            }
+          if (d + 1 < nbDisp)
+            {
+            best = std::min(best, previous[d + 1] + p1);
+            }
+          current[d] = cost[d] + best - previousMin;
+          }
+        }
+
+      CostType * sum = &m_Aggregated[(y * width + x) * nbDisp];
+      CostType currentMin = current[0];
+      for (unsigned int d = 0; d < nbDisp; ++d)
+        {
+        currentMin = std::min(currentMin, current[d]);
+        sum[d] += current[d];
+        }
+
+      std::swap(current, previous);
+      previousMin = currentMin;
+      }
+    }
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+ITK_THREAD_RETURN_TYPE
+SemiGlobalMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::CostVolumeThreaderCallback(void *arg)
+{
+  ThreadStruct *str = (ThreadStruct*)(((itk::MultiThreader::ThreadInfoStruct *)(arg))->UserData);
+  const itk::ThreadIdType threadId = ((itk::MultiThreader::ThreadInfoStruct *)(arg))->ThreadID;
+  const itk::ThreadIdType threadCount = ((itk::MultiThreader::ThreadInfoStruct *)(arg))->NumberOfThreads;
+
+  // Each thread computes a range of disparities
+  const unsigned int nbDisp = str->Filter->NumberOfDisparities();
+  const unsigned int dBegin = static_cast<unsigned int>(static_cast<unsigned long>(nbDisp) * threadId / threadCount);
+  const unsigned int dEnd = static_cast<unsigned int>(static_cast<unsigned long>(nbDisp) * (threadId + 1) / threadCount);
+  str->Filter->ComputeCostVolume(str->Filter->m_Tile, dBegin, dEnd, str->Filter->m_Costs, str->Filter->m_Validity);
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+ITK_THREAD_RETURN_TYPE
+SemiGlobalMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::AggregationThreaderCallback(void *arg)
+{
+  ThreadStruct *str = (ThreadStruct*)(((itk::MultiThreader::ThreadInfoStruct *)(arg))->UserData);
+  const itk::ThreadIdType threadId = ((itk::MultiThreader::ThreadInfoStruct *)(arg))->ThreadID;
+  const itk::ThreadIdType threadCount = ((itk::MultiThreader::ThreadInfoStruct *)(arg))->NumberOfThreads;
+
+  // Each thread aggregates a range of lines of the direction
+  const unsigned long nbLines = str->Filter->NumberOfLines(str->Dx, str->Dy);
+  str->Filter->AggregatePath(str->Dx, str->Dy, nbLines * threadId / threadCount, nbLines * (threadId + 1) / threadCount);
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+SemiGlobalMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::PrintSelf(std::ostream & os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "P1: " << m_P1 << std::endl;
+  os << indent << "P2: " << m_P2 << std::endl;
+  os << indent << "NormalizePenalties: " << m_NormalizePenalties << std::endl;
+  os << indent << "CostScale: " << m_CostScale << std::endl;
+  os << indent << "CostScaleSampleSize: " << m_CostScaleSampleSize << std::endl;
+  os << indent << "NumberOfPaths: " << m_NumberOfPaths << std::endl;
+  os << indent << "AggregationMargin: " << m_AggregationMargin << std::endl;
+}
+
+} // end namespace otb
+
+#endif
@@ -30,6 +30,7 @@ otb_module(OTBDisparityMap
     OTBCommon
     OTBITK
     OTBImageBase
+    OTBOSSIMAdapters
     OTBPointSet
     OTBStereo
     OTBTransform
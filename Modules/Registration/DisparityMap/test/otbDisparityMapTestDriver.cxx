@@ -43,4 +43,9 @@ void RegisterTests()
   REGISTER_TEST(otbPixelWiseBlockMatchingImageFilter);
   REGISTER_TEST(otbPixelWiseBlockMatchingImageFilterNew);
   REGISTER_TEST(otbPixelWiseBlockMatchingImageFilterNCC);
+  REGISTER_TEST(otbPixelWiseBlockMatchingImageFilterBoxFilter);
+  REGISTER_TEST(otbSemiGlobalMatchingImageFilterNew);
+  REGISTER_TEST(otbSemiGlobalMatchingImageFilter);
+  REGISTER_TEST(otbSemiGlobalMatchingImageFilterWeakTexture);
+  REGISTER_TEST(otbSemiGlobalMatchingImageFilterThreads);
 }
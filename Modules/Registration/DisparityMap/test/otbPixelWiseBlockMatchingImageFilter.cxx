@@ -23,6 +23,7 @@
 #include "otbImageFileReader.h"
 #include "otbImageFileWriter.h"
 #include "otbStandardWriterWatcher.h"
+#include "itkImageRegionIteratorWithIndex.h"
 
 typedef otb::Image<unsigned short>                    ImageType;
 typedef otb::Image<float>                             FloatImageType;
@@ -126,3 +127,94 @@ int otbPixelWiseBlockMatchingImageFilterNCC(int argc, char * argv[])
 
   return EXIT_SUCCESS;
 }
+
+template <class TFunctor>
+bool CheckBlockMatchingBoxFilter(const FloatImageType * left, const FloatImageType * right,
+                                 const TFunctor & functor, bool minimize, bool checkDisparity)
+{
+  typedef otb::PixelWiseBlockMatchingImageFilter<FloatImageType,FloatImageType,FloatImageType,ImageType,TFunctor> FilterType;
+
+  typename FilterType::Pointer refFilter = FilterType::New();
+  typename FilterType::Pointer boxFilter = FilterType::New();
+  typename FilterType::Pointer filters[2] = {refFilter, boxFilter};
+  for (unsigned int i = 0; i < 2; ++i)
+    {
+    filters[i]->SetLeftInput(left);
+    filters[i]->SetRightInput(right);
+    filters[i]->SetRadius(2);
+    filters[i]->SetMinimumHorizontalDisparity(-4);
+    filters[i]->SetMaximumHorizontalDisparity(3);
+    filters[i]->SetMinimumVerticalDisparity(-1);
+    filters[i]->SetMaximumVerticalDisparity(1);
+    filters[i]->SetMinimize(minimize);
+    filters[i]->GetFunctor() = functor;
+    filters[i]->SetUseBoxFilter(i == 1);
+    filters[i]->Update();
+    }
+
+  itk::ImageRegionConstIterator<FloatImageType> refMetricIt(refFilter->GetMetricOutput(),
+    refFilter->GetMetricOutput()->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<FloatImageType> boxMetricIt(boxFilter->GetMetricOutput(),
+    boxFilter->GetMetricOutput()->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<FloatImageType> refDispIt(refFilter->GetHorizontalDisparityOutput(),
+    refFilter->GetHorizontalDisparityOutput()->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<FloatImageType> boxDispIt(boxFilter->GetHorizontalDisparityOutput(),
+    boxFilter->GetHorizontalDisparityOutput()->GetLargestPossibleRegion());
+
+  for (refMetricIt.GoToBegin(), boxMetricIt.GoToBegin(), refDispIt.GoToBegin(), boxDispIt.GoToBegin();
+       !refMetricIt.IsAtEnd(); ++refMetricIt, ++boxMetricIt, ++refDispIt, ++boxDispIt)
+    {
+    const double tolerance = 1e-5 * std::max(1., vcl_abs(static_cast<double>(refMetricIt.Get())));
+    if (vcl_abs(refMetricIt.Get() - boxMetricIt.Get()) > tolerance
+        || (checkDisparity && refDispIt.Get() != boxDispIt.Get()))
+      {
+      std::cerr << "Mismatch at " << refMetricIt.GetIndex() << ": expected metric " << refMetricIt.Get()
+                << " and disparity " << refDispIt.Get() << ", got metric " << boxMetricIt.Get()
+                << " and disparity " << boxDispIt.Get() << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+int otbPixelWiseBlockMatchingImageFilterBoxFilter(int itkNotUsed(argc), char * itkNotUsed(argv) [])
+{
+  // Small integer valued images: sums are exact, both for the functors and
+  // the box filter
+  FloatImageType::SizeType size = {{ 23, 17 }};
+  FloatImageType::IndexType index;
+  index.Fill(0);
+  FloatImageType::RegionType region(index, size);
+
+  FloatImageType::Pointer left = FloatImageType::New();
+  left->SetRegions(region);
+  left->Allocate();
+  FloatImageType::Pointer right = FloatImageType::New();
+  right->SetRegions(region);
+  right->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<FloatImageType> leftIt(left, region);
+  itk::ImageRegionIteratorWithIndex<FloatImageType> rightIt(right, region);
+  for (leftIt.GoToBegin(), rightIt.GoToBegin(); !leftIt.IsAtEnd(); ++leftIt, ++rightIt)
+    {
+    const FloatImageType::IndexType & idx = leftIt.GetIndex();
+    leftIt.Set(1 + (idx[0] * 5 + idx[1] * 3 + idx[0] * idx[1]) % 13);
+    rightIt.Set(1 + ((idx[0] + 2) * 5 + idx[1] * 3 + (idx[0] + 2) * idx[1] + idx[0] % 3) % 13);
+    }
+
+  otb::Functor::SSDBlockMatching<FloatImageType,FloatImageType> ssdFunctor;
+  otb::Functor::SSDDivMeanBlockMatching<FloatImageType,FloatImageType> ssdDivMeanFunctor;
+  otb::Functor::NCCBlockMatching<FloatImageType,FloatImageType> nccFunctor;
+  otb::Functor::LPBlockMatching<FloatImageType,FloatImageType> lpFunctor;
+  lpFunctor.SetP(1.0);
+
+  bool passed = true;
+  passed = CheckBlockMatchingBoxFilter(left, right, ssdFunctor, true, true) && passed;
+  passed = CheckBlockMatchingBoxFilter(left, right, lpFunctor, true, true) && passed;
+  // SSDDivMean divides by the means: same rounding caveat as NCC
+  passed = CheckBlockMatchingBoxFilter(left, right, ssdDivMeanFunctor, true, false) && passed;
+  // NCC values are rounded differently, nearly equal optima may swap
+  passed = CheckBlockMatchingBoxFilter(left, right, nccFunctor, false, false) && passed;
+
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
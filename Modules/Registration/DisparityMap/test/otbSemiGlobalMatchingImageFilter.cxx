@@ -0,0 +1,280 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbSemiGlobalMatchingImageFilter.h"
+#include "otbPixelWiseBlockMatchingImageFilter.h"
+#include "otbImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+typedef otb::Image<float>                             FloatImageType;
+typedef otb::Image<unsigned char>                     MaskImageType;
+
+typedef otb::SemiGlobalMatchingImageFilter<FloatImageType,FloatImageType,FloatImageType,MaskImageType> SemiGlobalMatchingImageFilterType;
+
+namespace
+{
+// Deterministic texture without repetitive patterns
+float Texture(long x, long y)
+{
+  unsigned long h = static_cast<unsigned long>(x) * 73856093UL ^ static_cast<unsigned long>(y) * 19349663UL;
+  h = (h ^ (h >> 13)) * 1274126177UL;
+  return static_cast<float>((h >> 7) % 64);
+}
+
+// Deterministic noise in [-3,3], different for each seed
+float Noise(long x, long y, unsigned long seed)
+{
+  return static_cast<float>(static_cast<long>(Texture(x + 1000 * seed, y + 7)) % 7) - 3.f;
+}
+
+// Texture with a weakly textured square in the middle
+float WeakTexture(long x, long y)
+{
+  const bool weak = x >= 16 && x < 48 && y >= 16 && y < 48;
+  return weak ? static_cast<float>(static_cast<long>(Texture(x, y)) % 4) : Texture(x, y);
+}
+
+// Left and right images of a textured scene shifted by 3 pixels, with a
+// weakly textured area and independent noise on both images
+void FillWeakTexturePair(FloatImageType * left, FloatImageType * right)
+{
+  FloatImageType::SizeType size = {{ 64, 64 }};
+  FloatImageType::IndexType index;
+  index.Fill(0);
+  FloatImageType::RegionType region(index, size);
+
+  left->SetRegions(region);
+  left->Allocate();
+  right->SetRegions(region);
+  right->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<FloatImageType> leftIt(left, region);
+  itk::ImageRegionIteratorWithIndex<FloatImageType> rightIt(right, region);
+  for (leftIt.GoToBegin(), rightIt.GoToBegin(); !leftIt.IsAtEnd(); ++leftIt, ++rightIt)
+    {
+    const FloatImageType::IndexType & idx = leftIt.GetIndex();
+    leftIt.Set(WeakTexture(idx[0], idx[1]) + Noise(idx[0], idx[1], 1));
+    rightIt.Set(WeakTexture(idx[0] - 3, idx[1]) + Noise(idx[0], idx[1], 2));
+    }
+}
+
+// Count the wrong disparities of the local block-matching and of SGM with
+// the default penalties, on the pixels whose whole disparity range lies
+// in the right image
+template <class TFunctor>
+bool CheckSemiGlobalBeatsLocal(const FloatImageType * left, const FloatImageType * right,
+                               bool minimize, const char * metricName)
+{
+  typedef otb::PixelWiseBlockMatchingImageFilter<FloatImageType,FloatImageType,FloatImageType,MaskImageType,TFunctor> LocalFilterType;
+  typedef otb::SemiGlobalMatchingImageFilter<FloatImageType,FloatImageType,FloatImageType,MaskImageType,TFunctor> SGMFilterType;
+
+  const int shift = 3;
+  const int minDisparity = -2;
+  const int maxDisparity = 6;
+  const unsigned int radius = 1;
+
+  typename LocalFilterType::Pointer localFilter = LocalFilterType::New();
+  typename SGMFilterType::Pointer sgmFilter = SGMFilterType::New();
+  LocalFilterType * filters[2] = {localFilter.GetPointer(), sgmFilter.GetPointer()};
+  for (unsigned int i = 0; i < 2; ++i)
+    {
+    filters[i]->SetLeftInput(left);
+    filters[i]->SetRightInput(right);
+    filters[i]->SetRadius(radius);
+    filters[i]->SetMinimumHorizontalDisparity(minDisparity);
+    filters[i]->SetMaximumHorizontalDisparity(maxDisparity);
+    filters[i]->SetMinimize(minimize);
+    filters[i]->Update();
+    }
+
+  const FloatImageType::SizeType size = left->GetLargestPossibleRegion().GetSize();
+  FloatImageType::IndexType checkIndex;
+  checkIndex[0] = radius - minDisparity;
+  checkIndex[1] = radius;
+  FloatImageType::SizeType checkSize;
+  checkSize[0] = size[0] - radius - maxDisparity - checkIndex[0];
+  checkSize[1] = size[1] - 2 * radius;
+  FloatImageType::RegionType checkRegion(checkIndex, checkSize);
+
+  unsigned long nbErrors[2] = {0, 0};
+  for (unsigned int i = 0; i < 2; ++i)
+    {
+    itk::ImageRegionConstIteratorWithIndex<FloatImageType> dispIt(filters[i]->GetHorizontalDisparityOutput(), checkRegion);
+    for (dispIt.GoToBegin(); !dispIt.IsAtEnd(); ++dispIt)
+      {
+      if (dispIt.Get() != shift)
+        {
+        ++nbErrors[i];
+        }
+      }
+    }
+
+  std::cout << metricName << ": " << nbErrors[0] << " wrong disparities with local block-matching, "
+            << nbErrors[1] << " with SGM" << std::endl;
+  return nbErrors[0] > 0 && nbErrors[1] < nbErrors[0];
+}
+}
+
+int otbSemiGlobalMatchingImageFilterNew(int itkNotUsed(argc), char * itkNotUsed(argv) [])
+{
+  // Instantiation
+  SemiGlobalMatchingImageFilterType::Pointer sgmFilter = SemiGlobalMatchingImageFilterType::New();
+
+  return EXIT_SUCCESS;
+}
+
+int otbSemiGlobalMatchingImageFilter(int itkNotUsed(argc), char * itkNotUsed(argv) [])
+{
+  // The right image is the left one shifted by a known disparity
+  const int shift = 3;
+  const int minDisparity = -2;
+  const int maxDisparity = 6;
+  const unsigned int radius = 2;
+
+  FloatImageType::SizeType size = {{ 64, 48 }};
+  FloatImageType::IndexType index;
+  index.Fill(0);
+  FloatImageType::RegionType region(index, size);
+
+  FloatImageType::Pointer left = FloatImageType::New();
+  left->SetRegions(region);
+  left->Allocate();
+  FloatImageType::Pointer right = FloatImageType::New();
+  right->SetRegions(region);
+  right->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<FloatImageType> leftIt(left, region);
+  itk::ImageRegionIteratorWithIndex<FloatImageType> rightIt(right, region);
+  for (leftIt.GoToBegin(), rightIt.GoToBegin(); !leftIt.IsAtEnd(); ++leftIt, ++rightIt)
+    {
+    const FloatImageType::IndexType & idx = leftIt.GetIndex();
+    leftIt.Set(Texture(idx[0], idx[1]));
+    rightIt.Set(Texture(idx[0] - shift, idx[1]));
+    }
+
+  bool passed = true;
+  const unsigned int paths[2] = {4, 8};
+  const bool boxFilter[2] = {false, true};
+
+  for (unsigned int p = 0; p < 2; ++p)
+    {
+    for (unsigned int b = 0; b < 2; ++b)
+      {
+      SemiGlobalMatchingImageFilterType::Pointer sgmFilter = SemiGlobalMatchingImageFilterType::New();
+      sgmFilter->SetLeftInput(left);
+      sgmFilter->SetRightInput(right);
+      sgmFilter->SetRadius(radius);
+      sgmFilter->SetMinimumHorizontalDisparity(minDisparity);
+      sgmFilter->SetMaximumHorizontalDisparity(maxDisparity);
+      sgmFilter->SetNumberOfPaths(paths[p]);
+      sgmFilter->SetAggregationMargin(8);
+      sgmFilter->SetUseBoxFilter(boxFilter[b]);
+      sgmFilter->Update();
+
+      // Check the pixels whose whole disparity range lies in the right image
+      FloatImageType::IndexType checkIndex;
+      checkIndex[0] = radius - minDisparity;
+      checkIndex[1] = radius;
+      FloatImageType::SizeType checkSize;
+      checkSize[0] = size[0] - radius - maxDisparity - checkIndex[0];
+      checkSize[1] = size[1] - 2 * radius;
+      FloatImageType::RegionType checkRegion(checkIndex, checkSize);
+
+      itk::ImageRegionConstIteratorWithIndex<FloatImageType> dispIt(sgmFilter->GetHorizontalDisparityOutput(), checkRegion);
+      for (dispIt.GoToBegin(); !dispIt.IsAtEnd(); ++dispIt)
+        {
+        if (dispIt.Get() != shift)
+          {
+          std::cerr << "With " << paths[p] << " paths" << (boxFilter[b] ? " and box filter" : "")
+                    << ": wrong disparity at " << dispIt.GetIndex() << ", expected " << shift
+                    << ", got " << dispIt.Get() << std::endl;
+          passed = false;
+          break;
+          }
+        }
+      }
+    }
+
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int otbSemiGlobalMatchingImageFilterWeakTexture(int itkNotUsed(argc), char * itkNotUsed(argv) [])
+{
+  // Local matching fails in the weakly textured area, where SGM propagates
+  // the disparities of its neighborhood
+  FloatImageType::Pointer left = FloatImageType::New();
+  FloatImageType::Pointer right = FloatImageType::New();
+  FillWeakTexturePair(left, right);
+
+  // The same default penalties are used with both metrics, whose costs
+  // have very different ranges
+  bool passed = true;
+  passed = CheckSemiGlobalBeatsLocal< otb::Functor::SSDBlockMatching<FloatImageType,FloatImageType> >(
+    left, right, true, "SSD") && passed;
+  passed = CheckSemiGlobalBeatsLocal< otb::Functor::NCCBlockMatching<FloatImageType,FloatImageType> >(
+    left, right, false, "NCC") && passed;
+
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int otbSemiGlobalMatchingImageFilterThreads(int itkNotUsed(argc), char * itkNotUsed(argv) [])
+{
+  // The output must not depend on the number of threads
+  FloatImageType::Pointer left = FloatImageType::New();
+  FloatImageType::Pointer right = FloatImageType::New();
+  FillWeakTexturePair(left, right);
+
+  const unsigned int nbThreads[2] = {1, 5};
+  SemiGlobalMatchingImageFilterType::Pointer sgmFilters[2];
+  for (unsigned int i = 0; i < 2; ++i)
+    {
+    sgmFilters[i] = SemiGlobalMatchingImageFilterType::New();
+    sgmFilters[i]->SetLeftInput(left);
+    sgmFilters[i]->SetRightInput(right);
+    sgmFilters[i]->SetRadius(1);
+    sgmFilters[i]->SetMinimumHorizontalDisparity(-2);
+    sgmFilters[i]->SetMaximumHorizontalDisparity(6);
+    sgmFilters[i]->SetNumberOfThreads(nbThreads[i]);
+    sgmFilters[i]->Update();
+    }
+
+  itk::ImageRegionConstIteratorWithIndex<FloatImageType> dispIt1(sgmFilters[0]->GetHorizontalDisparityOutput(),
+                                                                 left->GetLargestPossibleRegion());
+  itk::ImageRegionConstIteratorWithIndex<FloatImageType> dispItN(sgmFilters[1]->GetHorizontalDisparityOutput(),
+                                                                 left->GetLargestPossibleRegion());
+  itk::ImageRegionConstIteratorWithIndex<FloatImageType> metricIt1(sgmFilters[0]->GetMetricOutput(),
+                                                                   left->GetLargestPossibleRegion());
+  itk::ImageRegionConstIteratorWithIndex<FloatImageType> metricItN(sgmFilters[1]->GetMetricOutput(),
+                                                                   left->GetLargestPossibleRegion());
+  for (dispIt1.GoToBegin(), dispItN.GoToBegin(), metricIt1.GoToBegin(), metricItN.GoToBegin();
+       !dispIt1.IsAtEnd(); ++dispIt1, ++dispItN, ++metricIt1, ++metricItN)
+    {
+    if (dispIt1.Get() != dispItN.Get() || metricIt1.Get() != metricItN.Get())
+      {
+      std::cerr << "Different outputs at " << dispIt1.GetIndex() << ": disparity " << dispIt1.Get()
+                << " and metric " << metricIt1.Get() << " with " << nbThreads[0] << " thread, disparity "
+                << dispItN.Get() << " and metric " << metricItN.Get() << " with " << nbThreads[1]
+                << " threads" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}